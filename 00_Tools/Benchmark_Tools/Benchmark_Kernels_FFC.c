@@ -0,0 +1,441 @@
+/* This program benchmarks a C-MEX kernel of Fragments-Expert without MATLAB. The kernel is called
+ * through its mexFunction (with the MEX API of mex.h in this folder) for synthetic fragments of
+ * the following types and of the fragment sizes allowed by Script_RawData_to_Fragments_FFC (128~4096 bytes):
+ *  zeros: All-zero bytes
+ *  header: Low-entropy bytes (a repeated record header with a counter field)
+ *  text: Text-like bytes (words of a small vocabulary, spaces, punctuation, and newlines)
+ *  random: Uniformly random bytes (as compressed or encrypted contents)
+ * For each fragment type and size, the latency percentiles (50%, 90%, and 99%) and the throughput
+ * are reported. The results can be saved as a baseline, and compared with a saved baseline: a median
+ * latency greater than the baseline by more than the threshold is reported as a regression.
+ *
+ * Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+ *
+ * This file is a part of Fragments-Expert software, a software package for
+ * feature extraction from file fragments and classification among various file formats.
+ *
+ * Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Compile (one executable for each kernel, selected by BENCH_<KERNEL>; run in this folder):
+ *  gcc -O2 -I. -DBENCH_LCSSEQ Benchmark_Kernels_FFC.c -lm -o Benchmark_LCSSeq_FFC
+ *  BENCH_LCSSEQ, BENCH_LCSSTR, BENCH_KOLMOGOROV, BENCH_FALSE_NEAREST, BENCH_LYAP_EXP_K, or BENCH_LONGESTCONTIGUOUS
+ *  (Run_Benchmark_FFC.sh compiles and runs all kernels)
+ *
+ * Usage method: Benchmark_<KERNEL>_FFC [-n NumCalls] [-sizes 128,512,...] [-baseline File] [-save File] [-threshold Ratio] [-band Band]
+ *  -n: Number of timed calls for each fragment type and size (default: 50)
+ *  -sizes: Comma-separated fragment sizes (default: 128,512,1024,1500,4096)
+ *  -baseline: Baseline file for comparison
+ *  -save: File for saving the results as a baseline (the lines of the other kernels in the file are kept)
+ *  -threshold: Allowed relative increase of the median latency (default: 0.10)
+ *  -band: Band width of the approximate mode of LCSSeq_FFC and LCSStr_FFC (default: exact mode);
+ *      the results are labeled as <Kernel>_Band<Band>, e.g. LCSSeq_FFC_Band128
+ *
+ * Outputs:
+ *  A table of results (latencies in microseconds, throughput in MB/s) in the standard output.
+ *  Exit status: 0 (no regression), 1 (error), or 2 (regression with respect to the baseline).
+ *
+ *  Baseline file format: One line for each kernel, fragment type, and size:
+ *  Kernel FragmentType Size P50 P90 P99 Throughput
+ *
+ * Revisions:
+ * 2026-Oct-18   function was created
+ * 2026-Oct-18   option for the approximate mode of LCS kernels was added
+ * 2026-Oct-18   Band is only defined for the LCS kernels
+ */
+
+#if defined(BENCH_LCSSEQ)
+#include "../../02_Feature_Extraction/Similarity/_Functions/LCSSeq_FFC.c"
+#define KERNEL_NAME "LCSSeq_FFC"
+#elif defined(BENCH_LCSSTR)
+#include "../../02_Feature_Extraction/Similarity/_Functions/LCSStr_FFC.c"
+#define KERNEL_NAME "LCSStr_FFC"
+#elif defined(BENCH_KOLMOGOROV)
+#include "../../02_Feature_Extraction/Randomness/_Functions/kolmogorov_FFC.c"
+#define KERNEL_NAME "kolmogorov_FFC"
+#elif defined(BENCH_FALSE_NEAREST)
+#include "../../02_Feature_Extraction/Randomness/_Functions/false_nearest_FFC.c"
+#define KERNEL_NAME "false_nearest_FFC"
+#elif defined(BENCH_LYAP_EXP_K)
+#include "../../02_Feature_Extraction/Randomness/_Functions/lyap_exp_k_FFC.c"
+#define KERNEL_NAME "lyap_exp_k_FFC"
+#elif defined(BENCH_LONGESTCONTIGUOUS)
+#include "../../02_Feature_Extraction/Byte_Distribution_Features/_functions/LongestContiguous_Core_FFC.c"
+#define KERNEL_NAME "LongestContiguous_Core_FFC"
+#else
+#error "The kernel is not selected (e.g. compile with -DBENCH_LCSSEQ)."
+#endif
+
+#include <stdint.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define NUM_FRAGMENTS 16 /* Number of distinct fragments of each type and size (used cyclically) */
+#define NUM_WARMUP 3
+#define MAX_SIZES 16
+#define MAX_LINES 4096
+
+static const char *FragmentTypes[] = {"zeros","header","text","random"};
+#define NUM_TYPES 4
+
+#if defined(BENCH_LCSSEQ) || defined(BENCH_LCSSTR)
+static int Band = -1; /* Band width of the approximate mode of LCS kernels (-1 for the exact mode) */
+#endif
+static char KernelLabel[64] = KERNEL_NAME; /* Label of the results */
+
+/* Wall-clock time (seconds) */
+static double now_seconds(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER f,c;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&c);
+    return (double)c.QuadPart/(double)f.QuadPart;
+#else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC,&t);
+    return (double)t.tv_sec+1e-9*(double)t.tv_nsec;
+#endif
+}
+
+/* Pseudo-random generator (xorshift64*) */
+static uint64_t rng_state;
+static uint64_t rng_next(void)
+{
+    rng_state ^= rng_state>>12;
+    rng_state ^= rng_state<<25;
+    rng_state ^= rng_state>>27;
+    return rng_state*0x2545F4914F6CDD1DULL;
+}
+
+/* Synthetic fragment of a given type (the bytes are written as doubles, as the kernels take them) */
+static void generate_fragment(int type,int n,uint64_t seed,double *x)
+{
+    static const char *words[] = {"the","of","and","to","in","a","is","that","for","it","as","with","was","on",
+        "file","fragment","data","format","value","header","stream","block","record","table","index"};
+    static const unsigned char record[16] = {0x52,0x49,0x46,0x46,0x00,0x00,0x01,0x00,0x57,0x41,0x56,0x45,0x66,0x6d,0x74,0x20};
+    int i,j,w;
+    uint64_t r;
+
+    rng_state = 0x9E3779B97F4A7C15ULL*(seed+1);
+    switch (type)
+    {
+        case 0: /* zeros */
+            for (i=0;i<n;i++)
+                x[i] = 0;
+            break;
+
+        case 1: /* header: 16-byte records with a 16-bit counter and a rare random byte */
+            for (i=0;i<n;i++)
+            {
+                j = i%16;
+                if (j==4)
+                    x[i] = (double)((i/16+seed)&255);
+                else if (j==5)
+                    x[i] = (double)(((i/16+seed)>>8)&255);
+                else if ((rng_next()&63)==0)
+                    x[i] = (double)(rng_next()&255);
+                else
+                    x[i] = (double)record[j];
+            }
+            break;
+
+        case 2: /* text: words with Zipf-like frequencies */
+            i = 0;
+            while (i<n)
+            {
+                r = rng_next();
+                w = (int)((r%25)*((r>>8)%25)/25);
+                for (j=0;words[w][j]!=0 && i<n;j++)
+                    x[i++] = (double)(unsigned char)words[w][j];
+                if (i<n)
+                {
+                    r = rng_next()%16;
+                    x[i++] = (r==0) ? '\n' : ((r==1) ? ',' : ((r==2) ? '.' : ' '));
+                }
+            }
+            break;
+
+        default: /* random */
+            for (i=0;i<n;i++)
+                x[i] = (double)(rng_next()&255);
+            break;
+    }
+}
+
+/* Inputs of the kernel for a fragment (rep is a second fragment of the same type and size) */
+static int prepare_inputs(mxArray *frag,mxArray *rep,mxArray **prhs)
+{
+    prhs[0] = frag;
+#if defined(BENCH_LCSSEQ) || defined(BENCH_LCSSTR)
+    prhs[1] = rep;
+    if (Band>=0)
+    {
+        prhs[2] = mxCreateDoubleScalar(Band);
+        return 3;
+    }
+    return 2;
+#elif defined(BENCH_FALSE_NEAREST)
+    (void)rep;
+    prhs[1] = mxCreateDoubleScalar(3); /* Default parameters of Script_GenerateDataset_from_FragmentDataset_FFC */
+    prhs[2] = mxCreateDoubleScalar(7);
+    prhs[3] = mxCreateDoubleScalar(2.0);
+    return 4;
+#elif defined(BENCH_LYAP_EXP_K)
+    (void)rep;
+    prhs[1] = mxCreateDoubleScalar(2);
+    prhs[2] = mxCreateDoubleScalar(5);
+    return 3;
+#else
+    (void)rep;
+    return 1;
+#endif
+}
+
+/* Call of the kernel; returns the elapsed time, or a negative value if the kernel raises an error */
+static double call_kernel(int nrhs,mxArray **prhs,mxArray **plhs)
+{
+    double t0;
+    plhs[0] = plhs[1] = NULL;
+    if (setjmp(mex_error_jump)!=0)
+        return -1;
+    t0 = now_seconds();
+    mexFunction(1,plhs,nrhs,(const mxArray**)prhs);
+    return now_seconds()-t0;
+}
+
+static int compare_double(const void *a,const void *b)
+{
+    double d = *(const double*)a-*(const double*)b;
+    return (d>0)-(d<0);
+}
+
+static double percentile(const double *sorted,int n,double p)
+{
+    int k = (int)(p*(n-1)+0.5);
+    return sorted[k];
+}
+
+/* Results and baseline lines */
+typedef struct {
+    char kernel[64];
+    char type[16];
+    int size;
+    double p50,p90,p99,throughput;
+} result_line;
+
+static int read_baseline(const char *filename,result_line *lines)
+{
+    FILE *fid = fopen(filename,"r");
+    char buf[256];
+    int n = 0;
+    if (fid==NULL)
+        return -1;
+    while (n<MAX_LINES && fgets(buf,sizeof(buf),fid)!=NULL)
+    {
+        if (buf[0]=='#')
+            continue;
+        if (sscanf(buf,"%63s %15s %d %lf %lf %lf %lf",lines[n].kernel,lines[n].type,&lines[n].size,
+                &lines[n].p50,&lines[n].p90,&lines[n].p99,&lines[n].throughput)==7)
+            n++;
+    }
+    fclose(fid);
+    return n;
+}
+
+static const result_line *find_line(const result_line *lines,int n,const char *kernel,const char *type,int size)
+{
+    int i;
+    for (i=0;i<n;i++)
+        if (strcmp(lines[i].kernel,kernel)==0 && strcmp(lines[i].type,type)==0 && lines[i].size==size)
+            return lines+i;
+    return NULL;
+}
+
+static result_line bench_results[MAX_LINES];
+static result_line bench_baseline[MAX_LINES];
+
+int main(int argc,char **argv)
+{
+    int NumCalls = 50;
+    int Sizes[MAX_SIZES] = {128,512,1024,1500,4096};
+    int NumSizes = 5;
+    const char *BaselineFile = NULL;
+    const char *SaveFile = NULL;
+    double Threshold = 0.10;
+    int NumBaseline = 0, NumResults = 0, NumRegressions = 0, NumErrors = 0;
+    int i,s,t,c,k,nrhs,n;
+    double *latency,total,t0;
+    mxArray *frags[NUM_FRAGMENTS],*reps[NUM_FRAGMENTS],*prhs[4],*plhs[2];
+    const result_line *b;
+    result_line *r;
+    char *tok;
+
+    /* Options */
+    for (i=1;i<argc;i++)
+    {
+        if (strcmp(argv[i],"-n")==0 && i+1<argc)
+            NumCalls = atoi(argv[++i]);
+        else if (strcmp(argv[i],"-sizes")==0 && i+1<argc)
+        {
+            NumSizes = 0;
+            for (tok=strtok(argv[++i],",");tok!=NULL && NumSizes<MAX_SIZES;tok=strtok(NULL,","))
+                Sizes[NumSizes++] = atoi(tok);
+        }
+        else if (strcmp(argv[i],"-baseline")==0 && i+1<argc)
+            BaselineFile = argv[++i];
+        else if (strcmp(argv[i],"-save")==0 && i+1<argc)
+            SaveFile = argv[++i];
+        else if (strcmp(argv[i],"-threshold")==0 && i+1<argc)
+            Threshold = atof(argv[++i]);
+#if defined(BENCH_LCSSEQ) || defined(BENCH_LCSSTR)
+        else if (strcmp(argv[i],"-band")==0 && i+1<argc)
+        {
+            Band = atoi(argv[++i]);
+            if (Band<0)
+            {
+                fprintf(stderr,"Band width should be non-negative.\n");
+                return 1;
+            }
+            sprintf(KernelLabel,"%s_Band%d",KERNEL_NAME,Band);
+        }
+#endif
+        else
+        {
+            fprintf(stderr,"Unknown option %s\n",argv[i]);
+            return 1;
+        }
+    }
+    if (NumCalls<1)
+    {
+        fprintf(stderr,"Number of calls should be positive.\n");
+        return 1;
+    }
+    for (s=0;s<NumSizes;s++)
+        if (Sizes[s]<128 || Sizes[s]>4096)
+        {
+            fprintf(stderr,"Fragment sizes should be in the range 128~4096.\n");
+            return 1;
+        }
+
+    if (BaselineFile!=NULL)
+    {
+        NumBaseline = read_baseline(BaselineFile,bench_baseline);
+        if (NumBaseline<0)
+        {
+            fprintf(stderr,"Baseline file %s cannot be opened; results are not compared.\n",BaselineFile);
+            NumBaseline = 0;
+        }
+    }
+
+    /* Benchmark */
+    latency = (double*)malloc(sizeof(double)*NumCalls);
+    printf("%-28s %-7s %5s %11s %11s %11s %10s %9s\n","Kernel","Type","Size","P50(us)","P90(us)","P99(us)","MB/s","Change");
+    for (t=0;t<NUM_TYPES;t++)
+        for (s=0;s<NumSizes;s++)
+        {
+            n = Sizes[s];
+            for (k=0;k<NUM_FRAGMENTS;k++)
+            {
+                frags[k] = mxCreateDoubleMatrix(1,n,mxREAL);
+                reps[k] = mxCreateDoubleMatrix(1,n,mxREAL);
+                generate_fragment(t,n,2*k,mxGetPr(frags[k]));
+                generate_fragment(t,n,2*k+1,mxGetPr(reps[k]));
+            }
+
+            total = 0;
+            for (c=-NUM_WARMUP;c<NumCalls;c++)
+            {
+                k = (c+NUM_WARMUP)%NUM_FRAGMENTS;
+                nrhs = prepare_inputs(frags[k],reps[k],prhs);
+                t0 = call_kernel(nrhs,prhs,plhs);
+                if (t0<0)
+                {
+                    fprintf(stderr,"%s (%s, %d bytes): %s\n",KernelLabel,FragmentTypes[t],n,mex_error_message);
+                    NumErrors++;
+                    break;
+                }
+                if (c>=0)
+                {
+                    latency[c] = t0;
+                    total += t0;
+                }
+                mxDestroyArray(plhs[0]);
+                for (i=1;i<nrhs;i++)
+                    if (prhs[i]!=reps[k])
+                        mxDestroyArray(prhs[i]);
+            }
+            for (k=0;k<NUM_FRAGMENTS;k++)
+            {
+                mxDestroyArray(frags[k]);
+                mxDestroyArray(reps[k]);
+            }
+            if (c<NumCalls)
+                continue;
+
+            qsort(latency,NumCalls,sizeof(double),compare_double);
+            r = bench_results+NumResults++;
+            strcpy(r->kernel,KernelLabel);
+            strcpy(r->type,FragmentTypes[t]);
+            r->size = n;
+            r->p50 = 1e6*percentile(latency,NumCalls,0.50);
+            r->p90 = 1e6*percentile(latency,NumCalls,0.90);
+            r->p99 = 1e6*percentile(latency,NumCalls,0.99);
+            r->throughput = (total>0) ? (double)n*NumCalls/total/1e6 : 0;
+
+            printf("%-28s %-7s %5d %11.2f %11.2f %11.2f %10.4g",r->kernel,r->type,r->size,r->p50,r->p90,r->p99,r->throughput);
+            b = find_line(bench_baseline,NumBaseline,r->kernel,r->type,r->size);
+            if (b!=NULL && b->p50>0)
+            {
+                printf(" %+8.1f%%",100*(r->p50/b->p50-1));
+                if (r->p50>b->p50*(1+Threshold))
+                {
+                    printf("  REGRESSION");
+                    NumRegressions++;
+                }
+            }
+            printf("\n");
+            fflush(stdout);
+        }
+    free(latency);
+
+    /* Save baseline (the lines of the other kernels are kept) */
+    if (SaveFile!=NULL)
+    {
+        FILE *fid;
+        NumBaseline = read_baseline(SaveFile,bench_baseline);
+        fid = fopen(SaveFile,"w");
+        if (fid==NULL)
+        {
+            fprintf(stderr,"Baseline file %s cannot be created.\n",SaveFile);
+            return 1;
+        }
+        fprintf(fid,"# Kernel FragmentType Size P50(us) P90(us) P99(us) Throughput(MB/s)\n");
+        for (i=0;i<NumBaseline;i++)
+            if (strcmp(bench_baseline[i].kernel,KernelLabel)!=0)
+                fprintf(fid,"%s %s %d %.3f %.3f %.3f %.3f\n",bench_baseline[i].kernel,bench_baseline[i].type,bench_baseline[i].size,
+                    bench_baseline[i].p50,bench_baseline[i].p90,bench_baseline[i].p99,bench_baseline[i].throughput);
+        for (i=0;i<NumResults;i++)
+            fprintf(fid,"%s %s %d %.3f %.3f %.3f %.3f\n",bench_results[i].kernel,bench_results[i].type,bench_results[i].size,
+                bench_results[i].p50,bench_results[i].p90,bench_results[i].p99,bench_results[i].throughput);
+        fclose(fid);
+    }
+
+    if (NumErrors>0)
+        return 1;
+    if (NumRegressions>0)
+    {
+        printf("%s: %d regression(s) with threshold %.1f%%\n",KernelLabel,NumRegressions,100*Threshold);
+        return 2;
+    }
+    return 0;
+}
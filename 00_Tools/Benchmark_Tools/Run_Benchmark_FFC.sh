@@ -0,0 +1,46 @@
+#!/bin/sh
+# This script compiles the benchmark of each C-MEX kernel (see Benchmark_Kernels_FFC.c) and runs it
+# without MATLAB. The options are passed to the benchmarks, e.g.
+#   ./Run_Benchmark_FFC.sh -save baseline.txt                      (save a baseline)
+#   ./Run_Benchmark_FFC.sh -baseline baseline.txt -threshold 0.05  (compare with the baseline)
+# The exit status is 0 (no regression), 1 (error), or 2 (regression in at least one kernel).
+#
+# Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+#
+# This file is a part of Fragments-Expert software, a software package for
+# feature extraction from file fragments and classification among various file formats.
+#
+# Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+#
+# Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this program.
+# If not, see <http://www.gnu.org/licenses/>.
+#
+# Revisions:
+# 2026-Oct-18   script was created
+
+CC=${CC:-gcc}
+CFLAGS=${CFLAGS:--O2}
+cd "$(dirname "$0")" || exit 1
+mkdir -p _bin || exit 1
+
+status=0
+for kernel in LCSSEQ LCSSTR KOLMOGOROV FALSE_NEAREST LYAP_EXP_K LONGESTCONTIGUOUS; do
+    exe=_bin/Benchmark_${kernel}_FFC
+    if ! $CC $CFLAGS -I. -DBENCH_$kernel Benchmark_Kernels_FFC.c -lm -o $exe; then
+        echo "Benchmark of $kernel cannot be compiled." >&2
+        status=1
+        continue
+    fi
+    $exe "$@"
+    ret=$?
+    if [ $ret -eq 1 ]; then
+        status=1
+    elif [ $ret -eq 2 ] && [ $status -eq 0 ]; then
+        status=2
+    fi
+done
+exit $status
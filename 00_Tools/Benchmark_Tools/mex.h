@@ -0,0 +1,136 @@
+/* This header provides the subset of the MEX API used by the C-MEX kernels of Fragments-Expert,
+ * so that the kernels can be compiled and benchmarked without MATLAB (see Benchmark_Kernels_FFC.c).
+ * Only real double matrices and scalar structures are supported. mexErrMsgTxt returns to the caller
+ * of the kernel with longjmp (see mex_error_jump).
+ *
+ * Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+ *
+ * This file is a part of Fragments-Expert software, a software package for
+ * feature extraction from file fragments and classification among various file formats.
+ *
+ * Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Revisions:
+ * 2026-Oct-18   function was created
+ * 2026-Oct-18   mxGetNumberOfElements and mxIsInf were added
+ */
+
+#ifndef MEX_H_BENCHMARK_FFC
+#define MEX_H_BENCHMARK_FFC
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+typedef enum { mxREAL, mxCOMPLEX } mxComplexity;
+
+typedef struct mxArray_tag {
+    size_t m,n;
+    double *pr;                 /* Data of a double matrix */
+    int nfields;                /* Fields of a 1x1 structure */
+    char **fieldnames;
+    struct mxArray_tag **fields;
+} mxArray;
+
+/* The benchmark sets mex_error_jump before calling mexFunction; mexErrMsgTxt jumps back to it */
+static jmp_buf mex_error_jump;
+static const char *mex_error_message = NULL;
+
+static inline void mexErrMsgTxt(const char *msg)
+{
+    mex_error_message = msg;
+    longjmp(mex_error_jump,1);
+}
+
+static inline mxArray *mxCreateDoubleMatrix(size_t m,size_t n,mxComplexity c)
+{
+    mxArray *a = (mxArray*)calloc(1,sizeof(mxArray));
+    (void)c;
+    a->m = m;
+    a->n = n;
+    a->pr = (double*)calloc(m*n+1,sizeof(double));
+    return a;
+}
+
+static inline mxArray *mxCreateDoubleScalar(double v)
+{
+    mxArray *a = mxCreateDoubleMatrix(1,1,mxREAL);
+    a->pr[0] = v;
+    return a;
+}
+
+static inline mxArray *mxCreateStructMatrix(size_t m,size_t n,int nfields,const char **fieldnames)
+{
+    int i;
+    mxArray *a = (mxArray*)calloc(1,sizeof(mxArray));
+    if (m*n!=1)
+        mexErrMsgTxt("Only scalar structures are supported.");
+    a->m = m;
+    a->n = n;
+    a->nfields = nfields;
+    a->fieldnames = (char**)malloc(sizeof(char*)*nfields);
+    a->fields = (mxArray**)calloc(nfields,sizeof(mxArray*));
+    for (i=0;i<nfields;i++)
+    {
+        a->fieldnames[i] = (char*)malloc(strlen(fieldnames[i])+1);
+        strcpy(a->fieldnames[i],fieldnames[i]);
+    }
+    return a;
+}
+
+static inline void mxDestroyArray(mxArray *a)
+{
+    int i;
+    if (a==NULL)
+        return;
+    for (i=0;i<a->nfields;i++)
+    {
+        free(a->fieldnames[i]);
+        mxDestroyArray(a->fields[i]);
+    }
+    free(a->fieldnames);
+    free(a->fields);
+    free(a->pr);
+    free(a);
+}
+
+static inline mxArray *mxGetField(const mxArray *a,size_t index,const char *name)
+{
+    int i;
+    (void)index;
+    for (i=0;i<a->nfields;i++)
+        if (strcmp(a->fieldnames[i],name)==0)
+            return a->fields[i];
+    return NULL;
+}
+
+static inline void mxSetField(mxArray *a,size_t index,const char *name,mxArray *value)
+{
+    int i;
+    (void)index;
+    for (i=0;i<a->nfields;i++)
+        if (strcmp(a->fieldnames[i],name)==0)
+        {
+            mxDestroyArray(a->fields[i]);
+            a->fields[i] = value;
+            return;
+        }
+}
+
+static inline double *mxGetPr(const mxArray *a) { return a->pr; }
+static inline size_t mxGetM(const mxArray *a) { return a->m; }
+static inline size_t mxGetN(const mxArray *a) { return a->n; }
+static inline int mxIsDouble(const mxArray *a) { return a->pr!=NULL; }
+static inline double mxGetScalar(const mxArray *a) { return (a->pr!=NULL && a->m*a->n>0) ? a->pr[0] : 0.0; }
+static inline size_t mxGetNumberOfElements(const mxArray *a) { return a->m*a->n; }
+static inline int mxIsInf(double v) { return v==v && (v-v)!=(v-v); }
+
+#endif
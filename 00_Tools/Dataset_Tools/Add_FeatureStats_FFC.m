@@ -0,0 +1,68 @@
+function Stats = Add_FeatureStats_FFC(Stats,Block)
+
+% This function adds a block of samples to the per-class statistics of the features (see Init_FeatureStats_FFC).
+% The mean and the sum of squared deviations of the block are merged with the accumulated ones by the
+% pairwise update of Welford's algorithm (Chan et al.), which is numerically stable for any block size.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Stats: Statistics of features (see Init_FeatureStats_FFC)
+%   Block: A block of the rows of dataset. The first F columns are the features and the column F+1 is
+%       the integer-valued class labels in {1,2,...,M}. The other columns (e.g., FileID) are ignored.
+%
+% Output:
+%   Stats: Updated statistics of features
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+F = Stats.NumFeatures;
+Labels = Block(:,F+1);
+for c=unique(Labels)'
+
+    X = Block(Labels==c,1:F);
+
+    % Counts
+    Finite = isfinite(X);
+    Stats.Count(c) = Stats.Count(c)+size(X,1);
+    Stats.NaNCount(c,:) = Stats.NaNCount(c,:)+sum(isnan(X),1);
+    Stats.PosInfCount(c,:) = Stats.PosInfCount(c,:)+sum(X==inf,1);
+    Stats.NegInfCount(c,:) = Stats.NegInfCount(c,:)+sum(X==-inf,1);
+    Stats.SentinelCount(c,:) = Stats.SentinelCount(c,:)+sum(X==Stats.Sentinel,1);
+
+    % Minimum and maximum of finite values
+    X(~Finite) = inf;
+    Stats.Min(c,:) = min(Stats.Min(c,:),min(X,[],1));
+    X(~Finite) = -inf;
+    Stats.Max(c,:) = max(Stats.Max(c,:),max(X,[],1));
+
+    % Mean and sum of squared deviations of the finite values of block
+    X(~Finite) = 0;
+    nb = sum(Finite,1);
+    Mean_b = sum(X,1)./max(nb,1);
+    D = bsxfun(@minus,X,Mean_b);
+    D(~Finite) = 0;
+    M2_b = sum(D.^2,1);
+
+    % Merge with the accumulated statistics
+    na = Stats.FiniteCount(c,:);
+    w = nb./max(na+nb,1);
+    delta = Mean_b-Stats.Mean(c,:);
+    Stats.Mean(c,:) = Stats.Mean(c,:)+delta.*w;
+    Stats.M2(c,:) = Stats.M2(c,:)+M2_b+delta.^2.*na.*w;
+    Stats.FiniteCount(c,:) = na+nb;
+
+end
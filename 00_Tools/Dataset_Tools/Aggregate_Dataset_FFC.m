@@ -0,0 +1,223 @@
+function [Summary,ErrorMsg] = Aggregate_Dataset_FFC(Source,M,Features,Options)
+
+% This function streams a dataset in blocks of rows and aggregates the selected features into compact
+% summaries for visualization: per-class 1-D histograms (which also serve as quantile sketches for box plots),
+% per-class 2-D histograms of pairs of features, and a stratified random sample of rows for scatter plots.
+% The sizes of the summaries do not depend on the number of samples.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Source: Dataset with L rows (L samples corresponding to L fragments)
+%       and C columns, or a matfile object of a dataset file (saved with -v7.3).
+%       The first C-2 columns correspond to features. The last two columns correspond
+%       to the integer-valued class labels and the FileID of the fragments, respectively.
+%   M: Number of classes
+%   Features: 1xn vector of the indices of the selected features
+%   Options: A structure with the following optional fields
+%       FeatureStats: Statistics of the features of Source (see Init_FeatureStats_FFC). If it is not provided
+%           (and it is not saved in the dataset file), it is calculated by an extra pass over the dataset.
+%       Classes: The classes whose values determine the ranges of histograms (default: all classes)
+%       NumBins: Scalar or 1xn vector of the number of bins of 1-D histograms (default: 0, no histogram)
+%       Pairs: Px2 matrix; each row is a pair of indices of Features for 2-D histograms (default: [], none)
+%       NumBins2: Number of bins of each axis of 2-D histograms (default: 50)
+%       SampleSize: Maximum number of sampled rows of each class (default: 0, no sample)
+%       Seed: Seed of random sampling (default: 1)
+%
+% Outputs:
+%   Summary: A structure with the following fields
+%       Features: Indices of the selected features
+%       Lo, Hi: 1xn vectors of the ranges of histograms
+%       Min, Max: Mxn matrices of the minimum and maximum of the finite values of features for classes
+%       Count: Mx1 vector of the number of samples of classes
+%       Hist: 1xn cell; Hist{i} is the NumBins(i)xM matrix of the counts of bins for classes. The edges of
+%           bins are Lo(i)+(Hi(i)-Lo(i))*(0:NumBins(i))/NumBins(i). The non-finite values are not counted.
+%       Pairs: Pairs of features of 2-D histograms
+%       Hist2: 1xP cell; Hist2{p} is the NumBins2xNumBins2xM array of the counts of bins for classes
+%       Sample: Sxn matrix of the values of the selected features for the sampled rows
+%       SampleLabels: Sx1 vector of the class labels of the sampled rows
+%   ErrorMsg: Possible error message. If there is no error, this output is empty.
+%
+%   Note: The aggregation is done by DensityAggregation_Core_FFC (if the MEX file is available).
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+Summary = [];
+ErrorMsg = '';
+if nargin<4
+    Options = struct;
+end
+Defaults = struct('FeatureStats',[],'Classes',1:M,'NumBins',0,'Pairs',zeros(0,2),'NumBins2',50,'SampleSize',0,'Seed',1);
+Names = fieldnames(Defaults);
+for k=1:length(Names)
+    if ~isfield(Options,Names{k}) || (isempty(Options.(Names{k})) && ~strcmp(Names{k},'FeatureStats'))
+        Options.(Names{k}) = Defaults.(Names{k});
+    end
+end
+BlockBytes = 2^27; % Memory used for each block of rows
+
+if isnumeric(Source)
+    [L,C] = size(Source);
+else
+    [L,C] = size(Source,'Dataset');
+end
+F = C-2;
+Features = Features(:)';
+n = length(Features);
+NumBins = Options.NumBins.*ones(1,n);
+Pairs = reshape(Options.Pairs,[],2);
+B2 = Options.NumBins2;
+K = Options.SampleSize;
+
+%% Ranges of features from the statistics of features
+FeatureStats = Options.FeatureStats;
+if isempty(FeatureStats) && ~isnumeric(Source)
+    try
+        FeatureStats = Source.FeatureStats;
+    catch
+        FeatureStats = [];
+    end
+end
+if isempty(FeatureStats) || FeatureStats.NumFeatures~=F || sum(FeatureStats.Count)~=L
+    [FeatureStats,ErrorMsg] = Collect_FeatureStats_FFC(Source,M);
+    if ~isempty(ErrorMsg)
+        return;
+    end
+end
+
+Lo = min(FeatureStats.Min(Options.Classes,Features),[],1);
+Hi = max(FeatureStats.Max(Options.Classes,Features),[],1);
+Lo(isinf(Lo)) = 0; % No finite value
+Hi(isinf(Hi)) = 1;
+idx = Hi<=Lo; % Constant feature
+Lo(idx) = Lo(idx)-0.5;
+Hi(idx) = Hi(idx)+0.5;
+
+%% Aggregation
+BlockSize = max(1,floor(BlockBytes/(8*C)));
+progressbar_FFC('Aggregating dataset for visualization ...');
+if exist('DensityAggregation_Core_FFC','file')==3
+
+    DensityAggregation_Core_FFC('init',F,M,Features,Lo,Hi,NumBins,Pairs,B2,K,Options.Seed);
+    for r1=1:BlockSize:L
+        r2 = min(r1+BlockSize-1,L);
+        try
+            if isnumeric(Source)
+                DensityAggregation_Core_FFC('accumulate',Source,r1,r2);
+            else
+                DensityAggregation_Core_FFC('accumulate',Source.Dataset(r1:r2,:));
+            end
+        catch ME
+            DensityAggregation_Core_FFC('clear');
+            ErrorMsg = ME.message;
+            return;
+        end
+
+        stopbar = progressbar_FFC(1,r2/L);
+        if stopbar
+            DensityAggregation_Core_FFC('clear');
+            ErrorMsg = 'Process is aborted by user.';
+            return;
+        end
+    end
+    [Hist,Hist2,Sample,SampleLabels,Count] = DensityAggregation_Core_FFC('finalize');
+
+else
+
+    % The sample is the rows of each class with the K smallest random keys (a uniform sample)
+    RandStr = RandStream('mt19937ar','Seed',Options.Seed);
+    Hist = cell(1,n);
+    for i=1:n
+        Hist{i} = zeros(NumBins(i),M);
+    end
+    Hist2 = repmat({zeros(B2,B2,M)},1,size(Pairs,1));
+    Count = zeros(M,1);
+    Sample = zeros(0,n);
+    SampleLabels = zeros(0,1);
+    Keys = zeros(0,1);
+    for r1=1:BlockSize:L
+        r2 = min(r1+BlockSize-1,L);
+        if isnumeric(Source)
+            X = Source(r1:r2,[Features F+1]);
+        else
+            X = Source.Dataset(r1:r2,:);
+            X = X(:,[Features F+1]);
+        end
+        y = X(:,end);
+        X(:,end) = [];
+        Count = Count+accumarray(y,1,[M 1]);
+
+        Bins = zeros(size(X));
+        for i=1:n
+            Bins(:,i) = bin_index(X(:,i),Lo(i),Hi(i),max(NumBins(i),1));
+            if NumBins(i)>0
+                ok = ~isnan(Bins(:,i));
+                Hist{i} = Hist{i}+accumarray([Bins(ok,i) y(ok)],1,[NumBins(i) M]);
+            end
+        end
+        for p=1:size(Pairs,1)
+            bx = bin_index(X(:,Pairs(p,1)),Lo(Pairs(p,1)),Hi(Pairs(p,1)),B2);
+            by = bin_index(X(:,Pairs(p,2)),Lo(Pairs(p,2)),Hi(Pairs(p,2)),B2);
+            ok = ~isnan(bx) & ~isnan(by);
+            Hist2{p} = Hist2{p}+accumarray([bx(ok) by(ok) y(ok)],1,[B2 B2 M]);
+        end
+
+        if K>0
+            Sample = [Sample ; X]; %#ok<AGROW>
+            SampleLabels = [SampleLabels ; y]; %#ok<AGROW>
+            Keys = [Keys ; rand(RandStr,length(y),1)]; %#ok<AGROW>
+            keep = false(size(Keys));
+            for c=unique(SampleLabels)'
+                idx = find(SampleLabels==c);
+                [~,order] = sort(Keys(idx));
+                keep(idx(order(1:min(K,end)))) = true;
+            end
+            Sample = Sample(keep,:);
+            SampleLabels = SampleLabels(keep);
+            Keys = Keys(keep);
+        end
+
+        stopbar = progressbar_FFC(1,r2/L);
+        if stopbar
+            ErrorMsg = 'Process is aborted by user.';
+            return;
+        end
+    end
+    [SampleLabels,order] = sort(SampleLabels);
+    Sample = Sample(order,:);
+
+end
+progressbar_FFC(1,1);
+
+%% Summary
+Summary.Features = Features;
+Summary.Lo = Lo;
+Summary.Hi = Hi;
+Summary.Min = FeatureStats.Min(:,Features);
+Summary.Max = FeatureStats.Max(:,Features);
+Summary.Count = Count;
+Summary.Hist = Hist;
+Summary.Pairs = Pairs;
+Summary.Hist2 = Hist2;
+Summary.Sample = Sample;
+Summary.SampleLabels = SampleLabels;
+
+%% Bins of values (NaN for non-finite values)
+function b = bin_index(x,Lo,Hi,nb)
+b = floor((x-Lo)/(Hi-Lo)*nb)+1;
+b = min(max(b,1),nb);
+b(~isfinite(x)) = NaN;
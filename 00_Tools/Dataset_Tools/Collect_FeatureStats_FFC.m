@@ -0,0 +1,64 @@
+function [Stats,ErrorMsg] = Collect_FeatureStats_FFC(Source,M)
+
+% This function calculates the per-class statistics of the features of a dataset (see Init_FeatureStats_FFC)
+% by a single pass over the blocks of its rows. It is used for the datasets that are saved without the
+% statistics of their features.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Source: Dataset with L rows (L samples corresponding to L fragments)
+%       and C columns, or a matfile object of a dataset file (saved with -v7.3).
+%       The first C-2 columns correspond to features. The last two columns correspond
+%       to the integer-valued class labels and the FileID of the fragments, respectively.
+%   M: Number of classes
+%
+% Outputs:
+%   Stats: Statistics of features (see Init_FeatureStats_FFC)
+%   ErrorMsg: Possible error message. If there is no error, this output is empty.
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+ErrorMsg = '';
+BlockBytes = 2^27; % Memory used for each block of rows
+
+if isnumeric(Source)
+    [L,C] = size(Source);
+else
+    [L,C] = size(Source,'Dataset');
+end
+Stats = Init_FeatureStats_FFC(C-2,M);
+
+%% Accumulate the statistics of blocks
+BlockSize = max(1,floor(BlockBytes/(8*C)));
+progressbar_FFC('Calculating statistics of features ...');
+for r1=1:BlockSize:L
+    r2 = min(r1+BlockSize-1,L);
+    if isnumeric(Source)
+        Stats = Add_FeatureStats_FFC(Stats,Source(r1:r2,:));
+    else
+        Stats = Add_FeatureStats_FFC(Stats,Source.Dataset(r1:r2,:));
+    end
+
+    stopbar = progressbar_FFC(1,r2/L);
+    if stopbar
+        Stats = [];
+        ErrorMsg = 'Process is aborted by user.';
+        return;
+    end
+end
+progressbar_FFC(1,1);
@@ -0,0 +1,66 @@
+function View = Create_DatasetView_FFC(Source)
+
+% This function creates a view of a dataset. A view represents the subsets, permutations, label remappings, and
+% feature scalings of a dataset by row indices, feature column indices, a label map, and scaling parameters over
+% one shared backing store (a matrix in memory, or the Dataset variable of a dataset file). The samples of a view
+% are only gathered into a matrix by Gather_DatasetView_FFC, when they are actually needed.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Input:
+%   Source: Dataset with L rows (L samples corresponding to L fragments) and C columns, a matfile object of
+%       a dataset file (see Open_Dataset_File_FFC), or a view (which is returned unchanged).
+%       The first C-2 columns correspond to features. The last two columns correspond to the integer-valued
+%       class labels and the FileID of the fragments, respectively.
+%
+% Output:
+%   View: A structure with the following fields:
+%       Source: The backing store (Dataset or matfile object)
+%       IsMatFile: true if Source is a matfile object
+%       NumSourceCols: Number of columns of the backing store (C)
+%       Rows: Lvx1 vector of the rows of backing store in the view
+%       Cols: 1xFv vector of the feature columns of backing store in the view
+%       LabelMap: Map from the class labels of backing store to the class labels of view (empty for identity)
+%       Scaling: Feature scaling parameters of view (see Scale_Features_FFC); empty for no scaling
+%           If the training samples are limited to other values than Scaling.Inf_Value, the structure has
+%           two more fields: Train_Inf_Value (1xFv vector) and TrainRows (the rows of backing store of training samples)
+%
+%   Note: A view has Lv rows and Fv+2 columns. The functions of decision machines accept both a dataset and a view.
+%
+% Revisions:
+% 2026-Oct-18   function was created
+% 2026-Oct-18   Scaling may have the fields Train_Inf_Value and TrainRows
+
+%% View of a view
+if isstruct(Source)
+    View = Source;
+    return;
+end
+
+%% Size of backing store
+View.Source = Source;
+View.IsMatFile = isa(Source,'matlab.io.MatFile');
+if View.IsMatFile
+    [L,C] = size(Source,'Dataset');
+else
+    [L,C] = size(Source);
+end
+
+%% Identity View
+View.NumSourceCols = C;
+View.Rows = (1:L)';
+View.Cols = 1:C-2;
+View.LabelMap = [];
+View.Scaling = [];
@@ -0,0 +1,32 @@
+function Constant = Find_ConstantFeatures_FFC(Stats)
+
+% This function finds the constant features of a dataset from the statistics of its features (see
+% Init_FeatureStats_FFC). A feature is constant if all of its values (over all classes) are equal, or all of
+% them are NaN.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Input:
+%   Stats: Statistics of features (see Init_FeatureStats_FFC)
+%
+% Output:
+%   Constant: 1xF logical vector which is true for the constant features
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+S = Subset_FeatureStats_FFC(Stats,[],ones(1,Stats.NumClasses));
+L = S.Count;
+Constant = (S.FiniteCount==L & S.Max==S.Min) | S.NaNCount==L | S.PosInfCount==L | S.NegInfCount==L;
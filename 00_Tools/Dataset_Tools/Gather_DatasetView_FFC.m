@@ -0,0 +1,107 @@
+function Data = Gather_DatasetView_FFC(Dataset,RowIndex,ColIndex)
+
+% This function gathers the selected rows and columns of a dataset (or a view) into a matrix. For a view,
+% the label map and feature scaling of the view are applied to the gathered samples.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Dataset: Dataset with L rows and C columns, or a view with L rows and C columns (see Create_DatasetView_FFC)
+%   RowIndex: Indices (or logical mask) of the rows (default = ':')
+%   ColIndex: Indices of the columns (default = ':'). Columns C-1 and C are the class labels and the FileIDs.
+%
+% Output:
+%   Data: The gathered matrix, i.e., Dataset(RowIndex,ColIndex)
+%
+%   Note: The rows of a dataset file are read in blocks of consecutive rows.
+%
+% Revisions:
+% 2026-Oct-18   function was created
+% 2026-Oct-18   the training samples of a scaled view are limited to Scaling.Train_Inf_Value
+
+%% Initialization
+if nargin<2
+    RowIndex = ':';
+end
+if nargin<3
+    ColIndex = ':';
+end
+
+%% Dataset
+if ~isstruct(Dataset)
+    Data = Dataset(RowIndex,ColIndex);
+    return;
+end
+View = Dataset;
+
+%% Rows and columns of backing store
+SrcRows = View.Rows(RowIndex);
+SrcRows = SrcRows(:);
+F = length(View.Cols);
+if ischar(ColIndex)
+    ColIndex = 1:F+2;
+end
+SrcCols = [View.Cols View.NumSourceCols-1 View.NumSourceCols];
+SrcCols = SrcCols(ColIndex);
+
+%% Read from backing store
+if View.IsMatFile
+
+    % Sorted rows are read as blocks of consecutive rows (at most BlockSize rows per read)
+    BlockSize = 65536;
+    Data = zeros(length(SrcRows),length(SrcCols));
+    [SortedRows,order] = sort(SrcRows);
+    BlockStart = find([true; diff(SortedRows)~=1]);
+    BlockEnd = [BlockStart(2:end)-1; length(SortedRows)];
+    c_min = min(SrcCols);
+    c_max = max(SrcCols);
+    for b=1:length(BlockStart)
+        for s=BlockStart(b):BlockSize:BlockEnd(b)
+            e = min(s+BlockSize-1,BlockEnd(b));
+            Block = View.Source.Dataset(SortedRows(s):SortedRows(e),c_min:c_max);
+            Data(order(s:e),:) = Block(:,SrcCols-c_min+1);
+        end
+    end
+
+else
+    Data = View.Source(SrcRows,SrcCols);
+end
+
+%% Map class labels
+if ~isempty(View.LabelMap)
+    idx = find(ColIndex==F+1);
+    for j=idx
+        Data(:,j) = View.LabelMap(Data(:,j));
+    end
+end
+
+%% Scale features
+if ~isempty(View.Scaling)
+    IsTrain = isfield(View.Scaling,'TrainRows');
+    if IsTrain
+        Train = ismember(SrcRows,View.Scaling.TrainRows);
+    end
+    for j=find(ColIndex<=F)
+        f = ColIndex(j);
+        x = Data(:,j);
+        Inf_Value = repmat(View.Scaling.Inf_Value(f),size(x));
+        if IsTrain
+            Inf_Value(Train) = View.Scaling.Train_Inf_Value(f);
+        end
+        idx = abs(x)>Inf_Value;
+        x(idx) = sign(x(idx)).*Inf_Value(idx);
+        Data(:,j) = (x-View.Scaling.A(f))/View.Scaling.B(f);
+    end
+end
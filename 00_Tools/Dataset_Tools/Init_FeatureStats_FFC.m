@@ -0,0 +1,53 @@
+function Stats = Init_FeatureStats_FFC(F,M)
+
+% This function initializes the per-class statistics of the features of a dataset. The statistics are
+% accumulated in a single pass over the samples by Add_FeatureStats_FFC (e.g., while the dataset is generated),
+% and they are used instead of scanning the dataset again (see Merge_FeatureStats_FFC).
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   F: Number of features
+%   M: Number of classes
+%
+% Output:
+%   Stats: A structure with the following fields
+%       NumFeatures: Number of features (F)
+%       NumClasses: Number of classes (M)
+%       Sentinel: The sentinel value of features (-1) whose occurrences are counted
+%       Count: Mx1 vector of the number of samples of classes
+%       FiniteCount: MxF matrix of the number of finite values of features for classes
+%       Mean: MxF matrix of the means of the finite values
+%       M2: MxF matrix of the sums of squared deviations of the finite values from their means
+%       Min, Max: MxF matrices of the minimum and maximum of the finite values (Inf and -Inf if there is none)
+%       NaNCount, PosInfCount, NegInfCount: MxF matrices of the number of NaN, Inf, and -Inf values
+%       SentinelCount: MxF matrix of the number of sentinel values
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+Stats.NumFeatures = F;
+Stats.NumClasses = M;
+Stats.Sentinel = -1;
+Stats.Count = zeros(M,1);
+Stats.FiniteCount = zeros(M,F);
+Stats.Mean = zeros(M,F);
+Stats.M2 = zeros(M,F);
+Stats.Min = inf(M,F);
+Stats.Max = -inf(M,F);
+Stats.NaNCount = zeros(M,F);
+Stats.PosInfCount = zeros(M,F);
+Stats.NegInfCount = zeros(M,F);
+Stats.SentinelCount = zeros(M,F);
@@ -1,4 +1,4 @@
-function [Filename,Dataset,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select,Feature_Transfrom,ErrorMsg] = Load_Dataset_FFC(dlg_title)
+function [Filename,Dataset,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select,Feature_Transfrom,ErrorMsg,FeatureStats] = Load_Dataset_FFC(dlg_title)
 
 % This function loads a Dataset.
 %
@@ -44,10 +44,13 @@ function [Filename,Dataset,FeatureLabels,ClassLabels,Function_Handles,Function_L
 %   Feature_Transfrom: A structure which determines the feature tranform if it is non-empty. 
 %   ErrorMsg: Possible error message. If there is no error, this output is
 %       empty.
+%   FeatureStats: Statistics of the features of Dataset (see Init_FeatureStats_FFC), or empty if
+%       the dataset file does not include them.
 %
 % Revisions:
 % 2020-Mar-03   function was created
 % 2021-Jan-03   Feature_Transfrom output was added
+% 2026-Oct-18   FeatureStats output was added
 
 %% Initialization
 Dataset = [];
@@ -58,6 +61,7 @@ Function_Labels = [];
 Function_Select = [];
 Feature_Transfrom = [];
 ErrorMsg = [];
+FeatureStats = [];
 
 if nargin==0
     dlg_title = 'Load Dataset';
@@ -86,6 +90,11 @@ try
     catch
         Feature_Transfrom = [];
     end
+    try
+        FeatureStats = matObj.FeatureStats;
+    catch
+        FeatureStats = [];
+    end
 catch
     ErrorMsg = 'Selected file is not a suported dataset!';
     return;
@@ -105,4 +114,9 @@ NumberofFeatures = length(FeatureLabels); % Number of Features
 if (size(Dataset,2)-2)~=NumberofFeatures
     ErrorMsg = 'Invalid Dataset: Number of features should be equal to the length of FeatureLabels';
     return;
+end
+
+% Statistics of features which do not describe Dataset are not used
+if ~isempty(FeatureStats) && (FeatureStats.NumFeatures~=NumberofFeatures || sum(FeatureStats.Count)~=size(Dataset,1))
+    FeatureStats = [];
 end
\ No newline at end of file
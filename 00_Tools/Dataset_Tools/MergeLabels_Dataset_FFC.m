@@ -1,4 +1,4 @@
-function [ErrorMsg,MergedDataset,MergedClassLabels] = MergeLabels_Dataset_FFC(Dataset,ClassLabels)
+function [ErrorMsg,MergedDataset,MergedClassLabels,LabelMap] = MergeLabels_Dataset_FFC(Dataset,ClassLabels)
 
 % This function takes labels of a Dataset and merge groups of labels into new labels.
 % Merged groups are selected by a graphical user interface.
@@ -22,6 +22,7 @@ function [ErrorMsg,MergedDataset,MergedClassLabels] = MergeLabels_Dataset_FFC(Da
 %       and C columns. The first C-2 columns correspond to features.
 %       The last two columns correspond to the integer-valued class labels
 %       and the FileID of the fragments, respectively.
+%       Dataset can also be a view (see Create_DatasetView_FFC).
 %   ClassLabels: 1xN cell. Cell contents are strings denoting the name of
 %       classes corresponding to integer-valued class labels 1,2,....
 %
@@ -30,8 +31,10 @@ function [ErrorMsg,MergedDataset,MergedClassLabels] = MergeLabels_Dataset_FFC(Da
 %   empty.
 %   MergedDataset: Dataset with L rows (L samples) and C columns (C-1 features)
 %       and final column is the integer-valued class label (an integer).
+%       If Dataset is a view, MergedDataset is a view of the sorted samples with merged labels.
 %   MergedClassLabels: 1xM cell. Cell contents are strings denoting the name of
 %       classes corresponding to integer-valued class labels 1,2,....
+%   LabelMap: 1xN vector that maps the class labels of Dataset to the class labels of MergedDataset
 %
 %   Note: In Dataset and MergedDataset, First, the samples of class 1 appear.
 %   Second, the the samples of class 2 appear, and so on. Also, for the samples
@@ -41,11 +44,15 @@ function [ErrorMsg,MergedDataset,MergedClassLabels] = MergeLabels_Dataset_FFC(Da
 % 2020-Mar-05   function was created
 % 2020-Sep-23   File identidiers for merged classes were changed in
 %               previous version. In this version, this problem is solved. 
+% 2026-Oct-18   the merged dataset is determined by a label map and the sorted row indices (views of
+%               dataset are not copied)
+% 2026-Oct-18   LabelMap output was added
 
 %% Initialization
 ErrorMsg = '';
 MergedDataset = [];
 MergedClassLabels = {};
+LabelMap = [];
 
 %% Select Labels to Merge
 [~,MergedClassIndices,Remain] = Select_from_List_FFC(ClassLabels,inf,'Select labels to merge');
@@ -58,25 +65,25 @@ end
 
 MergedClassLabels = SetVariableNames_FFC(Select_CellContents_FFC(ClassLabels,MergedClassIndices),true);
 
-%% Re-Generate Dataset
+%% Map from Old Labels to Merged Labels
 M = length(MergedClassLabels);
-MergedDataset = Dataset;
+LabelMap = zeros(1,length(ClassLabels));
 for j=1:M
-    for i=1:length(MergedClassIndices{j})
-        idx = (Dataset(:,end-1)==MergedClassIndices{j}(i));
-        MergedDataset(idx,end-1) = j;
-    end
+    LabelMap(MergedClassIndices{j}) = j;
 end
 
-%% Sort Labels
-[~,idx] = sort(MergedDataset(:,end-1));
-MergedDataset = MergedDataset(idx,:);
+%% Sort Labels and File Identifiers
+if isstruct(Dataset)
+    Labels = Gather_DatasetView_FFC(Dataset,':',length(Dataset.Cols)+(1:2));
+else
+    Labels = Dataset(:,end-1:end);
+end
+Labels(:,1) = LabelMap(Labels(:,1));
+[~,idx] = sortrows(Labels); % sortrows is stable, so the order of the fragments of a file is kept
 
-%% Sort File Identifiers
-for j=1:M
-    idx = find(MergedDataset(:,end-1)==j); % Indices for Class j
-    FileID = MergedDataset(idx,end); % File Identifiers for Class j Samples
-    [~,idx0] = sort(FileID);
-    
-    MergedDataset(idx,:) = MergedDataset(idx(idx0),:);
+%% Re-Generate Dataset
+if isstruct(Dataset)
+    MergedDataset = Subset_DatasetView_FFC(Dataset,idx,[],LabelMap);
+else
+    MergedDataset = Gather_DatasetView_FFC(Subset_DatasetView_FFC(Dataset,idx,[],LabelMap));
 end
\ No newline at end of file
@@ -0,0 +1,75 @@
+function [matObj,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select,Feature_Transfrom,ErrorMsg] = Open_Dataset_File_FFC(dlg_title)
+
+% This function opens a dataset file without loading the dataset itself in memory. The rows of
+% the dataset can be read in blocks by matObj.Dataset(r1:r2,:) (out-of-core processing).
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Input:
+%   dlg_title: The title for load file dialog box
+%
+% Outputs:
+%   matObj: matfile object of the dataset file
+%   FeatureLabels, ClassLabels, Function_Handles, Function_Labels, Function_Select, Feature_Transfrom:
+%       The variables of the dataset file (see Load_Dataset_FFC)
+%   ErrorMsg: Possible error message. If there is no error, this output is
+%       empty.
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+matObj = [];
+FeatureLabels = [];
+ClassLabels = [];
+Function_Handles = [];
+Function_Labels = [];
+Function_Select = [];
+Feature_Transfrom = [];
+ErrorMsg = [];
+
+%% Get file from user
+[Filename,path] = uigetfile('*.mat',dlg_title);
+if isequal(Filename,0)
+    ErrorMsg = 'No dataset file is selected!';
+    return;
+end
+
+%% Open file
+try
+    matObj = matfile([path Filename]);
+    FeatureLabels = matObj.FeatureLabels;
+    ClassLabels = matObj.ClassLabels;
+    Function_Handles = matObj.Function_Handles;
+    Function_Labels = matObj.Function_Labels;
+    Function_Select = matObj.Function_Select;
+    try
+        Feature_Transfrom = matObj.Feature_Transfrom;
+    catch
+        Feature_Transfrom = [];
+    end
+    [~,C] = size(matObj,'Dataset');
+catch
+    matObj = [];
+    ErrorMsg = 'Selected file is not a suported dataset!';
+    return;
+end
+
+%% Error Checking
+if (C-2)~=length(FeatureLabels)
+    matObj = [];
+    ErrorMsg = 'Invalid Dataset: Number of features should be equal to the length of FeatureLabels';
+    return;
+end
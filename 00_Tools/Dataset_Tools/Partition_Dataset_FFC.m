@@ -46,10 +46,15 @@ function [ErrorMsg,varargout] = Partition_Dataset_FFC(Dataset,ClassLabels,Partit
 %
 % Revisions:
 % 2020-Mar-04   function was created
+% 2026-Oct-18   Dataset can be a view of dataset (see Create_DatasetView_FFC)
 
 %% Initialization
 ErrorMsg = '';
 
+if isstruct(Dataset) % Only the class labels and FileIDs of a view are needed
+    Dataset = Gather_DatasetView_FFC(Dataset,':',length(Dataset.Cols)+(1:2));
+end
+
 M = length(ClassLabels); % Number of classes in Dataset
 
 N = length(Partitions); % Number of partitions
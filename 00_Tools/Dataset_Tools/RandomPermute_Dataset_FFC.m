@@ -21,11 +21,12 @@ function Dataset_p = RandomPermute_Dataset_FFC(Dataset,ClassLabels)
 %       and C columns. The first C-2 columns correspond to features.
 %       The last two columns correspond to the integer-valued class labels
 %       and the FileID of the fragments, respectively.
+%       Dataset can also be a view (see Create_DatasetView_FFC).
 %   ClassLabels: 1xM cell. Cell contents are strings denoting the name of
 %       classes corresponding to integer-valued class labels 1,2,....
 %
 % Output:
-%   Dataset_p: Permuted Dataset
+%   Dataset_p: Permuted Dataset. If Dataset is a view, Dataset_p is a view of the permuted samples.
 %
 %   Note: In Dataset and Dataset_p, First, the samples of class 1 appear. 
 %   Second, the the samples of class 2 appear, and so on. Also, for the samples 
@@ -33,23 +34,29 @@ function Dataset_p = RandomPermute_Dataset_FFC(Dataset,ClassLabels)
 %
 % Revisions:
 % 2020-Mar-05   function was created
+% 2026-Oct-18   the permutation is determined by row indices, and views of dataset are permuted without copying
 
 %% Initialization
 M = length(ClassLabels); % Number of classes in Dataset
+if isstruct(Dataset)
+    Labels = Gather_DatasetView_FFC(Dataset,':',length(Dataset.Cols)+(1:2)); % Class labels and FileIDs
+else
+    Labels = Dataset(:,end-1:end);
+end
 
 %% Find indices of different classes in Dataset
 Indices = cell(1,M); % Indices of samples of each class in Dataset
 P = cell(1,M); % Index for start of different File IDs in each class
 for i=1:length(ClassLabels)
     
-    Indices{i} = find(Dataset(:,end-1)==i);
-    FrgIndices = Dataset(Indices{i},end);
+    Indices{i} = find(Labels(:,1)==i);
+    FrgIndices = Labels(Indices{i},2);
     P{i} = [0 find(diff(FrgIndices)~=0)' length(FrgIndices)];
     
 end
 
 %% Random Permutation
-Dataset_p = zeros(size(Dataset));
+PermIndex = zeros(size(Labels,1),1); % Row indices of permuted Dataset
 cnt = 0;
 for i=1:M % Loop over different classes
     
@@ -59,8 +66,15 @@ for i=1:M % Loop over different classes
         idx_s = P{i}(rndprm(j))+1;
         idx_e = P{i}(rndprm(j)+1);
         lji = idx_e-idx_s+1;
-        Dataset_p(cnt+(1:lji),:) = Dataset(Indices{i}(idx_s:idx_e),:);
+        PermIndex(cnt+(1:lji)) = Indices{i}(idx_s:idx_e);
         cnt = cnt+lji;
     end
     
 end
+
+%% Permuted Dataset
+if isstruct(Dataset)
+    Dataset_p = Subset_DatasetView_FFC(Dataset,PermIndex);
+else
+    Dataset_p = Dataset(PermIndex,:);
+end
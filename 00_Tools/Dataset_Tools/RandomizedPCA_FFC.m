@@ -0,0 +1,136 @@
+function [Coef,Latent,ErrorMsg] = RandomizedPCA_FFC(Source,K,NumIterations)
+
+% This function calculates the top K principal components of the features of a dataset with randomized
+% subspace iteration. The dataset can be in memory, or in a dataset file. The dataset is read in blocks of
+% rows, so that the memory usage is bounded (by the size of a block and FxK matrices), and a dataset file
+% is not loaded in memory as a whole.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Source: Dataset with L rows (L samples corresponding to L fragments)
+%       and C columns, or a matfile object of a dataset file (saved with -v7.3).
+%       The first C-2 columns correspond to features. The last two columns correspond
+%       to the integer-valued class labels and the FileID of the fragments, respectively.
+%   K: Number of principal components (1~F)
+%   NumIterations: Number of power iterations (0~10). More iterations give more accurate components
+%       when the eigenvalues decay slowly. The dataset is read NumIterations+2 times.
+%
+% Outputs:
+%   Coef: FxK matrix of principal component coefficients (as the coeff output of pca)
+%   Latent: Kx1 vector of principal component variances (as the latent output of pca)
+%   ErrorMsg: Possible error message. If there is no error, this output is empty.
+%
+%   Note: The method is as follows. Starting with a random FxP matrix Q (P = K plus oversampling),
+%   each pass computes Z = S*Q, where S is the scatter matrix of features, by accumulating
+%   Xb'*(Xb*Q) over the blocks Xb of (centered) rows. Q is replaced by an orthonormal basis of Z
+%   after the first pass (range finder) and after each power iteration. In the last pass, the principal
+%   components are obtained from the eigenvectors of Q'*Z. If P is equal to F, a single pass gives the
+%   exact components.
+%
+%   Note: Rows with missing (NaN) or infinite feature values are ignored (as pca).
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+Coef = [];
+Latent = [];
+ErrorMsg = [];
+BlockBytes = 2^27; % Memory used for each block of rows
+Oversampling = 10;
+
+if isnumeric(Source)
+    [L,C] = size(Source);
+else
+    [L,C] = size(Source,'Dataset');
+end
+F = C-2;
+P = min(F,K+Oversampling);
+BlockSize = max(1,floor(BlockBytes/(8*C)));
+NumBlocks = ceil(L/BlockSize);
+
+%% Initial Subspace
+if P==F
+    Q = eye(F);
+    NumPasses = 1;
+else
+    [Q,~] = qr(randn(RandStream('mt19937ar','Seed',0),F,P),0);
+    NumPasses = NumIterations+2;
+end
+
+%% Subspace Iterations
+progressbar_FFC('Calculating principal components ...');
+Shift = [];
+for it=1:NumPasses
+
+    Z = zeros(F,P);
+    Sum = zeros(1,F);
+    N = 0;
+    for b=1:NumBlocks
+        r1 = (b-1)*BlockSize+1;
+        r2 = min(b*BlockSize,L);
+        if isnumeric(Source)
+            Xb = Source(r1:r2,1:F);
+        else
+            Xb = Source.Dataset(r1:r2,1:F);
+        end
+        Xb = Xb(all(isfinite(Xb),2),:);
+        if isempty(Xb)
+            continue;
+        end
+
+        % The rows are shifted by the mean of the first block (to avoid cancellation);
+        % the shift is corrected by the mean of all rows at the end of pass.
+        if isempty(Shift)
+            Shift = mean(Xb,1);
+        end
+        Xb = bsxfun(@minus,Xb,Shift);
+        Z = Z+Xb'*(Xb*Q);
+        Sum = Sum+sum(Xb,1);
+        N = N+size(Xb,1);
+
+        stopbar = progressbar_FFC(1,((it-1)*NumBlocks+b)/(NumPasses*NumBlocks));
+        if stopbar
+            ErrorMsg = 'Process is aborted by user.';
+            return;
+        end
+    end
+    if N<2
+        ErrorMsg = 'At least two samples without missing or infinite feature values are required.';
+        return;
+    end
+    d = Sum/N;
+    Z = Z-N*d'*(d*Q);
+
+    if it<NumPasses
+        [Q,~] = qr(Z,0);
+    end
+
+end
+
+%% Rayleigh-Ritz Projection
+T = Q'*Z;
+T = (T+T')/2;
+[V,D] = eig(T);
+[Latent,idx] = sort(diag(D),'descend');
+Latent = max(Latent(1:K),0)/(N-1);
+Coef = Q*V(:,idx(1:K));
+
+% Sign convention of pca: the largest element of each coefficient vector is positive
+[~,imax] = max(abs(Coef),[],1);
+sgn = sign(Coef(imax+(0:K-1)*F));
+sgn(sgn==0) = 1;
+Coef = bsxfun(@times,Coef,sgn);
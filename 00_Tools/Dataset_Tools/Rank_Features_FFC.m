@@ -0,0 +1,193 @@
+function [RHO,MI,ErrorMsg] = Rank_Features_FFC(Source,M,NumBins)
+
+% This function calculates the Pearson correlation coefficient and the mutual information between
+% each feature and the class label. The dataset can be in memory, or in a dataset file. In the latter case,
+% the dataset is read in blocks of rows, and it is not loaded in memory as a whole.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Source: Dataset with L rows (L samples corresponding to L fragments)
+%       and C columns, or a matfile object of a dataset file (saved with -v7.3).
+%       The first C-2 columns correspond to features. The last two columns correspond
+%       to the integer-valued class labels and the FileID of the fragments, respectively.
+%   M: Number of classes
+%   NumBins: Number of histogram bins of features for mutual information (an even number)
+%       Note: If this input is not provided, the default value 32 is used.
+%
+% Outputs:
+%   RHO: 1xF vector of absolute Pearson correlation coefficients between the features and the class label
+%       (0 for a feature with constant or non-finite values).
+%   MI: 1xF vector of mutual information (bits) between the discretized features and the class label
+%   ErrorMsg: Possible error message. If there is no error, this output is empty.
+%
+%   Note: The calculations are done by FeatureRanking_Core_FFC (if the MEX file is available). Otherwise,
+%   a dataset file is loaded in memory. In both cases, the histograms of mutual information are built by the
+%   rule of FeatureRanking_Core_FFC over the same blocks of rows: the range of the histograms of a feature is
+%   set by the first block with finite values, and it is doubled (merging adjacent bins) whenever a value
+%   falls outside the range. Therefore, the mutual information (and the ranking) does not depend on the
+%   availability of the MEX file.
+%
+% Revisions:
+% 2026-Oct-18   function was created
+% 2026-Oct-18   histograms of the MATLAB calculations follow the range-doubling rule of FeatureRanking_Core_FFC
+
+%% Initialization
+RHO = [];
+MI = [];
+ErrorMsg = '';
+if nargin<3
+    NumBins = 32;
+end
+BlockBytes = 2^27; % Memory used for each block of rows
+
+if isnumeric(Source)
+    [L,C] = size(Source);
+else
+    [L,C] = size(Source,'Dataset');
+end
+F = C-2;
+BlockSize = max(1,floor(BlockBytes/(8*C)));
+
+%% Calculations using the MEX file
+if exist('FeatureRanking_Core_FFC','file')==3
+
+    progressbar_FFC('Calculating Pearson correlation coefficients and mutual information ...');
+    FeatureRanking_Core_FFC('init',F,M,NumBins);
+    for r1=1:BlockSize:L
+        r2 = min(r1+BlockSize-1,L);
+        try
+            if isnumeric(Source)
+                FeatureRanking_Core_FFC('accumulate',Source,r1,r2);
+            else
+                FeatureRanking_Core_FFC('accumulate',Source.Dataset(r1:r2,:));
+            end
+        catch ME
+            FeatureRanking_Core_FFC('clear');
+            ErrorMsg = ME.message;
+            return;
+        end
+
+        stopbar = progressbar_FFC(1,r2/L);
+        if stopbar
+            FeatureRanking_Core_FFC('clear');
+            ErrorMsg = 'Process is aborted by user.';
+            return;
+        end
+    end
+    [RHO,MI] = FeatureRanking_Core_FFC('finalize');
+
+    RHO = abs(RHO);
+    RHO(isnan(RHO)) = 0;
+    return;
+
+end
+
+%% Calculations in MATLAB
+if isnumeric(Source)
+    Dataset = Source;
+else
+    Dataset = Source.Dataset;
+end
+progressbar_FFC('Calculating Pearson correlation coefficients and mutual information ...');
+RHO = zeros(1,F);
+MI = zeros(1,F);
+Y = Dataset(:,end-1);
+for j=1:F
+
+    x = Dataset(:,j);
+    RHO(j) = corr(x,Y);
+
+    % Mutual information with the histograms of FeatureRanking_Core_FFC
+    h = zeros(M,NumBins);
+    Lo = 0;
+    Width = 0;
+    for r1=1:BlockSize:L
+        r2 = min(r1+BlockSize-1,L);
+        [h,Lo,Width] = accumulate_histograms(h,Lo,Width,x(r1:r2),Y(r1:r2));
+    end
+    n = sum(h(:));
+    Q = sum(h,2)*sum(h,1);
+    k = h>0;
+    MI(j) = sum(h(k)/n.*log2(h(k)*n./Q(k)));
+
+    stopbar = progressbar_FFC(1,j/F);
+    if stopbar
+        ErrorMsg = 'Process is aborted by user.';
+        return;
+    end
+
+end
+
+RHO = abs(RHO);
+RHO(isnan(RHO)) = 0;
+MI = max(MI,0);
+
+function [h,Lo,Width] = accumulate_histograms(h,Lo,Width,x,y)
+% Histograms of a feature for classes (MxB) over a block of rows, as in FeatureRanking_Core_FFC:
+% bin b covers [Lo+(b-1)*Width, Lo+b*Width), and Width is zero before the first finite value.
+B = size(h,2);
+ok = isfinite(x);
+x = x(ok);
+y = y(ok);
+if isempty(x)
+    return;
+end
+
+% Initial range of histograms
+if Width==0
+    mn = min(x);
+    mx = max(x);
+    if mx>mn && (mx-mn)/(B-1)>0
+        Lo = mn;
+        Width = (mx-mn)/(B-1);
+    else
+        if mn~=0
+            Width = abs(mn)*1e-6;
+        else
+            Width = 1e-6;
+        end
+        Lo = mn-Width*(B/2);
+    end
+end
+
+% The values are binned in their order, and the range is doubled at each value outside the range
+r = 1;
+n = length(x);
+while r<=n
+    out = find(x(r:n)<Lo | x(r:n)>=Lo+B*Width,1,'first');
+    if isempty(out)
+        s = n;
+    else
+        s = r+out-2;
+    end
+    if s>=r
+        b = min(max(floor((x(r:s)-Lo)/Width),0),B-1)+1;
+        h = h+accumarray([y(r:s) b],1,size(h));
+    end
+    if isempty(out)
+        break;
+    end
+    r = s+1;
+    while x(r)<Lo
+        h = [zeros(size(h,1),B/2) h(:,1:2:end)+h(:,2:2:end)];
+        Lo = Lo-B*Width;
+        Width = 2*Width;
+    end
+    while x(r)>=Lo+B*Width
+        h = [h(:,1:2:end)+h(:,2:2:end) zeros(size(h,1),B/2)];
+        Width = 2*Width;
+    end
+end
@@ -1,4 +1,4 @@
-function [Scaled_Dataset,Scaling_Parameters] = Scale_Features_FFC(Dataset,Scaling_Option)
+function [Scaled_Dataset,Scaling_Parameters,Train_Inf_Value] = Scale_Features_FFC(Dataset,Scaling_Option,FeatureStats,TrainIndex)
 
 % This function takes Dataset and scales the features.
 %
@@ -21,6 +21,8 @@ function [Scaled_Dataset,Scaling_Parameters] = Scale_Features_FFC(Dataset,Scalin
 %       and C columns. The first C-2 columns correspond to features.
 %       The last two columns correspond to the integer-valued class labels
 %       and the FileID of the fragments, respectively.
+%       Dataset can also be a view (see Create_DatasetView_FFC). Then, Scaled_Dataset is the same view
+%       whose features are scaled when they are gathered (see Gather_DatasetView_FFC).
 %   Scaling_Option: Can be one of the following variables:
 %       Scaling_Method: String value that shows the method of scaling, the
 %           value can be 'z-score', 'min-max', or '' (for no scaling).
@@ -30,6 +32,13 @@ function [Scaled_Dataset,Scaling_Parameters] = Scale_Features_FFC(Dataset,Scalin
 %               Scaling_Parameters.B: 1xF vector that shows a values for features.
 %               Scaling_Parameters.Inf_Value: 1xF vector that shows maximum values
 %                   (corresponding to inf) for features
+%   FeatureStats: Statistics of the features of Dataset (see Init_FeatureStats_FFC) (optional)
+%       If Scaling_Option is a scaling method and FeatureStats is provided, the scaling parameters
+%       are determined from FeatureStats without scanning the samples. FeatureStats should describe
+%       exactly the samples of Dataset.
+%   TrainIndex: Indices of the training samples of a view (optional; default = ':' for all samples)
+%       If Scaling_Option is a scaling method, the scaling parameters are determined from these samples.
+%       The other samples of the view are scaled as test samples, i.e., with Scaling_Parameters.
 %
 % Outputs:
 %   Scaled_Dataset: Dataset with L rows (L samples corresponding to L fragments)
@@ -42,6 +51,9 @@ function [Scaled_Dataset,Scaling_Parameters] = Scale_Features_FFC(Dataset,Scalin
 %           Scaling_Parameters.B: 1xF vector that shows a values for features.
 %           Scaling_Parameters.Inf_Value: 1xF vector that shows maximum values
 %               (corresponding to inf) for features
+%   Train_Inf_Value: 1xF vector of the maximum values which are applied to the features of the training
+%       samples. It is equal to Scaling_Parameters.Inf_Value, except for no scaling, where the training
+%       samples are limited to 10 times the maximum absolute finite value, and Scaling_Parameters.Inf_Value is inf.
 %
 %   Note: In Dataset and Scaled_Dataset, First, the samples of class 1 appear.
 %   Second, the the samples of class 2 appear, and so on. Also, for the samples
@@ -49,6 +61,59 @@ function [Scaled_Dataset,Scaling_Parameters] = Scale_Features_FFC(Dataset,Scalin
 %
 % Revisions:
 % 2020-Mar-12   function was created
+% 2026-Oct-18   views of dataset are scaled without copying the samples
+% 2026-Oct-18   scaling parameters can be determined from the statistics of features
+% 2026-Oct-18   the training samples of a view are limited to Train_Inf_Value (as the training samples of a dataset)
+% 2026-Oct-18   with FeatureStats and no scaling, the training samples are limited to 10 times the maximum absolute value
+
+%% Scaling parameters from the statistics of features
+Stats_Inf_Value = []; % The maximum values of the training samples, if the parameters are determined from FeatureStats
+if nargin>2 && ~isempty(FeatureStats) && ~isstruct(Scaling_Option)
+    [Scaling_Option,Stats_Inf_Value] = scaling_from_stats(FeatureStats,Scaling_Option);
+end
+
+%% Scaling a view of dataset
+% The scaling parameters are determined column by column, and the features are scaled when they are gathered
+if isstruct(Dataset)
+    if ~isempty(Dataset.Scaling)
+        error('Unpredicted Error: The view of dataset is already scaled');
+    end
+    if nargin<4
+        TrainIndex = ':';
+    end
+    Train = Subset_DatasetView_FFC(Dataset,TrainIndex);
+    
+    if isstruct(Scaling_Option)
+        Scaling_Parameters = Scaling_Option;
+        if isempty(Stats_Inf_Value)
+            Train_Inf_Value = Scaling_Parameters.Inf_Value;
+        else
+            Train_Inf_Value = Stats_Inf_Value;
+        end
+    else
+        F = length(Train.Cols); % Number of features
+        L = length(Train.Rows); % Number of training samples
+        Scaling_Parameters.A = zeros(1,F);
+        Scaling_Parameters.B = ones(1,F);
+        Scaling_Parameters.Inf_Value = inf(1,F);
+        Train_Inf_Value = inf(1,F);
+        for j=1:F
+            [~,Scaling_Parameters_j,Train_Inf_Value(j)] = Scale_Features_FFC([Gather_DatasetView_FFC(Train,':',j) zeros(L,2)],Scaling_Option);
+            Scaling_Parameters.A(j) = Scaling_Parameters_j.A;
+            Scaling_Parameters.B(j) = Scaling_Parameters_j.B;
+            Scaling_Parameters.Inf_Value(j) = Scaling_Parameters_j.Inf_Value;
+        end
+    end
+    
+    Scaled_Dataset = Dataset;
+    Scaled_Dataset.Scaling = Scaling_Parameters;
+    if ~isequal(Train_Inf_Value,Scaling_Parameters.Inf_Value)
+        % The training samples (the rows of backing store) are limited to Train_Inf_Value
+        Scaled_Dataset.Scaling.Train_Inf_Value = Train_Inf_Value;
+        Scaled_Dataset.Scaling.TrainRows = unique(Train.Rows);
+    end
+    return;
+end
 
 %% Initialization
 if isstruct(Scaling_Option)
@@ -72,6 +137,8 @@ if isempty(Scaling_Parameters)
         end
         
     end
+elseif ~isempty(Stats_Inf_Value)
+    Inf_Value = Stats_Inf_Value; % Training samples are limited as above (the parameters may have Inf_Value=inf)
 else
     Inf_Value = Scaling_Parameters.Inf_Value;
 end
@@ -81,6 +148,7 @@ for j=1:F
     idx = abs(Dataset(:,j))>Inf_Value(j);
     Dataset(idx,j) = sign(Dataset(idx,j)).*Inf_Value(j);
 end
+Train_Inf_Value = Inf_Value;
 
 %% Determine the value of a and b in (x-a)/b scaling
 if isempty(Scaling_Parameters)
@@ -127,4 +195,53 @@ if isempty(Scaling_Parameters)
     Scaling_Parameters.A = A;
     Scaling_Parameters.B = B;
     Scaling_Parameters.Inf_Value = Inf_Value;
-end
\ No newline at end of file
+end
+
+
+%% Scaling parameters from the statistics of features
+% The parameters are those of the samples whose non-finite values are replaced by +-Train_Inf_Value (as above)
+function [Scaling_Parameters,Train_Inf_Value] = scaling_from_stats(FeatureStats,Scaling_Method)
+
+S = Subset_FeatureStats_FFC(FeatureStats,[],ones(1,FeatureStats.NumClasses));
+F = S.NumFeatures;
+L = S.Count;
+P = S.PosInfCount;
+N = S.NegInfCount;
+
+% Inf values
+Inf_Value = 10*max(abs(S.Min),abs(S.Max));
+Inf_Value(S.FiniteCount==0) = 1;
+Train_Inf_Value = Inf_Value;
+
+switch Scaling_Method
+    case 'z-score'
+        A = (S.FiniteCount.*S.Mean+(P-N).*Inf_Value)/L;
+        M2 = S.M2+S.FiniteCount.*(S.Mean-A).^2+P.*(Inf_Value-A).^2+N.*(-Inf_Value-A).^2;
+        B = sqrt(M2/max(L-1,1));
+        B(B==0) = 1;
+        A(S.NaNCount>0) = NaN;
+        B(S.NaNCount>0) = NaN;
+
+    case 'min-max'
+        Lo = S.Min;
+        Hi = S.Max;
+        Lo(N>0) = -Inf_Value(N>0);
+        Hi(P>0) = Inf_Value(P>0);
+        Lo(P>0 & N==0 & S.FiniteCount==0) = Inf_Value(P>0 & N==0 & S.FiniteCount==0);
+        Hi(N>0 & P==0 & S.FiniteCount==0) = -Inf_Value(N>0 & P==0 & S.FiniteCount==0);
+        Lo(isinf(Lo)) = NaN;
+        Hi(isinf(Hi)) = NaN;
+        A = Lo;
+        B = Hi-Lo;
+        B(B==0) = 1;
+
+    otherwise
+        Inf_Value = inf(1,F);
+        A = zeros(1,F);
+        B = ones(1,F);
+
+end
+
+Scaling_Parameters.A = A;
+Scaling_Parameters.B = B;
+Scaling_Parameters.Inf_Value = Inf_Value;
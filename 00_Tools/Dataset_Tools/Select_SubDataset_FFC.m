@@ -22,6 +22,7 @@ function [ErrorMsg,Dataset,FeatureLabels,ClassLabels,Function_Select,Feature_Tra
 %       and C columns. The first C-2 columns correspond to features.
 %       The last two columns correspond to the integer-valued class labels
 %       and the FileID of the fragments, respectively.
+%       Dataset can also be a view (see Create_DatasetView_FFC).
 %   FeatureLabels: 1xF cell. Cell contents are strings denoting the name of
 %       features corresponding to the columns of Dataset.
 %   ClassLabels: 1xM cell. Cell contents are strings denoting the name of
@@ -37,6 +38,7 @@ function [ErrorMsg,Dataset,FeatureLabels,ClassLabels,Function_Select,Feature_Tra
 %       and C columns. The first Cp-2 columns correspond to features.
 %       The last two columns correspond to the integer-valued class labels
 %       and the FileID of the fragments, respectively.
+%       If Dataset is a view, the output is a view of the selected samples and features.
 %   FeatureLabels: 1xFp cell. Cell contents are strings denoting the name of
 %       features corresponding to the columns of Dataset.
 %   ClassLabels: 1xMp cell. Cell contents are strings denoting the name of
@@ -52,6 +54,8 @@ function [ErrorMsg,Dataset,FeatureLabels,ClassLabels,Function_Select,Feature_Tra
 % Revisions:
 % 2020-Mar-05   function was created
 % 2021-Jan-03   Feature_Transfrom input/output were included
+% 2026-Oct-18   the sub-dataset is selected by row indices, feature indices and a label map (views of
+%               dataset are not copied)
 
 %% Select Sub-Classes
 [ErrorMsg,ClassSel,~] = Select_from_List_FFC(ClassLabels,1,'Select classes to be included');
@@ -68,7 +72,6 @@ end
 FeatSel = FeatSel{1};
 
 %% Select Sub-Features
-Dataset = Dataset(:,[FeatSel end-1:end]);
 FeatureLabels = FeatureLabels(FeatSel);
 if isempty(Feature_Transfrom)
     
@@ -91,15 +94,19 @@ end
 
 %% Select Sub-Classes
 ClassSel = sort(ClassSel);
+LabelMap = -ones(1,length(ClassLabels)); % Map from old class labels to new class labels (-1 for removed classes)
+LabelMap(ClassSel) = 1:length(ClassSel);
 ClassLabels = ClassLabels(ClassSel);
-for i=1:size(Dataset,1)
-    c = Dataset(i,end-1);
-    idx = find(ClassSel==c);
-    
-    if ~isempty(idx)
-        Dataset(i,end-1) = idx(1);
-    else
-        Dataset(i,end-1) = -1;
-    end
+if isstruct(Dataset)
+    Labels = Gather_DatasetView_FFC(Dataset,':',length(Dataset.Cols)+1);
+else
+    Labels = Dataset(:,end-1);
+end
+RowIndex = LabelMap(Labels)~=-1;
+
+%% Sub-Dataset
+if isstruct(Dataset)
+    Dataset = Subset_DatasetView_FFC(Dataset,RowIndex,FeatSel,LabelMap);
+else
+    Dataset = Gather_DatasetView_FFC(Subset_DatasetView_FFC(Dataset,RowIndex,FeatSel,LabelMap));
 end
-Dataset = Dataset(Dataset(:,end-1)~=-1,:);
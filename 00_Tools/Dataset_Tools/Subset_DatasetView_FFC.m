@@ -0,0 +1,76 @@
+function View = Subset_DatasetView_FFC(Dataset,RowIndex,FeatureIndex,LabelMap)
+
+% This function returns a view of the selected samples and features of a dataset (or a view), where the class
+% labels may be remapped. No sample is copied; the indices are composed with the indices of the input view.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Dataset: Dataset, matfile object of a dataset file, or a view (see Create_DatasetView_FFC)
+%   RowIndex: Indices (or logical mask) of the selected samples of Dataset, in the order of the new view
+%       (':' for all samples, default = ':'). An empty RowIndex selects no sample.
+%   FeatureIndex: Indices of the selected features of Dataset (empty for all features)
+%   LabelMap: A vector that maps the class labels of Dataset to the class labels of the new view;
+%       i.e., label c is changed to LabelMap(c) (empty or not provided for no remapping)
+%       The entries -1 of the label map of Dataset (the removed classes, see Select_SubDataset_FFC) are kept.
+%
+% Output:
+%   View: The view of selected samples and features
+%
+% Revisions:
+% 2026-Oct-18   function was created
+% 2026-Oct-18   ':' selects all samples (an empty RowIndex selects none), and removed classes are kept in label maps
+
+%% Initialization
+View = Create_DatasetView_FFC(Dataset);
+if nargin<2
+    RowIndex = ':';
+end
+if nargin<3
+    FeatureIndex = [];
+end
+if nargin<4
+    LabelMap = [];
+end
+
+%% Select samples
+if ~ischar(RowIndex)
+    View.Rows = View.Rows(RowIndex);
+    View.Rows = View.Rows(:);
+end
+
+%% Select features
+if ~isempty(FeatureIndex)
+    View.Cols = View.Cols(FeatureIndex);
+    if ~isempty(View.Scaling)
+        View.Scaling.A = View.Scaling.A(FeatureIndex);
+        View.Scaling.B = View.Scaling.B(FeatureIndex);
+        View.Scaling.Inf_Value = View.Scaling.Inf_Value(FeatureIndex);
+        if isfield(View.Scaling,'Train_Inf_Value')
+            View.Scaling.Train_Inf_Value = View.Scaling.Train_Inf_Value(FeatureIndex);
+        end
+    end
+end
+
+%% Remap class labels
+if ~isempty(LabelMap)
+    LabelMap = LabelMap(:)';
+    if isempty(View.LabelMap)
+        View.LabelMap = LabelMap;
+    else
+        k = View.LabelMap>0; % -1 for the removed classes
+        View.LabelMap(k) = LabelMap(View.LabelMap(k));
+    end
+end
@@ -0,0 +1,73 @@
+function Stats = Subset_FeatureStats_FFC(Stats,FeatureIndex,LabelMap)
+
+% This function returns the statistics of the selected features of a dataset (see Init_FeatureStats_FFC),
+% where the class labels may be remapped. The statistics of the classes which are mapped to the same label
+% are merged without scanning the dataset; e.g., LabelMap = ones(1,M) gives the statistics of all samples.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Stats: Statistics of features (see Init_FeatureStats_FFC)
+%   FeatureIndex: Indices of the selected features (empty for all features)
+%   LabelMap: A vector that maps the class labels to the new class labels {1,2,...};
+%       i.e., label c is changed to LabelMap(c) (empty or not provided for no remapping)
+%
+% Output:
+%   Stats: Statistics of the selected features for the new class labels
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+if nargin<2
+    FeatureIndex = [];
+end
+if nargin<3
+    LabelMap = [];
+end
+Fields = {'FiniteCount','Mean','M2','Min','Max','NaNCount','PosInfCount','NegInfCount','SentinelCount'};
+
+%% Select features
+if ~isempty(FeatureIndex)
+    for k=1:length(Fields)
+        Stats.(Fields{k}) = Stats.(Fields{k})(:,FeatureIndex);
+    end
+    Stats.NumFeatures = size(Stats.Mean,2);
+end
+
+%% Merge the statistics of classes with the same new label
+if ~isempty(LabelMap)
+    Old = Stats;
+    Stats = Init_FeatureStats_FFC(Old.NumFeatures,max(LabelMap));
+    Stats.Sentinel = Old.Sentinel;
+    for c=1:length(LabelMap)
+        d = LabelMap(c);
+        Stats.Count(d) = Stats.Count(d)+Old.Count(c);
+        Stats.Min(d,:) = min(Stats.Min(d,:),Old.Min(c,:));
+        Stats.Max(d,:) = max(Stats.Max(d,:),Old.Max(c,:));
+        Stats.NaNCount(d,:) = Stats.NaNCount(d,:)+Old.NaNCount(c,:);
+        Stats.PosInfCount(d,:) = Stats.PosInfCount(d,:)+Old.PosInfCount(c,:);
+        Stats.NegInfCount(d,:) = Stats.NegInfCount(d,:)+Old.NegInfCount(c,:);
+        Stats.SentinelCount(d,:) = Stats.SentinelCount(d,:)+Old.SentinelCount(c,:);
+
+        na = Stats.FiniteCount(d,:);
+        nb = Old.FiniteCount(c,:);
+        w = nb./max(na+nb,1);
+        delta = Old.Mean(c,:)-Stats.Mean(d,:);
+        Stats.Mean(d,:) = Stats.Mean(d,:)+delta.*w;
+        Stats.M2(d,:) = Stats.M2(d,:)+Old.M2(c,:)+delta.^2.*na.*w;
+        Stats.FiniteCount(d,:) = na+nb;
+    end
+end
@@ -0,0 +1,53 @@
+function Summary = Summarize_FeatureStats_FFC(Stats,ClassLabels,FeatureLabels)
+
+% This function summarizes the statistics of the features of a dataset (see Init_FeatureStats_FFC): the class
+% balance, and the constant features and the features with NaN, infinite, or sentinel values.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Stats: Statistics of features (see Init_FeatureStats_FFC)
+%   ClassLabels: 1xM cell. Cell contents are strings denoting the name of
+%       classes corresponding to integer-valued class labels 1,2,....
+%   FeatureLabels: 1xF cell. Cell contents are strings denoting the name of
+%       features corresponding to the columns of Dataset.
+%
+% Output:
+%   Summary: Cell array of strings that summarizes the statistics
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+M = Stats.NumClasses;
+L = sum(Stats.Count);
+S = Subset_FeatureStats_FFC(Stats,[],ones(1,M));
+Constant = Find_ConstantFeatures_FFC(Stats);
+
+%% Class balance
+Summary = cell(1,M+2);
+Summary{1} = sprintf('Statistics of features: %d samples, %d features',L,Stats.NumFeatures);
+for c=1:M
+    Summary{1+c} = sprintf('  %s: %d samples (%.1f%%)',ClassLabels{c},Stats.Count(c),100*Stats.Count(c)/max(L,1));
+end
+Summary{M+2} = sprintf('  Class imbalance ratio (largest/smallest class): %.2f',max(Stats.Count)/max(min(Stats.Count),1));
+
+%% Features with special values
+Summary{end+1} = sprintf('  Constant features: %d',sum(Constant));
+if any(Constant)
+    Summary{end+1} = sprintf('    %s',strjoin(FeatureLabels(Constant),', '));
+end
+Summary{end+1} = sprintf('  Features with NaN values: %d, with infinite values: %d, with sentinel (%g) values: %d',...
+    sum(S.NaNCount>0),sum(S.PosInfCount+S.NegInfCount>0),Stats.Sentinel,sum(S.SentinelCount>0));
@@ -0,0 +1,397 @@
+/* This c-mex function is the engine of the aggregation of a dataset for visualization (see Aggregate_Dataset_FFC).
+ * The dataset is given to the engine in blocks of rows, so that the whole dataset does not need to be in memory.
+ * In a single pass over the rows, the engine accumulates the following summaries of the selected features:
+ *   - The 1-D histogram of each selected feature for each class over a fixed range. With many bins, the
+ *       histogram is also a quantile sketch of the feature (the error of a quantile is at most one bin width).
+ *   - The 2-D histogram of each selected pair of features for each class.
+ *   - A uniform random sample (reservoir) of at most K rows of each class (stratified sample).
+ * The ranges of features are given in advance (e.g., from the statistics of features), so the summaries of
+ * different blocks are simply added. The histograms are computed in parallel (if OpenMP is available).
+ *
+ * Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+ *
+ * This file is a part of Fragments-Expert software, a software package for
+ * feature extraction from file fragments and classification among various file formats.
+ *
+ * Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Usage method:
+ *  DensityAggregation_Core_FFC('init',F,M,Features,Lo,Hi,NumBins,Pairs,NumBins2,K,Seed);
+ *  DensityAggregation_Core_FFC('accumulate',Block);
+ *  DensityAggregation_Core_FFC('accumulate',Dataset,r1,r2);
+ *  [Hist,Hist2,Sample,SampleLabels,Count] = DensityAggregation_Core_FFC('finalize');
+ *  DensityAggregation_Core_FFC('clear');
+ *
+ * Inputs:
+ *  F: Number of features of the dataset
+ *  M: Number of classes
+ *  Features: 1xn vector of the indices of the selected features (1~F)
+ *  Lo, Hi: 1xn vectors of the ranges of the selected features (Lo<Hi). The values out of the range are
+ *      counted in the first or the last bin, and the non-finite values are ignored.
+ *  NumBins: 1xn vector of the number of bins of the 1-D histograms (0 for no histogram)
+ *  Pairs: Px2 matrix; each row is a pair of indices of Features (1~n) for 2-D histograms (empty for none)
+ *  NumBins2: Number of bins of each axis of the 2-D histograms
+ *  K: Maximum number of the sampled rows of each class (0 for no sample)
+ *  Seed: Seed of the random number generator of sampling
+ *  Block: A block of rows of the dataset with at least F+1 columns. The first F columns correspond to
+ *      features, and the (F+1)-th column corresponds to the integer-valued class labels (1~M).
+ *  Dataset, r1, r2: The rows r1 to r2 of Dataset are used as a block (without copying them).
+ *
+ * Outputs:
+ *  Hist: 1xn cell; Hist{i} is the NumBins(i)xM matrix of the counts of the bins of feature i for classes
+ *  Hist2: 1xP cell; Hist2{p} is the NumBins2xNumBins2xM array of the counts of the bins of pair p for classes
+ *      (the first and the second dimensions correspond to Pairs(p,1) and Pairs(p,2), respectively)
+ *  Sample: Sxn matrix of the values of the selected features for the sampled rows
+ *  SampleLabels: Sx1 vector of the class labels of the sampled rows
+ *  Count: Mx1 vector of the number of rows of classes
+ *
+ * Note: 'finalize' also clears the engine.
+ *
+ * Compilation (OpenMP is optional):
+ *  mex -O COMPFLAGS="$COMPFLAGS /openmp" DensityAggregation_Core_FFC.c              (Windows, MSVC)
+ *  mex -O CFLAGS="$CFLAGS -fopenmp" LDFLAGS="$LDFLAGS -fopenmp" DensityAggregation_Core_FFC.c  (GCC)
+ *
+ * Revisions:
+ * 2026-Oct-18   function was created
+ */
+
+#include "mex.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Global Variables */
+int F,M,N,P,B2;
+int Initialized = 0;
+int *Feat;              /* n 0-based indices of the selected features */
+double *Lo,*Scale;      /* n ranges of features: the bin of x is floor((x-Lo)*Scale*bins) */
+int *B;                 /* n numbers of bins of 1-D histograms */
+size_t *Offset;         /* n offsets of the 1-D histograms in Hist */
+double *Hist;           /* 1-D histograms (index Offset[i]+c*B[i]+b) */
+int *Pair;              /* Px2 0-based indices of Features (index 2*p and 2*p+1) */
+double *Hist2;          /* PxMxB2xB2 2-D histograms (index ((p*M+c)*B2+by)*B2+bx) */
+size_t K;               /* Maximum number of sampled rows of each class */
+double *Reservoir;      /* MxKxn sampled values (index (c*K+k)*N+i) */
+double *Count;          /* M numbers of rows of classes */
+unsigned long long RandState;
+int *Label;             /* 0-based class labels of the current block */
+
+void free_state(void)
+{
+    free(Feat); free(Lo); free(Scale); free(B); free(Offset); free(Hist); free(Pair); free(Hist2);
+    free(Reservoir); free(Count); free(Label);
+    Feat = NULL; Lo = NULL; Scale = NULL; B = NULL; Offset = NULL; Hist = NULL; Pair = NULL; Hist2 = NULL;
+    Reservoir = NULL; Count = NULL; Label = NULL;
+    Initialized = 0;
+}
+
+/* Uniform random number in [0,1) (xorshift64*) */
+static double uniform(void)
+{
+    RandState ^= RandState >> 12;
+    RandState ^= RandState << 25;
+    RandState ^= RandState >> 27;
+    return (double) ((RandState*2685821657736338717ULL) >> 11)*(1.0/9007199254740992.0);
+}
+
+/* Bin of value x of selected feature i for a histogram with nb bins (-1 for a non-finite value) */
+static int bin(int i,double x,int nb)
+{
+    double t;
+    int b;
+    if (!isfinite(x))
+        return -1;
+    t = (x-Lo[i])*Scale[i]*nb;
+    if (t<0)
+        return 0;
+    b = t<nb ? (int) t : nb-1;
+    return b;
+}
+
+/* Accumulate the 1-D histogram of selected feature i over a block of n rows */
+static void accumulate_hist(int i,const double *X,size_t ld,size_t n)
+{
+    size_t r;
+    int b;
+    const double *x = X+(size_t)Feat[i]*ld;
+    double *h = Hist+Offset[i];
+    for (r=0;r<n;r++)
+    {
+        b = bin(i,x[r],B[i]);
+        if (b>=0)
+            h[(size_t)Label[r]*B[i]+b] += 1;
+    }
+}
+
+/* Accumulate the 2-D histogram of pair p over a block of n rows */
+static void accumulate_hist2(int p,const double *X,size_t ld,size_t n)
+{
+    size_t r;
+    int i1 = Pair[2*p], i2 = Pair[2*p+1], bx, by;
+    const double *x = X+(size_t)Feat[i1]*ld, *y = X+(size_t)Feat[i2]*ld;
+    double *h = Hist2+(size_t)p*M*B2*B2;
+    for (r=0;r<n;r++)
+    {
+        bx = bin(i1,x[r],B2);
+        by = bin(i2,y[r],B2);
+        if (bx>=0 && by>=0)
+            h[((size_t)Label[r]*B2+by)*B2+bx] += 1;
+    }
+}
+
+/* Accumulate a block of n rows (X is column-major with leading dimension ld) */
+void accumulate(const double *X,size_t ld,size_t n)
+{
+    size_t r,k;
+    int i,t;
+    const double *y = X+(size_t)F*ld;
+
+    if (n==0)
+        return;
+
+    /* Class labels */
+    Label = (int*) malloc(n*sizeof(int));
+    if (!Label)
+        mexErrMsgTxt("Out of memory.\n");
+    for (r=0;r<n;r++)
+    {
+        if (!(y[r]>=1 && y[r]<=M && y[r]==floor(y[r])))
+        {
+            free(Label); Label = NULL;
+            mexErrMsgTxt("Class labels must be integers in {1,2,...,M}.\n");
+        }
+        Label[r] = (int) y[r]-1;
+    }
+
+    /* Stratified sample (reservoir sampling for each class) */
+    for (r=0;r<n;r++)
+    {
+        Count[Label[r]] += 1;
+        if (K==0)
+            continue;
+        if (Count[Label[r]]<=(double)K)
+            k = (size_t) Count[Label[r]]-1;
+        else
+        {
+            k = (size_t) (uniform()*Count[Label[r]]);
+            if (k>=K)
+                continue;
+        }
+        for (i=0;i<N;i++)
+            Reservoir[((size_t)Label[r]*K+k)*N+i] = X[(size_t)Feat[i]*ld+r];
+    }
+
+    /* Histograms (each histogram is a separate task) */
+    #pragma omp parallel for schedule(dynamic,1)
+    for (t=0;t<N+P;t++)
+    {
+        if (t<N)
+        {
+            if (B[t]>0)
+                accumulate_hist(t,X,ld,n);
+        }
+        else if (B2>0)
+            accumulate_hist2(t-N,X,ld,n);
+    }
+
+    free(Label); Label = NULL;
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
+{
+    char mode[16];
+    int i;
+
+    /* Check for the proper number of arguments. */
+    if (nrhs<1 || !mxIsChar(prhs[0]) || mxGetString(prhs[0],mode,sizeof(mode)))
+        mexErrMsgTxt("The first input must be 'init', 'accumulate', 'finalize', or 'clear'.");
+    if (nlhs > 5)
+        mexErrMsgTxt("No more than five outputs are required!");
+    mexAtExit(free_state);
+
+    if (strcmp(mode,"clear")==0)
+    {
+        free_state();
+        return;
+    }
+
+    for (i=1;i<nrhs;i++)
+        if (!mxIsDouble(prhs[i]) || mxIsComplex(prhs[i]))
+            mexErrMsgTxt("All inputs (except the first one) must be real matrices of type double.\n");
+
+    if (strcmp(mode,"init")==0)
+    {
+        const double *feat,*lo,*hi,*nb,*pairs;
+        size_t total = 0;
+        double seed;
+
+        if (nrhs!=11)
+            mexErrMsgTxt("Eleven inputs are required for 'init'.");
+        free_state();
+        F = (int) mxGetScalar(prhs[1]);
+        M = (int) mxGetScalar(prhs[2]);
+        N = (int) mxGetNumberOfElements(prhs[3]);
+        P = (int) mxGetM(prhs[7]);
+        B2 = (int) mxGetScalar(prhs[8]);
+        K = (size_t) mxGetScalar(prhs[9]);
+        seed = mxGetScalar(prhs[10]);
+        if (F<1 || M<1 || N<1)
+            mexErrMsgTxt("Number of features, number of classes, and number of selected features must be positive.\n");
+        if ((int)mxGetNumberOfElements(prhs[4])!=N || (int)mxGetNumberOfElements(prhs[5])!=N || (int)mxGetNumberOfElements(prhs[6])!=N)
+            mexErrMsgTxt("Lo, Hi, and NumBins must have the same length as Features.\n");
+        if (P>0 && mxGetN(prhs[7])!=2)
+            mexErrMsgTxt("Pairs must have two columns.\n");
+        if (B2<0 || (P>0 && B2<1))
+            mexErrMsgTxt("Number of bins of 2-D histograms must be positive.\n");
+
+        feat = mxGetPr(prhs[3]); lo = mxGetPr(prhs[4]); hi = mxGetPr(prhs[5]); nb = mxGetPr(prhs[6]); pairs = mxGetPr(prhs[7]);
+        Feat = (int*) malloc(N*sizeof(int));
+        Lo = (double*) malloc(N*sizeof(double));
+        Scale = (double*) malloc(N*sizeof(double));
+        B = (int*) malloc(N*sizeof(int));
+        Offset = (size_t*) malloc(N*sizeof(size_t));
+        Pair = (int*) malloc((2*P+1)*sizeof(int));
+        Count = (double*) calloc(M,sizeof(double));
+        if (!Feat || !Lo || !Scale || !B || !Offset || !Pair || !Count)
+        {
+            free_state();
+            mexErrMsgTxt("Out of memory.\n");
+        }
+        for (i=0;i<N;i++)
+        {
+            if (!(feat[i]>=1 && feat[i]<=F && feat[i]==floor(feat[i])))
+            {
+                free_state();
+                mexErrMsgTxt("Features must be integers in {1,2,...,F}.\n");
+            }
+            if (!(isfinite(lo[i]) && isfinite(hi[i]) && lo[i]<hi[i]) || !(nb[i]>=0))
+            {
+                free_state();
+                mexErrMsgTxt("Ranges must be finite with Lo<Hi, and number of bins must be non-negative.\n");
+            }
+            Feat[i] = (int) feat[i]-1;
+            Lo[i] = lo[i];
+            Scale[i] = 1/(hi[i]-lo[i]);
+            B[i] = (int) nb[i];
+            Offset[i] = total;
+            total += (size_t)B[i]*M;
+        }
+        for (i=0;i<2*P;i++)
+        {
+            if (!(pairs[i]>=1 && pairs[i]<=N && pairs[i]==floor(pairs[i])))
+            {
+                free_state();
+                mexErrMsgTxt("Pairs must be integers in {1,2,...,n}.\n");
+            }
+            Pair[(i%P)*2+i/P] = (int) pairs[i]-1;
+        }
+        Hist = (double*) calloc(total+1,sizeof(double));
+        Hist2 = (double*) calloc((size_t)P*M*B2*B2+1,sizeof(double));
+        Reservoir = (double*) malloc((K*M*N+1)*sizeof(double));
+        if (!Hist || !Hist2 || !Reservoir)
+        {
+            free_state();
+            mexErrMsgTxt("Out of memory.\n");
+        }
+        RandState = 0x9E3779B97F4A7C15ULL ^ (unsigned long long) (seed>=0 ? seed : -seed);
+        if (RandState==0)
+            RandState = 1;
+        Initialized = 1;
+        return;
+    }
+
+    if (!Initialized)
+        mexErrMsgTxt("The engine is not initialized.");
+
+    if (strcmp(mode,"accumulate")==0)
+    {
+        size_t ld,r1,r2;
+        if (nrhs!=2 && nrhs!=4)
+            mexErrMsgTxt("Two or four inputs are required for 'accumulate'.");
+        if ((int)mxGetN(prhs[1])<F+1)
+            mexErrMsgTxt("The block must have at least F+1 columns.\n");
+        ld = mxGetM(prhs[1]);
+        r1 = 1;
+        r2 = ld;
+        if (nrhs==4)
+        {
+            double a = mxGetScalar(prhs[2]), b = mxGetScalar(prhs[3]);
+            if (!(a>=1 && b<=(double)ld && a<=b+1))
+                mexErrMsgTxt("The range of rows is not valid.\n");
+            r1 = (size_t) a;
+            r2 = (size_t) b;
+        }
+        accumulate(mxGetPr(prhs[1])+(r1-1),ld,r2+1-r1);
+    }
+    else if (strcmp(mode,"finalize")==0)
+    {
+        mxArray *out[5], *a;
+        mwSize dims[3];
+        size_t S = 0, s, k, kc;
+        int c;
+        double *sample,*labels;
+
+        /* 1-D histograms */
+        out[0] = mxCreateCellMatrix(1,N);
+        for (i=0;i<N;i++)
+        {
+            a = mxCreateDoubleMatrix(B[i],M,mxREAL);
+            memcpy(mxGetPr(a),Hist+Offset[i],(size_t)B[i]*M*sizeof(double));
+            mxSetCell(out[0],i,a);
+        }
+
+        /* 2-D histograms */
+        out[1] = mxCreateCellMatrix(1,P);
+        dims[0] = B2; dims[1] = B2; dims[2] = M;
+        for (i=0;i<P;i++)
+        {
+            a = mxCreateNumericArray(3,dims,mxDOUBLE_CLASS,mxREAL);
+            memcpy(mxGetPr(a),Hist2+(size_t)i*M*B2*B2,(size_t)M*B2*B2*sizeof(double));
+            mxSetCell(out[1],i,a);
+        }
+
+        /* Stratified sample */
+        for (c=0;c<M;c++)
+            S += Count[c]<(double)K ? (size_t)Count[c] : K;
+        out[2] = mxCreateDoubleMatrix(S,N,mxREAL);
+        out[3] = mxCreateDoubleMatrix(S,1,mxREAL);
+        sample = mxGetPr(out[2]);
+        labels = mxGetPr(out[3]);
+        s = 0;
+        for (c=0;c<M;c++)
+        {
+            kc = Count[c]<(double)K ? (size_t)Count[c] : K;
+            for (k=0;k<kc;k++,s++)
+            {
+                for (i=0;i<N;i++)
+                    sample[(size_t)i*S+s] = Reservoir[((size_t)c*K+k)*N+i];
+                labels[s] = c+1;
+            }
+        }
+
+        /* Number of rows of classes */
+        out[4] = mxCreateDoubleMatrix(M,1,mxREAL);
+        memcpy(mxGetPr(out[4]),Count,M*sizeof(double));
+
+        for (i=0;i<5;i++)
+        {
+            if (i<nlhs || (i==0 && nlhs==0))
+                plhs[i] = out[i];
+            else
+                mxDestroyArray(out[i]);
+        }
+        free_state();
+    }
+    else
+        mexErrMsgTxt("The first input must be 'init', 'accumulate', 'finalize', or 'clear'.");
+}
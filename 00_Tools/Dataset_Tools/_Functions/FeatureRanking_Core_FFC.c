@@ -0,0 +1,379 @@
+/* This c-mex function is the engine of feature ranking (see Rank_Features_FFC). The dataset is given to the
+ * engine in blocks of rows, so that the whole dataset does not need to be in memory. In a single pass over
+ * the rows, the engine accumulates the following statistics for each feature:
+ *   - The mean, the sum of squared deviations, and the co-moment with the class label, which give the
+ *       Pearson correlation coefficient between the feature and the class label, as corr.
+ *   - The histogram of the feature for each class, which gives the mutual information between the
+ *       (discretized) feature and the class label.
+ * The statistics of each block are computed around the block means and merged with the previous blocks
+ * (pairwise update), which avoids the cancellation of raw sums of squares. The range of histograms is not
+ * known in advance: it is set by the first block, and whenever a value falls outside the range, the range
+ * is doubled and the adjacent bins are merged (the MATLAB calculations of Rank_Features_FFC follow the same
+ * rule). The features are processed in parallel (if OpenMP is available).
+ *
+ * Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+ *
+ * This file is a part of Fragments-Expert software, a software package for
+ * feature extraction from file fragments and classification among various file formats.
+ *
+ * Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Usage method:
+ *  FeatureRanking_Core_FFC('init',F,M,NumBins);
+ *  FeatureRanking_Core_FFC('accumulate',Block);
+ *  FeatureRanking_Core_FFC('accumulate',Dataset,r1,r2);
+ *  [RHO,MI] = FeatureRanking_Core_FFC('finalize');
+ *  FeatureRanking_Core_FFC('clear');
+ *
+ * Inputs:
+ *  F: Number of features
+ *  M: Number of classes
+ *  NumBins: Number of histogram bins for each feature (an even number)
+ *  Block: A block of rows of the dataset with at least F+1 columns. The first F columns correspond to
+ *      features, and the (F+1)-th column corresponds to the integer-valued class labels (1~M).
+ *  Dataset, r1, r2: The rows r1 to r2 of Dataset are used as a block (without copying them).
+ *
+ * Outputs:
+ *  RHO: 1xF vector of the Pearson correlation coefficients between the features and the class label.
+ *      It is NaN for a feature with constant or non-finite values.
+ *  MI: 1xF vector of mutual information (bits) between the discretized features and the class label.
+ *      Non-finite values are ignored.
+ *
+ * Note: 'finalize' also clears the engine.
+ *
+ * Compilation (OpenMP is optional):
+ *  mex -O COMPFLAGS="$COMPFLAGS /openmp" FeatureRanking_Core_FFC.c              (Windows, MSVC)
+ *  mex -O CFLAGS="$CFLAGS -fopenmp" LDFLAGS="$LDFLAGS -fopenmp" FeatureRanking_Core_FFC.c  (GCC)
+ *
+ * Revisions:
+ * 2026-Oct-18   function was created
+ */
+
+#include "mex.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Global Variables */
+int F,M,B;
+int Initialized = 0;
+double Count;           /* Number of accumulated rows */
+double MeanY,M2Y;       /* Mean and sum of squared deviations of class labels */
+double *MeanX;          /* F means of features */
+double *M2X;            /* F sums of squared deviations of features */
+double *CXY;            /* F co-moments of features and class labels */
+char *Bad;              /* F flags of the features with non-finite values */
+double *Lo,*Width;      /* F ranges of histograms: bin b covers [Lo+b*Width, Lo+(b+1)*Width) */
+double *Hist;           /* FxMxB histograms (index (j*M+c)*B+b) */
+int *Label;             /* 0-based class labels of the current block */
+
+void free_state(void)
+{
+    free(MeanX); free(M2X); free(CXY); free(Bad); free(Lo); free(Width); free(Hist); free(Label);
+    MeanX = NULL; M2X = NULL; CXY = NULL; Bad = NULL; Lo = NULL; Width = NULL; Hist = NULL; Label = NULL;
+    Initialized = 0;
+}
+
+/* Double the range of the histograms of feature j, towards the lower (down=1) or upper (down=0) values */
+static void expand(int j,int down)
+{
+    int c,b;
+    double *h;
+    for (c=0;c<M;c++)
+    {
+        h = Hist+((size_t)j*M+c)*B;
+        if (down)
+        {
+            for (b=B-1;b>=B/2;b--)
+                h[b] = h[2*(b-B/2)]+h[2*(b-B/2)+1];
+            for (b=0;b<B/2;b++)
+                h[b] = 0;
+        }
+        else
+        {
+            for (b=0;b<B/2;b++)
+                h[b] = h[2*b]+h[2*b+1];
+            for (b=B/2;b<B;b++)
+                h[b] = 0;
+        }
+    }
+    if (down)
+        Lo[j] -= B*Width[j];
+    Width[j] *= 2;
+}
+
+/* Accumulate feature j over a block of n rows (x is the column of feature j in the block) */
+static void accumulate_feature(int j,const double *x,const double *y,size_t n,double my,double n0)
+{
+    size_t r;
+    double s = 0, mx, m2 = 0, cxy = 0, d, mn = HUGE_VAL, mxv = -HUGE_VAL;
+    double *h = Hist+(size_t)j*M*B;
+    int b, finite = 1;
+
+    for (r=0;r<n;r++)
+        s += x[r];
+    if (!isfinite(s))
+        finite = 0;
+
+    if (finite && !Bad[j])
+    {
+        /* Block statistics around the block means */
+        mx = s/(double)n;
+        for (r=0;r<n;r++)
+        {
+            d = x[r]-mx;
+            m2 += d*d;
+            cxy += d*(y[r]-my);
+        }
+
+        /* Pairwise update */
+        if (n0==0)
+        {
+            MeanX[j] = mx;
+            M2X[j] = m2;
+            CXY[j] = cxy;
+        }
+        else
+        {
+            double dx = mx-MeanX[j], f = n0*(double)n/(n0+(double)n);
+            M2X[j] += m2+dx*dx*f;
+            CXY[j] += cxy+dx*(my-MeanY)*f;
+            MeanX[j] += dx*(double)n/(n0+(double)n);
+        }
+    }
+    else
+        Bad[j] = 1;
+
+    /* Initial range of histograms */
+    if (Width[j]==0)
+    {
+        for (r=0;r<n;r++)
+            if (isfinite(x[r]))
+            {
+                if (x[r]<mn) mn = x[r];
+                if (x[r]>mxv) mxv = x[r];
+            }
+        if (mn>mxv)
+            return;
+        if (mxv>mn && (mxv-mn)/(B-1)>0)
+        {
+            Lo[j] = mn;
+            Width[j] = (mxv-mn)/(B-1);
+        }
+        else
+        {
+            Width[j] = (mn!=0 ? fabs(mn) : 1)*1e-6;
+            Lo[j] = mn-Width[j]*(B/2);
+        }
+    }
+
+    /* Histograms */
+    for (r=0;r<n;r++)
+    {
+        if (!isfinite(x[r]))
+            continue;
+        while (x[r]<Lo[j])
+            expand(j,1);
+        while (x[r]>=Lo[j]+B*Width[j])
+            expand(j,0);
+        b = (int) ((x[r]-Lo[j])/Width[j]);
+        if (b>=B) b = B-1;
+        if (b<0) b = 0;
+        h[(size_t)Label[r]*B+b] += 1;
+    }
+}
+
+/* Accumulate a block of n rows (X is column-major with leading dimension ld) */
+void accumulate(const double *X,size_t ld,size_t n)
+{
+    size_t r;
+    int j;
+    const double *y = X+(size_t)F*ld;
+    double s = 0, my, m2 = 0, d, n0 = Count;
+
+    if (n==0)
+        return;
+
+    /* Class labels */
+    Label = (int*) malloc(n*sizeof(int));
+    for (r=0;r<n;r++)
+    {
+        if (!(y[r]>=1 && y[r]<=M && y[r]==floor(y[r])))
+        {
+            free(Label); Label = NULL;
+            mexErrMsgTxt("Class labels must be integers in {1,2,...,M}.\n");
+        }
+        Label[r] = (int) y[r]-1;
+        s += y[r];
+    }
+    my = s/(double)n;
+    for (r=0;r<n;r++)
+    {
+        d = y[r]-my;
+        m2 += d*d;
+    }
+
+    /* Features (the label statistics are updated afterwards, as the features use the previous mean) */
+    #pragma omp parallel for schedule(dynamic,16)
+    for (j=0;j<F;j++)
+        accumulate_feature(j,X+(size_t)j*ld,y,n,my,n0);
+
+    if (n0==0)
+    {
+        MeanY = my;
+        M2Y = m2;
+    }
+    else
+    {
+        d = my-MeanY;
+        M2Y += m2+d*d*n0*(double)n/(n0+(double)n);
+        MeanY += d*(double)n/(n0+(double)n);
+    }
+    Count += (double)n;
+    free(Label); Label = NULL;
+}
+
+/* Correlation coefficients and mutual information */
+void finalize(double *RHO,double *MI)
+{
+    int j,c,b;
+    double *pc = (double*) malloc(M*sizeof(double));
+    double *pb = (double*) malloc(B*sizeof(double));
+    double n,p,mi;
+    const double *h;
+
+    for (j=0;j<F;j++)
+    {
+        if (Bad[j] || Count==0 || !(M2X[j]>0) || !(M2Y>0))
+            RHO[j] = mxGetNaN();
+        else
+        {
+            RHO[j] = CXY[j]/sqrt(M2X[j]*M2Y);
+            if (RHO[j]>1) RHO[j] = 1;
+            if (RHO[j]<-1) RHO[j] = -1;
+        }
+
+        h = Hist+(size_t)j*M*B;
+        memset(pc,0,M*sizeof(double));
+        memset(pb,0,B*sizeof(double));
+        n = 0;
+        for (c=0;c<M;c++)
+            for (b=0;b<B;b++)
+            {
+                pc[c] += h[c*B+b];
+                pb[b] += h[c*B+b];
+                n += h[c*B+b];
+            }
+        mi = 0;
+        for (c=0;c<M;c++)
+            for (b=0;b<B;b++)
+                if (h[c*B+b]>0)
+                {
+                    p = h[c*B+b]/n;
+                    mi += p*log2(h[c*B+b]*n/(pc[c]*pb[b]));
+                }
+        MI[j] = mi>0 ? mi : 0;
+    }
+    free(pc); free(pb);
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
+{
+    char mode[16];
+    int i;
+
+    /* Check for the proper number of arguments. */
+    if (nrhs<1 || !mxIsChar(prhs[0]) || mxGetString(prhs[0],mode,sizeof(mode)))
+        mexErrMsgTxt("The first input must be 'init', 'accumulate', 'finalize', or 'clear'.");
+    if (nlhs > 2)
+        mexErrMsgTxt("No more than two outputs are required!");
+    mexAtExit(free_state);
+
+    if (strcmp(mode,"clear")==0)
+    {
+        free_state();
+        return;
+    }
+
+    for (i=1;i<nrhs;i++)
+        if (!mxIsDouble(prhs[i]) || mxIsComplex(prhs[i]))
+            mexErrMsgTxt("All inputs (except the first one) must be real matrices of type double.\n");
+
+    if (strcmp(mode,"init")==0)
+    {
+        if (nrhs!=4)
+            mexErrMsgTxt("Four inputs are required for 'init'.");
+        free_state();
+        F = (int) mxGetScalar(prhs[1]);
+        M = (int) mxGetScalar(prhs[2]);
+        B = (int) mxGetScalar(prhs[3]);
+        if (F<1 || M<1)
+            mexErrMsgTxt("Number of features and number of classes must be positive.\n");
+        if (B<2 || B%2)
+            mexErrMsgTxt("Number of bins must be a positive even number.\n");
+        MeanX = (double*) calloc(F,sizeof(double));
+        M2X = (double*) calloc(F,sizeof(double));
+        CXY = (double*) calloc(F,sizeof(double));
+        Bad = (char*) calloc(F,sizeof(char));
+        Lo = (double*) calloc(F,sizeof(double));
+        Width = (double*) calloc(F,sizeof(double));
+        Hist = (double*) calloc((size_t)F*M*B,sizeof(double));
+        if (!MeanX || !M2X || !CXY || !Bad || !Lo || !Width || !Hist)
+        {
+            free_state();
+            mexErrMsgTxt("Out of memory.\n");
+        }
+        Count = 0;
+        MeanY = 0;
+        M2Y = 0;
+        Initialized = 1;
+        return;
+    }
+
+    if (!Initialized)
+        mexErrMsgTxt("The engine is not initialized.");
+
+    if (strcmp(mode,"accumulate")==0)
+    {
+        size_t ld,r1,r2;
+        if (nrhs!=2 && nrhs!=4)
+            mexErrMsgTxt("Two or four inputs are required for 'accumulate'.");
+        if ((int)mxGetN(prhs[1])<F+1)
+            mexErrMsgTxt("The block must have at least F+1 columns.\n");
+        ld = mxGetM(prhs[1]);
+        r1 = 1;
+        r2 = ld;
+        if (nrhs==4)
+        {
+            double a = mxGetScalar(prhs[2]), b = mxGetScalar(prhs[3]);
+            if (!(a>=1 && b<=(double)ld && a<=b+1))
+                mexErrMsgTxt("The range of rows is not valid.\n");
+            r1 = (size_t) a;
+            r2 = (size_t) b;
+        }
+        accumulate(mxGetPr(prhs[1])+(r1-1),ld,r2+1-r1);
+    }
+    else if (strcmp(mode,"finalize")==0)
+    {
+        mxArray *MI = mxCreateDoubleMatrix(1, F, mxREAL);
+        plhs[0] = mxCreateDoubleMatrix(1, F, mxREAL);
+        finalize(mxGetPr(plhs[0]),mxGetPr(MI));
+        if (nlhs>1)
+            plhs[1] = MI;
+        else
+            mxDestroyArray(MI);
+        free_state();
+    }
+    else
+        mexErrMsgTxt("The first input must be 'init', 'accumulate', 'finalize', or 'clear'.");
+}
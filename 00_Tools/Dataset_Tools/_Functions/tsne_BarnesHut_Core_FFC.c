@@ -0,0 +1,671 @@
+/* This c-mex function is the engine of Barnes-Hut t-SNE (see tsne_FFC), which is used for large datasets.
+ *   - Input affinities: For each point, the K nearest neighbors are found with a vantage-point tree, and
+ *       the precision of the Gaussian kernel is found by binary search (as d2p) over the neighbors only.
+ *   - Gradient steps: The attractive forces are computed from the sparse joint probabilities. The repulsive
+ *       forces are approximated with a space-partitioning tree (quadtree/octree) of the map points: a cell
+ *       that is far enough from a point (width/distance < theta) is replaced by its center of mass.
+ * The points are processed in parallel (if OpenMP is available).
+ *
+ * Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+ *
+ * This file is a part of Fragments-Expert software, a software package for
+ * feature extraction from file fragments and classification among various file formats.
+ *
+ * Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Usage method:
+ *  [Idx,Val] = tsne_BarnesHut_Core_FFC('affinities',X,K,perplexity);
+ *  [ydata,y_incs,gains] = tsne_BarnesHut_Core_FFC('iterate',ydata,y_incs,gains,Ptr,Idx,Val,Params,num_iter);
+ *
+ * Inputs:
+ *  X: NxD matrix of points
+ *  K: Number of nearest neighbors (1~N-1)
+ *  perplexity: The perplexity of the Gaussian kernel
+ *  ydata, y_incs, gains: Nxno_dims matrices of map points, their increments, and their gains (no_dims is 2 or 3)
+ *  Ptr, Idx, Val: The joint probabilities in compressed form: the non-zero probabilities of point i are
+ *      Val(Ptr(i)+1:Ptr(i+1)) with the points Idx(Ptr(i)+1:Ptr(i+1)). Ptr has N+1 elements.
+ *  Params: [momentum epsilon exaggeration theta]
+ *  num_iter: Number of gradient steps
+ *
+ * Outputs:
+ *  Idx: KxN matrix of the nearest neighbors (1-based) of points
+ *  Val: KxN matrix of conditional probabilities of the nearest neighbors of points
+ *  ydata, y_incs, gains: Updated inputs
+ *
+ * Compilation (OpenMP is optional):
+ *  mex -O COMPFLAGS="$COMPFLAGS /openmp" tsne_BarnesHut_Core_FFC.c              (Windows, MSVC)
+ *  mex -O CFLAGS="$CFLAGS -fopenmp" LDFLAGS="$LDFLAGS -fopenmp" tsne_BarnesHut_Core_FFC.c  (GCC)
+ *
+ * Revisions:
+ * 2026-Oct-18   function was created
+ */
+
+#include "mex.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define LEAF_SIZE 16        /* Maximum number of points in a leaf of VP-tree */
+#define ROUNDING_SLACK 1e-12 /* Relative slack of pruning, which guards the exact search against rounding errors */
+#define MAX_DEPTH 40        /* Maximum depth of space-partitioning tree (deeper cells contain duplicate points) */
+#define MIN_GAIN 0.01       /* Minimum gain for delta-bar-delta */
+
+/* A point and its distance */
+typedef struct
+{
+    double d;
+    int i;
+} item;
+
+/* Cell of space-partitioning tree */
+typedef struct
+{
+    double com[3];      /* Center of mass */
+    double width;       /* Width of cell */
+    int cnt;            /* Number of points */
+    int child;          /* Index of the first child (children are consecutive), or -1 for leaves */
+    int lo,hi;          /* Points of a leaf: Order[lo...hi-1] */
+} cell;
+
+/* Global Variables */
+int N,D,ND;
+double *Xp;             /* Points in the order of VP-tree (row-major) */
+int *Perm;              /* 0-based indices of points in the order of VP-tree */
+double *Radius;
+item *Items;
+unsigned int Seed;
+cell *Cells;            /* Cells of space-partitioning tree */
+int NumCells,CapCells;
+int *Order,*Tmp,*Buf;   /* Points in the order of cells, and work spaces */
+
+/* -------------------------------------------------------------------------------------------------------- */
+/* Nearest neighbors (vantage-point tree)                                                                    */
+/* -------------------------------------------------------------------------------------------------------- */
+
+static double distance(const double *a,const double *b)
+{
+    double s = 0, t;
+    int f;
+    for (f=0;f<D;f++)
+    {
+        t = a[f]-b[f];
+        s += t*t;
+    }
+    return sqrt(s);
+}
+
+/* Partially sort Items[lo...hi-1] so that Items[k] is in its sorted position */
+void select_item(int lo,int hi,int k)
+{
+    item tmp;
+    double pivot;
+    int i,j;
+
+    hi--;
+    while (lo<hi)
+    {
+        pivot = Items[lo+(hi-lo)/2].d;
+        i = lo;
+        j = hi;
+        while (i<=j)
+        {
+            while (Items[i].d<pivot)
+                i++;
+            while (Items[j].d>pivot)
+                j--;
+            if (i<=j)
+            {
+                tmp = Items[i];
+                Items[i] = Items[j];
+                Items[j] = tmp;
+                i++;
+                j--;
+            }
+        }
+        if (k<=j)
+            hi = j;
+        else if (k>=i)
+            lo = i;
+        else
+            return;
+    }
+}
+
+/* Build the node of the range [lo,hi) */
+void build_node(int lo,int hi)
+{
+    int j,v,mid;
+
+    if (hi-lo<=LEAF_SIZE)
+        return;
+
+    /* Random vantage point */
+    Seed = Seed*1103515245u+12345u;
+    v = lo+(int)((Seed>>8)%(unsigned int)(hi-lo));
+    j = Perm[lo];
+    Perm[lo] = Perm[v];
+    Perm[v] = j;
+
+    /* Median distance from the vantage point */
+    for (j=lo+1;j<hi;j++)
+    {
+        Items[j].d = distance(Xp+(size_t)Perm[lo]*D,Xp+(size_t)Perm[j]*D);
+        Items[j].i = Perm[j];
+    }
+    mid = lo+1+(hi-lo-1)/2;
+    select_item(lo+1,hi,mid);
+    for (j=lo+1;j<hi;j++)
+        Perm[j] = Items[j].i;
+    Radius[lo] = Items[mid].d;
+
+    build_node(lo+1,mid);
+    build_node(mid,hi);
+}
+
+/* (a.d,a.i) > (b.d,b.i) */
+static int item_greater(const item *a,const item *b)
+{
+    return a->d>b->d || (a->d==b->d && a->i>b->i);
+}
+
+/* Max-heap of the K nearest neighbors found so far */
+typedef struct
+{
+    item *h;
+    int n,K;
+} heap;
+
+static void heap_sift_down(heap *hp,int p)
+{
+    item tmp;
+    int c;
+    while ((c=2*p+1)<hp->n)
+    {
+        if (c+1<hp->n && item_greater(&hp->h[c+1],&hp->h[c]))
+            c++;
+        if (!item_greater(&hp->h[c],&hp->h[p]))
+            break;
+        tmp = hp->h[p];
+        hp->h[p] = hp->h[c];
+        hp->h[c] = tmp;
+        p = c;
+    }
+}
+
+static void heap_add(heap *hp,double d,int i)
+{
+    item x, tmp;
+    int p,c;
+    x.d = d;
+    x.i = i;
+    if (hp->n<hp->K)
+    {
+        c = hp->n++;
+        hp->h[c] = x;
+        while (c>0)
+        {
+            p = (c-1)/2;
+            if (!item_greater(&hp->h[c],&hp->h[p]))
+                break;
+            tmp = hp->h[p];
+            hp->h[p] = hp->h[c];
+            hp->h[c] = tmp;
+            c = p;
+        }
+    }
+    else if (item_greater(&hp->h[0],&x))
+    {
+        hp->h[0] = x;
+        heap_sift_down(hp,0);
+    }
+}
+
+/* Search the node of the range [lo,hi) for the neighbors of point q (the point itself is excluded) */
+void search_node(int q,int lo,int hi,heap *hp)
+{
+    int j,mid;
+    double dv,r,tau;
+    const double *x = Xp+(size_t)q*D;
+
+    if (hi-lo<=LEAF_SIZE)
+    {
+        for (j=lo;j<hi;j++)
+            if (Perm[j]!=q)
+                heap_add(hp,distance(x,Xp+(size_t)Perm[j]*D),Perm[j]);
+        return;
+    }
+
+    dv = distance(x,Xp+(size_t)Perm[lo]*D);
+    if (Perm[lo]!=q)
+        heap_add(hp,dv,Perm[lo]);
+    r = Radius[lo];
+    mid = lo+1+(hi-lo-1)/2;
+
+    if (dv<r)
+    {
+        search_node(q,lo+1,mid,hp);
+        tau = hp->n<hp->K ? HUGE_VAL : hp->h[0].d*(1+ROUNDING_SLACK);
+        if (r-dv<=tau)
+            search_node(q,mid,hi,hp);
+    }
+    else
+    {
+        search_node(q,mid,hi,hp);
+        tau = hp->n<hp->K ? HUGE_VAL : hp->h[0].d*(1+ROUNDING_SLACK);
+        if (dv-r<=tau)
+            search_node(q,lo+1,mid,hp);
+    }
+}
+
+/* Conditional probabilities of the neighbors of a point from their squared distances (as d2p and Hbeta) */
+static void conditional_probabilities(const double *d2,double *p,int K,double perplexity)
+{
+    double beta = 1, betamin = -HUGE_VAL, betamax = HUGE_VAL, logU = log(perplexity);
+    double H, Hdiff, sumP, sumDP;
+    int k, tries = 0;
+
+    while (1)
+    {
+        sumP = 0;
+        sumDP = 0;
+        for (k=0;k<K;k++)
+        {
+            p[k] = exp(-d2[k]*beta);
+            sumP += p[k];
+            sumDP += d2[k]*p[k];
+        }
+        if (!(sumP>0))
+        {
+            /* All kernel values underflow: use the nearest neighbors only */
+            for (k=0;k<K;k++)
+                p[k] = d2[k]==d2[0];
+            sumP = 0;
+            for (k=0;k<K;k++)
+                sumP += p[k];
+            break;
+        }
+        H = log(sumP)+beta*sumDP/sumP;
+        Hdiff = H-logU;
+        if (!(fabs(Hdiff)>1e-5) || tries>=50)
+            break;
+
+        if (Hdiff>0)
+        {
+            betamin = beta;
+            beta = isinf(betamax) ? beta*2 : (beta+betamax)/2;
+        }
+        else
+        {
+            betamax = beta;
+            beta = isinf(betamin) ? beta/2 : (beta+betamin)/2;
+        }
+        tries++;
+    }
+    for (k=0;k<K;k++)
+        p[k] /= sumP;
+}
+
+void affinities(const double *X,int K,double perplexity,double *Idx,double *Val)
+{
+    int i,j,f;
+
+    Xp = (double*) malloc((size_t)N*D*sizeof(double));
+    Perm = (int*) malloc(N*sizeof(int));
+    Radius = (double*) malloc(N*sizeof(double));
+    Items = (item*) malloc(N*sizeof(item));
+    for (i=0;i<N;i++)
+    {
+        Perm[i] = i;
+        for (f=0;f<D;f++)
+            Xp[(size_t)i*D+f] = X[i+(size_t)f*N];
+    }
+    Seed = 5489u;
+    build_node(0,N);
+    free(Items);
+    Items = NULL;
+
+    #pragma omp parallel
+    {
+        heap hp;
+        double *d2 = (double*) malloc(K*sizeof(double));
+        hp.h = (item*) malloc(K*sizeof(item));
+        hp.K = K;
+
+        #pragma omp for schedule(dynamic,64)
+        for (i=0;i<N;i++)
+        {
+            hp.n = 0;
+            search_node(i,0,N,&hp);
+
+            /* Neighbors in ascending order of distance */
+            for (j=hp.n-1;j>=0;j--)
+            {
+                Idx[(size_t)i*K+j] = hp.h[0].i+1;
+                d2[j] = hp.h[0].d*hp.h[0].d;
+                hp.h[0] = hp.h[--hp.n];
+                heap_sift_down(&hp,0);
+            }
+            conditional_probabilities(d2,Val+(size_t)i*K,K,perplexity);
+        }
+        free(d2);
+        free(hp.h);
+    }
+
+    free(Xp); free(Perm); free(Radius);
+    Xp = NULL; Perm = NULL; Radius = NULL;
+}
+
+/* -------------------------------------------------------------------------------------------------------- */
+/* Gradient steps (space-partitioning tree)                                                                  */
+/* -------------------------------------------------------------------------------------------------------- */
+
+/* Build the cell c with the points Order[lo...hi-1], the center ctr, and the half-width hw */
+void build_cell(const double *Y,int c,int lo,int hi,const double *ctr,double hw,int depth)
+{
+    int i,k,o,nc = 1<<ND, cnt[8], start[9], pos[8], first;
+    double cc[3];
+
+    Cells[c].width = 2*hw;
+    Cells[c].cnt = hi-lo;
+    Cells[c].child = -1;
+    Cells[c].lo = lo;
+    Cells[c].hi = hi;
+    for (k=0;k<ND;k++)
+    {
+        double s = 0;
+        for (i=lo;i<hi;i++)
+            s += Y[Order[i]+(size_t)k*N];
+        Cells[c].com[k] = s/(hi-lo);
+    }
+    if (hi-lo<=1 || depth>=MAX_DEPTH)
+        return;
+
+    /* Distribute the points among the orthants */
+    memset(cnt,0,sizeof(cnt));
+    for (i=lo;i<hi;i++)
+    {
+        o = 0;
+        for (k=0;k<ND;k++)
+            if (Y[Order[i]+(size_t)k*N]>ctr[k])
+                o |= 1<<k;
+        Tmp[i] = o;
+        cnt[o]++;
+    }
+    start[0] = lo;
+    for (o=0;o<nc;o++)
+        start[o+1] = start[o]+cnt[o];
+    memcpy(pos,start,nc*sizeof(int));
+    for (i=lo;i<hi;i++)
+        Buf[pos[Tmp[i]]++] = Order[i];
+    memcpy(Order+lo,Buf+lo,(hi-lo)*sizeof(int));
+
+    /* Children */
+    if (NumCells+nc>CapCells)
+    {
+        CapCells = 2*CapCells+nc;
+        Cells = (cell*) realloc(Cells,CapCells*sizeof(cell));
+    }
+    first = NumCells;
+    NumCells += nc;
+    Cells[c].child = first;
+    for (o=0;o<nc;o++)
+    {
+        for (k=0;k<ND;k++)
+            cc[k] = ctr[k]+((o>>k)&1 ? hw/2 : -hw/2);
+        if (cnt[o]>0)
+            build_cell(Y,first+o,start[o],start[o+1],cc,hw/2,depth+1);
+        else
+        {
+            Cells[first+o].cnt = 0;
+            Cells[first+o].child = -1;
+        }
+    }
+}
+
+void build_tree(const double *Y)
+{
+    int i,k;
+    double mn[3], mx[3], ctr[3], hw = 0;
+
+    for (k=0;k<ND;k++)
+    {
+        mn[k] = HUGE_VAL;
+        mx[k] = -HUGE_VAL;
+        for (i=0;i<N;i++)
+        {
+            if (Y[i+(size_t)k*N]<mn[k]) mn[k] = Y[i+(size_t)k*N];
+            if (Y[i+(size_t)k*N]>mx[k]) mx[k] = Y[i+(size_t)k*N];
+        }
+        ctr[k] = (mn[k]+mx[k])/2;
+        if ((mx[k]-mn[k])/2>hw)
+            hw = (mx[k]-mn[k])/2;
+    }
+    hw = hw*(1+1e-9)+1e-300;
+    for (i=0;i<N;i++)
+        Order[i] = i;
+    NumCells = 1;
+    build_cell(Y,0,0,N,ctr,hw,0);
+}
+
+/* Repulsive force on point i (negf, not normalized) and its contribution to the normalization */
+static double repulsion(const double *Y,int i,double theta,double *negf,int *stack)
+{
+    int sp = 0, c, j, k;
+    double y[3], diff[3], d2, q, sumQ = 0;
+
+    for (k=0;k<ND;k++)
+    {
+        y[k] = Y[i+(size_t)k*N];
+        negf[k] = 0;
+    }
+    stack[sp++] = 0;
+    while (sp>0)
+    {
+        c = stack[--sp];
+        if (Cells[c].cnt==0)
+            continue;
+
+        d2 = 0;
+        for (k=0;k<ND;k++)
+        {
+            diff[k] = y[k]-Cells[c].com[k];
+            d2 += diff[k]*diff[k];
+        }
+        if (Cells[c].child<0 || Cells[c].width*Cells[c].width<theta*theta*d2)
+        {
+            if (Cells[c].child<0 && Cells[c].cnt>1)
+            {
+                /* Leaf with duplicate points: exact terms */
+                for (j=Cells[c].lo;j<Cells[c].hi;j++)
+                {
+                    if (Order[j]==i)
+                        continue;
+                    d2 = 0;
+                    for (k=0;k<ND;k++)
+                    {
+                        diff[k] = y[k]-Y[Order[j]+(size_t)k*N];
+                        d2 += diff[k]*diff[k];
+                    }
+                    q = 1/(1+d2);
+                    sumQ += q;
+                    for (k=0;k<ND;k++)
+                        negf[k] += q*q*diff[k];
+                }
+                continue;
+            }
+            if (Cells[c].child<0 && Order[Cells[c].lo]==i)
+                continue;
+            q = 1/(1+d2);
+            sumQ += Cells[c].cnt*q;
+            for (k=0;k<ND;k++)
+                negf[k] += Cells[c].cnt*q*q*diff[k];
+        }
+        else
+            for (j=0;j<(1<<ND);j++)
+                stack[sp++] = Cells[c].child+j;
+    }
+    return sumQ;
+}
+
+void iterate(double *Y,double *Inc,double *Gains,const double *Ptr,const double *Idx,const double *Val,
+        double momentum,double epsilon,double exaggeration,double theta,int num_iter)
+{
+    double *posf = (double*) malloc((size_t)N*ND*sizeof(double));
+    double *negf = (double*) malloc((size_t)N*ND*sizeof(double));
+    double sumQ, g, mean;
+    size_t t;
+    int iter,i,k;
+
+    Order = (int*) malloc(N*sizeof(int));
+    Tmp = (int*) malloc(N*sizeof(int));
+    Buf = (int*) malloc(N*sizeof(int));
+    CapCells = 2*N+16;
+    Cells = (cell*) malloc(CapCells*sizeof(cell));
+
+    for (iter=0;iter<num_iter;iter++)
+    {
+        build_tree(Y);
+
+        /* Attractive and repulsive forces */
+        sumQ = 0;
+        #pragma omp parallel
+        {
+            int *stack = (int*) malloc((MAX_DEPTH*8+16)*sizeof(int));
+            double nf[3], pf[3], diff[3], d2, q;
+            int j,r;
+
+            #pragma omp for schedule(dynamic,256) reduction(+:sumQ)
+            for (i=0;i<N;i++)
+            {
+                sumQ += repulsion(Y,i,theta,nf,stack);
+                for (k=0;k<ND;k++)
+                    pf[k] = 0;
+                for (r=(int)Ptr[i];r<(int)Ptr[i+1];r++)
+                {
+                    j = (int) Idx[r]-1;
+                    d2 = 0;
+                    for (k=0;k<ND;k++)
+                    {
+                        diff[k] = Y[i+(size_t)k*N]-Y[j+(size_t)k*N];
+                        d2 += diff[k]*diff[k];
+                    }
+                    q = Val[r]/(1+d2);
+                    for (k=0;k<ND;k++)
+                        pf[k] += q*diff[k];
+                }
+                for (k=0;k<ND;k++)
+                {
+                    posf[i+(size_t)k*N] = pf[k];
+                    negf[i+(size_t)k*N] = nf[k];
+                }
+            }
+            free(stack);
+        }
+
+        /* Update the solution (as tsne_p) */
+        for (t=0;t<(size_t)N*ND;t++)
+        {
+            g = 4*(exaggeration*posf[t]-negf[t]/sumQ);
+            if ((g>0)-(g<0) != (Inc[t]>0)-(Inc[t]<0))
+                Gains[t] += 0.2;
+            else
+                Gains[t] *= 0.8;
+            if (Gains[t]<MIN_GAIN)
+                Gains[t] = MIN_GAIN;
+            Inc[t] = momentum*Inc[t]-epsilon*Gains[t]*g;
+            Y[t] += Inc[t];
+        }
+        for (k=0;k<ND;k++)
+        {
+            mean = 0;
+            for (i=0;i<N;i++)
+                mean += Y[i+(size_t)k*N];
+            mean /= N;
+            for (i=0;i<N;i++)
+                Y[i+(size_t)k*N] -= mean;
+        }
+    }
+
+    free(posf); free(negf); free(Order); free(Tmp); free(Buf); free(Cells);
+    Order = NULL; Tmp = NULL; Buf = NULL; Cells = NULL;
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
+{
+    char mode[16];
+    int i;
+
+    /* Check for the proper number of arguments. */
+    if (nrhs<1 || !mxIsChar(prhs[0]) || mxGetString(prhs[0],mode,sizeof(mode)))
+        mexErrMsgTxt("The first input must be 'affinities' or 'iterate'.");
+    if (nlhs > 3)
+        mexErrMsgTxt("No more than three outputs are required!");
+    for (i=1;i<nrhs;i++)
+        if (!mxIsDouble(prhs[i]) || mxIsComplex(prhs[i]))
+            mexErrMsgTxt("All inputs (except the first one) must be real matrices of type double.\n");
+
+    if (strcmp(mode,"affinities")==0)
+    {
+        int K;
+        double perplexity;
+        if (nrhs!=4)
+            mexErrMsgTxt("Four inputs are required for 'affinities'.");
+        N = (int) mxGetM(prhs[1]);
+        D = (int) mxGetN(prhs[1]);
+        K = (int) mxGetScalar(prhs[2]);
+        perplexity = mxGetScalar(prhs[3]);
+        if (K<1 || K>N-1)
+            mexErrMsgTxt("Number of nearest neighbors must be between 1 and N-1.\n");
+        if (!(perplexity>0))
+            mexErrMsgTxt("Perplexity must be positive.\n");
+        plhs[0] = mxCreateDoubleMatrix(K, N, mxREAL);
+        plhs[1] = mxCreateDoubleMatrix(K, N, mxREAL);
+        affinities(mxGetPr(prhs[1]),K,perplexity,mxGetPr(plhs[0]),mxGetPr(plhs[1]));
+    }
+    else if (strcmp(mode,"iterate")==0)
+    {
+        const double *Ptr,*Params;
+        size_t nnz;
+        if (nrhs!=9)
+            mexErrMsgTxt("Nine inputs are required for 'iterate'.");
+        N = (int) mxGetM(prhs[1]);
+        ND = (int) mxGetN(prhs[1]);
+        if (ND<2 || ND>3)
+            mexErrMsgTxt("The map must have 2 or 3 dimensions.\n");
+        for (i=2;i<4;i++)
+            if ((int)mxGetM(prhs[i])!=N || (int)mxGetN(prhs[i])!=ND)
+                mexErrMsgTxt("ydata, y_incs, and gains must have the same size.\n");
+        if ((int)mxGetNumberOfElements(prhs[4])!=N+1)
+            mexErrMsgTxt("Ptr must have N+1 elements.\n");
+        Ptr = mxGetPr(prhs[4]);
+        nnz = mxGetNumberOfElements(prhs[5]);
+        if (mxGetNumberOfElements(prhs[6])!=nnz || Ptr[0]!=0 || Ptr[N]!=(double)nnz)
+            mexErrMsgTxt("Ptr, Idx, and Val are not consistent.\n");
+        for (i=0;i<N;i++)
+            if (Ptr[i+1]<Ptr[i])
+                mexErrMsgTxt("Ptr must be nondecreasing.\n");
+        for (i=0;i<(int)nnz;i++)
+            if (!(mxGetPr(prhs[5])[i]>=1 && mxGetPr(prhs[5])[i]<=N))
+                mexErrMsgTxt("Idx is not valid.\n");
+        if (mxGetNumberOfElements(prhs[7])!=4)
+            mexErrMsgTxt("Params must have four elements.\n");
+        Params = mxGetPr(prhs[7]);
+
+        for (i=0;i<3;i++)
+            plhs[i] = mxDuplicateArray(prhs[i+1]);
+        iterate(mxGetPr(plhs[0]),mxGetPr(plhs[1]),mxGetPr(plhs[2]),Ptr,mxGetPr(prhs[5]),mxGetPr(prhs[6]),
+                Params[0],Params[1],Params[2],Params[3],(int)mxGetScalar(prhs[8]));
+    }
+    else
+        mexErrMsgTxt("The first input must be 'affinities' or 'iterate'.");
+}
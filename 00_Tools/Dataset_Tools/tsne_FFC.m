@@ -30,8 +30,14 @@ function ydata = tsne_FFC(X, labels, no_dims, initial_dims, perplexity, max_iter
 % by t-SNE itself, however, they are used to color intermediate plots.
 % max_iter is the maximum number of iterations in tsne_p function.
 %
+% For large datasets (at least 5000 points), Barnes-Hut t-SNE is used if
+% tsne_BarnesHut_Core_FFC is available: the input affinities are computed
+% over the nearest neighbors only, and the repulsive forces are approximated
+% with a space-partitioning tree (see tsne_bh function).
+%
 % Revisions:
 % 2020-Oct-28   function was created
+% 2026-Oct-18   Barnes-Hut t-SNE (tsne_BarnesHut_Core_FFC) was added for large datasets
 
 % Normalize input data
 X = X - min(X(:));
@@ -41,20 +47,46 @@ X = bsxfun(@minus, X, mean(X, 1));
 % Perform preprocessing using PCA
 GUI_MainEditBox_Update_FFC(false,'Preprocessing data using PCA...');
 pause(0.01);
-if size(X, 2) < size(X, 1)
+if size(X, 2) > 1000 && size(X, 2) < size(X, 1)
+    % Top principal components of wide datasets (see RandomizedPCA_FFC)
+    [M,~,ErrorMsg] = RandomizedPCA_FFC([X zeros(size(X, 1), 2)], initial_dims, 2);
+    if ~isempty(ErrorMsg)
+        ydata = -1;
+        return;
+    end
+    X = bsxfun(@minus, X, mean(X, 1)) * M;
+    clear M
+    C = [];
+elseif size(X, 2) < size(X, 1)
     C = X' * X;
 else
     C = (1 / size(X, 1)) * (X * X');
 end
-[M, lambda] = eig(C);
-[lambda, ind] = sort(diag(lambda), 'descend');
-M = M(:,ind(1:initial_dims));
-lambda = lambda(1:initial_dims);
-if ~(size(X, 2) < size(X, 1))
-    M = bsxfun(@times, X' * M, (1 ./ sqrt(size(X, 1) .* lambda))');
+if ~isempty(C)
+    [M, lambda] = eig(C);
+    [lambda, ind] = sort(diag(lambda), 'descend');
+    M = M(:,ind(1:initial_dims));
+    lambda = lambda(1:initial_dims);
+    if ~(size(X, 2) < size(X, 1))
+        M = bsxfun(@times, X' * M, (1 ./ sqrt(size(X, 1) .* lambda))');
+    end
+    X = bsxfun(@minus, X, mean(X, 1)) * M;
+    clear M lambda ind
+end
+clear C
+
+% Barnes-Hut t-SNE for large datasets
+if size(X, 1) >= 5000 && exist('tsne_BarnesHut_Core_FFC','file')==3
+    n = size(X, 1);
+    K = min(n - 1, floor(3 * perplexity));
+    GUI_MainEditBox_Update_FFC(false,'Computing P-values of nearest neighbors...');
+    pause(0.01);
+    [Idx, Val] = tsne_BarnesHut_Core_FFC('affinities', X, K, perplexity);
+    P = sparse(Idx(:), kron((1:n)', ones(K, 1)), Val(:), n, n);
+    clear Idx Val
+    ydata = tsne_bh(P, labels, no_dims, max_iter);
+    return;
 end
-X = bsxfun(@minus, X, mean(X, 1)) * M;
-clear M lambda ind
 
 % Compute pairwise distance matrix
 sum_X = sum(X .^ 2, 2);
@@ -276,65 +308,12 @@ for iter=1:max_iter
     
     % Display scatter plot (maximally first three dimensions)
     if ~rem(iter, 10) && ~isempty(labels)
-        if isempty(h)
-            h = figure('Name','t-SNE Visualization','NumberTitle','off');
-        else
-            figure(h);
-        end
-        if no_dims == 2
-            gscatter(ydata(:,1), ydata(:,2), labels);
-            set(gca,'xtick',[])
-            set(gca,'xticklabel',[])
-            set(gca,'ytick',[])
-            set(gca,'yticklabel',[])
-        else
-            gsh = gscatter(ydata(:,1), ydata(:,2), labels);
-            labels_unique = unique(labels);
-            for k = 1:numel(labels_unique)
-                set(gsh(k), 'ZData', ydata(cellfun(@isequal,labels,repmat(labels_unique(k),size(labels,1),1)),3));
-            end
-            view(3);
-            set(gca,'xtick',[])
-            set(gca,'xticklabel',[])
-            set(gca,'ytick',[])
-            set(gca,'yticklabel',[])
-            set(gca,'ztick',[])
-            set(gca,'zticklabel',[])
-        end
-        axis tight
-        drawnow
+        h = plot_tsne(h, ydata, labels, no_dims);
     end
     
     stopbar = progressbar_FFC(1,iter/max_iter);
     if stopbar
-        if isempty(h)
-            figure('Name','t-SNE Visualization','NumberTitle','off');
-        else
-            figure(h);
-        end
-        if no_dims == 2
-            gscatter(ydata(:,1), ydata(:,2), labels);
-            set(gca,'xtick',[])
-            set(gca,'xticklabel',[])
-            set(gca,'ytick',[])
-            set(gca,'yticklabel',[])
-        else
-            gsh = gscatter(ydata(:,1), ydata(:,2), labels);
-            labels_unique = unique(labels);
-            for k = 1:numel(labels_unique)
-                set(gsh(k), 'ZData', ydata(cellfun(@isequal,labels,repmat(labels_unique(k),size(labels,1),1)),3));
-            end
-            view(3);
-            set(gca,'xtick',[])
-            set(gca,'xticklabel',[])
-            set(gca,'ytick',[])
-            set(gca,'yticklabel',[])
-            set(gca,'ztick',[])
-            set(gca,'zticklabel',[])
-        end
-        axis tight
-        drawnow
-        
+        plot_tsne(h, ydata, labels, no_dims);
         return
     end
     
@@ -343,4 +322,102 @@ for iter=1:max_iter
     end
 end
 
-end
\ No newline at end of file
+end
+
+%% tsne_bh Function
+function ydata = tsne_bh(P, labels, no_dims, max_iter)
+% Performs Barnes-Hut t-SNE on the sparse affinity matrix P with the same
+% optimization schedule as tsne_p. The gradient steps are done by
+% tsne_BarnesHut_Core_FFC in batches of 10 iterations.
+
+% Initialize some variables
+n = size(P, 1);                                     % number of instances
+momentum = 0.5;                                     % initial momentum
+final_momentum = 0.8;                               % value to which momentum is changed
+mom_switch_iter = 250;                              % iteration at which momentum is changed
+stop_lying_iter = 100;                              % iteration at which lying about P-values is stopped
+epsilon = max(500, n / 48);                         % learning rate (increased for large datasets)
+theta = 0.5;                                        % accuracy of Barnes-Hut approximation
+exaggeration = 4;                                   % lie about the P-vals to find better local minima
+
+% Make sure P-vals are set properly
+P = 0.5 * (P + P');                                 % symmetrize P-values
+P = P / sum(P(:));                                  % make sure P-values sum to one
+[Idx, ~, Val] = find(P);                            % P is symmetric: column i gives the neighbors of point i
+Ptr = [0; cumsum(full(sum(P ~= 0, 1)))'];
+clear P
+
+% Initialize the solution
+ydata = .0001 * randn(n, no_dims);
+y_incs  = zeros(size(ydata));
+gains = ones(size(ydata));
+
+% Run the iterations
+h = [];
+progressbar_FFC('Please wait ...');
+for b=1:ceil(max_iter/10)
+    
+    iter = min(10 * b, max_iter);
+    num_iter = iter - 10 * (b - 1);
+    [ydata, y_incs, gains] = tsne_BarnesHut_Core_FFC('iterate', ydata, y_incs, gains, Ptr, Idx, Val, ...
+        [momentum epsilon exaggeration theta], num_iter);
+    
+    % Update the momentum and P-values if necessary
+    if iter >= mom_switch_iter
+        momentum = final_momentum;
+    end
+    if iter >= stop_lying_iter
+        exaggeration = 1;
+    end
+    
+    % Display scatter plot (maximally first three dimensions)
+    if ~isempty(labels)
+        h = plot_tsne(h, ydata, labels, no_dims);
+    end
+    
+    stopbar = progressbar_FFC(1,iter/max_iter);
+    if stopbar
+        plot_tsne(h, ydata, labels, no_dims);
+        return
+    end
+    
+    if ~isempty(labels) && iter<max_iter
+        progressbar_FFC();
+    end
+end
+
+end
+
+%% plot_tsne Function
+function h = plot_tsne(h, ydata, labels, no_dims)
+% Displays scatter plot of the map (maximally first three dimensions) in figure h
+
+if isempty(h)
+    h = figure('Name','t-SNE Visualization','NumberTitle','off');
+else
+    figure(h);
+end
+if no_dims == 2
+    gscatter(ydata(:,1), ydata(:,2), labels);
+    set(gca,'xtick',[])
+    set(gca,'xticklabel',[])
+    set(gca,'ytick',[])
+    set(gca,'yticklabel',[])
+else
+    gsh = gscatter(ydata(:,1), ydata(:,2), labels);
+    labels_unique = unique(labels);
+    for k = 1:numel(labels_unique)
+        set(gsh(k), 'ZData', ydata(cellfun(@isequal,labels,repmat(labels_unique(k),size(labels,1),1)),3));
+    end
+    view(3);
+    set(gca,'xtick',[])
+    set(gca,'xticklabel',[])
+    set(gca,'ytick',[])
+    set(gca,'yticklabel',[])
+    set(gca,'ztick',[])
+    set(gca,'zticklabel',[])
+end
+axis tight
+drawnow
+
+end
@@ -0,0 +1,56 @@
+function kNNIndex = Build_EnsemblekNN_Index_FFC(EnsemblekNN,kNNIndex)
+
+% This function builds the nearest neighbor index of the learners of an ensemble kNN. The training
+% points of each learner are indexed in the feature subspace of the learner with a VP-tree (see
+% kNN_VPTree_Core_FFC). If the index of the first learners is given (e.g. before the ensemble is grown
+% by resume), only the remaining learners are indexed.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   EnsemblekNN: Trained ensemble kNN (Subspace ensemble of kNN learners)
+%   kNNIndex: Index of the first learners of EnsemblekNN (optional, can be empty)
+%
+% Outputs:
+%   kNNIndex: A structure with the following fields
+%       Y: Nx1 vector of the classes of N training points (indices of EnsemblekNN.ClassNames)
+%       W: Nx1 vector of the weights of training points
+%       Features: FxT logical matrix that shows the features of T learners
+%       NumNeighbors: 1xT vector of the number of nearest neighbors of learners
+%       Perm: 1xT cell of the orders of training points in VP-trees
+%       Radius: 1xT cell of the radii of the nodes of VP-trees
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+X = EnsemblekNN.X;
+Features = EnsemblekNN.UsePredForLearner;
+T = EnsemblekNN.NumTrained;
+
+% The given index is used only if it belongs to the first learners of the ensemble
+if nargin<2 || isempty(kNNIndex) || length(kNNIndex.Y)~=size(X,1) || ...
+        size(kNNIndex.Features,2)>T || ~isequal(kNNIndex.Features,Features(:,1:size(kNNIndex.Features,2)))
+    [~,Y] = ismember(EnsemblekNN.Y,EnsemblekNN.ClassNames);
+    kNNIndex = struct('Y',Y(:),'W',EnsemblekNN.W(:),'Features',false(size(Features,1),0),...
+        'NumNeighbors',zeros(1,0),'Perm',{cell(1,0)},'Radius',{cell(1,0)});
+end
+
+%% Index the remaining learners
+for t=size(kNNIndex.Features,2)+1:T
+    [kNNIndex.Perm{t},kNNIndex.Radius{t}] = kNN_VPTree_Core_FFC(X(:,Features(:,t)));
+    kNNIndex.Features(:,t) = Features(:,t);
+    kNNIndex.NumNeighbors(t) = EnsemblekNN.Trained{t}.NumNeighbors;
+end
@@ -0,0 +1,77 @@
+function [ErrorMsg,PredictedLabel,Scores,Stage] = Classify_Fragments_Cascade_FFC(Cascade,Fragments)
+
+% This function classifies a batch of fragments with a cascade of decision machine bundles. Each stage adds
+% a group of features to the features of the previous stages. A fragment goes to the next stage only if the
+% maximum score of the current stage is less than its threshold, so the expensive features are calculated
+% only for the fragments that reach the later stages.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Cascade: Cascade loaded by Load_Cascade_FFC, or the name of the cascade file
+%   Fragments: Cell array with length L consisting of row vectors of byte values
+%
+% Outputs:
+%   ErrorMsg: Possible error message. If there is no error, this output is
+%       empty.
+%   PredictedLabel: Lx1 vector of predicted labels (indices of Cascade.ClassLabels)
+%   Scores: LxM matrix of scores for M classes (the scores of the stage at which the fragment is classified)
+%   Stage: Lx1 vector of the stages at which the fragments are classified
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+PredictedLabel = [];
+Scores = [];
+Stage = [];
+if ischar(Cascade)
+    [Cascade,ErrorMsg] = Load_Cascade_FFC(Cascade);
+    if ~isempty(ErrorMsg)
+        return;
+    end
+end
+ErrorMsg = '';
+L = length(Fragments);
+S = length(Cascade.Bundles);
+
+PredictedLabel = zeros(L,1);
+Scores = zeros(L,length(Cascade.ClassLabels));
+Stage = zeros(L,1);
+
+%% Stages
+Remain = (1:L)'; % Fragments that reach the current stage
+Features = []; % Raw features of the remaining fragments which are calculated by the previous stages
+for s=1:S
+    [ErrorMsg,PredictedLabel_s,Scores_s,Features] = Classify_Fragments_FFC(Cascade.Bundles{s},Fragments(Remain),Features);
+    if ~isempty(ErrorMsg)
+        return;
+    end
+
+    if s<S
+        Leave = max(Scores_s,[],2)>=Cascade.Thresholds(s);
+    else
+        Leave = true(length(Remain),1);
+    end
+    PredictedLabel(Remain(Leave)) = PredictedLabel_s(Leave);
+    Scores(Remain(Leave),:) = Scores_s(Leave,:);
+    Stage(Remain(Leave)) = s;
+
+    Remain = Remain(~Leave);
+    Features = Features(~Leave,:);
+    if isempty(Remain)
+        break;
+    end
+end
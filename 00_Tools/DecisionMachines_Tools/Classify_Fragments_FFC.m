@@ -0,0 +1,176 @@
+function [ErrorMsg,PredictedLabel,Scores,Features] = Classify_Fragments_FFC(Bundle,Fragments,Features)
+
+% This function classifies a batch of fragments with a decision machine bundle. If
+% Score_DecisionMachine_Bundle_Core_FFC (C-MEX) is available, the features are calculated from the raw
+% bytes of fragments by the native kernels of the feature plan and scored natively. Otherwise, the
+% features are calculated in memory with the function handles of the feature plan and scored in MATLAB.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Bundle: Decision machine bundle loaded by Load_DecisionMachine_Bundle_FFC, or the name of the bundle file
+%   Fragments: Cell array with length L consisting of row vectors of byte values
+%   Features: (optional) LxF1 matrix of raw features of the first function handles of the feature plan,
+%       which are already calculated (e.g. by the previous stage of a cascade; see Classify_Fragments_Cascade_FFC)
+%
+% Outputs:
+%   ErrorMsg: Possible error message. If there is no error, this output is
+%       empty.
+%   PredictedLabel: Lx1 vector of predicted labels (indices of Bundle.ClassLabels)
+%   Scores: LxM matrix of scores for M classes
+%   Features: LxF0 matrix of raw features (before feature transform and scaling)
+%
+% Revisions:
+% 2026-Oct-18   function was created
+% 2026-Oct-18   the features which are already calculated can be given as input
+% 2026-Oct-18   the features are calculated natively by Score_DecisionMachine_Bundle_Core_FFC
+
+%% Initialization
+PredictedLabel = [];
+Scores = [];
+if ischar(Bundle)
+    [Bundle,ErrorMsg] = Load_DecisionMachine_Bundle_FFC(Bundle);
+    if ~isempty(ErrorMsg)
+        return;
+    end
+end
+ErrorMsg = '';
+L = length(Fragments);
+if nargin<3
+    Features = [];
+end
+
+%% Native Feature Calculation and Scoring
+if exist('Score_DecisionMachine_Bundle_Core_FFC','file')==3 && all([Bundle.Plan.Kernel]>0)
+    [PredictedLabel,Scores,Features] = Score_DecisionMachine_Bundle_Core_FFC(Bundle.Filename,Fragments,Features);
+    if any(isnan(Features(:)))
+        PredictedLabel = [];
+        Scores = [];
+        ErrorMsg = 'The feature set of some fragments contains NaN.';
+    end
+    return;
+end
+
+%% Calculate Features
+if isempty(Features)
+    F1 = 0;
+    Features = zeros(L,Bundle.F0);
+else
+    F1 = size(Features,2);
+    Features = [Features zeros(L,Bundle.F0-F1)];
+end
+f_cnt = 0;
+for cnt=1:length(Bundle.Plan)
+    Select = Bundle.Plan(cnt).Select;
+    if ~any(Select)
+        continue;
+    end
+    f_sum = sum(Select);
+    if f_cnt+f_sum<=F1 % Already calculated
+        f_cnt = f_cnt+f_sum;
+        continue;
+    end
+    if Bundle.Plan(cnt).Batched
+        tmp = Bundle.Plan(cnt).Handle(Fragments);
+        Features(:,f_cnt+(1:f_sum)) = tmp(:,Select);
+    else
+        for i=1:L
+            tmp = Bundle.Plan(cnt).Handle(Fragments{i});
+            Features(i,f_cnt+(1:f_sum)) = tmp(Select);
+        end
+    end
+    f_cnt = f_cnt+f_sum;
+end
+
+if any(isnan(Features(:)))
+    ErrorMsg = 'The feature set of some fragments contains NaN.';
+    return;
+end
+
+%% Score Features
+RawFeatures = Features;
+if exist('Score_DecisionMachine_Bundle_Core_FFC','file')==3
+    [PredictedLabel,Scores] = Score_DecisionMachine_Bundle_Core_FFC(Bundle.Filename,Features);
+    return;
+end
+
+% Feature transform and scaling
+if ~isempty(Bundle.Coef)
+    Features = Features*Bundle.Coef;
+end
+if ~isempty(Bundle.Scaling_Parameters)
+    Features = Scale_Features_FFC([Features zeros(L,2)],Bundle.Scaling_Parameters);
+    Features = Features(:,1:end-2);
+end
+
+% Decision machine
+Model = Bundle.Model;
+M = length(Bundle.ClassLabels);
+switch Bundle.ModelType
+    case 1 % LDA
+        Scores = Softmax(Features*Model.W+Model.c);
+
+    case 2 % Naive Bayes
+        Scores = repmat(Model.LogPrior,L,1);
+        for k=1:M
+            for j=1:size(Features,2)
+                x = min(max(Features(:,j),Model.Grid{k,j}(1)),Model.Grid{k,j}(end));
+                Scores(:,k) = Scores(:,k)+interp1(Model.Grid{k,j},Model.LogPDF{k,j},x);
+            end
+        end
+        Scores = Softmax(Scores);
+
+    case {3,4} % Decision Tree and Random Forest
+        Scores = zeros(L,M);
+        for t=1:length(Model.Trees)
+            Tree = Model.Trees{t};
+            node = ones(L,1);
+            branch = Tree.CutFeature(node)>0;
+            while any(branch)
+                idx = find(branch);
+                cf = Tree.CutFeature(node(idx));
+                right = Features(sub2ind(size(Features),idx,cf))>=Tree.CutPoint(node(idx));
+                node(idx) = Tree.Children(sub2ind(size(Tree.Children),node(idx),right+1));
+                branch(idx) = Tree.CutFeature(node(idx))>0;
+            end
+            Scores = Scores+Tree.ClassProbability(node,:);
+        end
+        Scores = Scores/length(Model.Trees);
+
+    case 5 % SVM
+        Scores = zeros(L,M);
+        for k=1:M
+            SVM = Model.SVM{k};
+            U = (Features-SVM.Mu)./SVM.Sigma/SVM.Scale;
+            SV = SVM.SupportVectors/SVM.Scale;
+            switch SVM.Kernel
+                case 2
+                    K = exp(-(sum(U.^2,2)+sum(SV.^2,2)'-2*U*SV'));
+                case 3
+                    K = (1+U*SV').^SVM.Order;
+                otherwise
+                    K = U*SV';
+            end
+            Scores(:,k) = K*SVM.Coef+SVM.Bias;
+        end
+
+end
+[~,PredictedLabel] = max(Scores,[],2);
+Features = RawFeatures;
+
+function P = Softmax(S)
+S = S-max(S,[],2);
+P = exp(S);
+P = P./sum(P,2);
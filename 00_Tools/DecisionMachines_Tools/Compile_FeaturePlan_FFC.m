@@ -0,0 +1,171 @@
+function [Function_Handles,Function_Labels,Function_Select,Info] = Compile_FeaturePlan_FFC(Function_Handles,Function_Labels,Function_Select)
+
+% This function compiles a feature plan (the function handles used for generating a dataset, their output
+% labels, and the selected outputs) into a pruned plan that calculates the same selected features with less
+% work. The function handles with no selected output are removed, and the following function handles are
+% replaced by their partial versions, which only calculate the selected outputs (or the smallest group of
+% outputs that contains them):
+%   BFD_FFC and BFD_Parallel_FFC: The selected byte values of Range (if none of the four statistics of the
+%       full byte frequency distribution is selected)
+%   Byte_Bigram_FFC and Byte_Bigram_Parallel_FFC: The selected bigrams
+%   Autocorrelation_FFC and Autocorrelation_Parallel_FFC: The lags up to the largest selected lag
+%   Grayscale_GIST_FFC and Grayscale_GIST_Parallel_FFC: The Gabor filters (orientations and scales) with
+%       at least one selected block
+%   Compare_with_Centroids_FFC and Compare_with_Centroids_Parallel_FFC: The centroid models with at least one selected output
+% The other function handles are kept unchanged. The selected features of the pruned plan are the same as
+% those of the original plan and appear in the same order. Therefore, the pruned plan can replace the
+% original plan for the feature transform and the decision machine. The variables of the partial handles
+% are numeric arrays, so the pruned plan can be exported (see Export_DecisionMachine_FFC).
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Function_Handles: cell array of function handles used for generating dataset.
+%   Function_Labels: Cell array of feature labels used for generating dataset.
+%   Function_Select: Cell array of selected features after feature calculation.
+%
+% Outputs:
+%   Function_Handles: cell array of function handles of the pruned plan
+%   Function_Labels: Cell array of the labels of the outputs of the pruned function handles
+%   Function_Select: Cell array of the selected outputs of the pruned function handles (logical)
+%   Info: A structure with the following fields
+%       Functions: 1x2 vector of the number of function handles before and after compilation
+%       Outputs: 1x2 vector of the number of calculated outputs before and after compilation
+%       Features: Number of selected features (the same for both plans)
+%
+% Revisions:
+% 2026-Oct-18   function was created
+% 2026-Oct-18   Compare_with_Centroids_FFC was added
+
+%% Initialization
+N = length(Function_Handles);
+Keep = false(1,N);
+Info.Functions = [N 0];
+Info.Outputs = [sum(cellfun(@length,Function_Select)) 0];
+
+%% Compile function handles
+for i=1:N
+    Select = logical(Function_Select{i}(:)');
+    if ~any(Select)
+        continue;
+    end
+    Keep(i) = true;
+    [Function_Handles{i},Function_Labels{i},Function_Select{i}] = partial_handle(Function_Handles{i},Function_Labels{i},Select);
+end
+Function_Handles = Function_Handles(Keep);
+Function_Labels = Function_Labels(Keep);
+Function_Select = Function_Select(Keep);
+
+Info.Functions(2) = sum(Keep);
+Info.Outputs(2) = sum(cellfun(@length,Function_Select));
+Info.Features = sum(cellfun(@sum,Function_Select));
+
+%% Partial version of a function handle
+function [Handle,Labels,Select] = partial_handle(Handle,Labels,Select)
+
+% The handle must be a call of a function whose arguments (except the fragment) are captured variables
+Expression = func2str(Handle);
+tok = regexp(Expression,'^@\((\w+)\)\s*(\w+)\((.*)\)$','tokens','once');
+if isempty(tok)
+    return;
+end
+Args = strtrim(strsplit(tok{3},','));
+info = functions(Handle);
+if ~strcmp(Args{1},tok{1}) || ~isfield(info,'workspace') || isempty(info.workspace)
+    return;
+end
+ws = info.workspace{1};
+if length(Args)>1 && ~all(isfield(ws,Args(2:end)))
+    return;
+end
+Vars = Args(2:end);
+
+% Outputs: Indices of the outputs of the original handle that are calculated by the partial handle
+switch tok{2}
+    case {'BFD_FFC','BFD_Parallel_FFC'}
+        Range = ws.(Vars{1});
+        Full = isequal(Range,num2cell(0:255));
+        if all(Select) || (Full && (any(Select(257:end)) || all(Select(1:256))))
+            return;
+        end
+        Outputs = find(Select);
+        ws.(Vars{1}) = Range(Outputs);
+
+    case {'Byte_Bigram_FFC','Byte_Bigram_Parallel_FFC'}
+        if all(Select)
+            return;
+        end
+        if isempty(Vars)
+            Bigrams = 0:2^16-1;
+        else
+            Bigrams = ws.(Vars{1});
+        end
+        Outputs = find(Select);
+        Args{2} = 'Bigrams';
+        ws.Bigrams = Bigrams(Outputs);
+
+    case {'Autocorrelation_FFC','Autocorrelation_Parallel_FFC'}
+        lag = find(Select,1,'last');
+        if lag==length(Select)
+            return;
+        end
+        Outputs = 1:lag;
+        ws.(Vars{1}) = lag;
+
+    case {'Grayscale_GIST_FFC','Grayscale_GIST_Parallel_FFC'}
+        % Position of the argument of the indices of Gabor filters
+        pos = 5+strcmp(tok{2},'Grayscale_GIST_Parallel_FFC');
+        W = ws.(Vars{3})^2; % Number of blocks of each filter
+        if length(Args)>=pos
+            Filters = ws.(Args{pos});
+        else
+            Filters = 1:sum(ws.(Vars{2}));
+        end
+        Used = unique(ceil(find(Select)/W));
+        if length(Used)==length(Filters)
+            return;
+        end
+        Outputs = reshape((1:W)'+(Used-1)*W,1,[]);
+        if pos==6 && length(Args)<5
+            Args{5} = 'GIST_LowRes';
+            ws.GIST_LowRes = false;
+        end
+        Args{pos} = 'Filters';
+        ws.Filters = Filters(Used);
+
+    case {'Compare_with_Centroids_FFC','Compare_with_Centroids_Parallel_FFC'}
+        Used = unique(ceil(find(Select)/2));
+        if length(Used)==size(ws.(Vars{1}),1)
+            return;
+        end
+        Outputs = reshape([2*Used-1 ; 2*Used],1,[]);
+        ws.(Vars{1}) = ws.(Vars{1})(Used,:);
+        ws.(Vars{2}) = ws.(Vars{2})(Used,:);
+
+    otherwise
+        return;
+end
+
+Labels = Labels(Outputs);
+Select = Select(Outputs);
+Handle = make_handle(sprintf('@(%s) %s(%s)',tok{1},tok{2},strjoin(Args,',')),ws);
+
+function Handle__ = make_handle(Expression__,ws__)
+% The captured variables are defined in this workspace before the handle is built.
+Names__ = fieldnames(ws__);
+for i__=1:length(Names__)
+    eval([Names__{i__} ' = ws__.(Names__{i__});']);
+end
+Handle__ = eval(Expression__);
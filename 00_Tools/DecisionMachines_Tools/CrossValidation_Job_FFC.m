@@ -0,0 +1,169 @@
+function Results = CrossValidation_Job_FFC(SharedDataset,ClassLabels,FeatureLabels,Weights,Fold,DecisionModel,Prms,Tune)
+
+% This function runs a job of cross-validation: the decision machines of a fold are trained and tested for
+% a chain of tuning parameters. For random forests and ensemble kNNs, the number of trees or learners is
+% ascending along the chain, and the model of each tuning parameter is grown from the model of the previous one.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   SharedDataset: Dataset with L rows (L samples corresponding to L fragments) and C columns, or a
+%       parallel.pool.Constant of it (a read-only copy shared by the jobs of a parallel pool worker).
+%       The first C-2 columns correspond to features. The last two columns correspond to the integer-valued
+%       class labels and the FileID of the fragments, respectively.
+%   ClassLabels: 1xM cell. Cell contents are strings denoting the name of
+%       classes corresponding to integer-valued class labels 1,2,....
+%   FeatureLabels: 1xF cell. Cell contents are strings denoting the name of
+%       features corresponding to the columns of Dataset.
+%   Weights: Lx1 vector of sample weights.
+%   Fold: A structure with the following fields:
+%       TestIndex: Indices of test samples
+%       TrainValidationIndex: Indices of training and validation samples
+%       TIndex: Indices of training samples
+%       VIndex: Indices of validation samples
+%   DecisionModel: 'Decision Tree', 'SVM', 'Random Forest', 'Ensemble kNN', 'Naive Bayes',
+%       'Linear Discriminant Analysis (LDA)', or 'Neural Network'
+%   Prms: A structure of the parameters which are not tuned: Weighting_Method, feature_scaling_method,
+%       KernelFunction, PolynomialOrder, NumFeatures, and SearchEpsilon
+%   Tune: 1xN structure array of the chain of tuning parameters with the following fields:
+%       MinLeafSize (Decision Tree and Random Forest), KernelScale and BoxConstraint (SVM), NumTrees (Random Forest),
+%       NumLearners and NumNeighbors (Ensemble kNN), and hiddenSize (Neural Network)
+%
+% Output:
+%   Results: 1xN structure array of the results for the tuning parameters with the following fields:
+%       Pc_Train, ConfusionMatrix_Train: Accuracy and confusion matrix for training data
+%       Pc_Validation, ConfusionMatrix_Validation: Accuracy and confusion matrix for validation data
+%       Pc, ConfusionMatrix: Accuracy and confusion matrix for test data
+%       PredictedLabels, Scores: Predicted labels and scores of test data
+%
+% Revisions:
+% 2026-Oct-18   function was created
+% 2026-Oct-18   the fold is a view of dataset, and the features are scaled when they are gathered
+% 2026-Oct-18   the training samples are limited as in the baseline scaling (TrainIndex of Scale_Features_FFC)
+
+%% View of Dataset for Fold
+% The samples are only gathered (and scaled) by the functions of decision machines
+if isa(SharedDataset,'parallel.pool.Constant')
+    Dataset = Create_DatasetView_FFC(SharedDataset.Value);
+else
+    Dataset = Create_DatasetView_FFC(SharedDataset);
+end
+TestIndex = Fold.TestIndex;
+TrainValidationIndex = Fold.TrainValidationIndex;
+TIndex = Fold.TIndex;
+VIndex = Fold.VIndex;
+
+% Scaling Features
+switch DecisionModel
+    case {'SVM','Ensemble kNN','Naive Bayes','Linear Discriminant Analysis (LDA)','Neural Network'}
+        Dataset = Scale_Features_FFC(Dataset,Prms.feature_scaling_method,[],TrainValidationIndex);
+
+    case {'Decision Tree','Random Forest'}
+
+end
+
+%% Loop over Chain of Tuning Parameters
+N = length(Tune);
+Results = struct('Pc_Train',cell(1,N),'ConfusionMatrix_Train',[],'Pc_Validation',[],'ConfusionMatrix_Validation',[],...
+    'Pc',[],'ConfusionMatrix',[],'PredictedLabels',[],'Scores',[]);
+DM = [];
+DM_Index = [];
+for n=1:N
+
+    % Train Decision Model
+    switch DecisionModel
+        case 'Decision Tree'
+            [DM,~,Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp] = ...
+                Build_DecisionTree_FFC(Dataset,ClassLabels,FeatureLabels,Weights,TIndex,VIndex,Tune(n).MinLeafSize,0);
+
+        case 'SVM'
+            [DM,~,Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp] = ...
+                Build_MultiClassSVM_FFC(Dataset,ClassLabels,FeatureLabels,Weights,Prms.Weighting_Method,TIndex,VIndex,...
+                Prms.KernelFunction,Prms.PolynomialOrder,Tune(n).KernelScale,Tune(n).BoxConstraint,0);
+
+        case 'Random Forest'
+            if n==1 % Train Initial Random Forest
+                [DM,Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp] = ...
+                    Build_RandomForest_FFC([],Dataset,ClassLabels,FeatureLabels,Weights,TIndex,VIndex,Tune(n).NumTrees,Tune(n).MinLeafSize);
+            elseif Tune(n).NumTrees==Tune(n-1).NumTrees % Same Random Forest
+                Results(n) = Results(n-1);
+                continue;
+            else % Train Additional Trees
+                [DM,Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp] = ...
+                    Build_RandomForest_FFC(DM,Dataset,ClassLabels,FeatureLabels,Weights,TIndex,VIndex,Tune(n).NumTrees-Tune(n-1).NumTrees,Tune(n).MinLeafSize);
+            end
+
+        case 'Ensemble kNN'
+            if n==1 % Train Initial Ensemble kNN
+                [DM,Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp,DM_Index] = ...
+                    Build_EnsemblekNN_FFC([],Dataset,ClassLabels,FeatureLabels,Weights,TIndex,VIndex,...
+                    Tune(n).NumLearners,Prms.NumFeatures,Tune(n).NumNeighbors,[],Prms.SearchEpsilon);
+            elseif Tune(n).NumLearners==Tune(n-1).NumLearners % Same Ensemble kNN
+                Results(n) = Results(n-1);
+                continue;
+            else % Train Additional kNNs
+                [DM,Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp,DM_Index] = ...
+                    Build_EnsemblekNN_FFC(DM,Dataset,ClassLabels,FeatureLabels,Weights,TIndex,VIndex,...
+                    Tune(n).NumLearners-Tune(n-1).NumLearners,Prms.NumFeatures,Tune(n).NumNeighbors,DM_Index,Prms.SearchEpsilon);
+            end
+
+        case 'Naive Bayes'
+            [DM,~,Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp] = Build_NaiveBayes_FFC(Dataset,ClassLabels,FeatureLabels,Weights,TIndex,VIndex);
+
+        case 'Linear Discriminant Analysis (LDA)'
+            [DM,Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp] = Build_LDA_FFC(Dataset,ClassLabels,FeatureLabels,Weights,TIndex,VIndex);
+
+        case 'Neural Network'
+            [DM,Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp] = Build_PatternRecognitionNeuralNetwork_FFC(Dataset,ClassLabels,FeatureLabels,Weights,TIndex',VIndex',Tune(n).hiddenSize);
+    end
+
+    % Training and Validation Results
+    Results(n).Pc_Train = Pc_Train_tmp;
+    Results(n).ConfusionMatrix_Train = ConfusionMatrix_Train_tmp;
+    Results(n).Pc_Validation = Pc_tmp;
+    Results(n).ConfusionMatrix_Validation = ConfusionMatrix_tmp;
+
+    % Evaluate the performance of the final decision machine on the test set
+    switch DecisionModel
+        case 'Decision Tree'
+            [~,Pc_tmp,ConfusionMatrix_tmp,PLabel_tmp,Sc_tmp] = Test_DecisionTree_FFC(DM,Dataset,TestIndex,ClassLabels,ClassLabels,FeatureLabels,FeatureLabels,Weights);
+
+        case 'SVM'
+            [~,Pc_tmp,ConfusionMatrix_tmp,Sc_tmp,PLabel_tmp] = Test_MultiClassSVM_FFC(DM,Dataset,TestIndex,ClassLabels,ClassLabels,FeatureLabels,FeatureLabels,Weights);
+
+        case 'Random Forest'
+            [~,Pc_tmp,ConfusionMatrix_tmp,PLabel_tmp,Sc_tmp] = Test_RandomForest_FFC(DM,Dataset,TestIndex,ClassLabels,ClassLabels,FeatureLabels,FeatureLabels,Weights);
+
+        case 'Ensemble kNN'
+            [~,Pc_tmp,ConfusionMatrix_tmp,PLabel_tmp,Sc_tmp] = Test_EnsemblekNN_FFC(DM,Dataset,TestIndex,...
+                ClassLabels,ClassLabels,FeatureLabels,FeatureLabels,Weights,DM_Index,Prms.SearchEpsilon);
+
+        case 'Naive Bayes'
+            [~,Pc_tmp,ConfusionMatrix_tmp,PLabel_tmp,Sc_tmp] = Test_NaiveBayes_FFC(DM,Dataset,TestIndex,ClassLabels,ClassLabels,FeatureLabels,FeatureLabels,Weights);
+
+        case 'Linear Discriminant Analysis (LDA)'
+            [~,Pc_tmp,ConfusionMatrix_tmp,PLabel_tmp,Sc_tmp] = Test_LDA_FFC(DM,Dataset,TestIndex,ClassLabels,ClassLabels,FeatureLabels,FeatureLabels,Weights);
+
+        case 'Neural Network'
+            [~,Pc_tmp,ConfusionMatrix_tmp,PLabel_tmp,Sc_tmp] = Test_PatternRecognitionNeuralNetwork_FFC(DM,Dataset,TestIndex,ClassLabels,ClassLabels,FeatureLabels,FeatureLabels,Weights);
+    end
+
+    % Test Results
+    Results(n).Pc = Pc_tmp;
+    Results(n).ConfusionMatrix = ConfusionMatrix_tmp;
+    Results(n).PredictedLabels = PLabel_tmp;
+    Results(n).Scores = Sc_tmp;
+
+end
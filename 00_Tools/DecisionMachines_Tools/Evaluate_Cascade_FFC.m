@@ -0,0 +1,66 @@
+function [Pc,MeanCost,StageFraction,PredictedLabel,Stage] = Evaluate_Cascade_FFC(StageScores,TrueLabels,Weights,Thresholds,StageCosts)
+
+% This function evaluates a cascade of decision machines on a set of samples, given the scores of all stages
+% for all samples. A sample leaves the cascade at the first stage whose maximum score is not less than the
+% threshold of the stage.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   StageScores: 1xS cell; StageScores{s} is the LxM matrix of scores of stage s for L samples and M classes
+%   TrueLabels: Lx1 vector of true class labels
+%   Weights: Lx1 vector of sample weights
+%   Thresholds: 1xS vector of thresholds of stages (the threshold of the last stage is ignored)
+%   StageCosts: 1xS vector of costs of stages (the cost of stage s is added for the samples that reach stage s)
+%
+% Outputs:
+%   Pc: Average weighted accuracy of cascade (percent)
+%   MeanCost: Weighted mean cost of cascade per sample
+%   StageFraction: 1xS vector of the weighted fractions of samples that leave the cascade at each stage
+%   PredictedLabel: Lx1 vector of predicted labels
+%   Stage: Lx1 vector of the stages at which the samples leave the cascade
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+S = length(StageScores);
+L = length(TrueLabels);
+PredictedLabel = zeros(L,1);
+Stage = zeros(L,1);
+Remain = true(L,1);
+
+%% Pass samples through stages
+for s=1:S
+    [Confidence,Label] = max(StageScores{s},[],2);
+    if s<S
+        Leave = Remain & Confidence>=Thresholds(s);
+    else
+        Leave = Remain;
+    end
+    PredictedLabel(Leave) = Label(Leave);
+    Stage(Leave) = s;
+    Remain = Remain & ~Leave;
+end
+
+%% Accuracy and cost
+Weights = Weights(:)/sum(Weights);
+Pc = 100*sum(Weights(PredictedLabel==TrueLabels(:)));
+CumulativeCosts = cumsum(StageCosts);
+MeanCost = sum(Weights.*CumulativeCosts(Stage)');
+StageFraction = zeros(1,S);
+for s=1:S
+    StageFraction(s) = sum(Weights(Stage==s));
+end
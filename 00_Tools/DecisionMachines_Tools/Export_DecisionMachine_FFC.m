@@ -0,0 +1,453 @@
+function ErrorMsg = Export_DecisionMachine_FFC(FullFileName,TrainingParameters,DecisionMachine,DecisionMachine_CL,ClassLabels,FeatureLabels,...
+    Function_Handles,Function_Labels,Function_Select,Feature_Transfrom)
+
+% This function exports a trained decision machine together with its feature plan, feature transform,
+% and scaling parameters into a compact binary bundle. The bundle can be scored from the raw bytes of
+% fragments without MATLAB (see Score_DecisionMachine_Bundle_Core_FFC and Classify_Fragments_FFC).
+% Therefore, each function handle of the feature plan must have a native kernel in
+% Score_DecisionMachine_Bundle_Core_FFC; the other function handles are rejected. The function handles
+% with native kernels (and their parallel versions) are BFD_FFC, Byte_Bigram_FFC, RoC_FFC,
+% LongestContiguous_FFC, BinaryRatio_FFC, Entropy_FFC, kolmogorov_FFC, Mean_FFC, StandardDeviation_FFC,
+% LCSSeq2_FFC, LCSStr2_FFC, and Compare_with_Centroids_FFC.
+%
+%   Note: The bundle is written in ieee big-endian format (as the generic binary data format of fragments).
+%   Each string is written as a uint64 length followed by its characters. The bundle includes:
+%       Header: 'FFC-DM02' (8 characters), ModelType, M (number of classes), F0 (number of raw features),
+%           and F (number of features of decision machine) as uint64 values
+%       M class labels and F feature labels as strings
+%       Feature transform: uint64 flag followed by F0xF double matrix Coef (if flag is 1)
+%       Scaling: uint64 flag followed by 1xF double vectors A, B, and Inf_Value (if flag is 1)
+%       Decision machine:
+%           ModelType=1 (LDA): FxM double matrix W and 1xM double vector c; the posterior
+%               probabilities are softmax(c+z*W).
+%           ModelType=2 (Naive Bayes): 1xM double vector LogPrior, and for each class k and feature j
+%               (k is the outer loop) the uint64 grid size G, double values Lo and Hi, and G double values
+%               of log-density on linspace(Lo,Hi,G). The posterior probabilities are
+%               softmax(LogPrior+sum of log-densities).
+%           ModelType=3 (Decision Tree) and ModelType=4 (Random Forest): uint64 number of trees, and
+%               for each tree the uint64 number of nodes N, followed by double vectors CutFeature (0 for leaves),
+%               CutPoint, LeftChild, RightChild (all with length N) and NxM double matrix ClassProbability.
+%               The scores are the average class probabilities of the trees.
+%           ModelType=5 (SVM): For each of M one-against-all binary machines, uint64 Kernel
+%               (1: linear, 2: rbf, 3: polynomial), uint64 nSV, double values PolynomialOrder, KernelScale,
+%               and Bias, 1xF double vectors Mu and Sigma, nSVxF double matrix SupportVectors, and nSVx1
+%               double vector of coefficients (Alpha.*SupportVectorLabels).
+%       Feature plan: The plan is pruned before it is written (see Compile_FeaturePlan_FFC), so that only
+%           the selected features are calculated. It includes
+%           uint64 number of function handles, and for each function handle the expression (string),
+%           uint64 flag of batched handle (the handle takes a cell array of fragments), uint64 number of
+%           outputs followed by the labels (strings) and uint8 selection flags of outputs, uint64 native kernel
+%           and uint64 number of its parameters followed by the parameters (doubles; see FEATURE_* in
+%           Score_DecisionMachine_Bundle_Core_FFC), and uint64 number of captured variables (which are used
+%           by MATLAB). Each captured variable is written as its name (string) and uint64 kind:
+%               1: numeric array (uint64 rows, uint64 columns, doubles)
+%               2: char array (string)
+%               3: cell array of numeric arrays (uint64 rows, uint64 columns, and numeric arrays)
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   FullFileName: The name of the bundle file
+%   TrainingParameters: A structure that specifies the parameters for training (see Load_DecisionMachine_FFC).
+%   DecisionMachine: Decision Machine MATLAB Object
+%   DecisionMachine_CL: Decision Machine MATLAB Object with string class labels
+%   ClassLabels: 1xM cell. Cell contents are strings denoting the name of classes
+%   FeatureLabels: 1xF cell. Cell contents are strings denoting the name of features
+%   Function_Handles: cell array of function handles used for generating dataset.
+%   Function_Labels: Cell array of feature labels used for generating dataset.
+%   Function_Select: Cell array of selected features after feature calculation.
+%   Feature_Transfrom: A structure which determines the feature tranform if it is non-empty.
+%
+% Output:
+%   ErrorMsg: Possible error message. If there is no error, this output is
+%       empty.
+%
+% Revisions:
+% 2026-Oct-18   function was created
+% 2026-Oct-18   feature plan is pruned by Compile_FeaturePlan_FFC
+% 2026-Oct-18   function handles are written as native kernels with numeric parameters (version FFC-DM02)
+
+%% Initialization
+ErrorMsg = '';
+M = length(ClassLabels);
+F = length(FeatureLabels);
+
+%% Type of Decision Machine
+switch TrainingParameters.Type
+    case 'Linear Discriminant Analysis (LDA)'
+        ModelType = 1;
+    case 'Naive Bayes'
+        ModelType = 2;
+    case 'Decision Tree'
+        ModelType = 3;
+    case 'Random Forest'
+        ModelType = 4;
+    case 'SVM'
+        ModelType = 5;
+    otherwise
+        ErrorMsg = sprintf('Decision machines of type "%s" cannot be exported.',TrainingParameters.Type);
+        return;
+end
+
+%% Feature Plan
+if isempty(Function_Handles)
+    ErrorMsg = 'The decision machine does not include any function handle.';
+    return;
+end
+
+% Function handles with no selected output are removed and partial functions are called for the others
+[Function_Handles,Function_Labels,Function_Select] = Compile_FeaturePlan_FFC(Function_Handles,Function_Labels,Function_Select);
+
+NumHandles = length(Function_Handles);
+Plan = struct('Expression',cell(1,NumHandles),'Batched',[],'Labels',[],'Select',[],'Kernel',[],'Params',[],'VarNames',[],'VarValues',[]);
+for i=1:NumHandles
+
+    Plan(i).Expression = func2str(Function_Handles{i});
+    Plan(i).Batched = ~isempty(strfind(Plan(i).Expression,'_Parallel_FFC('));
+    Plan(i).Labels = Function_Labels{i};
+    Plan(i).Select = logical(Function_Select{i});
+
+    % Native kernel
+    [Plan(i).Kernel,Plan(i).Params] = native_kernel(Function_Handles{i});
+    if Plan(i).Kernel==0
+        ErrorMsg = sprintf('Function handle %s has no native kernel and cannot be exported.',Plan(i).Expression);
+        return;
+    end
+    if Plan(i).Kernel<0 || native_outputs(Plan(i).Kernel,Plan(i).Params)~=length(Plan(i).Labels)
+        ErrorMsg = sprintf('The parameters of function handle %s are not supported by its native kernel.',Plan(i).Expression);
+        return;
+    end
+
+    % Captured variables
+    info = functions(Function_Handles{i});
+    ws = struct;
+    if isfield(info,'workspace') && ~isempty(info.workspace)
+        ws = info.workspace{1};
+    end
+    Plan(i).VarNames = fieldnames(ws)';
+    Plan(i).VarValues = struct2cell(ws)';
+    for j=1:length(Plan(i).VarValues)
+        v = Plan(i).VarValues{j};
+        if ~(isnumeric(v) || islogical(v) || ischar(v) || (iscell(v) && all(cellfun(@(c) isnumeric(c) || islogical(c),v(:)))))
+            ErrorMsg = sprintf('Variable "%s" of function handle %s cannot be exported.',Plan(i).VarNames{j},Plan(i).Expression);
+            return;
+        end
+    end
+
+end
+
+F0 = sum(cellfun(@sum,{Plan.Select}));
+if isempty(Feature_Transfrom)
+    Coef = [];
+    if F0~=F
+        ErrorMsg = 'The feature plan and the features of the decision machine are incompatible.';
+        return;
+    end
+else
+    Coef = Feature_Transfrom.Coef;
+    if ~isequal(size(Coef),[F0 F])
+        ErrorMsg = 'The feature plan, the feature transform, and the features of the decision machine are incompatible.';
+        return;
+    end
+end
+
+%% Scaling
+Scaling_Parameters = [];
+if isfield(TrainingParameters,'Scaling_Parameters') && ModelType~=3 && ModelType~=4
+    Scaling_Parameters = TrainingParameters.Scaling_Parameters;
+end
+
+%% Open File
+fid = fopen(FullFileName,'w');
+if fid==-1
+    ErrorMsg = sprintf('File %s cannot be opened for writing.',FullFileName);
+    return;
+end
+
+%% Header
+fwrite(fid,'FFC-DM02','char');
+write_uint64(fid,[ModelType M F0 F]);
+for k=1:M
+    write_string(fid,ClassLabels{k});
+end
+for j=1:F
+    write_string(fid,FeatureLabels{j});
+end
+
+write_uint64(fid,~isempty(Coef));
+write_double(fid,Coef);
+
+write_uint64(fid,~isempty(Scaling_Parameters));
+if ~isempty(Scaling_Parameters)
+    write_double(fid,Scaling_Parameters.A);
+    write_double(fid,Scaling_Parameters.B);
+    write_double(fid,Scaling_Parameters.Inf_Value);
+end
+
+%% Decision Machine
+switch ModelType
+
+    case 1 % LDA with string class labels
+
+        LDA = DecisionMachine_CL;
+        [~,idx] = ismember(ClassLabels,LDA.ClassNames);
+        S = pinv(LDA.Sigma);
+        W = zeros(F,M);
+        c = -inf(1,M);
+        for k=find(idx)
+            mu = LDA.Mu(idx(k),:);
+            W(:,k) = S*mu';
+            c(k) = -0.5*mu*S*mu'+log(LDA.Prior(idx(k)));
+        end
+        write_double(fid,W);
+        write_double(fid,c);
+
+    case 2 % Naive Bayes with integer-valued class labels
+
+        NaiveBayes = DecisionMachine;
+        LogPrior = -inf(1,M);
+        for k=1:M
+            r = find(NaiveBayes.ClassNames==k);
+            if ~isempty(r)
+                LogPrior(k) = log(NaiveBayes.Prior(r));
+            end
+        end
+        write_double(fid,LogPrior);
+
+        for k=1:M
+            r = find(NaiveBayes.ClassNames==k);
+            for j=1:F
+                if isempty(r)
+                    write_uint64(fid,2);
+                    write_double(fid,[0 1 0 0]);
+                    continue;
+                end
+
+                % Sample the kernel density on a grid with a step of at most a quarter of bandwidth
+                pd = NaiveBayes.DistributionParameters{r,j};
+                x = pd.InputData.data;
+                h = pd.BandWidth;
+                Lo = min(x)-5*h;
+                Hi = max(x)+5*h;
+                G = min(max(ceil(4*(Hi-Lo)/h)+1,64),4096);
+                LogPDF = log(max(pdf(pd,linspace(Lo,Hi,G)),realmin));
+
+                write_uint64(fid,G);
+                write_double(fid,[Lo Hi LogPDF(:)']);
+            end
+        end
+
+    case {3,4} % Decision tree with integer-valued class labels or random forest with string class labels
+
+        if ModelType==3
+            Trees = {DecisionMachine};
+            [~,idx] = ismember(1:M,DecisionMachine.ClassNames);
+        else
+            Trees = DecisionMachine_CL.Trees;
+            [~,idx] = ismember(ClassLabels,DecisionMachine_CL.ClassNames);
+        end
+
+        [CutFeature,CutPoint,Children,ClassProbability,NumNodes] = Flatten_TreeEnsemble_FFC(Trees,idx);
+        write_uint64(fid,length(Trees));
+        n0 = 0;
+        for t=1:length(Trees)
+            n = n0+(1:NumNodes(t));
+            write_uint64(fid,NumNodes(t));
+            write_double(fid,[CutFeature(n)' CutPoint(n)' Children(n,1)' Children(n,2)' reshape(ClassProbability(n,:),1,[])]);
+            n0 = n0+NumNodes(t);
+        end
+
+    case 5 % M one-against-all binary SVMs
+
+        for k=1:M
+            SVMModel = DecisionMachine{k};
+
+            switch SVMModel.KernelParameters.Function
+                case 'linear'
+                    Kernel = 1;
+                case {'rbf','gaussian'}
+                    Kernel = 2;
+                case 'polynomial'
+                    Kernel = 3;
+            end
+            Order = 0;
+            if Kernel==3
+                Order = SVMModel.KernelParameters.Order;
+            end
+            Scale = SVMModel.KernelParameters.Scale;
+
+            Mu = zeros(1,F);
+            Sigma = ones(1,F);
+            if ~isempty(SVMModel.Mu)
+                Mu = SVMModel.Mu;
+                Sigma = SVMModel.Sigma;
+            end
+
+            % Linear machines are written as a single support vector Beta*KernelScale
+            if Kernel==1 && ~isempty(SVMModel.Beta)
+                SV = SVMModel.Beta(:)'*Scale;
+                SVCoef = 1;
+            else
+                SV = SVMModel.SupportVectors;
+                SVCoef = SVMModel.Alpha.*SVMModel.SupportVectorLabels;
+            end
+
+            write_uint64(fid,[Kernel size(SV,1)]);
+            write_double(fid,[Order Scale SVMModel.Bias Mu(:)' Sigma(:)' SV(:)' SVCoef(:)']);
+        end
+
+end
+
+%% Feature Plan
+write_uint64(fid,NumHandles);
+for i=1:NumHandles
+    write_string(fid,Plan(i).Expression);
+    write_uint64(fid,[Plan(i).Batched length(Plan(i).Labels)]);
+    for j=1:length(Plan(i).Labels)
+        write_string(fid,Plan(i).Labels{j});
+    end
+    fwrite(fid,uint8(Plan(i).Select),'uint8');
+    write_uint64(fid,[Plan(i).Kernel length(Plan(i).Params)]);
+    write_double(fid,Plan(i).Params);
+
+    write_uint64(fid,length(Plan(i).VarNames));
+    for j=1:length(Plan(i).VarNames)
+        write_string(fid,Plan(i).VarNames{j});
+        v = Plan(i).VarValues{j};
+        if ischar(v)
+            write_uint64(fid,2);
+            write_string(fid,v);
+        elseif iscell(v)
+            write_uint64(fid,[3 size(v)]);
+            for n=1:numel(v)
+                write_uint64(fid,size(v{n}));
+                write_double(fid,double(v{n}));
+            end
+        else
+            write_uint64(fid,[1 size(v)]);
+            write_double(fid,double(v));
+        end
+    end
+end
+
+fclose(fid);
+
+%% Native kernel of a function handle
+function [Kernel,Params] = native_kernel(Handle)
+
+% Kernel is 0 if the function handle has no native kernel and -1 if its variables are not supported.
+% The handle must be a call of a function whose arguments (except the fragment) are captured variables.
+Kernel = 0;
+Params = [];
+tok = regexp(func2str(Handle),'^@\((\w+)\)\s*(\w+)\((.*)\)$','tokens','once');
+if isempty(tok)
+    return;
+end
+Args = strtrim(strsplit(tok{3},','));
+info = functions(Handle);
+ws = struct;
+if isfield(info,'workspace') && ~isempty(info.workspace)
+    ws = info.workspace{1};
+end
+if ~strcmp(Args{1},tok{1}) || ~all(isfield(ws,Args(2:end)))
+    return;
+end
+Vars = cellfun(@(v) ws.(v),Args(2:end),'UniformOutput',false);
+NumVars = length(Vars);
+
+% The parallel versions have the same kernels (see FEATURE_* in Score_DecisionMachine_Bundle_Core_FFC)
+Names = {'BFD_FFC','Byte_Bigram_FFC','RoC_FFC','LongestContiguous_FFC','BinaryRatio_FFC','Entropy_FFC',...
+    'kolmogorov_FFC','Mean_FFC','StandardDeviation_FFC','LCSSeq2_FFC','LCSStr2_FFC','Compare_with_Centroids_FFC'};
+MaxVars = [1 1 0 0 0 0 0 0 0 2 2 2];
+[~,Kernel] = ismember(regexprep(tok{2},'_Parallel_FFC$','_FFC'),Names);
+if Kernel==0 || NumVars>MaxVars(Kernel)
+    Kernel = 0;
+    return;
+end
+
+is_byte = @(x) isnumeric(x) && all(x(:)>=0 & x(:)<=255 & x(:)==round(x(:)));
+switch Kernel
+    case 1 % BFD_FFC: [Full from_1 to_1 ... from_R to_R]
+        Range = Vars{1};
+        if ~iscell(Range) || ~all(cellfun(@(r) ~isempty(r) && is_byte(r),Range(:)))
+            Kernel = -1;
+            return;
+        end
+        Params = [isequal(Range,num2cell(0:255)) reshape(cell2mat(cellfun(@(r) double([r(1) r(end)]),Range(:),'UniformOutput',false))',1,[])];
+
+    case 2 % Byte_Bigram_FFC: [Bigrams]
+        if NumVars==1
+            Bigrams = Vars{1};
+            if ~isnumeric(Bigrams) || isempty(Bigrams) || ~all(Bigrams(:)>=0 & Bigrams(:)<=65535 & Bigrams(:)==round(Bigrams(:)))
+                Kernel = -1;
+                return;
+            end
+            Params = double(Bigrams(:)');
+        end
+
+    case {10,11} % LCSSeq2_FFC and LCSStr2_FFC: [Band NumReps length_1 bytes_1 ...]
+        Reps = Vars{1};
+        Band = Inf;
+        if NumVars==2
+            Band = Vars{2};
+        end
+        if ~iscell(Reps) || isempty(Reps) || ~all(cellfun(@(r) ~isempty(r) && is_byte(r),Reps(:))) || ...
+                ~isscalar(Band) || ~(isinf(Band) || (Band>=0 && Band==round(Band)))
+            Kernel = -1;
+            return;
+        end
+        if isinf(Band)
+            Band = -1;
+        end
+        Params = [Band length(Reps) cell2mat(cellfun(@(r) [length(r) double(r(:)')],Reps(:)','UniformOutput',false))];
+
+    case 12 % Compare_with_Centroids_FFC: [K centroids_mu(Kx256) centroids_sigma(Kx256)]
+        if NumVars~=2 || size(Vars{1},2)~=256 || ~isequal(size(Vars{1}),size(Vars{2}))
+            Kernel = -1;
+            return;
+        end
+        Params = [size(Vars{1},1) reshape(double(Vars{1})',1,[]) reshape(double(Vars{2})',1,[])];
+
+end
+
+%% Number of outputs of a native kernel
+function NumOutputs = native_outputs(Kernel,Params)
+
+switch Kernel
+    case 1
+        NumOutputs = (length(Params)-1)/2+4*Params(1);
+    case 2
+        NumOutputs = length(Params)+65536*isempty(Params);
+    case 3
+        NumOutputs = 257;
+    case 6
+        NumOutputs = 2;
+    case 8
+        NumOutputs = 3;
+    case 12
+        NumOutputs = 2*Params(1);
+    otherwise
+        NumOutputs = 1;
+end
+
+function write_uint64(fid,x)
+fwrite(fid,double(x),'uint64',0,'b');
+
+function write_double(fid,x)
+fwrite(fid,x(:),'double',0,'b');
+
+function write_string(fid,str)
+write_uint64(fid,length(str));
+fwrite(fid,str,'char');
@@ -0,0 +1,66 @@
+function [CutFeature,CutPoint,Children,ClassProbability,NumNodes] = Flatten_TreeEnsemble_FFC(Trees,idx)
+
+% This function flattens the nodes of a set of classification trees into arrays. The nodes of
+% trees appear consecutively in the outputs (see Score_TreeEnsemble_Core_FFC).
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Trees: Cell array of T classification trees (e.g. a decision tree in a cell, or the Trees property of TreeBagger)
+%   idx: 1xM vector that maps the columns of output class probabilities to the classes of trees;
+%       the k-th column corresponds to Trees{t}.ClassNames(idx(k)). If idx(k) is 0, the k-th column is zero.
+%
+% Outputs:
+%   CutFeature: Nx1 vector of cut features (index of predictors) of the nodes of all trees (0 for leaves)
+%   CutPoint: Nx1 vector of cut points (0 for leaves)
+%   Children: Nx2 matrix of the left and right children of nodes (indices of nodes within their trees)
+%   ClassProbability: NxM matrix of class probabilities of nodes
+%   NumNodes: Tx1 vector of the number of nodes of trees
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+T = length(Trees);
+M = length(idx);
+NumNodes = zeros(T,1);
+for t=1:T
+    NumNodes(t) = length(Trees{t}.CutPoint);
+end
+N = sum(NumNodes);
+
+CutFeature = zeros(N,1);
+CutPoint = zeros(N,1);
+Children = zeros(N,2);
+ClassProbability = zeros(N,M);
+
+%% Flatten Trees
+n0 = 0;
+for t=1:T
+    Tree = Trees{t};
+    n = n0+(1:NumNodes(t));
+
+    [~,cf] = ismember(Tree.CutPredictor,Tree.PredictorNames);
+    cf(~Tree.IsBranchNode) = 0;
+    cp = Tree.CutPoint;
+    cp(~Tree.IsBranchNode) = 0;
+
+    CutFeature(n) = cf;
+    CutPoint(n) = cp;
+    Children(n,:) = Tree.Children;
+    ClassProbability(n,idx>0) = Tree.ClassProbability(:,idx(idx>0));
+
+    n0 = n0+NumNodes(t);
+end
@@ -0,0 +1,63 @@
+function [Cascade,ErrorMsg] = Load_Cascade_FFC(FullFileName)
+
+% This function loads a cascade of decision machine bundles which is saved by Script_Cascade_DecisionMachine_Train_FFC.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Input:
+%   FullFileName: The name of the cascade file (*.mat)
+%
+% Outputs:
+%   Cascade: A structure with the following fields
+%       ClassLabels: 1xM cell of class labels
+%       StageFiles: 1xS cell of the names of the bundle files of stages (in the folder of cascade file)
+%       Stages: 1xS cell; Stages{s} is the indices of the function handles of dataset which are added in stage s
+%       StageCosts: 1xS vector of the costs of the feature groups of stages
+%       Thresholds: 1xS vector of the thresholds of stages (the last one is not used)
+%       TradeOff: A structure of the accuracy versus mean cost of cascade on held-out validation data
+%       Bundles: 1xS cell of the loaded bundles (see Load_DecisionMachine_Bundle_FFC)
+%   ErrorMsg: Possible error message. If there is no error, this output is
+%       empty.
+%
+% Revisions:
+% 2026-Oct-18   function was created
+% 2026-Oct-18   TradeOff is evaluated on held-out validation data (see Script_Cascade_DecisionMachine_Train_FFC)
+
+%% Initialization
+Cascade = [];
+ErrorMsg = '';
+
+%% Load cascade file
+try
+    tmp = load(FullFileName,'Cascade');
+    Cascade = tmp.Cascade;
+catch
+    Cascade = [];
+    ErrorMsg = sprintf('File %s is not a cascade of decision machines.',FullFileName);
+    return;
+end
+
+%% Load bundles of stages
+path = fileparts(FullFileName);
+S = length(Cascade.StageFiles);
+Cascade.Bundles = cell(1,S);
+for s=1:S
+    [Cascade.Bundles{s},ErrorMsg] = Load_DecisionMachine_Bundle_FFC(fullfile(path,Cascade.StageFiles{s}));
+    if ~isempty(ErrorMsg)
+        Cascade = [];
+        ErrorMsg = sprintf('Stage %d of cascade cannot be loaded. %s',s,ErrorMsg);
+        return;
+    end
+end
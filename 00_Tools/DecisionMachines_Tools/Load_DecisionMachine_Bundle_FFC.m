@@ -0,0 +1,222 @@
+function [Bundle,ErrorMsg] = Load_DecisionMachine_Bundle_FFC(FullFileName)
+
+% This function loads a decision machine bundle which is exported by Export_DecisionMachine_FFC.
+% The function handles of the feature plan are rebuilt from their expressions and captured variables.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Input:
+%   FullFileName: The name of the bundle file
+%
+% Outputs:
+%   Bundle: A structure with the following fields
+%       Filename: The name of the bundle file
+%       ModelType: Type of decision machine (see Export_DecisionMachine_FFC)
+%       ClassLabels: 1xM cell of class labels
+%       FeatureLabels: 1xF cell of feature labels
+%       Coef: F0xF feature transform (empty if there is no transform)
+%       Scaling_Parameters: Scaling parameters (empty if there is no scaling)
+%       Model: A structure that contains the parameters of decision machine
+%       Plan: A structure array with fields Handle, Expression, Batched, Labels, Select, Kernel, and Params
+%           (Kernel and Params are the native kernel and its parameters, Kernel is 0 for bundles of
+%           version FFC-DM01)
+%       F0: Number of raw features
+%   ErrorMsg: Possible error message. If there is no error, this output is
+%       empty.
+%
+% Revisions:
+% 2026-Oct-18   function was created
+% 2026-Oct-18   native kernels of the feature plan are read (version FFC-DM02)
+
+%% Initialization
+Bundle = [];
+ErrorMsg = '';
+
+fid = fopen(FullFileName,'r');
+if fid==-1
+    ErrorMsg = sprintf('File %s cannot be opened.',FullFileName);
+    return;
+end
+
+%% Read Bundle
+try
+
+    % Header
+    Version = find(strcmp(fread(fid,[1 8],'char=>char'),{'FFC-DM01','FFC-DM02'}));
+    if isempty(Version)
+        error('Invalid header');
+    end
+    h = read_uint64(fid,4);
+    ModelType = h(1);
+    M = h(2);
+    F0 = h(3);
+    F = h(4);
+
+    ClassLabels = cell(1,M);
+    for k=1:M
+        ClassLabels{k} = read_string(fid);
+    end
+    FeatureLabels = cell(1,F);
+    for j=1:F
+        FeatureLabels{j} = read_string(fid);
+    end
+
+    % Feature transform and scaling
+    Coef = [];
+    if read_uint64(fid,1)
+        Coef = reshape(read_double(fid,F0*F),F0,F);
+    end
+    Scaling_Parameters = [];
+    if read_uint64(fid,1)
+        Scaling_Parameters.A = read_double(fid,F)';
+        Scaling_Parameters.B = read_double(fid,F)';
+        Scaling_Parameters.Inf_Value = read_double(fid,F)';
+    end
+
+    % Decision machine
+    Model = struct;
+    switch ModelType
+        case 1 % LDA
+            Model.W = reshape(read_double(fid,F*M),F,M);
+            Model.c = read_double(fid,M)';
+
+        case 2 % Naive Bayes
+            Model.LogPrior = read_double(fid,M)';
+            Model.Grid = cell(M,F);
+            Model.LogPDF = cell(M,F);
+            for k=1:M
+                for j=1:F
+                    G = read_uint64(fid,1);
+                    LoHi = read_double(fid,2);
+                    Model.Grid{k,j} = linspace(LoHi(1),LoHi(2),G);
+                    Model.LogPDF{k,j} = read_double(fid,G)';
+                end
+            end
+
+        case {3,4} % Decision Tree and Random Forest
+            NumTrees = read_uint64(fid,1);
+            Model.Trees = cell(1,NumTrees);
+            for t=1:NumTrees
+                N = read_uint64(fid,1);
+                x = read_double(fid,N*(4+M));
+                Model.Trees{t}.CutFeature = x(1:N);
+                Model.Trees{t}.CutPoint = x(N+1:2*N);
+                Model.Trees{t}.Children = [x(2*N+1:3*N) x(3*N+1:4*N)];
+                Model.Trees{t}.ClassProbability = reshape(x(4*N+1:end),N,M);
+            end
+
+        case 5 % SVM
+            Model.SVM = cell(1,M);
+            for k=1:M
+                h = read_uint64(fid,2);
+                x = read_double(fid,3+2*F+h(2)*(F+1));
+                Model.SVM{k}.Kernel = h(1);
+                Model.SVM{k}.Order = x(1);
+                Model.SVM{k}.Scale = x(2);
+                Model.SVM{k}.Bias = x(3);
+                Model.SVM{k}.Mu = x(4:3+F)';
+                Model.SVM{k}.Sigma = x(4+F:3+2*F)';
+                Model.SVM{k}.SupportVectors = reshape(x(4+2*F:3+2*F+h(2)*F),h(2),F);
+                Model.SVM{k}.Coef = x(4+2*F+h(2)*F:end);
+            end
+
+        otherwise
+            error('Invalid model type');
+    end
+
+    % Feature plan
+    NumHandles = read_uint64(fid,1);
+    Plan = struct('Handle',cell(1,NumHandles),'Expression',[],'Batched',[],'Labels',[],'Select',[],'Kernel',0,'Params',[]);
+    for i=1:NumHandles
+        Plan(i).Expression = read_string(fid);
+        h = read_uint64(fid,2);
+        Plan(i).Batched = logical(h(1));
+        Plan(i).Labels = cell(1,h(2));
+        for j=1:h(2)
+            Plan(i).Labels{j} = read_string(fid);
+        end
+        Plan(i).Select = logical(fread(fid,[1 h(2)],'uint8=>double'));
+        if Version>=2
+            h = read_uint64(fid,2);
+            Plan(i).Kernel = h(1);
+            Plan(i).Params = read_double(fid,h(2))';
+        end
+
+        NumVars = read_uint64(fid,1);
+        VarNames = cell(1,NumVars);
+        VarValues = cell(1,NumVars);
+        for j=1:NumVars
+            VarNames{j} = read_string(fid);
+            switch read_uint64(fid,1)
+                case 1
+                    sz = read_uint64(fid,2)';
+                    VarValues{j} = reshape(read_double(fid,prod(sz)),sz);
+                case 2
+                    VarValues{j} = read_string(fid);
+                case 3
+                    sz = read_uint64(fid,2)';
+                    VarValues{j} = cell(sz);
+                    for n=1:prod(sz)
+                        sz_n = read_uint64(fid,2)';
+                        VarValues{j}{n} = reshape(read_double(fid,prod(sz_n)),sz_n);
+                    end
+            end
+        end
+        Plan(i).Handle = Make_Handle(Plan(i).Expression,VarNames,VarValues);
+    end
+
+catch
+    fclose(fid);
+    ErrorMsg = sprintf('File %s is not a valid decision machine bundle.',FullFileName);
+    return;
+end
+fclose(fid);
+
+%% Set Output
+Bundle.Filename = FullFileName;
+Bundle.ModelType = ModelType;
+Bundle.ClassLabels = ClassLabels;
+Bundle.FeatureLabels = FeatureLabels;
+Bundle.Coef = Coef;
+Bundle.Scaling_Parameters = Scaling_Parameters;
+Bundle.Model = Model;
+Bundle.Plan = Plan;
+Bundle.F0 = F0;
+
+function x = read_uint64(fid,n)
+x = fread(fid,n,'uint64=>double',0,'b');
+if length(x)~=n
+    error('Unexpected end of file');
+end
+
+function x = read_double(fid,n)
+x = fread(fid,n,'double=>double',0,'b');
+if length(x)~=n
+    error('Unexpected end of file');
+end
+
+function str = read_string(fid)
+n = read_uint64(fid,1);
+str = fread(fid,[1 n],'char=>char');
+if length(str)~=n
+    error('Unexpected end of file');
+end
+
+function Handle__ = Make_Handle(Expression__,VarNames__,VarValues__)
+% The captured variables are defined in this workspace before the handle is built.
+for i__=1:length(VarNames__)
+    eval([VarNames__{i__} ' = VarValues__{i__};']);
+end
+Handle__ = eval(Expression__);
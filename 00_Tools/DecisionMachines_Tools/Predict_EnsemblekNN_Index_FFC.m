@@ -0,0 +1,58 @@
+function [PredictedLabel,Scores] = Predict_EnsemblekNN_Index_FFC(EnsemblekNN,kNNIndex,X,Epsilon)
+
+% This function predicts the classes of samples with an ensemble kNN, where the nearest neighbors
+% are found with the index of learners (see Build_EnsemblekNN_Index_FFC). The scores are the
+% weighted fractions of the classes among the nearest neighbors averaged over learners, which are
+% the same as the scores of predict for the ensemble kNN.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   EnsemblekNN: Trained ensemble kNN
+%   kNNIndex: Index of the learners of EnsemblekNN
+%   X: LxF matrix of the features of L samples
+%   Epsilon: Relative error bound of the nearest neighbor search (0 for exact search).
+%       Larger values give faster and less accurate searches.
+%
+% Outputs:
+%   PredictedLabel: Lx1 vector of predicted labels (indices of EnsemblekNN.ClassNames)
+%   Scores: LxM matrix of scores for M classes of EnsemblekNN.ClassNames
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+L = size(X,1);
+M = length(EnsemblekNN.ClassNames);
+N = length(kNNIndex.Y);
+T = size(kNNIndex.Features,2);
+Scores = zeros(L,M);
+
+%% Score the samples with each learner
+for t=1:T
+    f = kNNIndex.Features(:,t);
+    K = min(kNNIndex.NumNeighbors(t),N);
+    Idx = kNN_VPTree_Core_FFC(EnsemblekNN.X(:,f),kNNIndex.Perm{t},kNNIndex.Radius{t},X(:,f),K,Epsilon);
+    Yn = reshape(kNNIndex.Y(Idx),L,K);
+    Wn = reshape(kNNIndex.W(Idx),L,K);
+
+    P = zeros(L,M);
+    for k=1:M
+        P(:,k) = sum(Wn.*(Yn==k),2);
+    end
+    Scores = Scores+P./sum(Wn,2);
+end
+Scores = Scores/T;
+[~,PredictedLabel] = max(Scores,[],2);
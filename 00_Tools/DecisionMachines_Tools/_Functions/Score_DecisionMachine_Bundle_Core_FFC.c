@@ -0,0 +1,1541 @@
+/* This c-mex function loads a decision machine bundle which is exported by Export_DecisionMachine_FFC
+ * and scores a batch of fragments, from their raw bytes or from their raw (selected) features. The feature
+ * plan, the feature transform, the scaling of features and the decision machine itself are evaluated natively:
+ *   - The bundle is loaded once and kept in memory. It is loaded again only if another bundle is given
+ *       or the bundle file is modified.
+ *   - Each function handle of the feature plan is evaluated by its native kernel (see FEATURE_* below),
+ *       which gives the same outputs as the MATLAB function.
+ *   - The fragments are scored in parallel (if OpenMP is available).
+ *
+ * The scoring routines (load_bundle, create_workspace, compute_features, score_sample) only depend on the
+ * C standard library, so that they can also be used outside MATLAB (e.g. in carving or DPI pipelines) by
+ * removing mexFunction. A fragment is classified by compute_features followed by score_sample.
+ *
+ * Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+ *
+ * This file is a part of Fragments-Expert software, a software package for
+ * feature extraction from file fragments and classification among various file formats.
+ *
+ * Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Usage method: [PredictedLabel,Scores,Features] = Score_DecisionMachine_Bundle_Core_FFC(BundleFile,Fragments,Features1);
+ *               [PredictedLabel,Scores] = Score_DecisionMachine_Bundle_Core_FFC(BundleFile,Features);
+ *
+ * Inputs:
+ *  BundleFile: The name of the decision machine bundle file (see Export_DecisionMachine_FFC for its format)
+ *  Fragments: Cell array with length L consisting of vectors of byte values (uint8 or double)
+ *  Features1: (optional) LxF1 matrix of raw features of the first function handles of the feature plan,
+ *      which are already calculated (see Classify_Fragments_FFC)
+ *  Features: LxF0 matrix of raw features for L fragments. The columns are the selected outputs of the
+ *      feature plan in the bundle (i.e. before the feature transform).
+ *
+ * Outputs:
+ *  PredictedLabel: Lx1 vector of predicted labels (indices of class labels in the bundle)
+ *  Scores: LxM matrix of scores for M classes
+ *  Features: LxF0 matrix of raw features of the fragments
+ *
+ * Compilation (OpenMP is optional):
+ *  mex -O COMPFLAGS="$COMPFLAGS /openmp" Score_DecisionMachine_Bundle_Core_FFC.c              (Windows, MSVC)
+ *  mex -O CFLAGS="$CFLAGS -fopenmp" LDFLAGS="$LDFLAGS -fopenmp" Score_DecisionMachine_Bundle_Core_FFC.c  (GCC)
+ *
+ * Revisions:
+ * 2026-Oct-18   function was created
+ * 2026-Oct-18   the feature plan is evaluated natively from the raw bytes of fragments
+ */
+
+#include "mex.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <sys/stat.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Types of decision machines */
+#define MODEL_LDA           1
+#define MODEL_NAIVEBAYES    2
+#define MODEL_DECISIONTREE  3
+#define MODEL_RANDOMFOREST  4
+#define MODEL_SVM           5
+
+/* Kernels of SVM */
+#define KERNEL_LINEAR       1
+#define KERNEL_RBF          2
+#define KERNEL_POLYNOMIAL   3
+
+/* Native kernels of the function handles of the feature plan (the parameters are given in brackets) */
+#define FEATURE_BFD                 1   /* BFD_FFC [Full from_1 to_1 ... from_R to_R] */
+#define FEATURE_BYTE_BIGRAM         2   /* Byte_Bigram_FFC [Bigrams] (all bigrams if there is no parameter) */
+#define FEATURE_ROC                 3   /* RoC_FFC */
+#define FEATURE_LONGESTCONTIGUOUS   4   /* LongestContiguous_FFC */
+#define FEATURE_BINARYRATIO         5   /* BinaryRatio_FFC */
+#define FEATURE_ENTROPY             6   /* Entropy_FFC */
+#define FEATURE_KOLMOGOROV          7   /* kolmogorov_FFC */
+#define FEATURE_MEAN                8   /* Mean_FFC */
+#define FEATURE_STANDARDDEVIATION   9   /* StandardDeviation_FFC */
+#define FEATURE_LCSSEQ2             10  /* LCSSeq2_FFC [Band NumReps length_1 bytes_1 ... ] (Band=-1 for Inf) */
+#define FEATURE_LCSSTR2             11  /* LCSStr2_FFC [Band NumReps length_1 bytes_1 ... ] (Band=-1 for Inf) */
+#define FEATURE_CENTROIDS           12  /* Compare_with_Centroids_FFC [K centroids_mu(Kx256) centroids_sigma(Kx256)] */
+
+/* A function handle of the feature plan */
+typedef struct
+{
+    int Kernel;             /* Native kernel (FEATURE_*) */
+    int NumOutputs;         /* Number of outputs of the function handle */
+    int NumSelected;        /* Number of selected outputs */
+    unsigned char *Select;  /* Selection flags of outputs */
+    int NumParams;
+    double *Params;         /* Parameters of the kernel */
+
+    /* LCSSeq2 and LCSStr2: representative fragment j is Reps+RepOff[j] with length RepLen[j] */
+    int Band;               /* -1 for the exact mode */
+    int NumReps;
+    unsigned char *Reps;
+    size_t *RepOff;
+    int *RepLen;
+
+    /* Compare_with_Centroids: norms of centroids_mu */
+    double *Norm;
+} plan_handle;
+
+/* A packed node of trees */
+typedef struct
+{
+    double CutPoint;
+    int CutFeature;     /* 0-based feature index (-1 for leaves) */
+    int Child;          /* Index of the left child (the right child is Child+1) */
+} tree_node;
+
+/* A loaded decision machine bundle */
+typedef struct
+{
+    int Type;           /* Type of decision machine */
+    int M;              /* Number of classes */
+    int F0;             /* Number of raw features */
+    int F;              /* Number of features of decision machine */
+
+    double *Coef;       /* F0xF feature transform (NULL if there is no transform) */
+    double *A,*B,*InfValue; /* Scaling parameters (NULL if there is no scaling) */
+
+    /* LDA: s_k = c_k + z*W(:,k) */
+    double *W,*c;
+
+    /* Naive Bayes: s_k = LogPrior_k + sum_j LogPDF_kj(z_j), LogPDF_kj is sampled on a uniform grid */
+    double *LogPrior;
+    int *G;             /* Grid size for each (k,j), index k*F+j */
+    double *Lo,*Step;
+    double **LogPDF;
+
+    /* Decision Tree and Random Forest: all nodes of all trees */
+    int NumTrees;
+    int *Root;
+    tree_node *Nodes;
+    double *ClassProb;  /* NumNodesxM, index node*M+k */
+
+    /* SVM: M binary one-against-all machines */
+    int *Kernel,*nSV;
+    double *Order,*Scale,*Bias;
+    double **Mu,**Sigma,**SV,**SVCoef;  /* SV{k} is nSVxF, index i*F+j */
+
+    /* Feature plan (NumHandles is 0 for bundles of version FFC-DM01) */
+    int NumHandles;
+    plan_handle *Plan;
+    int MaxOutputs;     /* Maximum number of outputs of function handles */
+    int UseBigrams;     /* Whether the plan includes Byte_Bigram_FFC */
+} bundle;
+
+/* Scratch buffers of a thread */
+typedef struct
+{
+    double *z;          /* Scratch of score_sample (length 2F+M) */
+    double *out;        /* Outputs of a function handle (length MaxOutputs) */
+    int *bigram;        /* Counts of bigrams (all-zero on entry and on return of kernel_bigram) */
+    double HNu_n, HNu;  /* Expected entropy of Entropy_FFC for the last fragment length */
+    uint64_t *pm,*v;    /* Bit-parallel LCSSeq */
+    int *rows;          /* LCSStr */
+    unsigned char *bytes; /* Bytes of a fragment which is given as double values */
+    size_t pm_cap,v_cap,rows_cap,bytes_cap;
+} workspace;
+
+/* The cached bundle */
+static bundle *Cached = NULL;
+static char *CachedName = NULL;
+static time_t CachedTime;
+static long long CachedSize;
+
+/* ---------------------------------------- Reading Bundle ---------------------------------------- */
+
+/* Read an ieee big-endian uint64 value */
+static int read_uint64(FILE *fid,uint64_t *v)
+{
+    unsigned char buf[8];
+    int i;
+    if (fread(buf,1,8,fid)!=8)
+        return 0;
+    *v = 0;
+    for (i=0;i<8;i++)
+        *v = (*v<<8)|buf[i];
+    return 1;
+}
+
+static int read_int(FILE *fid,int *v)
+{
+    uint64_t u;
+    if (!read_uint64(fid,&u) || u>0x7FFFFFFF)
+        return 0;
+    *v = (int) u;
+    return 1;
+}
+
+/* Read n ieee big-endian doubles into a newly allocated array */
+static double *read_doubles(FILE *fid,size_t n)
+{
+    double *x = (double*) malloc((n>0?n:1)*sizeof(double));
+    uint64_t u;
+    size_t i;
+    if (x==NULL)
+        return NULL;
+    for (i=0;i<n;i++)
+    {
+        if (!read_uint64(fid,&u))
+        {
+            free(x);
+            return NULL;
+        }
+        memcpy(&x[i],&u,8);
+    }
+    return x;
+}
+
+/* Skip a string (uint64 length followed by characters) */
+static int skip_string(FILE *fid)
+{
+    uint64_t n;
+    if (!read_uint64(fid,&n))
+        return 0;
+    return fseek(fid,(long)n,SEEK_CUR)==0;
+}
+
+static void free_bundle(bundle *b)
+{
+    int k;
+    if (b==NULL)
+        return;
+    free(b->Coef); free(b->A); free(b->B); free(b->InfValue);
+    free(b->W); free(b->c);
+    if (b->LogPDF!=NULL)
+        for (k=0;k<b->M*b->F;k++)
+            free(b->LogPDF[k]);
+    free(b->LogPrior); free(b->G); free(b->Lo); free(b->Step); free(b->LogPDF);
+    free(b->Root); free(b->Nodes); free(b->ClassProb);
+    if (b->SV!=NULL)
+        for (k=0;k<b->M;k++)
+        {
+            free(b->Mu[k]); free(b->Sigma[k]); free(b->SV[k]); free(b->SVCoef[k]);
+        }
+    free(b->Kernel); free(b->nSV); free(b->Order); free(b->Scale); free(b->Bias);
+    free(b->Mu); free(b->Sigma); free(b->SV); free(b->SVCoef);
+    if (b->Plan!=NULL)
+        for (k=0;k<b->NumHandles;k++)
+        {
+            plan_handle *h = b->Plan+k;
+            free(h->Select); free(h->Params); free(h->Reps); free(h->RepOff); free(h->RepLen); free(h->Norm);
+        }
+    free(b->Plan);
+    free(b);
+}
+
+/* Read the trees of Decision Tree and Random Forest. The nodes of each tree are stored in breadth-first
+ * order, so that the children of a node are next to each other. */
+static int read_trees(FILE *fid,bundle *b)
+{
+    int t,n,i,u,l,r,head,tail,NumNodes,Total,valid,M = b->M;
+    double *cf,*cp,*lc,*rc,*pr;
+    int *order,*newidx;
+    long start;
+
+    if (!read_int(fid,&b->NumTrees) || b->NumTrees<1)
+        return 0;
+    b->Root = (int*) malloc(b->NumTrees*sizeof(int));
+
+    /* Count nodes */
+    start = ftell(fid);
+    Total = 0;
+    for (t=0;t<b->NumTrees;t++)
+    {
+        if (!read_int(fid,&NumNodes) || NumNodes<1)
+            return 0;
+        Total += NumNodes;
+        if (fseek(fid,(long)(8*(size_t)NumNodes*(4+M)),SEEK_CUR)!=0)
+            return 0;
+    }
+    fseek(fid,start,SEEK_SET);
+
+    b->Nodes = (tree_node*) malloc(Total*sizeof(tree_node));
+    b->ClassProb = (double*) malloc((size_t)Total*M*sizeof(double));
+    order = (int*) malloc(Total*sizeof(int));
+    newidx = (int*) malloc(Total*sizeof(int));
+    if (b->Nodes==NULL || b->ClassProb==NULL || order==NULL || newidx==NULL)
+    {
+        free(order); free(newidx);
+        return 0;
+    }
+
+    Total = 0;
+    valid = 1;
+    for (t=0;t<b->NumTrees && valid;t++)
+    {
+        read_int(fid,&NumNodes);
+        cf = read_doubles(fid,NumNodes);
+        cp = read_doubles(fid,NumNodes);
+        lc = read_doubles(fid,NumNodes);
+        rc = read_doubles(fid,NumNodes);
+        pr = read_doubles(fid,(size_t)NumNodes*M);
+        valid = cf!=NULL && cp!=NULL && lc!=NULL && rc!=NULL && pr!=NULL;
+
+        /* Breadth-first order of reachable nodes */
+        order[0] = 0;
+        head = 0;
+        tail = 1;
+        while (head<tail && valid)
+        {
+            u = order[head++];
+            if (cf[u]>0)
+            {
+                l = (int)lc[u]-1;
+                r = (int)rc[u]-1;
+                valid = l>=0 && l<NumNodes && r>=0 && r<NumNodes && tail+2<=NumNodes && cf[u]<=b->F;
+                if (valid)
+                {
+                    order[tail++] = l;
+                    order[tail++] = r;
+                }
+            }
+        }
+
+        if (valid)
+        {
+            b->Root[t] = Total;
+            for (n=0;n<tail;n++)
+                newidx[order[n]] = Total+n;
+            for (n=0;n<tail;n++)
+            {
+                u = order[n];
+                b->Nodes[Total+n].CutFeature = cf[u]>0 ? (int)cf[u]-1 : -1;
+                b->Nodes[Total+n].CutPoint = cp[u];
+                b->Nodes[Total+n].Child = cf[u]>0 ? newidx[(int)lc[u]-1] : -1;
+                for (i=0;i<M;i++)
+                    b->ClassProb[(size_t)(Total+n)*M+i] = pr[u+(size_t)i*NumNodes];
+            }
+            Total += tail;
+        }
+        free(cf); free(cp); free(lc); free(rc); free(pr);
+    }
+    free(order);
+    free(newidx);
+    return valid;
+}
+
+/* Skip a captured variable of a function handle (only used by MATLAB) */
+static int skip_variable(FILE *fid)
+{
+    uint64_t kind,r,c,i,rn,cn;
+    if (!skip_string(fid) || !read_uint64(fid,&kind))
+        return 0;
+    switch (kind)
+    {
+        case 1:
+            return read_uint64(fid,&r) && read_uint64(fid,&c) && fseek(fid,(long)(8*r*c),SEEK_CUR)==0;
+        case 2:
+            return skip_string(fid);
+        case 3:
+            if (!read_uint64(fid,&r) || !read_uint64(fid,&c))
+                return 0;
+            for (i=0;i<r*c;i++)
+                if (!read_uint64(fid,&rn) || !read_uint64(fid,&cn) || fseek(fid,(long)(8*rn*cn),SEEK_CUR)!=0)
+                    return 0;
+            return 1;
+    }
+    return 0;
+}
+
+/* Check the parameters of a function handle against its number of outputs and prepare its kernel */
+static int prepare_handle(plan_handle *h)
+{
+    int j,k,R,NumOutputs;
+    const double *p = h->Params;
+    size_t n,total;
+
+    switch (h->Kernel)
+    {
+        case FEATURE_BFD:
+            if (h->NumParams<1 || h->NumParams%2==0 || (p[0]!=0 && p[0]!=1))
+                return 0;
+            R = (h->NumParams-1)/2;
+            for (j=1;j<h->NumParams;j++)
+                if (!(p[j]>=0 && p[j]<=255 && p[j]==(int)p[j]))
+                    return 0;
+            NumOutputs = R+(p[0]==1 ? 4 : 0);
+            break;
+
+        case FEATURE_BYTE_BIGRAM:
+            for (j=0;j<h->NumParams;j++)
+                if (!(p[j]>=0 && p[j]<=65535 && p[j]==(int)p[j]))
+                    return 0;
+            NumOutputs = h->NumParams>0 ? h->NumParams : 65536;
+            break;
+
+        case FEATURE_ROC:
+            NumOutputs = 257;
+            break;
+
+        case FEATURE_ENTROPY:
+            NumOutputs = 2;
+            break;
+
+        case FEATURE_MEAN:
+            NumOutputs = 3;
+            break;
+
+        case FEATURE_LONGESTCONTIGUOUS:
+        case FEATURE_BINARYRATIO:
+        case FEATURE_KOLMOGOROV:
+        case FEATURE_STANDARDDEVIATION:
+            NumOutputs = 1;
+            break;
+
+        case FEATURE_LCSSEQ2:
+        case FEATURE_LCSSTR2:
+            if (h->NumParams<2 || !(p[0]>=-1 && p[0]<=0x7FFFFFFF && p[0]==(int)p[0]) || !(p[1]>=1 && p[1]<=h->NumParams))
+                return 0;
+            h->Band = (int) p[0];
+            h->NumReps = (int) p[1];
+            h->RepOff = (size_t*) malloc(h->NumReps*sizeof(size_t));
+            h->RepLen = (int*) malloc(h->NumReps*sizeof(int));
+            h->Reps = (unsigned char*) malloc(h->NumParams);
+            if (h->RepOff==NULL || h->RepLen==NULL || h->Reps==NULL)
+                return 0;
+            total = 0;
+            n = 2;
+            for (k=0;k<h->NumReps;k++)
+            {
+                if (n>=(size_t)h->NumParams || !(p[n]>=1 && p[n]<=h->NumParams-n-1 && p[n]==(int)p[n]))
+                    return 0;
+                h->RepLen[k] = (int) p[n++];
+                h->RepOff[k] = total;
+                for (j=0;j<h->RepLen[k];j++,n++)
+                {
+                    if (!(p[n]>=0 && p[n]<=255 && p[n]==(int)p[n]))
+                        return 0;
+                    h->Reps[total++] = (unsigned char) p[n];
+                }
+            }
+            if (n!=(size_t)h->NumParams)
+                return 0;
+            NumOutputs = 1;
+            break;
+
+        case FEATURE_CENTROIDS:
+            if (h->NumParams<1 || !(p[0]>=1 && p[0]==(int)p[0]) || h->NumParams!=1+512*p[0])
+                return 0;
+            R = (int) p[0];
+            h->Norm = (double*) malloc(R*sizeof(double));
+            if (h->Norm==NULL)
+                return 0;
+            for (k=0;k<R;k++)
+            {
+                double v = 0;
+                for (j=0;j<256;j++)
+                    v += p[1+256*k+j]*p[1+256*k+j];
+                h->Norm[k] = sqrt(v);
+            }
+            NumOutputs = 2*R;
+            break;
+
+        default:
+            return 0;
+    }
+    return NumOutputs==h->NumOutputs;
+}
+
+/* Read the feature plan. The expressions, the labels and the captured variables of function handles are
+ * only used by MATLAB and are skipped. */
+static int read_plan(FILE *fid,bundle *b)
+{
+    int i,j,NumVars,F0 = 0;
+    uint64_t Batched;
+    plan_handle *h;
+
+    if (!read_int(fid,&b->NumHandles) || b->NumHandles<1)
+        return 0;
+    b->Plan = (plan_handle*) calloc(b->NumHandles,sizeof(plan_handle));
+    if (b->Plan==NULL)
+    {
+        b->NumHandles = 0;
+        return 0;
+    }
+
+    for (i=0;i<b->NumHandles;i++)
+    {
+        h = b->Plan+i;
+        if (!skip_string(fid) || !read_uint64(fid,&Batched) || !read_int(fid,&h->NumOutputs) || h->NumOutputs<1)
+            return 0;
+        for (j=0;j<h->NumOutputs;j++)
+            if (!skip_string(fid))
+                return 0;
+        h->Select = (unsigned char*) malloc(h->NumOutputs);
+        if (h->Select==NULL || fread(h->Select,1,h->NumOutputs,fid)!=(size_t)h->NumOutputs)
+            return 0;
+        for (j=0;j<h->NumOutputs;j++)
+            h->NumSelected += h->Select[j]!=0;
+        F0 += h->NumSelected;
+
+        if (!read_int(fid,&h->Kernel) || !read_int(fid,&h->NumParams) || (h->Params = read_doubles(fid,h->NumParams))==NULL)
+            return 0;
+        if (!prepare_handle(h))
+            return 0;
+        if (h->NumOutputs>b->MaxOutputs)
+            b->MaxOutputs = h->NumOutputs;
+        if (h->Kernel==FEATURE_BYTE_BIGRAM)
+            b->UseBigrams = 1;
+
+        if (!read_int(fid,&NumVars))
+            return 0;
+        for (j=0;j<NumVars;j++)
+            if (!skip_variable(fid))
+                return 0;
+    }
+    return F0==b->F0;
+}
+
+/* Load a bundle. Returns NULL if the file is not a valid bundle. */
+static bundle *load_bundle(const char *Filename)
+{
+    FILE *fid;
+    bundle *b;
+    char magic[8];
+    uint64_t flag;
+    int i,k,version,ok = 0;
+    size_t n;
+
+    fid = fopen(Filename,"rb");
+    if (fid==NULL)
+        return NULL;
+    b = (bundle*) calloc(1,sizeof(bundle));
+    if (b==NULL)
+    {
+        fclose(fid);
+        return NULL;
+    }
+
+    do
+    {
+        /* Header (the feature plan of FFC-DM01 has no native kernels and is not read) */
+        if (fread(magic,1,8,fid)!=8 || memcmp(magic,"FFC-DM0",7)!=0 || (magic[7]!='1' && magic[7]!='2'))
+            break;
+        version = magic[7]-'0';
+        if (!read_int(fid,&b->Type) || !read_int(fid,&b->M) || !read_int(fid,&b->F0) || !read_int(fid,&b->F))
+            break;
+        if (b->M<1 || b->F<1 || b->F0<1)
+            break;
+
+        /* Class labels and feature labels */
+        for (i=0;i<b->M+b->F;i++)
+            if (!skip_string(fid))
+                break;
+        if (i<b->M+b->F)
+            break;
+
+        /* Feature transform */
+        if (!read_uint64(fid,&flag))
+            break;
+        if (flag)
+        {
+            if ((b->Coef = read_doubles(fid,(size_t)b->F0*b->F))==NULL)
+                break;
+        }
+        else if (b->F0!=b->F)
+            break;
+
+        /* Scaling */
+        if (!read_uint64(fid,&flag))
+            break;
+        if (flag)
+        {
+            b->A = read_doubles(fid,b->F);
+            b->B = read_doubles(fid,b->F);
+            b->InfValue = read_doubles(fid,b->F);
+            if (b->A==NULL || b->B==NULL || b->InfValue==NULL)
+                break;
+        }
+
+        /* Decision machine */
+        switch (b->Type)
+        {
+            case MODEL_LDA:
+                b->W = read_doubles(fid,(size_t)b->F*b->M);
+                b->c = read_doubles(fid,b->M);
+                ok = b->W!=NULL && b->c!=NULL;
+                break;
+
+            case MODEL_NAIVEBAYES:
+                b->LogPrior = read_doubles(fid,b->M);
+                b->G = (int*) calloc((size_t)b->M*b->F,sizeof(int));
+                b->Lo = (double*) calloc((size_t)b->M*b->F,sizeof(double));
+                b->Step = (double*) calloc((size_t)b->M*b->F,sizeof(double));
+                b->LogPDF = (double**) calloc((size_t)b->M*b->F,sizeof(double*));
+                if (b->LogPrior==NULL || b->G==NULL || b->Lo==NULL || b->Step==NULL || b->LogPDF==NULL)
+                    break;
+                ok = 1;
+                for (k=0;k<b->M*b->F && ok;k++)
+                {
+                    double *lohi;
+                    if (!read_int(fid,&b->G[k]) || b->G[k]<2 || (lohi = read_doubles(fid,2))==NULL)
+                    {
+                        ok = 0;
+                        break;
+                    }
+                    b->Lo[k] = lohi[0];
+                    b->Step[k] = (lohi[1]-lohi[0])/(b->G[k]-1);
+                    free(lohi);
+                    ok = (b->LogPDF[k] = read_doubles(fid,b->G[k]))!=NULL;
+                }
+                break;
+
+            case MODEL_DECISIONTREE:
+            case MODEL_RANDOMFOREST:
+                ok = read_trees(fid,b);
+                break;
+
+            case MODEL_SVM:
+                b->Kernel = (int*) calloc(b->M,sizeof(int));
+                b->nSV = (int*) calloc(b->M,sizeof(int));
+                b->Order = (double*) calloc(b->M,sizeof(double));
+                b->Scale = (double*) calloc(b->M,sizeof(double));
+                b->Bias = (double*) calloc(b->M,sizeof(double));
+                b->Mu = (double**) calloc(b->M,sizeof(double*));
+                b->Sigma = (double**) calloc(b->M,sizeof(double*));
+                b->SV = (double**) calloc(b->M,sizeof(double*));
+                b->SVCoef = (double**) calloc(b->M,sizeof(double*));
+                ok = 1;
+                for (k=0;k<b->M && ok;k++)
+                {
+                    double *par,*sv;
+                    int j;
+                    if (!read_int(fid,&b->Kernel[k]) || !read_int(fid,&b->nSV[k]) || (par = read_doubles(fid,3))==NULL)
+                    {
+                        ok = 0;
+                        break;
+                    }
+                    b->Order[k] = par[0];
+                    b->Scale[k] = par[1];
+                    b->Bias[k] = par[2];
+                    free(par);
+                    n = (size_t) b->nSV[k];
+                    b->Mu[k] = read_doubles(fid,b->F);
+                    b->Sigma[k] = read_doubles(fid,b->F);
+                    sv = read_doubles(fid,n*b->F);
+                    b->SVCoef[k] = read_doubles(fid,n);
+                    if (b->Mu[k]==NULL || b->Sigma[k]==NULL || sv==NULL || b->SVCoef[k]==NULL)
+                    {
+                        free(sv);
+                        ok = 0;
+                        break;
+                    }
+
+                    /* Support vectors are stored row by row and divided by the kernel scale */
+                    b->SV[k] = (double*) malloc((n>0?n:1)*b->F*sizeof(double));
+                    for (i=0;i<(int)n;i++)
+                        for (j=0;j<b->F;j++)
+                            b->SV[k][(size_t)i*b->F+j] = sv[i+j*n]/b->Scale[k];
+                    free(sv);
+                }
+                break;
+        }
+
+        /* Feature plan */
+        if (ok && version>=2)
+            ok = read_plan(fid,b);
+    } while (0);
+
+    fclose(fid);
+    if (!ok)
+    {
+        free_bundle(b);
+        return NULL;
+    }
+    return b;
+}
+
+/* ---------------------------------------- Features ---------------------------------------- */
+
+/* Grow buffer *p to n bytes (zero-filled if zero is nonzero). Returns 0 if there is not enough memory. */
+static int reserve(void **p,size_t *cap,size_t n,int zero)
+{
+    void *q;
+    if (n<=*cap)
+        return 1;
+    q = zero ? calloc(n,1) : malloc(n);
+    if (q==NULL)
+        return 0;
+    free(*p);
+    *p = q;
+    *cap = n;
+    return 1;
+}
+
+static void free_workspace(workspace *w)
+{
+    if (w==NULL)
+        return;
+    free(w->z); free(w->out); free(w->bigram);
+    free(w->pm); free(w->v); free(w->rows); free(w->bytes);
+    free(w);
+}
+
+/* Create the scratch buffers of a thread. Returns NULL if there is not enough memory. */
+static workspace *create_workspace(const bundle *b)
+{
+    workspace *w = (workspace*) calloc(1,sizeof(workspace));
+    if (w==NULL)
+        return NULL;
+    w->z = (double*) malloc((2*(size_t)b->F+b->M)*sizeof(double));
+    w->out = (double*) malloc((b->MaxOutputs>0 ? b->MaxOutputs : 1)*sizeof(double));
+    if (b->UseBigrams)
+        w->bigram = (int*) calloc(65536,sizeof(int));
+    if (w->z==NULL || w->out==NULL || (b->UseBigrams && w->bigram==NULL))
+    {
+        free_workspace(w);
+        return NULL;
+    }
+    w->HNu_n = -1;
+    return w;
+}
+
+/* Upper tail of the regularized incomplete gamma function Q(a,x); chi2cdf(T,k,'upper') is Q(k/2,T/2) */
+static double gamma_q(double a,double x)
+{
+    double sum,del,ap,an,bn,c,d,h;
+    int i;
+
+    if (!(x>0))
+        return 1;
+    if (x<a+1)
+    {
+        /* Series of P(a,x) */
+        ap = a;
+        sum = del = 1/a;
+        for (i=0;i<1000 && fabs(del)>fabs(sum)*1e-16;i++)
+        {
+            ap += 1;
+            del *= x/ap;
+            sum += del;
+        }
+        return 1-sum*exp(-x+a*log(x)-lgamma(a));
+    }
+
+    /* Continued fraction of Q(a,x) (modified Lentz method) */
+    bn = x+1-a;
+    c = 1/1e-300;
+    d = 1/bn;
+    h = d;
+    for (i=1;i<1000;i++)
+    {
+        an = -i*(i-a);
+        bn += 2;
+        d = an*d+bn;
+        d = (fabs(d)<1e-300) ? 1e-300 : d;
+        c = bn+an/c;
+        c = (fabs(c)<1e-300) ? 1e-300 : c;
+        d = 1/d;
+        del = d*c;
+        h *= del;
+        if (fabs(del-1)<1e-16)
+            break;
+    }
+    return exp(-x+a*log(x)-lgamma(a))*h;
+}
+
+/* BFD_FFC: byte frequencies (multiplied by 256) of the ranges; the four statistics of the full byte
+ * frequency distribution (SdFreq, ModesFreq, CorNextFreq and ChiSq p-value) are appended if Full is 1 */
+static void kernel_bfd(const plan_handle *h,const int *cnt,size_t n,double *out)
+{
+    int i,r,R = (h->NumParams-1)/2;
+    double freq[256],top[4],v,t,mean,d,num,den,e,T;
+
+    for (i=0;i<256;i++)
+        freq[i] = cnt[i]/(double)n*256;
+    for (r=0;r<R;r++)
+    {
+        int from = (int) h->Params[1+2*r], to = (int) h->Params[2+2*r];
+        v = 0;
+        for (i=from;i<=to;i++)
+            v += freq[i];
+        out[r] = v;
+    }
+    if (h->Params[0]==0)
+        return;
+
+    /* SdFreq and CorNextFreq (NaN is replaced by one in Autocorrelation_FFC) */
+    mean = 0;
+    for (i=0;i<256;i++)
+        mean += freq[i];
+    mean /= 256;
+    num = 0;
+    den = 0;
+    for (i=0;i<256;i++)
+    {
+        d = freq[i]-mean;
+        den += d*d;
+        if (i<255)
+            num += d*(freq[i+1]-mean);
+    }
+    out[R] = sqrt(den/255);
+    out[R+2] = (den>0) ? num/den : 1.0;
+
+    /* ModesFreq */
+    top[0] = top[1] = top[2] = top[3] = -HUGE_VAL;
+    for (i=0;i<256;i++)
+    {
+        v = freq[i];
+        for (r=0;r<4;r++)
+            if (v>top[r])
+            {
+                t = top[r];
+                top[r] = v;
+                v = t;
+            }
+    }
+    out[R+1] = top[0]+top[1]+top[2]+top[3];
+
+    /* ChiSq: p-value of the chi-square test of uniform distribution */
+    e = n/256.0;
+    T = 0;
+    for (i=0;i<256;i++)
+        T += (cnt[i]-e)*(cnt[i]-e)/e;
+    out[R+3] = gamma_q(255/2.0,T/2);
+}
+
+/* Byte_Bigram_FFC: frequencies of bigrams (multiplied by 65536) */
+static void kernel_bigram(const plan_handle *h,workspace *w,const unsigned char *x,size_t n,double *out)
+{
+    size_t i;
+    int j;
+
+    for (i=1;i<n;i++)
+        w->bigram[256*x[i-1]+x[i]]++;
+    if (h->NumParams==0)
+        for (j=0;j<65536;j++)
+            out[j] = w->bigram[j]/((double)n-1)*65536;
+    else
+        for (j=0;j<h->NumParams;j++)
+            out[j] = w->bigram[(int)h->Params[j]]/((double)n-1)*65536;
+    for (i=1;i<n;i++)
+        w->bigram[256*x[i-1]+x[i]] = 0;
+}
+
+/* RoC_FFC: normalized rate of change and its mean */
+static void kernel_roc(const unsigned char *x,size_t n,double *out)
+{
+    int roc[256],i;
+    size_t k;
+    double sum = 0;
+
+    memset(roc,0,sizeof(roc));
+    for (k=1;k<n;k++)
+        roc[abs(x[k]-x[k-1])]++;
+    out[0] = roc[0]/((double)n-1)/(1/256.0);
+    for (i=1;i<256;i++)
+        out[i] = roc[i]/((double)n-1)/((256-i)/(256.0*128));
+    for (i=0;i<256;i++)
+        sum += out[i];
+    out[256] = sum/256;
+}
+
+/* LongestContiguous_FFC: the size of the longest contiguous streak of repeating bytes */
+static double kernel_longestcontiguous(const unsigned char *x,size_t n)
+{
+    size_t k,L = 1,Lmax = 1;
+    if (n==0)
+        return 0;
+    for (k=1;k<n;k++)
+    {
+        if (x[k]==x[k-1])
+            L++;
+        else
+        {
+            Lmax = (L>Lmax) ? L : Lmax;
+            L = 1;
+        }
+    }
+    Lmax = (L>Lmax) ? L : Lmax;
+    return (double) Lmax;
+}
+
+/* BinaryRatio_FFC: (number of zero bits+1)/(number of one bits+1) */
+static double kernel_binaryratio(const int *cnt,size_t n)
+{
+    int i,j;
+    double ones = 0;
+    for (i=1;i<256;i++)
+        for (j=0;j<8;j++)
+            ones += cnt[i]*((i>>j)&1);
+    return (8.0*n-ones+1)/(ones+1);
+}
+
+/* Entropy_FFC: entropy and its difference with the expected entropy of random data (HNu) */
+static void kernel_entropy(workspace *w,const int *cnt,size_t n,double *out)
+{
+    int i,j;
+    double c,t,s,p,H;
+
+    if (w->HNu_n!=(double)n)
+    {
+        c = n/256.0;
+        t = 1; /* c^(j-1)/(j-1)! */
+        s = 0;
+        for (j=1;j<=171;j++)
+        {
+            s += t*log2((double)j);
+            t *= c/j;
+        }
+        w->HNu = log2(c)+8-exp(-c)*s;
+        w->HNu_n = (double) n;
+    }
+
+    H = 0;
+    for (i=0;i<256;i++)
+        if (cnt[i]>0)
+        {
+            p = cnt[i]/(double)n;
+            H -= p*log2(p);
+        }
+    out[0] = H;
+    out[1] = w->HNu-H;
+}
+
+/* kolmogorov_FFC: Lempel-Ziv complexity normalized by the length */
+static double kernel_kolmogorov(const unsigned char *S,size_t n)
+{
+    int c = 1;
+    size_t l = 1,i = 0,k = 1,kmax = 1;
+
+    while ((l+k)<=n)
+    {
+        if (S[i+k-1]==S[l+k-1])
+        {
+            k = k+1;
+            if ((l+k)<n)
+                continue;
+            c = c+1;
+            break;
+        }
+        if (k>kmax)
+            kmax = k;
+        i = i+1;
+        if (i==l)
+        {
+            c = c+1;
+            l = l+kmax;
+            if (l>=n)
+                break;
+            i = 0;
+            kmax = 1;
+        }
+        k = 1;
+    }
+    return (double) c/(double) n;
+}
+
+/* Mean_FFC: arithmetic, geometric and harmonic means */
+static void kernel_mean(const int *cnt,size_t n,double *out)
+{
+    int i;
+    double s = 0,slog = 0,sinv = 0;
+    for (i=0;i<256;i++)
+        s += (double)cnt[i]*i;
+    if (cnt[0]>0)
+    {
+        slog = -HUGE_VAL;
+        sinv = HUGE_VAL;
+    }
+    else
+        for (i=1;i<256;i++)
+        {
+            slog += cnt[i]*log((double)i);
+            sinv += cnt[i]/(double)i;
+        }
+    out[0] = s/n;
+    out[1] = exp(slog/n);
+    out[2] = n/sinv;
+}
+
+/* StandardDeviation_FFC: standard deviation of bytes (normalized by n-1) */
+static double kernel_standarddeviation(const int *cnt,size_t n)
+{
+    int i;
+    double mu = 0,v = 0;
+    if (n<2)
+        return 0;
+    for (i=0;i<256;i++)
+        mu += (double)cnt[i]*i;
+    mu /= n;
+    for (i=0;i<256;i++)
+        v += cnt[i]*(i-mu)*(i-mu);
+    return sqrt(v/(n-1));
+}
+
+static int popcount64(uint64_t x)
+{
+    x = x-((x>>1)&0x5555555555555555ULL);
+    x = (x&0x3333333333333333ULL)+((x>>2)&0x3333333333333333ULL);
+    x = (x+(x>>4))&0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x*0x0101010101010101ULL)>>56);
+}
+
+/* Bit-parallel LCSSeq of LCSSeq_FFC (only the cells with |i-j|<=band if band>=0). Returns -1 if there
+ * is not enough memory. */
+static int lcsseq(workspace *w,const unsigned char *Xb,int m,const unsigned char *Yb,int n,int band)
+{
+    int i,j,L,lo,hi,wlo,whi,nw = (m+63)/64;
+    uint64_t U,sum,t,carry,pmw,*pm,*PM,*V;
+
+    if (m==0 || n==0)
+        return 0;
+    if (!reserve((void**)&w->pm,&w->pm_cap,256*nw*sizeof(uint64_t),1) || !reserve((void**)&w->v,&w->v_cap,nw*sizeof(uint64_t),0))
+        return -1;
+    PM = w->pm;
+    V = w->v;
+
+    for (i=0;i<m;i++)
+        PM[Xb[i]*nw+(i>>6)] |= 1ULL<<(i&63);
+    for (i=0;i<nw;i++)
+        V[i] = ~0ULL;
+
+    lo = 0; hi = m-1;
+    wlo = 0; whi = nw-1;
+    for (j=0;j<n;j++)
+    {
+        if (band>=0)
+        {
+            lo = j-band; hi = j+band;
+            if (lo>m-1)
+                break;
+            lo = (lo<0) ? 0 : lo;
+            hi = (hi>m-1) ? m-1 : hi;
+            wlo = lo>>6; whi = hi>>6;
+        }
+
+        pm = PM+Yb[j]*nw;
+        carry = 0;
+        for (i=wlo;i<=whi;i++)
+        {
+            pmw = pm[i];
+            if (band>=0)
+            {
+                if (i==wlo)
+                    pmw &= ~0ULL<<(lo&63);
+                if (i==whi)
+                    pmw &= ~0ULL>>(63-(hi&63));
+            }
+            U = V[i]&pmw;
+            sum = V[i]+U;
+            t = sum+carry;
+            carry = (sum<U)|(t<sum);
+            V[i] = t|(V[i]&~pmw);
+        }
+    }
+
+    /* The workspace is all-zero on return */
+    for (i=0;i<m;i++)
+        PM[Xb[i]*nw+(i>>6)] = 0;
+
+    L = 0;
+    for (i=0;i<nw;i++)
+    {
+        if ((i+1)*64<=m)
+            L += 64-popcount64(V[i]);
+        else
+            L += (m-i*64)-popcount64(V[i]&((1ULL<<(m-i*64))-1));
+    }
+    return L;
+}
+
+/* LCSStr of LCSStr_FFC (two rows of the table; only the cells with |i-j|<=band if band>=0). Returns -1
+ * if there is not enough memory. */
+static int lcsstr(workspace *w,const unsigned char *Xv,int m,const unsigned char *Yv,int n,int band)
+{
+    int i,j,L,jlo,jhi,*prev,*cur,*tmp;
+
+    if (m==0 || n==0)
+        return 0;
+    if (!reserve((void**)&w->rows,&w->rows_cap,2*(size_t)(n+1)*sizeof(int),0))
+        return -1;
+    prev = w->rows;
+    cur = w->rows+n+1;
+    for (j=0;j<=n;j++)
+        prev[j] = cur[j] = 0;
+
+    L = 0;
+    for (i=1;i<=m && (band<0 || i-band<=n);i++)
+    {
+        const int x = Xv[i-1];
+        jlo = (band>=0 && i-band>1) ? i-band : 1;
+        jhi = (band>=0 && i+band<n) ? i+band : n;
+        for (j=jlo;j<=jhi;j++)
+        {
+            cur[j] = (x==Yv[j-1]) ? prev[j-1]+1 : 0;
+            L = (cur[j]>L) ? cur[j] : L;
+        }
+        tmp = prev; prev = cur; cur = tmp;
+    }
+    return L;
+}
+
+/* LCSSeq2_FFC and LCSStr2_FFC: the average normalized LCS with the representative fragments. Returns 0
+ * if there is not enough memory. */
+static int kernel_lcs(const plan_handle *h,workspace *w,const unsigned char *x,size_t m,double *out)
+{
+    int j,n,band,L;
+    double sum = 0;
+
+    for (j=0;j<h->NumReps;j++)
+    {
+        n = h->RepLen[j];
+        band = (h->Band<0 || h->Band>=(int)(m>(size_t)n ? m : (size_t)n)) ? -1 : h->Band;
+        if (h->Kernel==FEATURE_LCSSEQ2)
+            L = lcsseq(w,x,(int)m,h->Reps+h->RepOff[j],n,band);
+        else
+            L = lcsstr(w,x,(int)m,h->Reps+h->RepOff[j],n,band);
+        if (L<0)
+            return 0;
+        sum += (double)L/(double)(m<(size_t)n ? m : (size_t)n);
+    }
+    out[0] = sum/h->NumReps;
+    return 1;
+}
+
+/* Compare_with_Centroids_FFC: cosine similarity and Mahalanobis distance of BFD with each centroid */
+static void kernel_centroids(const plan_handle *h,const int *cnt,size_t n,double *out)
+{
+    int i,k,K = (int) h->Params[0];
+    const double *mu,*sigma;
+    double BFD[256],norm = 0,dot,dist,d;
+
+    for (i=0;i<256;i++)
+    {
+        BFD[i] = cnt[i]/(double)n*256;
+        norm += BFD[i]*BFD[i];
+    }
+    norm = sqrt(norm);
+    for (k=0;k<K;k++)
+    {
+        mu = h->Params+1+256*(size_t)k;
+        sigma = h->Params+1+256*(size_t)(K+k);
+        dot = 0;
+        dist = 0;
+        for (i=0;i<256;i++)
+        {
+            dot += BFD[i]*mu[i];
+            d = BFD[i]-mu[i];
+            dist += d*d/(0.01+sigma[i]*sigma[i]); /* Smoothing factor 0.01 */
+        }
+        out[2*k] = dot/(norm*h->Norm[k]);
+        out[2*k+1] = sqrt(dist);
+    }
+}
+
+/* Calculate the selected features of fragment x with length n into f (stride incf). The first F1 features
+ * are already calculated; the function handles whose selected outputs are among them are skipped.
+ * Returns 0 if there is not enough memory. */
+static int compute_features(const bundle *b,workspace *w,const unsigned char *x,size_t n,double *f,size_t incf,int F1)
+{
+    int i,j,f_cnt = 0,ok = 1,cnt[256];
+    size_t k;
+    const plan_handle *h;
+    double *out = w->out;
+
+    memset(cnt,0,sizeof(cnt));
+    for (k=0;k<n;k++)
+        cnt[x[k]]++;
+
+    for (i=0;i<b->NumHandles && ok;i++)
+    {
+        h = b->Plan+i;
+        if (h->NumSelected==0)
+            continue;
+        if (f_cnt+h->NumSelected<=F1) /* Already calculated */
+        {
+            f_cnt += h->NumSelected;
+            continue;
+        }
+
+        switch (h->Kernel)
+        {
+            case FEATURE_BFD:               kernel_bfd(h,cnt,n,out); break;
+            case FEATURE_BYTE_BIGRAM:       kernel_bigram(h,w,x,n,out); break;
+            case FEATURE_ROC:               kernel_roc(x,n,out); break;
+            case FEATURE_LONGESTCONTIGUOUS: out[0] = kernel_longestcontiguous(x,n); break;
+            case FEATURE_BINARYRATIO:       out[0] = kernel_binaryratio(cnt,n); break;
+            case FEATURE_ENTROPY:           kernel_entropy(w,cnt,n,out); break;
+            case FEATURE_KOLMOGOROV:        out[0] = kernel_kolmogorov(x,n); break;
+            case FEATURE_MEAN:              kernel_mean(cnt,n,out); break;
+            case FEATURE_STANDARDDEVIATION: out[0] = kernel_standarddeviation(cnt,n); break;
+            case FEATURE_LCSSEQ2:
+            case FEATURE_LCSSTR2:           ok = kernel_lcs(h,w,x,n,out); break;
+            case FEATURE_CENTROIDS:         kernel_centroids(h,cnt,n,out); break;
+        }
+
+        for (j=0;j<h->NumOutputs;j++)
+            if (h->Select[j])
+                f[(size_t)(f_cnt++)*incf] = out[j];
+    }
+    return ok;
+}
+
+/* ---------------------------------------- Scoring ---------------------------------------- */
+
+/* Convert scores s (log-likelihoods) into posterior probabilities */
+static void softmax(double *s,int M)
+{
+    double mx = -HUGE_VAL,sum = 0;
+    int k;
+    for (k=0;k<M;k++)
+        if (s[k]>mx)
+            mx = s[k];
+    if (mx==-HUGE_VAL)
+    {
+        for (k=0;k<M;k++)
+            s[k] = 1.0/M;
+        return;
+    }
+    for (k=0;k<M;k++)
+    {
+        s[k] = exp(s[k]-mx);
+        sum += s[k];
+    }
+    for (k=0;k<M;k++)
+        s[k] /= sum;
+}
+
+/* Score a single fragment with raw features x (stride incx). z is a scratch buffer of length F.
+ * The scores are written into s (stride incs) and the predicted label (1-based) is returned. */
+static int score_sample(const bundle *b,const double *x,size_t incx,double *z,double *s,size_t incs)
+{
+    int F = b->F, M = b->M, i, j, k, node;
+    double v, best;
+    int label;
+    double *p = z+F; /* scratch scores (length M) */
+
+    /* Feature transform */
+    if (b->Coef!=NULL)
+        for (j=0;j<F;j++)
+        {
+            const double *cj = b->Coef+(size_t)j*b->F0;
+            v = 0;
+            for (i=0;i<b->F0;i++)
+                v += x[i*incx]*cj[i];
+            z[j] = v;
+        }
+    else
+        for (j=0;j<F;j++)
+            z[j] = x[j*incx];
+
+    /* Scaling */
+    if (b->A!=NULL)
+        for (j=0;j<F;j++)
+        {
+            v = z[j];
+            if (fabs(v)>b->InfValue[j])
+                v = v>0 ? b->InfValue[j] : -b->InfValue[j];
+            z[j] = (v-b->A[j])/b->B[j];
+        }
+
+    switch (b->Type)
+    {
+        case MODEL_LDA:
+            for (k=0;k<M;k++)
+            {
+                const double *wk = b->W+(size_t)k*F;
+                v = b->c[k];
+                for (j=0;j<F;j++)
+                    v += z[j]*wk[j];
+                p[k] = v;
+            }
+            softmax(p,M);
+            break;
+
+        case MODEL_NAIVEBAYES:
+            for (k=0;k<M;k++)
+            {
+                v = b->LogPrior[k];
+                for (j=0;j<F && v>-HUGE_VAL;j++)
+                {
+                    int idx = k*F+j, G = b->G[idx];
+                    const double *lp = b->LogPDF[idx];
+                    double t = (z[j]-b->Lo[idx])/b->Step[idx];
+                    int g;
+                    if (!(t>0))
+                        v += lp[0];
+                    else if (t>=G-1)
+                        v += lp[G-1];
+                    else
+                    {
+                        g = (int) t;
+                        t -= g;
+                        v += lp[g]+t*(lp[g+1]-lp[g]);
+                    }
+                }
+                p[k] = v;
+            }
+            softmax(p,M);
+            break;
+
+        case MODEL_DECISIONTREE:
+        case MODEL_RANDOMFOREST:
+            for (k=0;k<M;k++)
+                p[k] = 0;
+            for (i=0;i<b->NumTrees;i++)
+            {
+                node = b->Root[i];
+                while (b->Nodes[node].CutFeature>=0)
+                    node = b->Nodes[node].Child+(z[b->Nodes[node].CutFeature]<b->Nodes[node].CutPoint ? 0 : 1);
+                for (k=0;k<M;k++)
+                    p[k] += b->ClassProb[(size_t)node*M+k];
+            }
+            for (k=0;k<M;k++)
+                p[k] /= b->NumTrees;
+            break;
+
+        case MODEL_SVM:
+            for (k=0;k<M;k++)
+            {
+                const double *mu = b->Mu[k], *sg = b->Sigma[k], *sc = b->SVCoef[k];
+                double sk = 1.0/b->Scale[k], f = b->Bias[k];
+                double *u = p+M; /* scaled features (length F) */
+                for (j=0;j<F;j++)
+                    u[j] = (z[j]-mu[j])/sg[j]*sk;
+                for (i=0;i<b->nSV[k];i++)
+                {
+                    const double *sv = b->SV[k]+(size_t)i*F;
+                    double d = 0;
+                    switch (b->Kernel[k])
+                    {
+                        case KERNEL_RBF:
+                            for (j=0;j<F;j++)
+                                d += (u[j]-sv[j])*(u[j]-sv[j]);
+                            d = exp(-d);
+                            break;
+                        case KERNEL_POLYNOMIAL:
+                            for (j=0;j<F;j++)
+                                d += u[j]*sv[j];
+                            d = pow(1+d,b->Order[k]);
+                            break;
+                        default:
+                            for (j=0;j<F;j++)
+                                d += u[j]*sv[j];
+                    }
+                    f += sc[i]*d;
+                }
+                p[k] = f;
+            }
+            break;
+    }
+
+    /* Predicted label */
+    label = 1;
+    best = p[0];
+    for (k=0;k<M;k++)
+    {
+        s[k*incs] = p[k];
+        if (p[k]>best)
+        {
+            best = p[k];
+            label = k+1;
+        }
+    }
+    return label;
+}
+
+/* ---------------------------------------- MEX Interface ---------------------------------------- */
+
+static void clear_cache(void)
+{
+    free_bundle(Cached);
+    Cached = NULL;
+    free(CachedName);
+    CachedName = NULL;
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
+{
+    char *Filename;
+    struct stat st;
+    double *Features,*PredictedLabel,*Scores;
+    const unsigned char **Bytes = NULL;
+    const double **Values = NULL;
+    size_t *Length = NULL;
+    int L,r,F1 = 0,FromBytes,NoMemory = 0,NotBytes = 0;
+    mxArray *FeaturesArray = NULL;
+    bundle *b;
+
+    /* Check for the proper number of arguments. */
+    if (nrhs < 2 || nrhs > 3)
+        mexErrMsgTxt("Two or three inputs are required.");
+    if (nlhs > 3)
+        mexErrMsgTxt("No more than three outputs are required!");
+
+    /* Check inputs */
+    if (!mxIsChar(prhs[0]))
+        mexErrMsgTxt("BundleFile must be a string.\n");
+    FromBytes = mxIsCell(prhs[1]);
+    if (!FromBytes && (!mxIsDouble(prhs[1]) || mxIsComplex(prhs[1])))
+        mexErrMsgTxt("Features must be a real matrix of type double.\n");
+    if (!FromBytes && (nrhs>2 || nlhs>2))
+        mexErrMsgTxt("Features1 and the output Features are only supported if Fragments are given.\n");
+
+    /* Load bundle (if it is not cached) */
+    Filename = mxArrayToString(prhs[0]);
+    if (stat(Filename,&st)!=0)
+    {
+        mxFree(Filename);
+        mexErrMsgTxt("The bundle file cannot be opened.\n");
+    }
+    if (Cached==NULL || strcmp(CachedName,Filename)!=0 || CachedTime!=st.st_mtime || CachedSize!=(long long)st.st_size)
+    {
+        clear_cache();
+        mexAtExit(clear_cache);
+        Cached = load_bundle(Filename);
+        if (Cached==NULL)
+        {
+            mxFree(Filename);
+            mexErrMsgTxt("The bundle file is not a valid decision machine bundle.\n");
+        }
+        CachedName = (char*) malloc(strlen(Filename)+1);
+        strcpy(CachedName,Filename);
+        CachedTime = st.st_mtime;
+        CachedSize = (long long) st.st_size;
+    }
+    mxFree(Filename);
+    b = Cached;
+
+    if (FromBytes)
+    {
+        /* Fragments (uint8 fragments are used in place and double fragments are converted by each thread) */
+        if (b->NumHandles==0)
+            mexErrMsgTxt("The bundle does not include a native feature plan. Export the decision machine again.\n");
+        L = (int) mxGetNumberOfElements(prhs[1]);
+        Bytes = (const unsigned char**) mxCalloc(L>0 ? L : 1,sizeof(unsigned char*));
+        Values = (const double**) mxCalloc(L>0 ? L : 1,sizeof(double*));
+        Length = (size_t*) mxCalloc(L>0 ? L : 1,sizeof(size_t));
+        for (r=0;r<L;r++)
+        {
+            const mxArray *Fragment = mxGetCell(prhs[1],r);
+            if (Fragment==NULL || mxIsComplex(Fragment) || !(mxIsUint8(Fragment) || mxIsDouble(Fragment)))
+                mexErrMsgTxt("Each fragment must be a real vector of type uint8 or double.\n");
+            Length[r] = mxGetNumberOfElements(Fragment);
+            if (mxIsUint8(Fragment))
+                Bytes[r] = (const unsigned char*) mxGetData(Fragment);
+            else
+                Values[r] = mxGetPr(Fragment);
+        }
+
+        /* Features which are already calculated */
+        if (nrhs==3 && !mxIsEmpty(prhs[2]))
+        {
+            if (!mxIsDouble(prhs[2]) || mxIsComplex(prhs[2]) || (int)mxGetM(prhs[2])!=L || (int)mxGetN(prhs[2])>b->F0)
+                mexErrMsgTxt("Features1 must be a real matrix of type double with a row for each fragment and at most F0 columns.\n");
+            F1 = (int) mxGetN(prhs[2]);
+        }
+
+        FeaturesArray = mxCreateDoubleMatrix(L, b->F0, mxREAL);
+        Features = mxGetPr(FeaturesArray);
+        if (F1>0)
+            memcpy(Features,mxGetPr(prhs[2]),(size_t)L*F1*sizeof(double));
+    }
+    else
+    {
+        L = (int) mxGetM(prhs[1]);
+        if (L>0 && (int)mxGetN(prhs[1])!=b->F0)
+            mexErrMsgTxt("The number of columns in Features does not match the decision machine bundle.\n");
+        Features = mxGetPr(prhs[1]);
+    }
+
+    plhs[0] = mxCreateDoubleMatrix(L, 1, mxREAL);
+    PredictedLabel = mxGetPr(plhs[0]);
+    plhs[1] = mxCreateDoubleMatrix(L, b->M, mxREAL);
+    Scores = mxGetPr(plhs[1]);
+
+    /* Calculate features and score fragments */
+    #pragma omp parallel
+    {
+        workspace *w = create_workspace(b);
+        const unsigned char *x;
+        size_t k;
+
+        #pragma omp for schedule(dynamic,16)
+        for (r=0;r<L;r++)
+        {
+            if (w==NULL)
+            {
+                NoMemory = 1;
+                continue;
+            }
+            if (FromBytes)
+            {
+                x = Bytes[r];
+                if (x==NULL)
+                {
+                    if (!reserve((void**)&w->bytes,&w->bytes_cap,Length[r]+1,0))
+                    {
+                        NoMemory = 1;
+                        continue;
+                    }
+                    for (k=0;k<Length[r];k++)
+                    {
+                        double v = Values[r][k];
+                        if (!(v>=0 && v<=255 && v==(int)v))
+                            break;
+                        w->bytes[k] = (unsigned char) v;
+                    }
+                    if (k<Length[r])
+                    {
+                        NotBytes = 1;
+                        continue;
+                    }
+                    x = w->bytes;
+                }
+                if (!compute_features(b,w,x,Length[r],Features+r,(size_t)L,F1))
+                {
+                    NoMemory = 1;
+                    continue;
+                }
+            }
+            PredictedLabel[r] = score_sample(b,Features+r,(size_t)L,w->z,Scores+r,(size_t)L);
+        }
+
+        free_workspace(w);
+    }
+
+    if (NoMemory)
+        mexErrMsgTxt("Out of memory.\n");
+    if (NotBytes)
+        mexErrMsgTxt("Fragments must consist of byte values (integers between 0 and 255).\n");
+
+    if (nlhs>2)
+        plhs[2] = FeaturesArray;
+    else if (FeaturesArray!=NULL)
+        mxDestroyArray(FeaturesArray);
+
+    return;
+}
@@ -0,0 +1,417 @@
+/* This c-mex function calculates the scores of a tree ensemble (a decision tree or the trees of a random forest)
+ * for a set of samples. The scores are the average class probabilities of the leaves reached in the trees,
+ * which are the same as the scores of predict for ClassificationTree and TreeBagger models.
+ *
+ * The trees are compiled before scoring as follows:
+ *   - The nodes of each tree are stored in breadth-first order in a table of packed nodes (cut point,
+ *       cut feature, and index of the left child; the right child is next to the left child).
+ *   - For the trees with at most 64 leaves, the nodes are also compiled into QuickScorer bitvectors:
+ *       the conditions of all such trees are sorted by cut point for each feature, and a sample reaches
+ *       the leftmost leaf which is not masked by its false conditions (x>=CutPoint).
+ *   - The samples are scored in blocks, so that all samples of a block traverse each tree while it is in
+ *       the cache. The blocks are scored in parallel (if OpenMP is available).
+ *
+ * If the value of the cut feature of a node is NaN, the sample stops at that node (as in predict when the
+ * tree has no surrogate splits).
+ *
+ * Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+ *
+ * This file is a part of Fragments-Expert software, a software package for
+ * feature extraction from file fragments and classification among various file formats.
+ *
+ * Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Usage method: Scores = Score_TreeEnsemble_Core_FFC(X,CutFeature,CutPoint,Children,ClassProbability,NumNodes);
+ *
+ * Inputs:
+ *  X: LxF matrix of features for L samples
+ *  CutFeature: Nx1 vector of cut features (column index of X) for the nodes of all trees (0 for leaves)
+ *  CutPoint: Nx1 vector of cut points. A sample goes to the left child if X(:,CutFeature)<CutPoint.
+ *  Children: Nx2 matrix of the left and right children of nodes (indices of nodes within their trees)
+ *  ClassProbability: NxM matrix of class probabilities of nodes
+ *  NumNodes: Tx1 vector of the number of nodes of T trees (the nodes of trees appear consecutively)
+ *
+ *  Note: The inputs CutFeature ... NumNodes are generated by Flatten_TreeEnsemble_FFC.
+ *
+ * Output:
+ *  Scores: LxM matrix of scores
+ *
+ * Compilation (OpenMP is optional):
+ *  mex -O COMPFLAGS="$COMPFLAGS /openmp" Score_TreeEnsemble_Core_FFC.c              (Windows, MSVC)
+ *  mex -O CFLAGS="$CFLAGS -fopenmp" LDFLAGS="$LDFLAGS -fopenmp" Score_TreeEnsemble_Core_FFC.c  (GCC)
+ *
+ * Revisions:
+ * 2026-Oct-18   function was created
+ */
+
+#include "mex.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#define MAX_QS_LEAVES 64    /* Maximum number of leaves of QuickScorer trees */
+#define BLOCK_ENTRIES 262144 /* Maximum number of (sample,tree) leaf entries of a block */
+#define MAX_BLOCK 64        /* Maximum number of samples in a block */
+
+/* A packed node */
+typedef struct
+{
+    double CutPoint;
+    int CutFeature;     /* 0-based feature index (-1 for leaves) */
+    int Child;          /* Index of the left child (the right child is Child+1) */
+} node;
+
+/* A QuickScorer condition */
+typedef struct
+{
+    double CutPoint;
+    int Feature;
+    int Slot;           /* QuickScorer slot of the tree */
+    uint64_t Mask;      /* Leaves which remain possible if the condition is false */
+} condition;
+
+/* Global Variables */
+int L,F,M,T;
+double *X;
+
+node *Nodes;            /* Packed nodes of all trees */
+int *NodeProb;          /* Row of ClassProbability for each packed node */
+int *Root;              /* Packed index of the root of each tree */
+double *Prob;           /* ClassProbability (row-major) */
+
+int nQS;                /* Number of QuickScorer trees */
+int *QSTree;            /* Tree of each QuickScorer slot */
+int *TreeQS;            /* QuickScorer slot of each tree (-1 if the tree is not a QuickScorer tree) */
+int *QSLeafProb;        /* Row of ClassProbability for each leaf of QuickScorer trees (nQS x 64) */
+int *CondStart;         /* Conditions of feature f are CondStart[f] ... CondStart[f+1]-1 */
+double *CondCutPoint;
+int *CondSlot;
+uint64_t *CondMask;
+
+/* Index of the lowest set bit */
+static int lowest_bit(uint64_t v)
+{
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward64(&idx,v);
+    return (int) idx;
+#else
+    return __builtin_ctzll(v);
+#endif
+}
+
+int compare_conditions(const void *a,const void *b)
+{
+    const condition *ca = (const condition*)a, *cb = (const condition*)b;
+    if (ca->Feature!=cb->Feature)
+        return ca->Feature-cb->Feature;
+    return (ca->CutPoint>cb->CutPoint)-(ca->CutPoint<cb->CutPoint);
+}
+
+/* Number the leaves of a QuickScorer tree from left to right and collect its conditions.
+ * Returns the number of leaves in the subtree of node p; first is the number of the leftmost leaf. */
+int collect_conditions(int p,int first,int slot,condition *cond,int *ncond)
+{
+    int nl,nr;
+    if (Nodes[p].CutFeature<0)
+    {
+        QSLeafProb[slot*MAX_QS_LEAVES+first] = NodeProb[p];
+        return 1;
+    }
+    nl = collect_conditions(Nodes[p].Child,first,slot,cond,ncond);
+    nr = collect_conditions(Nodes[p].Child+1,first+nl,slot,cond,ncond);
+    cond[*ncond].CutPoint = Nodes[p].CutPoint;
+    cond[*ncond].Feature = Nodes[p].CutFeature;
+    cond[*ncond].Slot = slot;
+    cond[*ncond].Mask = ~((((uint64_t)1<<nl)-1)<<first); /* x>=CutPoint: the left subtree is not reached */
+    (*ncond)++;
+    return nl+nr;
+}
+
+/* Compile the trees into packed nodes (breadth-first) and QuickScorer conditions.
+ * Returns 0 if the trees are not valid. */
+int compile_trees(const double *cf,const double *cp,const double *ch,const double *cprob,const double *NumNodes,int N)
+{
+    int t,i,o,n,head,tail,u,l,r,base,ncond,slot,valid;
+    int *order,*newidx,*LeafCount;
+    condition *cond;
+
+    Nodes = (node*) malloc((N>0?N:1)*sizeof(node));
+    NodeProb = (int*) malloc((N>0?N:1)*sizeof(int));
+    Root = (int*) malloc(T*sizeof(int));
+    Prob = (double*) malloc(((size_t)N*M+1)*sizeof(double));
+    order = (int*) malloc((N>0?N:1)*sizeof(int));
+    newidx = (int*) malloc((N>0?N:1)*sizeof(int));
+    LeafCount = (int*) calloc(T,sizeof(int));
+
+    for (i=0;i<N;i++)
+        for (u=0;u<M;u++)
+            Prob[(size_t)i*M+u] = cprob[i+(size_t)u*N];
+
+    /* Breadth-first layout */
+    base = 0;
+    o = 0;
+    for (t=0;t<T;t++)
+    {
+        n = (int) NumNodes[t];
+        if (n<1 || o+n>N)
+            break;
+        order[0] = 0;
+        head = 0;
+        tail = 1;
+        valid = 1;
+        while (head<tail && valid)
+        {
+            u = order[head++];
+            if (cf[o+u]>0)
+            {
+                l = (int)ch[o+u]-1;
+                r = (int)ch[o+u+N]-1;
+                valid = l>=0 && l<n && r>=0 && r<n && tail+2<=n && cf[o+u]<=F;
+                if (valid)
+                {
+                    order[tail++] = l;
+                    order[tail++] = r;
+                }
+            }
+        }
+        if (!valid)
+            break;
+
+        for (i=0;i<tail;i++)
+            newidx[order[i]] = base+i;
+        Root[t] = base;
+        for (i=0;i<tail;i++)
+        {
+            u = order[i];
+            NodeProb[base+i] = o+u;
+            if (cf[o+u]>0)
+            {
+                Nodes[base+i].CutFeature = (int)cf[o+u]-1;
+                Nodes[base+i].CutPoint = cp[o+u];
+                Nodes[base+i].Child = newidx[(int)ch[o+u]-1];
+            }
+            else
+            {
+                Nodes[base+i].CutFeature = -1;
+                Nodes[base+i].CutPoint = 0;
+                Nodes[base+i].Child = -1;
+                LeafCount[t]++;
+            }
+        }
+        base += tail;
+        o += n;
+    }
+    free(order);
+    free(newidx);
+    if (t<T)
+    {
+        free(LeafCount);
+        return 0;
+    }
+
+    /* QuickScorer trees */
+    nQS = 0;
+    ncond = 0;
+    TreeQS = (int*) malloc(T*sizeof(int));
+    for (t=0;t<T;t++)
+    {
+        TreeQS[t] = -1;
+        if (LeafCount[t]>1 && LeafCount[t]<=MAX_QS_LEAVES)
+        {
+            TreeQS[t] = nQS++;
+            ncond += LeafCount[t]-1;
+        }
+    }
+    QSTree = (int*) malloc((nQS>0?nQS:1)*sizeof(int));
+    QSLeafProb = (int*) malloc(((size_t)nQS*MAX_QS_LEAVES+1)*sizeof(int));
+    cond = (condition*) malloc((ncond>0?ncond:1)*sizeof(condition));
+    ncond = 0;
+    for (t=0;t<T;t++)
+        if ((slot = TreeQS[t])>=0)
+        {
+            QSTree[slot] = t;
+            collect_conditions(Root[t],0,slot,cond,&ncond);
+        }
+    free(LeafCount);
+
+    /* Sort conditions by feature and cut point */
+    qsort(cond,ncond,sizeof(condition),compare_conditions);
+    CondStart = (int*) calloc(F+1,sizeof(int));
+    CondCutPoint = (double*) malloc((ncond>0?ncond:1)*sizeof(double));
+    CondSlot = (int*) malloc((ncond>0?ncond:1)*sizeof(int));
+    CondMask = (uint64_t*) malloc((ncond>0?ncond:1)*sizeof(uint64_t));
+    for (i=0;i<ncond;i++)
+    {
+        CondStart[cond[i].Feature+1]++;
+        CondCutPoint[i] = cond[i].CutPoint;
+        CondSlot[i] = cond[i].Slot;
+        CondMask[i] = cond[i].Mask;
+    }
+    for (i=0;i<F;i++)
+        CondStart[i+1] += CondStart[i];
+    free(cond);
+
+    return 1;
+}
+
+void free_trees(void)
+{
+    free(Nodes); free(NodeProb); free(Root); free(Prob);
+    free(QSTree); free(TreeQS); free(QSLeafProb);
+    free(CondStart); free(CondCutPoint); free(CondSlot); free(CondMask);
+    Nodes = NULL; NodeProb = NULL; Root = NULL; Prob = NULL;
+    QSTree = NULL; TreeQS = NULL; QSLeafProb = NULL;
+    CondStart = NULL; CondCutPoint = NULL; CondSlot = NULL; CondMask = NULL;
+}
+
+/* Traverse tree t for a sample x. Returns the row of ClassProbability of the reached node. */
+static int traverse(int t,const double *x)
+{
+    int p = Root[t];
+    double v;
+    while (Nodes[p].CutFeature>=0)
+    {
+        v = x[Nodes[p].CutFeature];
+        if (v!=v) /* NaN */
+            break;
+        p = Nodes[p].Child+(v<Nodes[p].CutPoint ? 0 : 1);
+    }
+    return NodeProb[p];
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
+{
+    int N,B,i;
+    double *Scores;
+
+    /* Check for the proper number of arguments. */
+    if (nrhs != 6)
+        mexErrMsgTxt("Six inputs are required.");
+    if (nlhs > 1)
+        mexErrMsgTxt("No more than one output is required!");
+
+    /* Check inputs */
+    for (i=0;i<6;i++)
+        if (!mxIsDouble(prhs[i]) || mxIsComplex(prhs[i]))
+            mexErrMsgTxt("All inputs must be real matrices of type double.\n");
+
+    L = (int) mxGetM(prhs[0]);
+    F = (int) mxGetN(prhs[0]);
+    X = mxGetPr(prhs[0]);
+    N = (int) mxGetNumberOfElements(prhs[1]);
+    M = (int) mxGetN(prhs[4]);
+    T = (int) mxGetNumberOfElements(prhs[5]);
+    if ((int)mxGetNumberOfElements(prhs[2])!=N || (int)mxGetM(prhs[3])!=N || mxGetN(prhs[3])!=2 || (int)mxGetM(prhs[4])!=N)
+        mexErrMsgTxt("The sizes of tree arrays are incompatible.\n");
+    if (T<1)
+        mexErrMsgTxt("The ensemble must include at least one tree.\n");
+
+    /* Compile trees */
+    if (!compile_trees(mxGetPr(prhs[1]),mxGetPr(prhs[2]),mxGetPr(prhs[3]),mxGetPr(prhs[4]),mxGetPr(prhs[5]),N))
+    {
+        free_trees();
+        mexErrMsgTxt("The trees are not valid.\n");
+    }
+
+    plhs[0] = mxCreateDoubleMatrix(L, M, mxREAL);
+    Scores = mxGetPr(plhs[0]);
+
+    /* Number of samples in a block */
+    B = BLOCK_ENTRIES/T;
+    if (B>MAX_BLOCK)
+        B = MAX_BLOCK;
+    if (B<1)
+        B = 1;
+
+    /* Score blocks of samples */
+    #pragma omp parallel
+    {
+        double *xb = (double*) malloc(((size_t)B*F+1)*sizeof(double));
+        double *sb = (double*) malloc((size_t)M*sizeof(double));
+        int *leaf = (int*) malloc((size_t)B*T*sizeof(int));
+        uint64_t *v = (uint64_t*) malloc((nQS>0?nQS:1)*sizeof(uint64_t));
+        unsigned char *nanrow = (unsigned char*) malloc(B);
+        int r0,b,nb,f,c,t,k,s;
+
+        #pragma omp for schedule(dynamic,1)
+        for (r0=0;r0<L;r0+=B)
+        {
+            nb = L-r0<B ? L-r0 : B;
+
+            /* Samples of the block (row-major) */
+            for (b=0;b<nb;b++)
+            {
+                nanrow[b] = 0;
+                for (f=0;f<F;f++)
+                {
+                    xb[(size_t)b*F+f] = X[r0+b+(size_t)f*L];
+                    if (xb[(size_t)b*F+f]!=xb[(size_t)b*F+f])
+                        nanrow[b] = 1;
+                }
+            }
+
+            /* QuickScorer trees */
+            if (nQS>0)
+                for (b=0;b<nb;b++)
+                {
+                    const double *x = xb+(size_t)b*F;
+                    int *lf = leaf+(size_t)b*T;
+                    if (nanrow[b])
+                        continue;
+                    for (s=0;s<nQS;s++)
+                        v[s] = ~(uint64_t)0;
+                    for (f=0;f<F;f++)
+                        for (c=CondStart[f];c<CondStart[f+1] && CondCutPoint[c]<=x[f];c++)
+                            v[CondSlot[c]] &= CondMask[c];
+                    for (s=0;s<nQS;s++)
+                        lf[QSTree[s]] = QSLeafProb[s*MAX_QS_LEAVES+lowest_bit(v[s])];
+                }
+
+            /* Other trees (and samples with NaN): all samples of the block traverse each tree */
+            for (t=0;t<T;t++)
+                for (b=0;b<nb;b++)
+                    if (TreeQS[t]<0 || nanrow[b])
+                        leaf[(size_t)b*T+t] = traverse(t,xb+(size_t)b*F);
+
+            /* Average class probabilities (in the order of trees) */
+            for (b=0;b<nb;b++)
+            {
+                const int *lf = leaf+(size_t)b*T;
+                for (k=0;k<M;k++)
+                    sb[k] = 0;
+                for (t=0;t<T;t++)
+                {
+                    const double *p = Prob+(size_t)lf[t]*M;
+                    for (k=0;k<M;k++)
+                        sb[k] += p[k];
+                }
+                for (k=0;k<M;k++)
+                    Scores[r0+b+(size_t)k*L] = sb[k]/T;
+            }
+        }
+
+        free(xb);
+        free(sb);
+        free(leaf);
+        free(v);
+        free(nanrow);
+    }
+
+    free_trees();
+    return;
+}
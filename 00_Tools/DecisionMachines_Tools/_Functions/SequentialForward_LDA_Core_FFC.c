@@ -0,0 +1,638 @@
+/* This c-mex function is the engine of sequential forward feature selection with LDA classifier and
+ * K-fold cross-validation (see Script_SequentialForward_FeatureSelection_FFC). In each fold, the LDA
+ * classifier is trained on the other folds, and tested on the fold, as fitcdiscr (pseudoLinear) and predict.
+ *
+ * The engine keeps the following state for each fold:
+ *   - Scaling parameters, weighted class means, and pooled within-class variances of all features.
+ *   - The Cholesky factor of the pooled within-class covariance of the selected features, and the
+ *       covariances between the selected features and all features.
+ *   - The whitened coordinates and the discriminant scores of the test samples.
+ * A candidate feature is evaluated by a rank-one (bordered Cholesky) update: the new whitened coordinate
+ * is added to the scores of test samples, without training the classifier from scratch. A candidate which
+ * is a linear combination of the selected features (within classes) does not change the classifier, as the
+ * pseudo-inverse of the covariance ignores it. The candidates are evaluated in parallel (if OpenMP is available).
+ *
+ * Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+ *
+ * This file is a part of Fragments-Expert software, a software package for
+ * feature extraction from file fragments and classification among various file formats.
+ *
+ * Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Usage method:
+ *  SequentialForward_LDA_Core_FFC('init',Dataset,Weights,Fold,M,ScalingMethod);
+ *  Pc = SequentialForward_LDA_Core_FFC('evaluate',Dataset,Candidates);
+ *  SequentialForward_LDA_Core_FFC('add',Dataset,Feature);
+ *  SequentialForward_LDA_Core_FFC('clear');
+ *
+ * Inputs:
+ *  Dataset: Dataset with L rows (L samples corresponding to L fragments) and C columns. The first C-2 columns
+ *      correspond to features. The last two columns correspond to the integer-valued class labels (1~M) and
+ *      the FileID of the fragments, respectively. The same dataset must be given in all calls.
+ *  Weights: Lx1 vector of sample weights
+ *  Fold: Lx1 vector of the folds of samples (1~K, or 0 for the samples that are not used)
+ *  M: Number of classes
+ *  ScalingMethod: The method of feature scaling (1: z-score, 2: min-max, 3: no scaling)
+ *  Candidates: Vector of candidate features (column indices of Dataset)
+ *  Feature: The selected feature (column index of Dataset)
+ *
+ * Output:
+ *  Pc: Average weighted accuracy (percent) over K folds for each candidate feature
+ *
+ * Compilation (OpenMP is optional):
+ *  mex -O COMPFLAGS="$COMPFLAGS /openmp" SequentialForward_LDA_Core_FFC.c              (Windows, MSVC)
+ *  mex -O CFLAGS="$CFLAGS -fopenmp" LDFLAGS="$LDFLAGS -fopenmp" SequentialForward_LDA_Core_FFC.c  (GCC)
+ *
+ * Revisions:
+ * 2026-Oct-18   function was created
+ */
+
+#include "mex.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define DEGENERACY_TOL 1e-10 /* A feature is ignored if its residual variance is below this fraction of its mean square */
+
+/* Global Variables */
+int N,F,M,K,Cap;
+int Initialized = 0;
+int *Label;             /* 0-based classes of samples */
+int *Fold;              /* 0-based folds of samples (-1 for the samples that are not used) */
+double *W;              /* Weights of samples */
+int *TestStart;         /* Test samples of fold k are TestRows[TestStart[k] ... TestStart[k+1]-1] */
+int *TestRows;
+double *A,*B;           /* KxF scaling parameters (index k*F+j) */
+double *InfTrain;       /* KxF clamping values of training samples */
+double *InfTest;        /* KxF clamping values of test samples */
+double *Mu;             /* KxFxM class means of scaled features (index (k*F+j)*M+c) */
+double *Diag;           /* KxF pooled within-class variances */
+double *Mag;            /* KxF mean squares of scaled features (with the normalization of covariances) */
+double *LogPrior;       /* KxM logarithm of class priors (-Inf for the classes without training samples) */
+double *Norm;           /* K normalization factors of covariances */
+int *NumActive;         /* K numbers of selected features with whitened coordinates */
+double *Chol;           /* KxCapxCap lower-triangular Cholesky factors (row-major) */
+double *WMu;            /* KxMxCap whitened class means */
+double *Cross;          /* KxFxCap covariances between all features and the selected features */
+double *Z;              /* LxCap whitened coordinates of samples (in the fold of each sample) */
+double *Scores;         /* LxM discriminant scores of samples (in the fold of each sample) */
+double *CurErr;         /* K weighted errors of the current classifiers */
+
+void free_state(void)
+{
+    free(Label); free(Fold); free(W); free(TestStart); free(TestRows);
+    free(A); free(B); free(InfTrain); free(InfTest); free(Mu); free(Diag); free(Mag); free(LogPrior); free(Norm);
+    free(NumActive); free(Chol); free(WMu); free(Cross); free(Z); free(Scores); free(CurErr);
+    Label = NULL; Fold = NULL; W = NULL; TestStart = NULL; TestRows = NULL;
+    A = NULL; B = NULL; InfTrain = NULL; InfTest = NULL; Mu = NULL; Diag = NULL; Mag = NULL; LogPrior = NULL; Norm = NULL;
+    NumActive = NULL; Chol = NULL; WMu = NULL; Cross = NULL; Z = NULL; Scores = NULL; CurErr = NULL;
+    Initialized = 0;
+}
+
+static double clamp(double x,double v)
+{
+    if (x>v)
+        return v;
+    if (x<-v)
+        return -v;
+    return x;
+}
+
+/* Scaled value of feature j of a training/test sample in fold k */
+static double scaled_train(const double *X,int k,int j,int r)
+{
+    size_t kj = (size_t)k*F+j;
+    return (clamp(X[r+(size_t)j*N],InfTrain[kj])-A[kj])/B[kj];
+}
+
+static double scaled_test(const double *X,int k,int j,int r)
+{
+    size_t kj = (size_t)k*F+j;
+    return (clamp(X[r+(size_t)j*N],InfTest[kj])-A[kj])/B[kj];
+}
+
+/* Predicted class (0-based) of a sample from its scores */
+static int best_class(const double *s,const double *lp)
+{
+    int c,best = -1;
+    for (c=0;c<M;c++)
+        if (lp[c]>-HUGE_VAL && (best<0 || s[c]>s[best]))
+            best = c;
+    return best;
+}
+
+/* Weighted error of the current classifier of fold k */
+static double current_error(int k)
+{
+    int t,r;
+    double e = 0;
+    for (t=TestStart[k];t<TestStart[k+1];t++)
+    {
+        r = TestRows[t];
+        if (best_class(Scores+(size_t)r*M,LogPrior+(size_t)k*M)!=Label[r])
+            e += W[r];
+    }
+    return e;
+}
+
+/* Increase the capacity of the selected features */
+void grow(int NewCap)
+{
+    double *chol = (double*) calloc((size_t)K*NewCap*NewCap,sizeof(double));
+    double *wmu = (double*) calloc((size_t)K*M*NewCap,sizeof(double));
+    double *cross = (double*) calloc((size_t)K*F*NewCap,sizeof(double));
+    double *z = (double*) calloc((size_t)N*NewCap,sizeof(double));
+    size_t i;
+    int a,b;
+
+    if (Cap>0)
+    {
+        for (i=0;i<(size_t)K;i++)
+            for (a=0;a<Cap;a++)
+                for (b=0;b<Cap;b++)
+                    chol[(i*NewCap+a)*NewCap+b] = Chol[(i*Cap+a)*Cap+b];
+        for (i=0;i<(size_t)K*M;i++)
+            memcpy(wmu+i*NewCap,WMu+i*Cap,Cap*sizeof(double));
+        for (i=0;i<(size_t)K*F;i++)
+            memcpy(cross+i*NewCap,Cross+i*Cap,Cap*sizeof(double));
+        for (i=0;i<(size_t)N;i++)
+            memcpy(z+i*NewCap,Z+i*Cap,Cap*sizeof(double));
+    }
+    free(Chol); free(WMu); free(Cross); free(Z);
+    Chol = chol; WMu = wmu; Cross = cross; Z = z;
+    Cap = NewCap;
+}
+
+/* Bordered Cholesky update of fold k for feature j: l = L\Cross(j), and the residual variance is returned.
+ * The whitened class means of feature j are written to mn (if the residual variance is not degenerate). */
+static double border(int k,int j,double *l,double *mn)
+{
+    int a,b,c,n = NumActive[k];
+    const double *L = Chol+(size_t)k*Cap*Cap;
+    const double *cr = Cross+((size_t)k*F+j)*Cap;
+    const double *mu = Mu+((size_t)k*F+j)*M;
+    double d2 = Diag[(size_t)k*F+j], d, s;
+
+    for (a=0;a<n;a++)
+    {
+        s = cr[a];
+        for (b=0;b<a;b++)
+            s -= L[a*Cap+b]*l[b];
+        l[a] = s/L[a*Cap+a];
+        d2 -= l[a]*l[a];
+    }
+    if (!(d2>DEGENERACY_TOL*Mag[(size_t)k*F+j]))
+        return 0;
+
+    d = sqrt(d2);
+    for (c=0;c<M;c++)
+    {
+        const double *m = WMu+((size_t)k*M+c)*Cap;
+        s = mu[c];
+        for (a=0;a<n;a++)
+            s -= l[a]*m[a];
+        mn[c] = s/d;
+    }
+    return d2;
+}
+
+/* Initialize the state of engine */
+void init(const double *X,const double *Weights,const double *Folds,int ScalingMethod)
+{
+    int r,k,c;
+    double *Wc,*W2c,*Wt;
+    int *cnt;
+
+    Label = (int*) malloc(N*sizeof(int));
+    Fold = (int*) malloc(N*sizeof(int));
+    W = (double*) malloc(N*sizeof(double));
+    TestStart = (int*) calloc(K+1,sizeof(int));
+    TestRows = (int*) malloc((N>0?N:1)*sizeof(int));
+    A = (double*) malloc((size_t)K*F*sizeof(double));
+    B = (double*) malloc((size_t)K*F*sizeof(double));
+    InfTrain = (double*) malloc((size_t)K*F*sizeof(double));
+    InfTest = (double*) malloc((size_t)K*F*sizeof(double));
+    Mu = (double*) malloc((size_t)K*F*M*sizeof(double));
+    Diag = (double*) malloc((size_t)K*F*sizeof(double));
+    Mag = (double*) malloc((size_t)K*F*sizeof(double));
+    LogPrior = (double*) malloc((size_t)K*M*sizeof(double));
+    Norm = (double*) malloc(K*sizeof(double));
+    NumActive = (int*) calloc(K,sizeof(int));
+    Scores = (double*) malloc(((size_t)N*M+1)*sizeof(double));
+    CurErr = (double*) malloc(K*sizeof(double));
+    Cap = 0;
+    grow(16);
+    Initialized = 1;
+
+    for (r=0;r<N;r++)
+    {
+        Label[r] = (int)X[r+(size_t)F*N]-1;
+        Fold[r] = (int)Folds[r]-1;
+        W[r] = Weights[r];
+        if (Label[r]<0 || Label[r]>=M)
+            Fold[r] = -1;
+        if (Fold[r]>=0)
+            TestStart[Fold[r]+1]++;
+    }
+    for (k=0;k<K;k++)
+        TestStart[k+1] += TestStart[k];
+    cnt = (int*) calloc(K,sizeof(int));
+    for (r=0;r<N;r++)
+        if (Fold[r]>=0)
+        {
+            TestRows[TestStart[Fold[r]]+cnt[Fold[r]]] = r;
+            cnt[Fold[r]]++;
+        }
+    free(cnt);
+
+    /* Class weights of folds: the training samples of fold k are the samples of other folds */
+    Wc = (double*) calloc((size_t)K*M,sizeof(double));
+    W2c = (double*) calloc((size_t)K*M,sizeof(double));
+    Wt = (double*) calloc(K,sizeof(double));
+    for (r=0;r<N;r++)
+        if (Fold[r]>=0)
+            for (k=0;k<K;k++)
+                if (k!=Fold[r])
+                {
+                    Wc[k*M+Label[r]] += W[r];
+                    W2c[k*M+Label[r]] += W[r]*W[r];
+                    Wt[k] += W[r];
+                }
+    for (k=0;k<K;k++)
+    {
+        /* Unbiased pooled covariance of normalized weights: 1-sum(W2c/Wc) */
+        double denom = 1;
+        for (c=0;c<M;c++)
+        {
+            LogPrior[k*M+c] = Wc[k*M+c]>0 ? log(Wc[k*M+c]/Wt[k]) : -HUGE_VAL;
+            if (Wc[k*M+c]>0)
+                denom -= W2c[k*M+c]/(Wc[k*M+c]*Wt[k]);
+        }
+        if (!(denom>0))
+            denom = 1;
+        Norm[k] = Wt[k]*denom;
+    }
+
+    /* Scaling parameters, class means, and variances of features */
+    #pragma omp parallel
+    {
+        /* Partial sums over the samples of each fold */
+        double *mx = (double*) malloc(K*sizeof(double));
+        double *mn = (double*) malloc(K*sizeof(double));
+        double *ma = (double*) malloc(K*sizeof(double));
+        double *s1 = (double*) malloc(K*sizeof(double));
+        double *s2 = (double*) malloc(K*sizeof(double));
+        int *nf = (int*) malloc(K*sizeof(int));
+        int *np = (int*) malloc(K*sizeof(int));
+        int *nn = (int*) malloc(K*sizeof(int));
+        double *ws = (double*) malloc((size_t)K*M*sizeof(double));
+        double *v = (double*) malloc((size_t)K*sizeof(double));
+        double *q = (double*) malloc((size_t)K*sizeof(double));
+        int jj,f,kk,cc,rr;
+
+        #pragma omp for schedule(dynamic,1)
+        for (jj=0;jj<F;jj++)
+        {
+            const double *x = X+(size_t)jj*N;
+            double shift = 0, x0;
+            for (rr=0;rr<N;rr++)
+                if (Fold[rr]>=0 && fabs(x[rr])<HUGE_VAL)
+                {
+                    shift = x[rr];
+                    break;
+                }
+            for (f=0;f<K;f++)
+            {
+                mx[f] = -HUGE_VAL; mn[f] = HUGE_VAL; ma[f] = 0; s1[f] = 0; s2[f] = 0;
+                nf[f] = 0; np[f] = 0; nn[f] = 0;
+            }
+
+            for (rr=0;rr<N;rr++)
+            {
+                f = Fold[rr];
+                if (f<0)
+                    continue;
+                x0 = x[rr];
+                if (fabs(x0)<HUGE_VAL)
+                {
+                    nf[f]++;
+                    if (x0>mx[f]) mx[f] = x0;
+                    if (x0<mn[f]) mn[f] = x0;
+                    if (fabs(x0)>ma[f]) ma[f] = fabs(x0);
+                    s1[f] += x0-shift;
+                    s2[f] += (x0-shift)*(x0-shift);
+                }
+                else if (x0>0)
+                    np[f]++;
+                else if (x0<0)
+                    nn[f]++;
+            }
+
+            for (kk=0;kk<K;kk++)
+            {
+                size_t kj = (size_t)kk*F+jj;
+                double Mx = -HUGE_VAL, Mn = HUGE_VAL, Ma = 0, S1 = 0, S2 = 0, n, inf_val, mean, var;
+                int Nf = 0, Np = 0, Nn = 0;
+                for (f=0;f<K;f++)
+                    if (f!=kk)
+                    {
+                        if (mx[f]>Mx) Mx = mx[f];
+                        if (mn[f]<Mn) Mn = mn[f];
+                        if (ma[f]>Ma) Ma = ma[f];
+                        S1 += s1[f]; S2 += s2[f];
+                        Nf += nf[f]; Np += np[f]; Nn += nn[f];
+                    }
+
+                /* Clamping as Scale_Features_FFC */
+                inf_val = Nf>0 ? 10*Ma : 1;
+                InfTrain[kj] = inf_val;
+                InfTest[kj] = inf_val;
+                n = Nf+Np+Nn;
+                switch (ScalingMethod)
+                {
+                    case 1: /* z-score */
+                        S1 += Np*(inf_val-shift)-Nn*(inf_val+shift);
+                        S2 += Np*(inf_val-shift)*(inf_val-shift)+Nn*(inf_val+shift)*(inf_val+shift);
+                        mean = n>0 ? shift+S1/n : 0;
+                        var = n>1 ? (S2-S1*S1/n)/(n-1) : 0;
+                        A[kj] = mean;
+                        B[kj] = var>0 ? sqrt(var) : 1;
+                        break;
+                    case 2: /* min-max */
+                        if (Nn>0) Mn = -inf_val;
+                        if (Np>0) Mx = inf_val;
+                        A[kj] = n>0 ? Mn : 0;
+                        B[kj] = n>0 && Mx-Mn>0 ? Mx-Mn : 1;
+                        break;
+                    default: /* no scaling: the test samples are not clamped */
+                        A[kj] = 0;
+                        B[kj] = 1;
+                        InfTest[kj] = HUGE_VAL;
+                }
+            }
+
+            /* Class means of scaled feature */
+            memset(ws,0,(size_t)K*M*sizeof(double));
+            for (rr=0;rr<N;rr++)
+            {
+                f = Fold[rr];
+                if (f<0)
+                    continue;
+                for (kk=0;kk<K;kk++)
+                    if (kk!=f)
+                        ws[kk*M+Label[rr]] += W[rr]*scaled_train(X,kk,jj,rr);
+            }
+            for (kk=0;kk<K;kk++)
+            {
+                for (cc=0;cc<M;cc++)
+                    Mu[((size_t)kk*F+jj)*M+cc] = Wc[kk*M+cc]>0 ? ws[kk*M+cc]/Wc[kk*M+cc] : 0;
+                v[kk] = 0;
+                q[kk] = 0;
+            }
+
+            /* Pooled within-class variances */
+            for (rr=0;rr<N;rr++)
+            {
+                f = Fold[rr];
+                if (f<0)
+                    continue;
+                for (kk=0;kk<K;kk++)
+                    if (kk!=f)
+                    {
+                        double x1 = scaled_train(X,kk,jj,rr), u = x1-Mu[((size_t)kk*F+jj)*M+Label[rr]];
+                        v[kk] += W[rr]*u*u;
+                        q[kk] += W[rr]*x1*x1;
+                    }
+            }
+            for (kk=0;kk<K;kk++)
+            {
+                Diag[(size_t)kk*F+jj] = v[kk]/Norm[kk];
+                Mag[(size_t)kk*F+jj] = q[kk]/Norm[kk];
+            }
+        }
+
+        free(mx); free(mn); free(ma); free(s1); free(s2); free(nf); free(np); free(nn);
+        free(ws); free(v); free(q);
+    }
+
+    /* Classifiers without any feature */
+    for (r=0;r<N;r++)
+        if (Fold[r]>=0)
+            for (c=0;c<M;c++)
+                Scores[(size_t)r*M+c] = LogPrior[Fold[r]*M+c];
+    for (k=0;k<K;k++)
+        CurErr[k] = current_error(k);
+
+    free(Wc); free(W2c); free(Wt);
+}
+
+/* Average weighted accuracy of candidate features */
+void evaluate(const double *X,const double *Candidates,int nc,double *Pc)
+{
+    #pragma omp parallel
+    {
+        double *l = (double*) malloc((Cap+1)*sizeof(double));
+        double *mn = (double*) malloc(M*sizeof(double));
+        double *q = (double*) malloc(M*sizeof(double));
+        double *s = (double*) malloc(M*sizeof(double));
+        int i,j,k,t,r,a,c,best,n;
+        double d,d2,e,z,sum;
+
+        #pragma omp for schedule(dynamic,1)
+        for (i=0;i<nc;i++)
+        {
+            j = (int)Candidates[i]-1;
+            sum = 0;
+            for (k=0;k<K;k++)
+            {
+                n = TestStart[k+1]-TestStart[k];
+                if (n==0)
+                    continue;
+                e = CurErr[k];
+                d2 = border(k,j,l,mn);
+                if (d2>0)
+                {
+                    const double *lp = LogPrior+(size_t)k*M;
+                    d = sqrt(d2);
+                    for (c=0;c<M;c++)
+                        q[c] = -0.5*mn[c]*mn[c];
+                    e = 0;
+                    for (t=TestStart[k];t<TestStart[k+1];t++)
+                    {
+                        r = TestRows[t];
+                        z = scaled_test(X,k,j,r);
+                        for (a=0;a<NumActive[k];a++)
+                            z -= l[a]*Z[(size_t)r*Cap+a];
+                        z /= d;
+                        for (c=0;c<M;c++)
+                            s[c] = Scores[(size_t)r*M+c]+z*mn[c]+q[c];
+                        best = best_class(s,lp);
+                        if (best!=Label[r])
+                            e += W[r];
+                    }
+                }
+                sum += 100*(1-e/n);
+            }
+            Pc[i] = sum/K;
+        }
+
+        free(l); free(mn); free(q); free(s);
+    }
+}
+
+/* Add a feature to the selected features */
+void add(const double *X,int j)
+{
+    double *l = (double*) malloc((Cap+1)*sizeof(double));
+    double *mn = (double*) malloc(M*sizeof(double));
+    double *u = (double*) malloc((N>0?N:1)*sizeof(double));
+    double d2,d,z;
+    int k,a,b,c,t,r,jj;
+
+    for (k=0;k<K;k++)
+    {
+        d2 = border(k,j,l,mn);
+        if (d2<=0)
+            continue;
+        d = sqrt(d2);
+
+        a = NumActive[k];
+        if (a>=Cap)
+        {
+            grow(2*Cap);
+            l = (double*) realloc(l,(Cap+1)*sizeof(double));
+        }
+
+        /* Cholesky factor and whitened class means */
+        for (b=0;b<a;b++)
+            Chol[((size_t)k*Cap+a)*Cap+b] = l[b];
+        Chol[((size_t)k*Cap+a)*Cap+a] = d;
+        for (c=0;c<M;c++)
+            WMu[((size_t)k*M+c)*Cap+a] = mn[c];
+
+        /* Whitened coordinates and scores of test samples */
+        for (t=TestStart[k];t<TestStart[k+1];t++)
+        {
+            r = TestRows[t];
+            z = scaled_test(X,k,j,r);
+            for (b=0;b<a;b++)
+                z -= l[b]*Z[(size_t)r*Cap+b];
+            z /= d;
+            Z[(size_t)r*Cap+a] = z;
+            for (c=0;c<M;c++)
+                Scores[(size_t)r*M+c] += z*mn[c]-0.5*mn[c]*mn[c];
+        }
+
+        /* Covariances between all features and the new feature */
+        for (r=0;r<N;r++)
+            u[r] = Fold[r]>=0 && Fold[r]!=k ? W[r]*(scaled_train(X,k,j,r)-Mu[((size_t)k*F+j)*M+Label[r]]) : 0;
+        #pragma omp parallel for schedule(dynamic,16)
+        for (jj=0;jj<F;jj++)
+        {
+            const double *mu = Mu+((size_t)k*F+jj)*M;
+            double s = 0;
+            int rr;
+            for (rr=0;rr<N;rr++)
+                if (u[rr]!=0)
+                    s += u[rr]*(scaled_train(X,k,jj,rr)-mu[Label[rr]]);
+            Cross[((size_t)k*F+jj)*Cap+a] = s/Norm[k];
+        }
+
+        NumActive[k] = a+1;
+        CurErr[k] = current_error(k);
+    }
+
+    free(l);
+    free(mn);
+    free(u);
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
+{
+    char mode[16];
+    int i,nc;
+    double *Pc;
+
+    /* Check for the proper number of arguments. */
+    if (nrhs<1 || !mxIsChar(prhs[0]) || mxGetString(prhs[0],mode,sizeof(mode)))
+        mexErrMsgTxt("The first input must be 'init', 'evaluate', 'add', or 'clear'.");
+    if (nlhs > 1)
+        mexErrMsgTxt("No more than one output is required!");
+    mexAtExit(free_state);
+
+    if (strcmp(mode,"clear")==0)
+    {
+        free_state();
+        return;
+    }
+
+    if (nrhs<3)
+        mexErrMsgTxt("Not enough inputs.");
+    for (i=1;i<nrhs;i++)
+        if (!mxIsDouble(prhs[i]) || mxIsComplex(prhs[i]))
+            mexErrMsgTxt("All inputs (except the first one) must be real matrices of type double.\n");
+
+    if (strcmp(mode,"init")==0)
+    {
+        int ScalingMethod,r;
+        const double *Folds;
+        if (nrhs!=6)
+            mexErrMsgTxt("Six inputs are required for 'init'.");
+        free_state();
+        N = (int) mxGetM(prhs[1]);
+        F = (int) mxGetN(prhs[1])-2;
+        if (F<1)
+            mexErrMsgTxt("Dataset must have at least one feature.\n");
+        if ((int)mxGetNumberOfElements(prhs[2])!=N || (int)mxGetNumberOfElements(prhs[3])!=N)
+            mexErrMsgTxt("Weights and Fold must have one element for each sample.\n");
+        M = (int) mxGetScalar(prhs[4]);
+        ScalingMethod = (int) mxGetScalar(prhs[5]);
+        if (M<1)
+            mexErrMsgTxt("Number of classes must be positive.\n");
+        Folds = mxGetPr(prhs[3]);
+        K = 0;
+        for (r=0;r<N;r++)
+            if (Folds[r]>K)
+                K = (int) Folds[r];
+        if (K<1)
+            mexErrMsgTxt("At least one fold is required.\n");
+        init(mxGetPr(prhs[1]),mxGetPr(prhs[2]),Folds,ScalingMethod);
+        return;
+    }
+
+    if (!Initialized)
+        mexErrMsgTxt("The engine is not initialized.");
+    if ((int)mxGetM(prhs[1])!=N || (int)mxGetN(prhs[1])!=F+2)
+        mexErrMsgTxt("The size of Dataset is not the same as the size of Dataset in 'init'.\n");
+
+    if (strcmp(mode,"evaluate")==0)
+    {
+        const double *Candidates = mxGetPr(prhs[2]);
+        nc = (int) mxGetNumberOfElements(prhs[2]);
+        for (i=0;i<nc;i++)
+            if (!(Candidates[i]>=1 && Candidates[i]<=F))
+                mexErrMsgTxt("Candidate features are not valid.\n");
+        plhs[0] = mxCreateDoubleMatrix(1, nc, mxREAL);
+        Pc = mxGetPr(plhs[0]);
+        evaluate(mxGetPr(prhs[1]),Candidates,nc,Pc);
+    }
+    else if (strcmp(mode,"add")==0)
+    {
+        double j = mxGetScalar(prhs[2]);
+        if (!(j>=1 && j<=F))
+            mexErrMsgTxt("The feature is not valid.\n");
+        add(mxGetPr(prhs[1]),(int)j-1);
+    }
+    else
+        mexErrMsgTxt("The first input must be 'init', 'evaluate', 'add', or 'clear'.");
+}
@@ -0,0 +1,400 @@
+/* This c-mex function builds a vantage-point tree (VP-tree) over a set of points, and finds the
+ * K nearest neighbors (Euclidean distance) of a set of query points with the VP-tree.
+ *
+ * The VP-tree is stored implicitly in the order of points: the node of a range [lo,hi) of points is
+ * the vantage point Perm(lo); the points of the inside child [lo+1,mid) are not farther than Radius(lo)
+ * from the vantage point, and the points of the outside child [mid,hi) are not nearer than Radius(lo),
+ * where mid = lo+1+floor((hi-lo-1)/2). The ranges with at most LEAF_SIZE points are leaves.
+ *
+ * The search is exact if Epsilon is 0. If Epsilon>0, a child of a node is skipped when it cannot contain
+ * a point nearer than d/(1+Epsilon), where d is the distance of the current K-th nearest neighbor.
+ * Therefore, each returned distance is at most (1+Epsilon) times the exact distance, and larger values
+ * of Epsilon give faster and less accurate searches. Ties in distance are broken in favor of the points
+ * with smaller indices.
+ *
+ * Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+ *
+ * This file is a part of Fragments-Expert software, a software package for
+ * feature extraction from file fragments and classification among various file formats.
+ *
+ * Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Usage method:
+ *  [Perm,Radius] = kNN_VPTree_Core_FFC(X);                         (build the VP-tree)
+ *  [Idx,D] = kNN_VPTree_Core_FFC(X,Perm,Radius,Q,K,Epsilon);       (search the VP-tree)
+ *
+ * Inputs:
+ *  X: NxF matrix of N points
+ *  Perm: Nx1 uint32 vector of the indices of points (rows of X) in the order of VP-tree
+ *  Radius: Nx1 vector of the radii of the nodes of VP-tree
+ *  Q: LxF matrix of L query points
+ *  K: Number of nearest neighbors (1<=K<=N)
+ *  Epsilon: Relative error bound of the search (0 for exact search)
+ *
+ * Outputs:
+ *  Perm: Nx1 uint32 vector of the indices of points in the order of VP-tree
+ *  Radius: Nx1 vector of the radii of the nodes of VP-tree
+ *  Idx: LxK matrix of the indices of nearest neighbors (rows of X) sorted by distance
+ *  D: LxK matrix of the distances of nearest neighbors
+ *
+ * Compilation (OpenMP is optional):
+ *  mex -O COMPFLAGS="$COMPFLAGS /openmp" kNN_VPTree_Core_FFC.c              (Windows, MSVC)
+ *  mex -O CFLAGS="$CFLAGS -fopenmp" LDFLAGS="$LDFLAGS -fopenmp" kNN_VPTree_Core_FFC.c  (GCC)
+ *
+ * Revisions:
+ * 2026-Oct-18   function was created
+ */
+
+#include "mex.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define LEAF_SIZE 16        /* Maximum number of points in a leaf */
+#define ROUNDING_SLACK 1e-12 /* Relative slack of pruning, which guards the exact search against rounding errors */
+
+/* A point and its distance */
+typedef struct
+{
+    double d;
+    int i;
+} item;
+
+/* Global Variables */
+int N,F;
+double *Xp;             /* Points in the order of VP-tree (row-major) */
+int *Perm;              /* 0-based indices of points in the order of VP-tree */
+double *Radius;
+item *Items;
+unsigned int Seed;
+
+static double distance(const double *a,const double *b)
+{
+    double s = 0, t;
+    int f;
+    for (f=0;f<F;f++)
+    {
+        t = a[f]-b[f];
+        s += t*t;
+    }
+    return sqrt(s);
+}
+
+/* Partially sort Items[lo...hi-1] so that Items[k] is in its sorted position */
+void select_item(int lo,int hi,int k)
+{
+    item tmp;
+    double pivot;
+    int i,j;
+
+    hi--;
+    while (lo<hi)
+    {
+        pivot = Items[lo+(hi-lo)/2].d;
+        i = lo;
+        j = hi;
+        while (i<=j)
+        {
+            while (Items[i].d<pivot)
+                i++;
+            while (Items[j].d>pivot)
+                j--;
+            if (i<=j)
+            {
+                tmp = Items[i];
+                Items[i] = Items[j];
+                Items[j] = tmp;
+                i++;
+                j--;
+            }
+        }
+        if (k<=j)
+            hi = j;
+        else if (k>=i)
+            lo = i;
+        else
+            return;
+    }
+}
+
+/* Build the node of the range [lo,hi) */
+void build_node(const double *X,int lo,int hi)
+{
+    int j,v,mid;
+    double vp[64], *vpp;
+
+    if (hi-lo<=LEAF_SIZE)
+        return;
+
+    /* Random vantage point */
+    Seed = Seed*1103515245u+12345u;
+    v = lo+(int)((Seed>>8)%(unsigned int)(hi-lo));
+    j = Perm[lo];
+    Perm[lo] = Perm[v];
+    Perm[v] = j;
+
+    vpp = F<=64 ? vp : (double*) malloc(F*sizeof(double));
+    for (j=0;j<F;j++)
+        vpp[j] = X[Perm[lo]+(size_t)j*N];
+
+    /* Median distance from the vantage point */
+    for (j=lo+1;j<hi;j++)
+    {
+        double s = 0, t;
+        int f;
+        for (f=0;f<F;f++)
+        {
+            t = X[Perm[j]+(size_t)f*N]-vpp[f];
+            s += t*t;
+        }
+        Items[j].d = sqrt(s);
+        Items[j].i = Perm[j];
+    }
+    if (vpp!=vp)
+        free(vpp);
+
+    mid = lo+1+(hi-lo-1)/2;
+    select_item(lo+1,hi,mid);
+    for (j=lo+1;j<hi;j++)
+        Perm[j] = Items[j].i;
+    Radius[lo] = Items[mid].d;
+
+    build_node(X,lo+1,mid);
+    build_node(X,mid,hi);
+}
+
+/* (a.d,a.i) > (b.d,b.i) */
+static int item_greater(const item *a,const item *b)
+{
+    return a->d>b->d || (a->d==b->d && a->i>b->i);
+}
+
+/* Max-heap of the K nearest neighbors found so far */
+typedef struct
+{
+    item *h;
+    int n,K;
+} heap;
+
+static void heap_sift_down(heap *hp,int p)
+{
+    item tmp;
+    int c;
+    while ((c=2*p+1)<hp->n)
+    {
+        if (c+1<hp->n && item_greater(&hp->h[c+1],&hp->h[c]))
+            c++;
+        if (!item_greater(&hp->h[c],&hp->h[p]))
+            break;
+        tmp = hp->h[p];
+        hp->h[p] = hp->h[c];
+        hp->h[c] = tmp;
+        p = c;
+    }
+}
+
+static void heap_add(heap *hp,double d,int i)
+{
+    item x, tmp;
+    int p,c;
+    x.d = d;
+    x.i = i;
+    if (hp->n<hp->K)
+    {
+        c = hp->n++;
+        hp->h[c] = x;
+        while (c>0)
+        {
+            p = (c-1)/2;
+            if (!item_greater(&hp->h[c],&hp->h[p]))
+                break;
+            tmp = hp->h[p];
+            hp->h[p] = hp->h[c];
+            hp->h[c] = tmp;
+            c = p;
+        }
+    }
+    else if (item_greater(&hp->h[0],&x))
+    {
+        hp->h[0] = x;
+        heap_sift_down(hp,0);
+    }
+}
+
+/* Search the node of the range [lo,hi) */
+void search_node(const double *q,int lo,int hi,heap *hp,double shrink)
+{
+    int j,mid;
+    double dv,r,tau;
+
+    if (hi-lo<=LEAF_SIZE)
+    {
+        for (j=lo;j<hi;j++)
+            heap_add(hp,distance(q,Xp+(size_t)j*F),Perm[j]);
+        return;
+    }
+
+    dv = distance(q,Xp+(size_t)lo*F);
+    heap_add(hp,dv,Perm[lo]);
+    r = Radius[lo];
+    mid = lo+1+(hi-lo-1)/2;
+
+    if (dv<r)
+    {
+        search_node(q,lo+1,mid,hp,shrink);
+        tau = hp->n<hp->K ? HUGE_VAL : hp->h[0].d*shrink;
+        if (r-dv<=tau)
+            search_node(q,mid,hi,hp,shrink);
+    }
+    else
+    {
+        search_node(q,mid,hi,hp,shrink);
+        tau = hp->n<hp->K ? HUGE_VAL : hp->h[0].d*shrink;
+        if (dv-r<=tau)
+            search_node(q,lo+1,mid,hp,shrink);
+    }
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
+{
+    int L,K,i;
+    double *X,*Q,*Idx,*D,Epsilon,shrink;
+    unsigned int *p;
+
+    /* Check for the proper number of arguments. */
+    if (nrhs != 1 && nrhs != 6)
+        mexErrMsgTxt("One input (build) or six inputs (search) are required.");
+    if (nlhs > 2)
+        mexErrMsgTxt("No more than two outputs are required!");
+    if (!mxIsDouble(prhs[0]) || mxIsComplex(prhs[0]))
+        mexErrMsgTxt("Input X must be a real matrix of type double.\n");
+
+    N = (int) mxGetM(prhs[0]);
+    F = (int) mxGetN(prhs[0]);
+    X = mxGetPr(prhs[0]);
+
+    /* Build the VP-tree */
+    if (nrhs==1)
+    {
+        plhs[0] = mxCreateNumericMatrix(N, 1, mxUINT32_CLASS, mxREAL);
+        plhs[1] = mxCreateDoubleMatrix(N, 1, mxREAL);
+        p = (unsigned int*) mxGetData(plhs[0]);
+        Radius = mxGetPr(plhs[1]);
+
+        Perm = (int*) malloc((N>0?N:1)*sizeof(int));
+        Items = (item*) malloc((N>0?N:1)*sizeof(item));
+        for (i=0;i<N;i++)
+            Perm[i] = i;
+        Seed = 5489u;
+        build_node(X,0,N);
+
+        for (i=0;i<N;i++)
+            p[i] = (unsigned int) Perm[i]+1;
+
+        free(Perm);
+        free(Items);
+        Perm = NULL;
+        Items = NULL;
+        return;
+    }
+
+    /* Check inputs of search */
+    if (!mxIsUint32(prhs[1]) || (int)mxGetNumberOfElements(prhs[1])!=N)
+        mexErrMsgTxt("Input Perm must be a uint32 vector with one element for each point.\n");
+    for (i=2;i<6;i++)
+        if (!mxIsDouble(prhs[i]) || mxIsComplex(prhs[i]))
+            mexErrMsgTxt("Inputs Radius, Q, K, and Epsilon must be real values of type double.\n");
+    if ((int)mxGetNumberOfElements(prhs[2])!=N)
+        mexErrMsgTxt("Input Radius must have one element for each point.\n");
+    if ((int)mxGetN(prhs[3])!=F)
+        mexErrMsgTxt("The number of columns of Q and X must be the same.\n");
+
+    L = (int) mxGetM(prhs[3]);
+    Q = mxGetPr(prhs[3]);
+    K = (int) mxGetScalar(prhs[4]);
+    Epsilon = mxGetScalar(prhs[5]);
+    if (K<1 || K>N)
+        mexErrMsgTxt("Input K must be between 1 and the number of points.\n");
+    if (!(Epsilon>=0))
+        mexErrMsgTxt("Input Epsilon must be nonnegative.\n");
+    shrink = (1+ROUNDING_SLACK)/(1+Epsilon);
+
+    p = (unsigned int*) mxGetData(prhs[1]);
+    Radius = mxGetPr(prhs[2]);
+    Perm = (int*) malloc(N*sizeof(int));
+    Xp = (double*) malloc(((size_t)N*F+1)*sizeof(double));
+    for (i=0;i<N;i++)
+    {
+        int f;
+        if (p[i]<1 || p[i]>(unsigned int)N)
+        {
+            free(Perm);
+            free(Xp);
+            Perm = NULL;
+            Xp = NULL;
+            mexErrMsgTxt("Input Perm is not valid.\n");
+        }
+        Perm[i] = (int) p[i]-1;
+        for (f=0;f<F;f++)
+            Xp[(size_t)i*F+f] = X[Perm[i]+(size_t)f*N];
+    }
+
+    plhs[0] = mxCreateDoubleMatrix(L, K, mxREAL);
+    plhs[1] = mxCreateDoubleMatrix(L, K, mxREAL);
+    Idx = mxGetPr(plhs[0]);
+    D = mxGetPr(plhs[1]);
+
+    /* Search the query points */
+    #pragma omp parallel
+    {
+        double *q = (double*) malloc((F+1)*sizeof(double));
+        heap hp;
+        item tmp;
+        int r,f,k,n;
+
+        hp.h = (item*) malloc(K*sizeof(item));
+        hp.K = K;
+
+        #pragma omp for schedule(dynamic,64)
+        for (r=0;r<L;r++)
+        {
+            for (f=0;f<F;f++)
+                q[f] = Q[r+(size_t)f*L];
+            hp.n = 0;
+            search_node(q,0,N,&hp,shrink);
+
+            /* Sort the neighbors by distance */
+            for (n=hp.n-1;n>0;n--)
+            {
+                tmp = hp.h[0];
+                hp.h[0] = hp.h[n];
+                hp.h[n] = tmp;
+                hp.n = n;
+                heap_sift_down(&hp,0);
+            }
+            for (k=0;k<K;k++)
+            {
+                Idx[r+(size_t)k*L] = hp.h[k].i+1;
+                D[r+(size_t)k*L] = hp.h[k].d;
+            }
+        }
+
+        free(q);
+        free(hp.h);
+    }
+
+    free(Perm);
+    free(Xp);
+    Perm = NULL;
+    Xp = NULL;
+}
@@ -0,0 +1,93 @@
+function [Identical,ErrorMsg] = Check_ConvertFragmentDataset_FFC
+
+% This function checks that ConvertFragmentDataset_Core_FFC (C-MEX) and ConvertCSVtoDAT_mFile_FFC (MATLAB)
+% convert CSV fragment datasets to identical DAT files. The CSV test files contain blank rows (empty,
+% with spaces or commas only, with a carriage return, and as the last row without newline), which are
+% converted to fragments of length zero. With file identifiers, both functions must reject a blank row.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Outputs:
+%   Identical: True if the outputs of the two functions are identical for all test files
+%   ErrorMsg: Description of the first difference. If there is no difference, this output is empty.
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+Identical = false;
+ErrorMsg = '';
+if exist('ConvertFragmentDataset_Core_FFC','file')~=3
+    ErrorMsg = 'ConvertFragmentDataset_Core_FFC (C-MEX) is not available.';
+    return;
+end
+
+NL = char(10);
+CR = char(13);
+Tests = {
+    % Name, CSV contents, IncludedFileIdentifier
+    'blank rows',['1,2,3' NL NL '4,5' NL '  ' NL ',,' NL '255,0,300' NL CR NL '7' CR NL],false
+    'blank last row',['10,20' NL NL '30' NL ' '],false
+    'only a blank row',NL,false
+    'file identifiers',['5,1,2' NL '5,3' NL '6,4,5,6' CR NL '5,7' NL],true
+    'blank row with file identifiers',['5,1,2' NL NL '6,3' NL],true
+    };
+
+CSV_File = [tempname '.csv'];
+DAT_File_Native = [tempname '.dat'];
+DAT_File_MATLAB = [tempname '.dat'];
+
+%% Convert Test Files
+for t=1:size(Tests,1)
+
+    fid = fopen(CSV_File,'w');
+    fwrite(fid,Tests{t,2},'char');
+    fclose(fid);
+
+    try
+        ConvertFragmentDataset_Core_FFC('csv2dat',CSV_File,DAT_File_Native,Tests{t,3});
+        NativeFailed = false;
+    catch
+        NativeFailed = true;
+    end
+    [~,ErrMsg] = ConvertCSVtoDAT_mFile_FFC(CSV_File,DAT_File_MATLAB,Tests{t,3});
+    MATLABFailed = ~isempty(ErrMsg);
+
+    if NativeFailed~=MATLABFailed
+        ErrorMsg = sprintf('Test "%s": only one of the converters rejects the file.',Tests{t,1});
+        break;
+    end
+    if ~isequal(read_bytes(DAT_File_Native),read_bytes(DAT_File_MATLAB))
+        ErrorMsg = sprintf('Test "%s": the DAT files are different.',Tests{t,1});
+        break;
+    end
+
+end
+Identical = isempty(ErrorMsg);
+
+%% Delete Test Files
+delete(CSV_File);
+if exist(DAT_File_Native,'file')
+    delete(DAT_File_Native);
+end
+if exist(DAT_File_MATLAB,'file')
+    delete(DAT_File_MATLAB);
+end
+
+function x = read_bytes(FileName)
+% Contents of a file as a column vector of bytes
+fid = fopen(FileName,'r');
+x = fread(fid,Inf,'uint8=>uint8');
+fclose(fid);
@@ -0,0 +1,113 @@
+function [NumFragments,ErrorMsg] = ConvertCSVtoDAT_mFile_FFC(InputFile,OutputFile,IncludedFileIdentifier,ShowProgress)
+
+% This function converts a fragments dataset from CSV format (*.csv), where each row is a fragment,
+% to generic binary data format (*.dat) line by line. It is the MATLAB counterpart of
+% ConvertFragmentDataset_Core_FFC('csv2dat',...), and both functions give identical DAT files.
+%
+%   Note: A blank row is converted to a fragment of length zero. If the file identifier is
+%   included, a blank row has no file identifier and the conversion is aborted.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   InputFile: The name of the CSV file
+%   OutputFile: The name of the DAT file
+%   IncludedFileIdentifier: If true, the first value of each row is the file identifier, and
+%       fragment IDs are counted from one for each run of consecutive rows with the same file
+%       identifier. Otherwise, the i-th row gets file ID i and fragment ID 1.
+%   ShowProgress (optional): If true, the progress of the file is shown in the second bar of
+%       progressbar_FFC, and the process can be aborted by user (default: false).
+%
+% Outputs:
+%   NumFragments: The number of converted fragments
+%   ErrorMsg: Possible error message. If there is no error, this output is empty.
+%
+% Revisions:
+% 2026-Oct-18   function was created (from the loop of Script_ConvertCSVtoDATFragmentDataset_FFC)
+
+%% Initialization
+ErrorMsg = '';
+NumFragments = 0;
+if nargin<4
+    ShowProgress = false;
+end
+
+% Open csv file for reading
+fileID_Read = fopen(InputFile,'r');
+if fileID_Read<0
+    ErrorMsg = sprintf('Process is aborted. The file %s cannot be opened.',InputFile);
+    return;
+end
+
+% Length of file
+FileLength = GetFileSize_FFC(fileID_Read);
+
+% Open dat file for writing
+fileID_Write = fopen(OutputFile,'w');
+if fileID_Write<0
+    fclose(fileID_Read);
+    ErrorMsg = sprintf('Process is aborted. The file %s cannot be created.',OutputFile);
+    return;
+end
+
+%% Read Fragments and Write them to DAT Format
+curr_file_id = -1;
+file_id = 0;
+frg_id = 0;
+while ~feof(fileID_Read)
+
+    line = fgets(fileID_Read);
+
+    if ShowProgress
+        stopbar = progressbar_FFC(2,ftell(fileID_Read)/FileLength);
+        if stopbar
+            ErrorMsg = sprintf('Process is aborted by user.');
+            break;
+        end
+    end
+
+    if isequal(line,-1)
+        break; % Exit the loop at the end of the file
+    end
+    Fragment = str2num(line); %#ok<ST2NM>
+
+    if IncludedFileIdentifier
+        if isempty(Fragment)
+            ErrorMsg = sprintf('Process is aborted. A blank row of %s has no file identifier.',InputFile);
+            break;
+        end
+        file_id = Fragment(1);
+        if curr_file_id~=file_id
+            curr_file_id = file_id;
+            frg_id = 0;
+        end
+        frg_id = frg_id+1;
+        Fragment(1) = [];
+    else
+        file_id = file_id+1;
+        frg_id = 1;
+    end
+
+    fwrite(fileID_Write,file_id,'uint64',0,'b');
+    fwrite(fileID_Write,frg_id,'uint64',0,'b');
+    fwrite(fileID_Write,length(Fragment),'uint64',0,'b');
+    fwrite(fileID_Write,Fragment,'uint8',0,'b');
+    NumFragments = NumFragments+1;
+
+end
+
+%% Close files
+fclose(fileID_Write);
+fclose(fileID_Read);
@@ -0,0 +1,559 @@
+/* This c-mex function converts a fragments dataset from CSV format (*.csv), where each row is a
+ * fragment, to generic binary data format (*.dat), or vice versa. The input file is read in large
+ * chunks. Each chunk is split into slices of complete rows (or records) that are converted on
+ * multiple threads (if OpenMP is available), and the converted slices are written in their original
+ * order with one write per slice.
+ *
+ * The information about fragments in the generic binary data format is written consecutively as folows:
+ *   8 bytes for file ID written in ieee big-endian uint64 format
+ *   8 bytes for fragment ID written in ieee big-endian uint64 format
+ *   8 bytes for fragment length L (in bytes) written in ieee big-endian uint64 format
+ *   L bytes for fragment contents
+ *
+ * Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+ *
+ * This file is a part of Fragments-Expert software, a software package for
+ * feature extraction from file fragments and classification among various file formats.
+ *
+ * Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Usage method: NumFragments = ConvertFragmentDataset_Core_FFC(Direction,InputFile,OutputFile,FileIdentifier);
+ *
+ * Inputs:
+ *  Direction: 'csv2dat' or 'dat2csv'
+ *  InputFile: The name of the input file
+ *  OutputFile: The name of the output file
+ *  FileIdentifier: If nonzero, the first value of each row of the CSV file is the file identifier.
+ *      - csv2dat: If FileIdentifier is nonzero, fragment IDs are counted from one for each run of
+ *          consecutive rows with the same file identifier. Otherwise, the i-th row gets file ID i
+ *          and fragment ID 1. As in the MATLAB conversion, a blank row is a fragment of length zero
+ *          (if FileIdentifier is nonzero, a blank row has no file identifier and it is an error).
+ *      - dat2csv: If FileIdentifier is nonzero, the file ID is written at the beginning of each row.
+ *
+ * Output:
+ *  NumFragments: The number of converted fragments
+ *
+ * Compilation (OpenMP is optional):
+ *  mex -O COMPFLAGS="$COMPFLAGS /openmp" ConvertFragmentDataset_Core_FFC.c              (Windows, MSVC)
+ *  mex -O CFLAGS="$CFLAGS -fopenmp" LDFLAGS="$LDFLAGS -fopenmp" ConvertFragmentDataset_Core_FFC.c  (GCC)
+ *
+ * Revisions:
+ * 2026-Oct-18   function was created
+ * 2026-Oct-18   blank rows are converted to fragments of length zero (as in the MATLAB conversion)
+ * 2026-Oct-18   allocations are checked, and a record longer than the rest of the input file is rejected
+ */
+
+#define _FILE_OFFSET_BITS 64
+#include "mex.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(_MSC_VER)
+#define fseek64 _fseeki64
+#define ftell64 _ftelli64
+#else
+#define fseek64 fseeko
+#define ftell64 ftello
+#endif
+
+#define CHUNK_SIZE (64*1024*1024)
+#define SLICES_PER_THREAD 4
+
+/* A converted slice of a chunk */
+typedef struct
+{
+    size_t begin,end;       /* input range */
+    unsigned char *out;     /* converted data */
+    size_t outlen;
+    int64_t nrec;           /* number of records */
+    uint64_t *file_id;      /* csv2dat: file ID of each record */
+    size_t *hdr;            /* csv2dat: offset of the header of each record in out */
+    int failed;
+    int blank;              /* csv2dat: a blank row was found while FileIdentifier is nonzero */
+} slice;
+
+/* Number to text for byte values */
+char ByteText[256][4];
+int ByteTextLen[256];
+
+void write_uint64_be(unsigned char *buf,uint64_t v)
+{
+    int i;
+    for (i=7;i>=0;i--)
+    {
+        buf[i] = (unsigned char)(v&0xFF);
+        v >>= 8;
+    }
+}
+
+uint64_t read_uint64_be(const unsigned char *buf)
+{
+    uint64_t v = 0;
+    int i;
+    for (i=0;i<8;i++)
+        v = (v<<8)|buf[i];
+    return v;
+}
+
+/* Parse the next number of a row. Returns 0 if there is no more number in the row.
+ * Integers are parsed by hand; other forms (e.g. 1.5e+03) are parsed by strtod. */
+int parse_number(const char **p,const char *end,double *val)
+{
+    const char *s = *p, *digits;
+    uint64_t v;
+    int neg;
+    char tmp[64];
+    size_t n;
+
+    while (s<end && (*s==',' || *s==' ' || *s=='\t' || *s=='\r'))
+        s++;
+    if (s>=end || *s=='\n')
+    {
+        *p = s;
+        return 0;
+    }
+
+    neg = 0;
+    if (*s=='-' || *s=='+')
+    {
+        neg = (*s=='-');
+        s++;
+    }
+    v = 0;
+    digits = s;
+    while (s<end && *s>='0' && *s<='9')
+        v = v*10+(uint64_t)(*s++-'0');
+
+    if (s==digits || (s<end && *s!=',' && *s!=' ' && *s!='\t' && *s!='\r' && *s!='\n'))
+    {
+        /* Fall back to strtod */
+        const char *t = *p;
+        while (t<end && (*t==',' || *t==' ' || *t=='\t' || *t=='\r'))
+            t++;
+        n = 0;
+        while (t<end && n<sizeof(tmp)-1 && *t!=',' && *t!=' ' && *t!='\t' && *t!='\r' && *t!='\n')
+            tmp[n++] = *t++;
+        tmp[n] = 0;
+        *val = strtod(tmp,NULL);
+        *p = t;
+        return 1;
+    }
+
+    *val = neg ? -(double)v : (double)v;
+    *p = s;
+    return 1;
+}
+
+/* Value of a byte as it is written by fwrite (rounded and saturated) */
+unsigned char to_byte(double x)
+{
+    x = floor(x+0.5);
+    if (x<0)
+        return 0;
+    if (x>255)
+        return 255;
+    return (unsigned char) x;
+}
+
+/* csv2dat: convert the rows of buf[sl->begin,sl->end) */
+void convert_csv_slice(const char *buf,slice *sl,int FileIdentifier)
+{
+    const char *p = buf+sl->begin, *end = buf+sl->end, *q;
+    size_t nlines = 0, cap, o, len;
+    double val;
+    int64_t r;
+
+    for (q=p;q<end;q++)
+        if (*q=='\n')
+            nlines++;
+    nlines++;
+
+    cap = (sl->end-sl->begin)+24*nlines+16;
+    sl->out = (unsigned char*) malloc(cap);
+    sl->file_id = (uint64_t*) malloc(nlines*sizeof(uint64_t));
+    sl->hdr = (size_t*) malloc(nlines*sizeof(size_t));
+    if (sl->out==NULL || sl->file_id==NULL || sl->hdr==NULL)
+    {
+        sl->failed = 1;
+        return;
+    }
+
+    o = 0;
+    r = 0;
+    while (p<end)
+    {
+        /* A blank row is a fragment of length zero */
+        if (!parse_number(&p,end,&val))
+        {
+            if (FileIdentifier)
+            {
+                sl->blank = 1;
+                break;
+            }
+            sl->hdr[r] = o;
+            o += 24;
+            sl->file_id[r] = 0;
+            write_uint64_be(sl->out+sl->hdr[r]+16,0);
+            r++;
+            if (p<end)
+                p++; /* '\n' */
+            continue;
+        }
+
+        sl->hdr[r] = o;
+        o += 24;
+        if (FileIdentifier)
+            sl->file_id[r] = (uint64_t) floor(val+0.5);
+        else
+        {
+            sl->file_id[r] = 0;
+            sl->out[o++] = to_byte(val);
+        }
+        while (parse_number(&p,end,&val))
+            sl->out[o++] = to_byte(val);
+        if (p<end)
+            p++; /* '\n' */
+
+        len = o-sl->hdr[r]-24;
+        write_uint64_be(sl->out+sl->hdr[r]+16,(uint64_t)len);
+        r++;
+    }
+
+    sl->outlen = o;
+    sl->nrec = r;
+}
+
+/* dat2csv: convert the records of buf[sl->begin,sl->end) */
+void convert_dat_slice(const unsigned char *buf,slice *sl,int FileIdentifier)
+{
+    size_t pos = sl->begin, cap, o, L, i;
+    uint64_t id;
+    char tmp[32];
+    int n;
+
+    cap = 5*(sl->end-sl->begin)+64;
+    sl->out = (unsigned char*) malloc(cap);
+    if (sl->out==NULL)
+    {
+        sl->failed = 1;
+        return;
+    }
+
+    o = 0;
+    while (pos<sl->end)
+    {
+        id = read_uint64_be(buf+pos);
+        L = (size_t) read_uint64_be(buf+pos+16);
+        pos += 24;
+
+        if (FileIdentifier)
+        {
+            n = sprintf(tmp,"%llu",(unsigned long long)id);
+            memcpy(sl->out+o,tmp,n);
+            o += n;
+            if (L>0)
+                sl->out[o++] = ',';
+        }
+        for (i=0;i<L;i++)
+        {
+            memcpy(sl->out+o,ByteText[buf[pos+i]],4);
+            o += ByteTextLen[buf[pos+i]];
+            sl->out[o++] = ',';
+        }
+        if (L>0)
+            o--; /* the last comma */
+        sl->out[o++] = '\n';
+
+        pos += L;
+        sl->nrec++;
+    }
+
+    sl->outlen = o;
+}
+
+void free_slices(slice *sl,int n)
+{
+    int i;
+    for (i=0;i<n;i++)
+    {
+        free(sl[i].out);
+        free(sl[i].file_id);
+        free(sl[i].hdr);
+    }
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
+{
+    char *Direction,*InputFile,*OutputFile,errmsg[256];
+    int FileIdentifier,csv2dat,nslices,maxslices,s,eof;
+    FILE *fin,*fout;
+    unsigned char *buf,*newbuf;
+    size_t bufcap,have,got,used,step,pos,L,k;
+    int64_t FileLength,consumed;
+    slice *sl;
+    int64_t NumFragments,file_counter,frg_id;
+    uint64_t curr_file_id;
+    int have_curr;
+
+    /* Check for the proper number of arguments. */
+    if (nrhs != 4)
+        mexErrMsgTxt("Four inputs are required.");
+    if (nlhs > 1)
+        mexErrMsgTxt("No more than one output is required!");
+    if (!mxIsChar(prhs[0]) || !mxIsChar(prhs[1]) || !mxIsChar(prhs[2]))
+        mexErrMsgTxt("Direction, InputFile and OutputFile must be strings.\n");
+
+    Direction = mxArrayToString(prhs[0]);
+    csv2dat = (strcmp(Direction,"csv2dat")==0);
+    if (!csv2dat && strcmp(Direction,"dat2csv")!=0)
+    {
+        mxFree(Direction);
+        mexErrMsgTxt("Direction must be 'csv2dat' or 'dat2csv'.\n");
+    }
+    mxFree(Direction);
+    FileIdentifier = (mxGetScalar(prhs[3])!=0);
+
+    /* Text of byte values */
+    for (s=0;s<256;s++)
+    {
+        memset(ByteText[s],0,4);
+        ByteTextLen[s] = sprintf(ByteText[s],"%d",s);
+    }
+
+    /* Open files */
+    InputFile = mxArrayToString(prhs[1]);
+    OutputFile = mxArrayToString(prhs[2]);
+    fin = fopen(InputFile,"rb");
+    fout = (fin!=NULL) ? fopen(OutputFile,"wb") : NULL;
+    mxFree(InputFile);
+    mxFree(OutputFile);
+    if (fin==NULL)
+        mexErrMsgTxt("The input file cannot be opened.\n");
+    if (fout==NULL)
+    {
+        fclose(fin);
+        mexErrMsgTxt("The output file cannot be opened.\n");
+    }
+
+#ifdef _OPENMP
+    maxslices = SLICES_PER_THREAD*omp_get_max_threads();
+#else
+    maxslices = 1;
+#endif
+    sl = (slice*) calloc(maxslices,sizeof(slice));
+    bufcap = CHUNK_SIZE;
+    buf = (unsigned char*) malloc(bufcap+1);
+    if (sl==NULL || buf==NULL)
+    {
+        free(sl);
+        free(buf);
+        fclose(fin);
+        fclose(fout);
+        mexErrMsgTxt("Out of memory.\n");
+    }
+
+    /* Length of input file (the length of a record cannot exceed the rest of the file) */
+    fseek64(fin,0,SEEK_END);
+    FileLength = (int64_t) ftell64(fin);
+    fseek64(fin,0,SEEK_SET);
+    consumed = 0;
+
+    errmsg[0] = 0;
+    NumFragments = 0;
+    file_counter = 0;
+    frg_id = 0;
+    curr_file_id = 0;
+    have_curr = 0;
+    have = 0;
+    eof = 0;
+    while (!eof || have>0)
+    {
+        /* Fill the buffer */
+        if (!eof)
+        {
+            got = fread(buf+have,1,bufcap-have,fin);
+            have += got;
+            if (have<bufcap)
+                eof = 1;
+        }
+
+        /* Find the part of buffer that contains complete rows (or records) */
+        if (csv2dat)
+        {
+            if (eof)
+                used = have;
+            else
+            {
+                used = have;
+                while (used>0 && buf[used-1]!='\n')
+                    used--;
+                if (used==0) /* a row longer than the buffer */
+                {
+                    newbuf = (unsigned char*) realloc(buf,2*bufcap+1);
+                    if (newbuf==NULL)
+                    {
+                        strcpy(errmsg,"Out of memory.\n");
+                        break;
+                    }
+                    buf = newbuf;
+                    bufcap *= 2;
+                    continue;
+                }
+            }
+        }
+        else
+        {
+            used = 0;
+            while (used+24<=have)
+            {
+                if (read_uint64_be(buf+used+16)>(uint64_t)(FileLength-consumed-(int64_t)used-24))
+                {
+                    strcpy(errmsg,"The length of a record exceeds the size of the input file.\n");
+                    break;
+                }
+                L = (size_t) read_uint64_be(buf+used+16);
+                if (used+24+L>have)
+                    break;
+                used += 24+L;
+            }
+            if (errmsg[0] && used==0)
+                break;
+            if (used==0 && !eof) /* a record longer than the buffer */
+            {
+                newbuf = (unsigned char*) realloc(buf,2*bufcap+1);
+                if (newbuf==NULL)
+                {
+                    strcpy(errmsg,"Out of memory.\n");
+                    break;
+                }
+                buf = newbuf;
+                bufcap *= 2;
+                continue;
+            }
+            if (eof && used<have && !errmsg[0])
+            {
+                strcpy(errmsg,"The input file ends with an incomplete record.\n");
+                have = used;
+            }
+        }
+        if (used==0)
+            break;
+
+        /* Split into slices at row (or record) boundaries */
+        nslices = 0;
+        step = used/maxslices+1;
+        pos = 0;
+        while (pos<used)
+        {
+            sl[nslices].begin = pos;
+            if (csv2dat)
+            {
+                pos = (pos+step<used) ? pos+step : used;
+                while (pos<used && buf[pos-1]!='\n')
+                    pos++;
+            }
+            else
+            {
+                k = pos;
+                while (pos<used && pos-k<step)
+                    pos += 24+(size_t) read_uint64_be(buf+pos+16);
+            }
+            sl[nslices].end = pos;
+            sl[nslices].out = NULL;
+            sl[nslices].file_id = NULL;
+            sl[nslices].hdr = NULL;
+            sl[nslices].outlen = 0;
+            sl[nslices].nrec = 0;
+            sl[nslices].failed = 0;
+            sl[nslices].blank = 0;
+            nslices++;
+        }
+
+        /* Convert slices in parallel */
+        #pragma omp parallel for schedule(dynamic,1)
+        for (s=0;s<nslices;s++)
+        {
+            if (csv2dat)
+                convert_csv_slice((const char*)buf,&sl[s],FileIdentifier);
+            else
+                convert_dat_slice(buf,&sl[s],FileIdentifier);
+        }
+
+        /* Write slices in order (file and fragment IDs are assigned sequentially) */
+        for (s=0;s<nslices;s++)
+        {
+            if (sl[s].failed)
+            {
+                strcpy(errmsg,"Out of memory.\n");
+                break;
+            }
+            if (csv2dat)
+                for (k=0;k<(size_t)sl[s].nrec;k++)
+                {
+                    if (FileIdentifier)
+                    {
+                        if (!have_curr || curr_file_id!=sl[s].file_id[k])
+                        {
+                            curr_file_id = sl[s].file_id[k];
+                            have_curr = 1;
+                            frg_id = 0;
+                        }
+                        frg_id++;
+                        write_uint64_be(sl[s].out+sl[s].hdr[k],curr_file_id);
+                        write_uint64_be(sl[s].out+sl[s].hdr[k]+8,(uint64_t)frg_id);
+                    }
+                    else
+                    {
+                        file_counter++;
+                        write_uint64_be(sl[s].out+sl[s].hdr[k],(uint64_t)file_counter);
+                        write_uint64_be(sl[s].out+sl[s].hdr[k]+8,1);
+                    }
+                }
+            if (sl[s].outlen>0 && fwrite(sl[s].out,1,sl[s].outlen,fout)!=sl[s].outlen)
+            {
+                strcpy(errmsg,"Writing into the output file failed.\n");
+                break;
+            }
+            NumFragments += sl[s].nrec;
+            if (sl[s].blank)
+            {
+                strcpy(errmsg,"A blank row has no file identifier.\n");
+                break;
+            }
+        }
+        free_slices(sl,nslices);
+        if (errmsg[0])
+            break;
+
+        /* Keep the incomplete row (or record) for the next chunk */
+        memmove(buf,buf+used,have-used);
+        have -= used;
+        consumed += (int64_t) used;
+    }
+
+    /* Free memory */
+    free(buf);
+    free(sl);
+    fclose(fin);
+    fclose(fout);
+
+    if (errmsg[0])
+        mexErrMsgTxt(errmsg);
+
+    plhs[0] = mxCreateDoubleScalar((double) NumFragments);
+
+    return;
+}
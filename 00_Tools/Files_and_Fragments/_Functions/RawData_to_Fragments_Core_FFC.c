@@ -0,0 +1,341 @@
+/* This c-mex function takes random fragments from a list of files and writes them directly into a
+ * binary file in the generic binary data format (*.dat). It is the native counterpart of calling
+ * TakeRandomFragments_FFC for each file in Script_RawData_to_Fragments_FFC:
+ *   - The files are processed in parallel (if OpenMP is available), while the fragments are
+ *       written in the order of files.
+ *   - The positions of packets are sampled with the same semantics as TakeRandomFragments_FFC
+ *       (random packet sizes, discarding BOF and EOF, and at most MaxFragment fragments in random order).
+ *       The candidate packets are sampled on the fly (reservoir sampling), so that the memory does not
+ *       depend on the file size.
+ *   - The selected packets are read in the order of their offsets.
+ *
+ * The information about fragments is written consecutively as folows:
+ *   8 bytes for file ID written in ieee big-endian uint64 format
+ *   8 bytes for fragment ID written in ieee big-endian uint64 format
+ *   8 bytes for fragment length L (in bytes) written in ieee big-endian uint64 format
+ *   L bytes for fragment contents
+ *
+ * Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+ *
+ * This file is a part of Fragments-Expert software, a software package for
+ * feature extraction from file fragments and classification among various file formats.
+ *
+ * Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Usage method: NumFragments = RawData_to_Fragments_Core_FFC(Filenames,datFilename,PossiblePacketSizes,DisregardBOF,DisregardEOF,MaxFragment,Seed);
+ *
+ * Inputs:
+ *  Filenames: 1xN cell that contains the name of files (the file ID of the i-th file is i)
+ *  datFilename: The name of the output binary file
+ *  PossiblePacketSizes: 1xn vector that contains the possible values for packet size
+ *  DisregardBOF: A number in interval (0,1) that specifies the percent of fragments from begining of file which should be discarded
+ *  DisregardEOF: A number in interval (0,1) that specifies the percent of fragments from end of file which should be discarded
+ *  MaxFragment: Maximum number of fragments taken from a file
+ *  Seed: Seed of the random number generator. The random sequence of the i-th file depends only on Seed and i.
+ *
+ * Output:
+ *  NumFragments: 1xN vector that contains the number of fragments taken from each file
+ *      (-1 if the file cannot be opened)
+ *
+ * Compilation (OpenMP is optional):
+ *  mex -O COMPFLAGS="$COMPFLAGS /openmp" RawData_to_Fragments_Core_FFC.c              (Windows, MSVC)
+ *  mex -O CFLAGS="$CFLAGS -fopenmp" LDFLAGS="$LDFLAGS -fopenmp" RawData_to_Fragments_Core_FFC.c  (GCC)
+ *
+ * Revisions:
+ * 2026-Oct-18   function was created
+ * 2026-Oct-18   allocation failures of the buffers of threads are reported
+ */
+
+#define _FILE_OFFSET_BITS 64
+#include "mex.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(_MSC_VER)
+#define fseek64 _fseeki64
+#define ftell64 _ftelli64
+#else
+#define fseek64 fseeko
+#define ftell64 ftello
+#endif
+
+/* Global Variables */
+int nSizes;
+int *PacketSizes;
+double DisregardBOF,DisregardEOF;
+int MaxFragment;
+uint64_t Seed;
+
+/* A selected packet */
+typedef struct
+{
+    int64_t pos;
+    int len;
+    int k;      /* fragment ID - 1 */
+} packet;
+
+/* Random number generator (splitmix64) */
+uint64_t next_random(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z^(z>>30))*0xBF58476D1CE4E5B9ULL;
+    z = (z^(z>>27))*0x94D049BB133111EBULL;
+    return z^(z>>31);
+}
+
+/* Uniform random integer in [0,n-1] */
+int64_t random_index(uint64_t *state,int64_t n)
+{
+    return (int64_t)(next_random(state)%(uint64_t)n);
+}
+
+int compare_pos(const void *a,const void *b)
+{
+    int64_t pa = ((const packet*)a)->pos, pb = ((const packet*)b)->pos;
+    return (pa>pb)-(pa<pb);
+}
+
+/* Select at most MaxFragment random packets of a file with given length.
+ * Packet positions are 0, s1, s1+s2, ... with random sizes s taken from PacketSizes,
+ * until the position reaches FileLength. A position p is kept if p>FileLength*DisregardBOF
+ * and p<=FileLength*(1-DisregardEOF). Each kept position which is followed by another kept
+ * position is a candidate. Returns the number of selected packets. */
+int select_packets(int64_t FileLength,uint64_t *rng,packet *sel)
+{
+    int64_t p,prev,NumCandidates,r;
+    double lo = FileLength*DisregardBOF, hi = FileLength-FileLength*DisregardEOF;
+    int nsel = 0, i;
+    packet tmp;
+
+    p = 0;
+    prev = -1;
+    NumCandidates = 0;
+    while (1)
+    {
+        if (p>lo && p<=hi)
+        {
+            if (prev>=0)
+            {
+                /* prev is a candidate (reservoir sampling) */
+                NumCandidates++;
+                if (nsel<MaxFragment)
+                    r = nsel++;
+                else
+                    r = random_index(rng,NumCandidates);
+                if (r<MaxFragment)
+                {
+                    sel[r].pos = prev;
+                    sel[r].len = (int)(p-prev);
+                }
+            }
+            prev = p;
+        }
+        if (p>=FileLength)
+            break;
+        p += PacketSizes[random_index(rng,nSizes)];
+    }
+
+    /* Random order of fragments */
+    for (i=nsel-1;i>0;i--)
+    {
+        r = random_index(rng,i+1);
+        tmp = sel[i]; sel[i] = sel[r]; sel[r] = tmp;
+    }
+    for (i=0;i<nsel;i++)
+        sel[i].k = i;
+
+    return nsel;
+}
+
+void write_uint64_be(unsigned char *buf,uint64_t v)
+{
+    int i;
+    for (i=7;i>=0;i--)
+    {
+        buf[i] = (unsigned char)(v&0xFF);
+        v >>= 8;
+    }
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
+{
+    char **Filenames,*datFilename;
+    double *sizes,*NumFragments;
+    int N,i,j,maxSize,writeFailed,memFailed;
+    FILE *out;
+
+    /* Check for the proper number of arguments. */
+    if (nrhs != 7)
+        mexErrMsgTxt("Seven inputs are required.");
+    if (nlhs > 1)
+        mexErrMsgTxt("No more than one output is required!");
+
+    /* Check inputs */
+    if (!mxIsCell(prhs[0]))
+        mexErrMsgTxt("Filenames must be a cell array.\n");
+    if (!mxIsChar(prhs[1]))
+        mexErrMsgTxt("datFilename must be a string.\n");
+    if (!mxIsDouble(prhs[2]) || mxIsEmpty(prhs[2]))
+        mexErrMsgTxt("PossiblePacketSizes must be a nonempty real vector.\n");
+
+    N = (int) mxGetNumberOfElements(prhs[0]);
+    nSizes = (int) mxGetNumberOfElements(prhs[2]);
+    sizes = mxGetPr(prhs[2]);
+    DisregardBOF = mxGetScalar(prhs[3]);
+    DisregardEOF = mxGetScalar(prhs[4]);
+    MaxFragment = (int) mxGetScalar(prhs[5]);
+    Seed = (uint64_t) mxGetScalar(prhs[6]);
+    if (MaxFragment<1)
+        mexErrMsgTxt("MaxFragment must be positive.\n");
+
+    PacketSizes = (int*) malloc(nSizes*sizeof(int));
+    if (PacketSizes==NULL)
+        mexErrMsgTxt("Out of memory.\n");
+    maxSize = 0;
+    for (j=0;j<nSizes;j++)
+    {
+        PacketSizes[j] = (int) sizes[j];
+        if (PacketSizes[j]<1)
+        {
+            free(PacketSizes);
+            mexErrMsgTxt("Packet sizes must be positive.\n");
+        }
+        if (PacketSizes[j]>maxSize)
+            maxSize = PacketSizes[j];
+    }
+
+    /* Get file names */
+    for (i=0;i<N;i++)
+        if (!mxIsChar(mxGetCell(prhs[0],i)))
+        {
+            free(PacketSizes);
+            mexErrMsgTxt("Filenames must contain strings.\n");
+        }
+    Filenames = (char**) malloc(N*sizeof(char*));
+    if (Filenames==NULL)
+    {
+        free(PacketSizes);
+        mexErrMsgTxt("Out of memory.\n");
+    }
+    for (i=0;i<N;i++)
+        Filenames[i] = mxArrayToString(mxGetCell(prhs[0],i));
+    datFilename = mxArrayToString(prhs[1]);
+
+    /* Open output file */
+    out = fopen(datFilename,"wb");
+    if (out==NULL)
+    {
+        for (i=0;i<N;i++)
+            mxFree(Filenames[i]);
+        free(Filenames);
+        free(PacketSizes);
+        mxFree(datFilename);
+        mexErrMsgTxt("The output file cannot be opened.\n");
+    }
+
+    plhs[0] = mxCreateDoubleMatrix(1, N, mxREAL);
+    NumFragments = mxGetPr(plhs[0]);
+    writeFailed = 0;
+    memFailed = 0;
+
+    /* Process files in parallel, write in the order of files */
+    #pragma omp parallel
+    {
+        packet *sel = (packet*) malloc(MaxFragment*sizeof(packet));
+        unsigned char *data = (unsigned char*) malloc((size_t)MaxFragment*(maxSize+24));
+        size_t *offset = (size_t*) malloc((MaxFragment+1)*sizeof(size_t));
+        int ii,k,nsel;
+
+        /* After an allocation failure, the threads still take part in the loop (as required by ordered),
+         * but no file is processed */
+        if (sel==NULL || data==NULL || offset==NULL)
+        {
+            #pragma omp critical (raw_memory)
+            memFailed = 1;
+        }
+        #pragma omp barrier
+
+        #pragma omp for ordered schedule(dynamic,1)
+        for (ii=0;ii<N;ii++)
+        {
+            FILE *fid;
+            int64_t FileLength;
+            uint64_t rng = Seed*0x100000001B3ULL+(uint64_t)ii;
+            size_t got;
+
+            nsel = -1;
+            fid = memFailed ? NULL : fopen(Filenames[ii],"rb");
+            if (fid!=NULL)
+            {
+                /* Get file size */
+                fseek64(fid,0,SEEK_END);
+                FileLength = (int64_t) ftell64(fid);
+
+                /* Select packets */
+                nsel = select_packets(FileLength,&rng,sel);
+
+                /* Offsets of fragments in the output buffer (in the order of fragment IDs) */
+                offset[0] = 0;
+                for (k=0;k<nsel;k++)
+                    offset[k+1] = offset[k]+24+sel[k].len;
+                for (k=0;k<nsel;k++)
+                {
+                    unsigned char *rec = data+offset[k];
+                    write_uint64_be(rec,(uint64_t)(ii+1));
+                    write_uint64_be(rec+8,(uint64_t)(k+1));
+                    write_uint64_be(rec+16,(uint64_t)sel[k].len);
+                }
+
+                /* Read packets in the order of offsets (the last packet may be padded with zeros) */
+                qsort(sel,nsel,sizeof(packet),compare_pos);
+                for (k=0;k<nsel;k++)
+                {
+                    unsigned char *frg = data+offset[sel[k].k]+24;
+                    fseek64(fid,sel[k].pos,SEEK_SET);
+                    got = fread(frg,1,sel[k].len,fid);
+                    if (got<(size_t)sel[k].len)
+                        memset(frg+got,0,sel[k].len-got);
+                }
+                fclose(fid);
+            }
+
+            #pragma omp ordered
+            {
+                NumFragments[ii] = (double) nsel;
+                if (nsel>0 && fwrite(data,1,offset[nsel],out)!=offset[nsel])
+                    writeFailed = 1;
+            }
+        }
+
+        free(sel);
+        free(data);
+        free(offset);
+    }
+
+    /* Free memory */
+    fclose(out);
+    for (i=0;i<N;i++)
+        mxFree(Filenames[i]);
+    free(Filenames);
+    free(PacketSizes);
+    mxFree(datFilename);
+
+    if (memFailed)
+        mexErrMsgTxt("Out of memory.\n");
+    if (writeFailed)
+        mexErrMsgTxt("Writing into the output file failed.\n");
+
+    return;
+}
@@ -0,0 +1,58 @@
+function Profile = Add_GenerationProfile_FFC(Profile,Batch,FunctionIndex,NumFragments,Bytes,WallTime,CPUTime,BufferBytes)
+
+% This function adds a record to the profile of dataset generation (see Init_GenerationProfile_FFC).
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Profile: The profile of dataset generation
+%   Batch: Index of batch
+%   FunctionIndex: Index of feature extraction function (compute phase), 0 (read phase), or -1 (write phase)
+%   NumFragments: Number of fragments of the batch
+%   Bytes: Number of bytes of the fragments of the batch
+%   WallTime: Wall-clock time (seconds)
+%   CPUTime: CPU time of MATLAB client (seconds)
+%   BufferBytes: Memory of the buffers of fragments and features (bytes)
+%       Note: If this input is not provided, the peak buffer memory is not updated.
+%
+% Output:
+%   Profile: The updated profile
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Increase Capacity
+n = Profile.NumRecords+1;
+if n>length(Profile.Batch)
+    Capacity = 2*length(Profile.Batch);
+    Profile.Batch(Capacity,1) = 0;
+    Profile.FunctionIndex(Capacity,1) = 0;
+    Profile.NumFragments(Capacity,1) = 0;
+    Profile.Bytes(Capacity,1) = 0;
+    Profile.WallTime(Capacity,1) = 0;
+    Profile.CPUTime(Capacity,1) = 0;
+end
+
+%% Add Record
+Profile.Batch(n) = Batch;
+Profile.FunctionIndex(n) = FunctionIndex;
+Profile.NumFragments(n) = NumFragments;
+Profile.Bytes(n) = Bytes;
+Profile.WallTime(n) = WallTime;
+Profile.CPUTime(n) = CPUTime;
+Profile.NumRecords = n;
+if nargin>7
+    Profile.PeakBufferBytes = max(Profile.PeakBufferBytes,BufferBytes);
+end
@@ -0,0 +1,47 @@
+function Available = Banded_LCS_Available_FFC(Kernel)
+
+% This function checks whether the C-MEX file of an LCS kernel supports the approximate mode (the third input Band).
+% The C-MEX files which are built from the sources before the approximate mode only accept two inputs.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Input:
+%   Kernel: The name of the C-MEX function ('LCSSeq_FFC' or 'LCSStr_FFC')
+%
+% Output:
+%   Available: True if the C-MEX file of Kernel exists and accepts a band width
+%
+%   Note: The result is kept for the next calls (until the function is cleared).
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+persistent Checked
+if isempty(Checked)
+    Checked = struct;
+end
+
+if ~isfield(Checked,Kernel)
+    Available = false;
+    if exist(Kernel,'file')==3
+        try
+            feval(Kernel,[1 2],[1 2],1);
+            Available = true;
+        catch
+        end
+    end
+    Checked.(Kernel) = Available;
+end
+Available = Checked.(Kernel);
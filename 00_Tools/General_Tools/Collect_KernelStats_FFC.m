@@ -0,0 +1,98 @@
+function [Stats,Totals,ErrorMsg] = Collect_KernelStats_FFC(fragments,KernelName,varargin)
+
+% This function calls a C-MEX kernel in its instrumentation mode for a batch of fragments, and collects
+% the counters of the work done by the kernel for each fragment (e.g. for finding the fragments with
+% pathological cost, or tuning the parameters of the kernel).
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   fragments: Cell array with length M consisting of row vectors of byte values
+%   KernelName: Name of the kernel: 'lyap_exp_k_FFC', 'false_nearest_FFC', 'kolmogorov_FFC',
+%       'LCSSeq_FFC', or 'LCSStr_FFC'
+%   varargin: The other inputs of the kernel (after the fragment). For 'LCSSeq_FFC' and 'LCSStr_FFC',
+%       the input is a cell array of representative fragments, and the counters are summed over the
+%       representatives; the band width of the approximate mode can be given as the next input.
+%
+% Outputs:
+%   Stats: 1xM structure array of the counters for the fragments (see the help of the kernel)
+%   Totals: A structure with the same fields as Stats; each field is the sum of the counters over the fragments
+%       (the maximum for Epsilon, Method, and the fields that begin with Max)
+%   ErrorMsg: Possible error message. If there is no error, this output is empty.
+%
+%   Note: The kernel should be compiled in the instrumentation mode (e.g. mex -O -DKERNEL_STATS lyap_exp_k_FFC.c).
+%
+% Revisions:
+% 2026-Oct-18   function was created
+% 2026-Oct-18   band width of the approximate mode of LCS kernels can be given
+
+%% Initialization
+Stats = [];
+Totals = [];
+ErrorMsg = '';
+
+KernelNames = {'lyap_exp_k_FFC','false_nearest_FFC','kolmogorov_FFC','LCSSeq_FFC','LCSStr_FFC'};
+if ~any(strcmp(KernelName,KernelNames))
+    ErrorMsg = sprintf('%s is not an instrumented kernel.',KernelName);
+    return;
+end
+if exist(KernelName,'file')~=3
+    ErrorMsg = sprintf('C-MEX function %s is not available.',KernelName);
+    return;
+end
+f = str2func(KernelName);
+IsLCS = any(strcmp(KernelName,{'LCSSeq_FFC','LCSStr_FFC'}));
+
+%% Call Kernel for Fragments
+M = length(fragments);
+try
+    for j=1:M
+        if IsLCS
+            Reps = varargin{1};
+            for k=1:length(Reps)
+                [~,s] = f(fragments{j},Reps{k},varargin{2:end});
+                if k==1
+                    stat = s;
+                else
+                    stat = sum_fields(stat,s);
+                end
+            end
+        else
+            [~,stat] = f(fragments{j},varargin{:});
+        end
+        if j==1
+            Stats = repmat(stat,1,M);
+            Totals = stat;
+        else
+            Stats(j) = stat;
+            Totals = sum_fields(Totals,stat);
+        end
+    end
+catch ME
+    Stats = [];
+    Totals = [];
+    ErrorMsg = sprintf('The counters of %s cannot be collected: %s',KernelName,ME.message);
+end
+
+function a = sum_fields(a,b)
+% Sum of the fields of two structures of counters
+FieldNames = fieldnames(a);
+for i=1:length(FieldNames)
+    if any(strcmp(FieldNames{i},{'Epsilon','Method'})) || strncmp(FieldNames{i},'Max',3)
+        a.(FieldNames{i}) = max(a.(FieldNames{i}),b.(FieldNames{i}));
+    else
+        a.(FieldNames{i}) = a.(FieldNames{i})+b.(FieldNames{i});
+    end
+end
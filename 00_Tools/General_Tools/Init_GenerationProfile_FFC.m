@@ -0,0 +1,63 @@
+function Profile = Init_GenerationProfile_FFC(f_handles)
+
+% This function initializes the profile of dataset generation (see Add_GenerationProfile_FFC and
+% Save_GenerationProfile_FFC). The profile records the wall and CPU times of the read, compute, and
+% write phases of each batch of fragments, and the compute time of each feature extraction function.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Input:
+%   f_handles: Cell array of function handles of feature extraction
+%
+% Output:
+%   Profile: A structure with the following fields:
+%       FunctionNames: 1xNumFeatExtFunc cell of the names of feature extraction functions
+%       Batch, FunctionIndex, NumFragments, Bytes, WallTime, CPUTime: Vectors of the fields of records
+%           (FunctionIndex is the index of feature extraction function in compute phase, 0 in read phase,
+%           and -1 in write phase)
+%       NumRecords: Number of records
+%       PeakBufferBytes: Peak memory of the buffers of fragments and features (bytes)
+%       StartTime, StartCPUTime: Wall-clock and CPU time at the beginning of dataset generation
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Names of Functions
+% The name of the first function called in each anonymous function is used (e.g. @(x) Entropy_FFC(x) gives Entropy_FFC).
+NumFeatExtFunc = length(f_handles);
+FunctionNames = cell(1,NumFeatExtFunc);
+for cnt=1:NumFeatExtFunc
+    str = func2str(f_handles{cnt});
+    str = regexprep(str,'^@\([^)]*\)\s*','');
+    tok = regexp(str,'[A-Za-z]\w*','match','once');
+    if isempty(tok)
+        tok = str;
+    end
+    FunctionNames{cnt} = tok;
+end
+
+%% Profile
+Capacity = 1024;
+Profile.FunctionNames = FunctionNames;
+Profile.Batch = zeros(Capacity,1);
+Profile.FunctionIndex = zeros(Capacity,1);
+Profile.NumFragments = zeros(Capacity,1);
+Profile.Bytes = zeros(Capacity,1);
+Profile.WallTime = zeros(Capacity,1);
+Profile.CPUTime = zeros(Capacity,1);
+Profile.NumRecords = 0;
+Profile.PeakBufferBytes = 0;
+Profile.StartTime = tic;
+Profile.StartCPUTime = cputime;
@@ -0,0 +1,146 @@
+function [Summary,ErrorMsg] = Save_GenerationProfile_FFC(Profile,FileName)
+
+% This function saves the profile of dataset generation (see Init_GenerationProfile_FFC) in CSV and JSON
+% files, and returns a summary of the profile.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Profile: The profile of dataset generation
+%   FileName: Full name of the files without extension. The records are saved in [FileName '.csv'],
+%       and the totals and the records are saved in [FileName '.json'].
+%
+% Outputs:
+%   Summary: Cell array of strings that summarizes the profile
+%   ErrorMsg: Possible error message. If there is no error, this output is
+%       empty.
+%
+%   Note: The CPU times are the CPU times of MATLAB client, and do not include parallel pool workers.
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+ErrorMsg = '';
+n = Profile.NumRecords;
+Batch = Profile.Batch(1:n);
+FunctionIndex = Profile.FunctionIndex(1:n);
+NumFragments = Profile.NumFragments(1:n);
+Bytes = Profile.Bytes(1:n);
+WallTime = Profile.WallTime(1:n);
+CPUTime = Profile.CPUTime(1:n);
+TotalWallTime = toc(Profile.StartTime);
+TotalCPUTime = cputime-Profile.StartCPUTime;
+
+Names = [{'write','read'} Profile.FunctionNames];
+Phases = {'write','read','compute'};
+Name = @(k) Names{k+2};
+Phase = @(k) Phases{min(k,1)+2};
+
+%% Totals of Phases and Functions
+% Rows: read, compute, write, and then feature extraction functions
+NumFeatExtFunc = length(Profile.FunctionNames);
+Totals = zeros(3+NumFeatExtFunc,4); % [WallTime CPUTime NumFragments Bytes]
+TotalNames = [{'read','compute','write'} Profile.FunctionNames];
+for r=1:n
+    k = FunctionIndex(r);
+    if k>0
+        row = [2 3+k];
+    elseif k==0
+        row = 1;
+    else
+        row = 3;
+    end
+    Totals(row,1:2) = Totals(row,1:2)+repmat([WallTime(r) CPUTime(r)],length(row),1);
+    Totals(row(end),3:4) = Totals(row(end),3:4)+[NumFragments(r) Bytes(r)];
+end
+% Fragments and bytes of compute phase are those of one function
+if NumFeatExtFunc>0
+    Totals(2,3:4) = Totals(4,3:4);
+end
+
+%% Save CSV File
+fid = fopen([FileName '.csv'],'w');
+if fid<0
+    ErrorMsg = sprintf('The profile file %s.csv cannot be created.',FileName);
+    Summary = {};
+    return;
+end
+fprintf(fid,'Batch,Phase,Function,NumFragments,Bytes,WallTime,CPUTime,FragmentsPerSecond,BytesPerSecond\n');
+for r=1:n
+    k = FunctionIndex(r);
+    fprintf(fid,'%d,%s,%s,%d,%d,%.6f,%.6f,%.6g,%.6g\n',Batch(r),Phase(k),Name(k),NumFragments(r),Bytes(r),...
+        WallTime(r),CPUTime(r),rate(NumFragments(r),WallTime(r)),rate(Bytes(r),WallTime(r)));
+end
+fclose(fid);
+
+%% Save JSON File
+fid = fopen([FileName '.json'],'w');
+if fid<0
+    ErrorMsg = sprintf('The profile file %s.json cannot be created.',FileName);
+    Summary = {};
+    return;
+end
+fprintf(fid,'{\n"TotalWallTime": %.6f,\n"TotalCPUTime": %.6f,\n"PeakBufferBytes": %d,\n',TotalWallTime,TotalCPUTime,Profile.PeakBufferBytes);
+fprintf(fid,'"Totals": [\n');
+for r=1:size(Totals,1)
+    if r<=3
+        str = sprintf('"Phase": "%s"',TotalNames{r});
+    else
+        str = sprintf('"Phase": "compute", "Function": "%s"',TotalNames{r});
+    end
+    fprintf(fid,'  {%s, "NumFragments": %d, "Bytes": %d, "WallTime": %.6f, "CPUTime": %.6f, "FragmentsPerSecond": %.6g, "BytesPerSecond": %.6g}',...
+        str,Totals(r,3),Totals(r,4),Totals(r,1),Totals(r,2),rate(Totals(r,3),Totals(r,1)),rate(Totals(r,4),Totals(r,1)));
+    if r<size(Totals,1)
+        fprintf(fid,',\n');
+    else
+        fprintf(fid,'\n');
+    end
+end
+fprintf(fid,'],\n"Records": [\n');
+for r=1:n
+    k = FunctionIndex(r);
+    fprintf(fid,'  {"Batch": %d, "Phase": "%s", "Function": "%s", "NumFragments": %d, "Bytes": %d, "WallTime": %.6f, "CPUTime": %.6f}',...
+        Batch(r),Phase(k),Name(k),NumFragments(r),Bytes(r),WallTime(r),CPUTime(r));
+    if r<n
+        fprintf(fid,',\n');
+    else
+        fprintf(fid,'\n');
+    end
+end
+fprintf(fid,']\n}\n');
+fclose(fid);
+
+%% Summary
+Summary = cell(1,5+NumFeatExtFunc);
+Summary{1} = sprintf('Profile of dataset generation (saved in %s.csv and %s.json):',FileName,FileName);
+Summary{2} = sprintf('  Total: %.2f s wall-clock time, %.2f s CPU time, peak buffer memory %.1f MB',...
+    TotalWallTime,TotalCPUTime,Profile.PeakBufferBytes/2^20);
+for r=1:3
+    Summary{2+r} = sprintf('  %-8s: %10.2f s (%5.1f%%), %10.1f fragments/s, %8.2f MB/s',TotalNames{r},Totals(r,1),...
+        100*Totals(r,1)/max(TotalWallTime,eps),rate(Totals(r,3),Totals(r,1)),rate(Totals(r,4),Totals(r,1))/2^20);
+end
+for r=4:size(Totals,1)
+    Summary{2+r} = sprintf('    %s: %.2f s (%.1f%% of compute), %.1f fragments/s',TotalNames{r},Totals(r,1),...
+        100*Totals(r,1)/max(Totals(2,1),eps),rate(Totals(r,3),Totals(r,1)));
+end
+
+function r = rate(amount,time)
+% Throughput (0 if time is zero)
+if time>0
+    r = amount/time;
+else
+    r = 0;
+end
@@ -0,0 +1,152 @@
+function [Report,ErrorMsg] = Validate_Approximate_LCS_FFC(Fragments,Labels,ClassLabels,Representatives,Bands,TestRatio)
+
+% This function measures the effect of the approximate mode (banded dynamic programming) of LCSSeq_FFC and
+% LCSStr_FFC on a labeled set of fragments. The LCS features of the fragments (the normalized averages over the
+% representatives of each class, as in LCSSeq2_FFC and LCSStr2_FFC) are calculated in the exact mode and for
+% each band width. Then, the errors of the features, the documented error bounds, the speedup, and the accuracy
+% of an LDA classifier (trained on the exact features, or retrained on the approximate features) are reported.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   Fragments: Cell array with length L consisting of row vectors of byte values
+%   Labels: Lx1 vector of integer-valued class labels of the fragments
+%   ClassLabels: 1xM cell. Cell contents are strings denoting the name of
+%       classes corresponding to integer-valued class labels 1,2,....
+%   Representatives: 1xM cell; Representatives{c} is a cell array of the representative fragments of class c
+%       (the representatives should not be included in Fragments)
+%   Bands: Vector of band widths of the approximate mode
+%   TestRatio: The ratio of the test fragments of each class (optional, default: 0.3)
+%
+% Outputs:
+%   Report: 1x(1+length(Bands)) structure array. The first element is for the exact mode (Band=Inf).
+%       Band: Band width
+%       TimePerFragment: Time of calculating the LCS features for a fragment (seconds)
+%       Speedup: Ratio of the time of the exact mode to the time of the approximate mode
+%       MeanAbsError, MaxAbsError: Mean and maximum of the absolute errors of the normalized features
+%       MeanErrorBound, MaxErrorBound: Mean and maximum of the documented error bounds of the normalized features
+%           (see LCSSeq_FFC and LCSStr_FFC)
+%       CertifiedFraction: The fraction of the features whose error bound is zero (certified exact values)
+%       Pc_ExactModel: Accuracy (percent) of LDA classifier trained on the exact features and tested on the
+%           approximate features of the test fragments
+%       Pc_Retrained: Accuracy (percent) of LDA classifier trained and tested on the approximate features
+%   ErrorMsg: Possible error message. If there is no error, this output is empty.
+%
+%   Note: The C-MEX functions LCSSeq_FFC and LCSStr_FFC should be compiled with the approximate mode.
+%
+% Revisions:
+% 2026-Oct-18   function was created
+% 2026-Oct-18   the C-MEX files are checked for the approximate mode (Banded_LCS_Available_FFC)
+
+%% Initialization
+Report = [];
+ErrorMsg = '';
+if nargin<6
+    TestRatio = 0.3;
+end
+if ~Banded_LCS_Available_FFC('LCSSeq_FFC') || ~Banded_LCS_Available_FFC('LCSStr_FFC')
+    ErrorMsg = 'C-MEX functions LCSSeq_FFC and LCSStr_FFC with approximate mode are not available (rebuild them from _Functions).';
+    return;
+end
+
+Labels = Labels(:);
+L = length(Fragments);
+M = length(ClassLabels);
+FeatureLabels = [cellfun(@(c) sprintf('LCS_Seq_%s',c),ClassLabels,'UniformOutput',false) ...
+    cellfun(@(c) sprintf('LCS_Str_%s',c),ClassLabels,'UniformOutput',false)];
+
+%% Split fragments of each class into train and test sets
+TIndex = [];
+VIndex = [];
+for c=1:M
+    idx = find(Labels==c);
+    idx = idx(randperm(length(idx)));
+    NumTest = round(TestRatio*length(idx));
+    VIndex = [VIndex; idx(1:NumTest)]; %#ok<AGROW>
+    TIndex = [TIndex; idx(NumTest+1:end)]; %#ok<AGROW>
+end
+Weights = Assign_Weights_FFC(Labels,ClassLabels,'balanced');
+
+%% Features of all modes
+Bands = [Inf Bands(:)'];
+Report = struct('Band',num2cell(Bands),'TimePerFragment',0,'Speedup',1,'MeanAbsError',0,'MaxAbsError',0,...
+    'MeanErrorBound',0,'MaxErrorBound',0,'CertifiedFraction',1,'Pc_ExactModel',[],'Pc_Retrained',[]);
+for b=1:length(Bands)
+
+    try
+        [Features,Bound,Time] = lcs_features(Fragments,Representatives,Bands(b));
+    catch ME
+        Report = [];
+        ErrorMsg = sprintf('LCS features cannot be calculated with band width %g. %s',Bands(b),ME.message);
+        return;
+    end
+    Dataset = [Features Labels zeros(L,1)];
+
+    try
+        if b==1
+            Features_Exact = Features;
+            [LDA_Exact,Pc_Exact] = Build_LDA_FFC(Dataset,ClassLabels,FeatureLabels,Weights,TIndex,VIndex);
+            Report(b).Pc_ExactModel = Pc_Exact;
+            Report(b).Pc_Retrained = Pc_Exact;
+        else
+            [~,Report(b).Pc_ExactModel] = Test_LDA_FFC(LDA_Exact,Dataset,VIndex,ClassLabels,ClassLabels,FeatureLabels,FeatureLabels,Weights);
+            [~,Report(b).Pc_Retrained] = Build_LDA_FFC(Dataset,ClassLabels,FeatureLabels,Weights,TIndex,VIndex);
+        end
+    catch ME
+        Report = [];
+        ErrorMsg = sprintf('LDA classifier cannot be trained with band width %g. %s',Bands(b),ME.message);
+        return;
+    end
+
+    Err = abs(Features-Features_Exact);
+    Report(b).TimePerFragment = Time;
+    Report(b).Speedup = Report(1).TimePerFragment/Time;
+    Report(b).MeanAbsError = mean(Err(:));
+    Report(b).MaxAbsError = max(Err(:));
+    Report(b).MeanErrorBound = mean(Bound(:));
+    Report(b).MaxErrorBound = max(Bound(:));
+    Report(b).CertifiedFraction = mean(Bound(:)==0);
+
+end
+
+%% Normalized LCS features, their error bounds, and the time per fragment
+function [Features,Bound,Time] = lcs_features(Fragments,Representatives,Band)
+
+L = length(Fragments);
+M = length(Representatives);
+Kernels = {@LCSSeq_FFC,@LCSStr_FFC};
+Features = zeros(L,2*M);
+Bound = zeros(L,2*M);
+
+tic;
+for i=1:L
+    x = Fragments{i};
+    for c=1:M
+        N = length(Representatives{c});
+        for k=1:2
+            for r=1:N
+                y = Representatives{c}{r};
+                if isinf(Band)
+                    Lk = Kernels{k}(x,y);
+                else
+                    Lk = Kernels{k}(x,y,Band);
+                    Bound(i,(k-1)*M+c) = Bound(i,(k-1)*M+c)+max(0,max(length(x),length(y))-Band-1-Lk)/min(length(x),length(y))/N;
+                end
+                Features(i,(k-1)*M+c) = Features(i,(k-1)*M+c)+Lk/min(length(x),length(y))/N;
+            end
+        end
+    end
+end
+Time = toc/L;
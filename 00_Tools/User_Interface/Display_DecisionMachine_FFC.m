@@ -30,6 +30,7 @@ function Display_DecisionMachine_FFC(TrainingParameters,TrainingResults,Decision
 %
 % Revisions:
 % 2020-Mar-07   function was created
+% 2026-Oct-18   relative error bound of nearest neighbor search is shown for ensemble kNN
 
 %% Show General Parameters
 GUI_MainEditBox_Update_FFC(false,sprintf('Decision Machine Type: %s',TrainingParameters.Type));
@@ -76,6 +77,9 @@ switch TrainingParameters.Type
         GUI_MainEditBox_Update_FFC(false,sprintf('Number of random selected features for each kNN learner: %d',TrainingParameters.NumFeatures));
         GUI_MainEditBox_Update_FFC(false,sprintf('Number of kNN learners in ensemble: %d',TrainingParameters.NumLearners));
         GUI_MainEditBox_Update_FFC(false,sprintf('Number of nearest neighbors for classifying each point: %d',TrainingParameters.NumNeighbors));
+        if isfield(TrainingParameters,'SearchEpsilon')
+            GUI_MainEditBox_Update_FFC(false,sprintf('Relative error bound of the nearest neighbor search: %g',TrainingParameters.SearchEpsilon));
+        end
         
     case {'Naive Bayes','Linear Discriminant Analysis (LDA)'}
         
@@ -1,4 +1,4 @@
-function GUI_Dataset_Update_FFC(Filename,Dataset,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select,Feature_Transfrom)
+function GUI_Dataset_Update_FFC(Filename,Dataset,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select,Feature_Transfrom,FeatureStats)
 
 % This function updates the Fragments-Expert GUI according to Generated/Loaded Dataset. 
 %
@@ -38,10 +38,13 @@ function GUI_Dataset_Update_FFC(Filename,Dataset,FeatureLabels,ClassLabels,Funct
 %       dataset. 
 %   Function_Select: Cell array of selected features after feature calculation. 
 %   Feature_Transfrom: A structure which determines the feature tranform if it is non-empty. 
+%   FeatureStats: Statistics of the features of Dataset (see Init_FeatureStats_FFC). If it is not
+%       provided, the statistics of the previous dataset are cleared.
 %
 % Revisions:
 % 2020-Mar-03   function was created
 % 2021-Jan-03   Feature_Transfrom input was added
+% 2026-Oct-18   FeatureStats input was added, and the number of samples of classes is taken from it
 
 %% Initialization
 global Dataset_FFC_Name_TextBox Dataset_FFC_Classes_TextBox Dataset_FFC_Features_TextBox View_Classes_PushButton_FFC View_Features_PushButton_FFC
@@ -49,11 +52,15 @@ global Dataset_FFC ClassLabels_FFC FeatureLabels_FFC
 global ClassLabelsandNumbers_FFC
 global Function_Handles_FFC Function_Labels_FFC Function_Select_FFC
 global Feature_Transfrom_FFC
+global FeatureStats_FFC
 
 %% Manage Inputs
 if nargin<8
     Feature_Transfrom = [];
 end
+if nargin<9
+    FeatureStats = [];
+end
 
 %% Update GUI
 set(Dataset_FFC_Name_TextBox,'String',Filename);
@@ -70,7 +77,12 @@ Function_Handles_FFC = Function_Handles;
 Function_Labels_FFC = Function_Labels;
 Function_Select_FFC = Function_Select;
 Feature_Transfrom_FFC = Feature_Transfrom;
+FeatureStats_FFC = FeatureStats;
 ClassLabelsandNumbers_FFC = cell(size(ClassLabels_FFC));
 for j=1:length(ClassLabels_FFC)
-    ClassLabelsandNumbers_FFC{j} = sprintf('%s: %s samples',ClassLabels_FFC{j},num2str(sum(Dataset_FFC(:,end-1)==j)));
+    if isempty(FeatureStats_FFC)
+        ClassLabelsandNumbers_FFC{j} = sprintf('%s: %s samples',ClassLabels_FFC{j},num2str(sum(Dataset_FFC(:,end-1)==j)));
+    else
+        ClassLabelsandNumbers_FFC{j} = sprintf('%s: %s samples',ClassLabels_FFC{j},num2str(FeatureStats_FFC.Count(j)));
+    end
 end
\ No newline at end of file
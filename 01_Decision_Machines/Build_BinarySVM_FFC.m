@@ -51,12 +51,13 @@ function [SVMModel,SVMModel_CL,Pc,ConfusionMatrix,Pc_Train,ConfusionMatrix_Train
 %
 % Revisions:
 % 2020-Mar-11   function was created
+% 2026-Oct-18   Dataset can be a view of dataset (see Create_DatasetView_FFC)
 
 %% Train and Validation Sets
-Train = Dataset(TIndex,:);
+Train = Gather_DatasetView_FFC(Dataset,TIndex);
 Train_Weights = Weights(TIndex);
 
-Validation = Dataset(VIndex,:);
+Validation = Gather_DatasetView_FFC(Dataset,VIndex);
 Validation_Weights = Weights(VIndex);
 
 %% Train SVM using the train set
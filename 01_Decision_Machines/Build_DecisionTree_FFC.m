@@ -58,12 +58,13 @@ function [Tree,Tree_CL,Pc,ConfusionMatrix,Pc_Train,ConfusionMatrix_Train,stopbar
 %
 % Revisions:
 % 2020-Mar-03   function was created
+% 2026-Oct-18   Dataset can be a view of dataset (see Create_DatasetView_FFC)
 
 %% Train and Validation Sets
-Train = Dataset(TIndex,:);
+Train = Gather_DatasetView_FFC(Dataset,TIndex);
 Train_Weights = Weights(TIndex);
 
-Validation = Dataset(VIndex,:);
+Validation = Gather_DatasetView_FFC(Dataset,VIndex);
 Validation_Weights = Weights(VIndex);
 
 %% Train the initial tree using the train set
@@ -1,4 +1,4 @@
-function [EnsemblekNN_CL,Pc,ConfusionMatrix,Pc_Train,ConfusionMatrix_Train] = Build_EnsemblekNN_FFC(EnsemblekNN_CL,Dataset,ClassLabels,FeatureLabels,Weights,TIndex,VIndex,NumLearners,NumFeatures,NumNeighbors)
+function [EnsemblekNN_CL,Pc,ConfusionMatrix,Pc_Train,ConfusionMatrix_Train,kNNIndex] = Build_EnsemblekNN_FFC(EnsemblekNN_CL,Dataset,ClassLabels,FeatureLabels,Weights,TIndex,VIndex,NumLearners,NumFeatures,NumNeighbors,kNNIndex,Epsilon)
 
 % This function takes a dataset and trains an ensemble kNN. 
 %
@@ -39,6 +39,8 @@ function [EnsemblekNN_CL,Pc,ConfusionMatrix,Pc_Train,ConfusionMatrix_Train] = Bu
 %   NumLearners: Number of kNN learners
 %   NumFeatures: Number of random selected features for each kNN learner
 %   NumNeighbors: Number of nearest neighbors for classifying each point
+%   kNNIndex: Index of the learners of initial ensemble kNN (optional, see Build_EnsemblekNN_Index_FFC)
+%   Epsilon: Relative error bound of the nearest neighbor search (optional, default 0 for exact search)
 %
 % Outputs:
 %   EnsemblekNN_CL: ensemble kNN with string class labels taken from ClassLabels
@@ -46,12 +48,15 @@ function [EnsemblekNN_CL,Pc,ConfusionMatrix,Pc_Train,ConfusionMatrix_Train] = Bu
 %   ConfusionMatrix: Confusion matrix for validation data
 %   Pc_Train: Average weighted accuracy over all samples of training set
 %   ConfusionMatrix_Train: Confusion matrix for training data
+%   kNNIndex: Index of the learners of ensemble kNN (empty if kNN_VPTree_Core_FFC is not available)
 %
 % Revisions:
 % 2020-Mar-18   function was created
+% 2026-Oct-18   the learners are indexed by Build_EnsemblekNN_Index_FFC if kNN_VPTree_Core_FFC (C-MEX) is available
+% 2026-Oct-18   Dataset can be a view of dataset (see Create_DatasetView_FFC)
 
 %% Train Set
-Train = Dataset(TIndex,:);
+Train = Gather_DatasetView_FFC(Dataset,TIndex);
 Train_Weights = Weights(TIndex);
 
 %% Train (or grow) ensemble kNN using the train set
@@ -63,6 +68,19 @@ else
     EnsemblekNN_CL = resume(EnsemblekNN_CL,NumLearners);
 end
 
+%% Index the learners of ensemble kNN
+if nargin<11
+    kNNIndex = [];
+end
+if nargin<12
+    Epsilon = 0;
+end
+if exist('kNN_VPTree_Core_FFC','file')==3
+    kNNIndex = Build_EnsemblekNN_Index_FFC(EnsemblekNN_CL,kNNIndex);
+else
+    kNNIndex = [];
+end
+
 %% Evaluate the performance of Ensemble kNN Using Training and Validation Set
-[~,Pc_Train,ConfusionMatrix_Train,~,~] = Test_EnsemblekNN_FFC(EnsemblekNN_CL,Dataset,TIndex,ClassLabels,ClassLabels,FeatureLabels,FeatureLabels,Weights);
-[~,Pc,ConfusionMatrix,~,~] = Test_EnsemblekNN_FFC(EnsemblekNN_CL,Dataset,VIndex,ClassLabels,ClassLabels,FeatureLabels,FeatureLabels,Weights);
\ No newline at end of file
+[~,Pc_Train,ConfusionMatrix_Train,~,~] = Test_EnsemblekNN_FFC(EnsemblekNN_CL,Dataset,TIndex,ClassLabels,ClassLabels,FeatureLabels,FeatureLabels,Weights,kNNIndex,Epsilon);
+[~,Pc,ConfusionMatrix,~,~] = Test_EnsemblekNN_FFC(EnsemblekNN_CL,Dataset,VIndex,ClassLabels,ClassLabels,FeatureLabels,FeatureLabels,Weights,kNNIndex,Epsilon);
\ No newline at end of file
@@ -67,6 +67,7 @@ function [SVMModel_j,SVMModel_CL_j,Pc,ConfusionMatrix,Pc_Train,ConfusionMatrix_T
 %
 % Revisions:
 % 2020-Mar-11   function was created
+% 2026-Oct-18   Dataset can be a view of dataset (see Create_DatasetView_FFC)
 
 %% Prepare outputs
 M = length(ClassLabels);
@@ -81,14 +82,12 @@ ConfusionMatrix_Train_j = cell(1,M); % A cell array; each element is confusion m
 progressbar_FFC(prg_idx,eps);
 for j=1:M
     
-    % Prepare binary-labeld Dataset
-    Datasetj = Dataset;
-    idx = Datasetj(:,end-1)~=j;
-    Datasetj(idx,end-1) = 0;
-    Datasetj(~idx,end-1) = 1;
-    Datasetj(:,end-1) = Datasetj(:,end-1)+1;
+    % Prepare binary-labeld view of Dataset (the samples are not copied)
+    LabelMap = ones(1,M);
+    LabelMap(j) = 2;
+    Datasetj = Subset_DatasetView_FFC(Dataset,':',[],LabelMap);
     ClassLabelsj = {['Non' ClassLabels{j}] ClassLabels{j}};
-    Weightsj = Assign_Weights_FFC(Datasetj(:,end-1),ClassLabelsj,Weighting_Method);
+    Weightsj = Assign_Weights_FFC(Gather_DatasetView_FFC(Datasetj,':',length(Datasetj.Cols)+1),ClassLabelsj,Weighting_Method);
     
     % Train binary SVM
     [SVMModel_j{j},SVMModel_CL_j{j},Pc_j{j},ConfusionMatrix_j{j},Pc_Train_j{j},ConfusionMatrix_Train_j{j}] = ...
@@ -45,9 +45,10 @@ function [NaiveBayes,NaiveBayes_CL,Pc,ConfusionMatrix,Pc_Train,ConfusionMatrix_T
 %
 % Revisions:
 % 2020-Mar-19   function was created
+% 2026-Oct-18   Dataset can be a view of dataset (see Create_DatasetView_FFC)
 
 %% Train Set
-Train = Dataset(TIndex,:);
+Train = Gather_DatasetView_FFC(Dataset,TIndex);
 Train_Weights = Weights(TIndex);
 
 %% Train Naive Bayes
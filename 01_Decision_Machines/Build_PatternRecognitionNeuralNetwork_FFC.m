@@ -47,15 +47,18 @@ function [PRNN,Pc,ConfusionMatrix,Pc_Train,ConfusionMatrix_Train] = Build_Patter
 %
 % Revisions:
 % 2020-Mar-19   function was created
+% 2026-Oct-18   Dataset can be a view of dataset (see Create_DatasetView_FFC)
 
 %% Train Set
 M = length(ClassLabels);
 Index = [TIndex VIndex];
-X = Dataset(Index,1:end-2)';
+Train = Gather_DatasetView_FFC(Dataset,Index);
+X = Train(:,1:end-2)';
 T = zeros(M,size(X,2));
 for j=1:size(X,2)
-    T(Dataset(Index(j),end-1),j) = 1;
+    T(Train(j,end-1),j) = 1;
 end
+clear Train
 W = Weights(Index);
 
 %% Initialize Network
@@ -51,9 +51,10 @@ function [RandomForest_CL,Pc,ConfusionMatrix,Pc_Train,ConfusionMatrix_Train] = B
 %
 % Revisions:
 % 2020-Mar-14   function was created
+% 2026-Oct-18   Dataset can be a view of dataset (see Create_DatasetView_FFC)
 
 %% Train Set
-Train = Dataset(TIndex,:);
+Train = Gather_DatasetView_FFC(Dataset,TIndex);
 Train_Weights = Weights(TIndex);
 
 %% Train (or grow) random forest using the train set
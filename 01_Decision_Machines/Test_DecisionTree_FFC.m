@@ -51,6 +51,8 @@ function [ErrorMsg,Pc,ConfusionMatrix,PredictedLabel,Scores] = Test_DecisionTree
 % 2020-Mar-03   function was created
 % 2021-Jan-15   The Nodes output was removed for compatibility with other
 %               MATLAB releases.
+% 2026-Oct-18   the tree is scored by Score_TreeEnsemble_Core_FFC (C-MEX) if it is available
+% 2026-Oct-18   Dataset can be a view of dataset (see Create_DatasetView_FFC)
 
 %% Initialization
 ErrorMsg= '';
@@ -66,9 +68,19 @@ if ~isequal(DataFeartureLabels,TreeFeartureLabels)
 end
 
 %% Test Set
-Test = Dataset(TestIndex,:);
+Test = Gather_DatasetView_FFC(Dataset,TestIndex);
 Test_Weights = Weights(TestIndex);
 
 %% Evaluate the performance of the final tree on the test set
-[PredictedLabel,Scores] = predict(tree,Test(:,1:end-2));
+if exist('Score_TreeEnsemble_Core_FFC','file')==3
+    
+    % Score the flattened tree
+    [CutFeature,CutPoint,Children,ClassProbability,NumNodes] = Flatten_TreeEnsemble_FFC({tree},1:length(tree.ClassNames));
+    Scores = Score_TreeEnsemble_Core_FFC(Test(:,1:end-2),CutFeature,CutPoint,Children,ClassProbability,NumNodes);
+    [~,idx] = max(Scores,[],2);
+    PredictedLabel = tree.ClassNames(idx);
+    
+else
+    [PredictedLabel,Scores] = predict(tree,Test(:,1:end-2));
+end
 [ConfusionMatrix,Pc] = ConfusionMatrix_FFC(Test(:,end-1),PredictedLabel,DataClassLabels,TreeClassLabels,Test_Weights);
\ No newline at end of file
@@ -1,4 +1,4 @@
-function [ErrorMsg,Pc,ConfusionMatrix,PredictedLabel,Scores] = Test_EnsemblekNN_FFC(EnsemblekNN,Dataset,TestIndex,DataClassLabels,kNNClassLabels,DataFeartureLabels,kNNFeartureLabels,Weights)
+function [ErrorMsg,Pc,ConfusionMatrix,PredictedLabel,Scores] = Test_EnsemblekNN_FFC(EnsemblekNN,Dataset,TestIndex,DataClassLabels,kNNClassLabels,DataFeartureLabels,kNNFeartureLabels,Weights,kNNIndex,Epsilon)
 
 % This function takes a ensemble kNN and evaluates the performace of the
 % ensemble kNN on a test set. 
@@ -35,6 +35,9 @@ function [ErrorMsg,Pc,ConfusionMatrix,PredictedLabel,Scores] = Test_EnsemblekNN_
 %   DataFeartureLabels: 1xF0 cell. Cell contents are strings denoting the name of features in Dataset.
 %   kNNFeartureLabels: 1xF cell. Cell contents are strings denoting the name of features in kNN.
 %   Weights: Lx1 vector of sample weights. 
+%   kNNIndex: Index of the learners of ensemble kNN (optional, see Build_EnsemblekNN_Index_FFC).
+%       If it is empty or incomplete, the remaining learners are indexed.
+%   Epsilon: Relative error bound of the nearest neighbor search (optional, default 0 for exact search)
 %
 % Outputs:
 %   ErrorMsg: Possible error message. If there is no error, this output is
@@ -49,6 +52,8 @@ function [ErrorMsg,Pc,ConfusionMatrix,PredictedLabel,Scores] = Test_EnsemblekNN_
 %
 % Revisions:
 % 2020-Mar-18   function was created
+% 2026-Oct-18   the nearest neighbors are found by kNN_VPTree_Core_FFC (C-MEX) if it is available
+% 2026-Oct-18   Dataset can be a view of dataset (see Create_DatasetView_FFC)
 
 %% Initialization
 ErrorMsg= '';
@@ -64,11 +69,23 @@ if ~isequal(DataFeartureLabels,kNNFeartureLabels)
 end
 
 %% Test Set
-Test = Dataset(TestIndex,:);
+Test = Gather_DatasetView_FFC(Dataset,TestIndex);
 Test_Weights = Weights(TestIndex);
 
 %% Evaluate the performance of ensemble kNN on the test set
-[label_T_str,Scores] = predict(EnsemblekNN,Test(:,1:end-2));
+if nargin<9
+    kNNIndex = [];
+end
+if nargin<10
+    Epsilon = 0;
+end
+if exist('kNN_VPTree_Core_FFC','file')==3
+    kNNIndex = Build_EnsemblekNN_Index_FFC(EnsemblekNN,kNNIndex);
+    [label_T,Scores] = Predict_EnsemblekNN_Index_FFC(EnsemblekNN,kNNIndex,Test(:,1:end-2),Epsilon);
+    label_T_str = EnsemblekNN.ClassNames(label_T);
+else
+    [label_T_str,Scores] = predict(EnsemblekNN,Test(:,1:end-2));
+end
 
 [~,idx] = ismember(kNNClassLabels,EnsemblekNN.ClassNames');
 Scores = Scores(:,idx);
@@ -49,6 +49,7 @@ function [ErrorMsg,Pc,ConfusionMatrix,PredictedLabel,Scores] = Test_LDA_FFC(LDA,
 %
 % Revisions:
 % 2020-Mar-18   function was created
+% 2026-Oct-18   Dataset can be a view of dataset (see Create_DatasetView_FFC)
 
 %% Initialization
 ErrorMsg= '';
@@ -64,7 +65,7 @@ if ~isequal(DataFeartureLabels,LDAFeartureLabels)
 end
 
 %% Test Set
-Test = Dataset(TestIndex,:);
+Test = Gather_DatasetView_FFC(Dataset,TestIndex);
 Test_Weights = Weights(TestIndex);
 
 %% Evaluate the performance of LDA Model on the test set
@@ -47,6 +47,7 @@ function [ErrorMsg,Pc,ConfusionMatrix,Scores,PredictedLabel] = Test_MultiClassSV
 %
 % Revisions:
 % 2020-Mar-11   function was created
+% 2026-Oct-18   Dataset can be a view of dataset (see Create_DatasetView_FFC)
 
 %% Initialization
 ErrorMsg= '';
@@ -62,7 +63,7 @@ if ~isequal(DataFeartureLabels,SVMFeartureLabels)
 end
 
 %% Test Set
-Test = Dataset(TestIndex,:);
+Test = Gather_DatasetView_FFC(Dataset,TestIndex);
 Test_Weights = Weights(TestIndex);
 
 %% Evaluate the performance of the SVMModel on the test set
@@ -49,6 +49,7 @@ function [ErrorMsg,Pc,ConfusionMatrix,PredictedLabel,Scores] = Test_PatternRecog
 %
 % Revisions:
 % 2020-Mar-18   function was created
+% 2026-Oct-18   Dataset can be a view of dataset (see Create_DatasetView_FFC)
 
 %% Initialization
 ErrorMsg= '';
@@ -64,7 +65,9 @@ if ~isequal(DataFeartureLabels,PRNNFeartureLabels)
 end
 
 %% Test Set
-Test = Dataset(TestIndex,1:end-2)';
+Test = Gather_DatasetView_FFC(Dataset,TestIndex);
+Test_Labels = Test(:,end-1);
+Test = Test(:,1:end-2)';
 Test_Weights = Weights(TestIndex);
 
 %% Evaluate the performance of PRNN Model on the test set
@@ -73,4 +76,4 @@ Scores = Scores';
 
 [~,PredictedLabel] = max(Scores,[],2);
 
-[ConfusionMatrix,Pc] = ConfusionMatrix_FFC(Dataset(TestIndex,end-1),PredictedLabel,DataClassLabels,PRNNClassLabels,Test_Weights);
+[ConfusionMatrix,Pc] = ConfusionMatrix_FFC(Test_Labels,PredictedLabel,DataClassLabels,PRNNClassLabels,Test_Weights);
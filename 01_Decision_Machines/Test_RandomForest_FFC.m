@@ -49,6 +49,8 @@ function [ErrorMsg,Pc,ConfusionMatrix,PredictedLabel,Scores] = Test_RandomForest
 %
 % Revisions:
 % 2020-Mar-14   function was created
+% 2026-Oct-18   trees are scored by Score_TreeEnsemble_Core_FFC (C-MEX) if it is available
+% 2026-Oct-18   Dataset can be a view of dataset (see Create_DatasetView_FFC)
 
 %% Initialization
 ErrorMsg= '';
@@ -64,19 +66,31 @@ if ~isequal(DataFeartureLabels,TreeFeartureLabels)
 end
 
 %% Test Set
-Test = Dataset(TestIndex,:);
+Test = Gather_DatasetView_FFC(Dataset,TestIndex);
 Test_Weights = Weights(TestIndex);
 
 %% Evaluate the performance of the final tree on the test set
-[label_T_str,Scores] = predict(RandomForest,Test(:,1:end-2));
-
-[~,idx] = ismember(TreeClassLabels,RandomForest.ClassNames');
-Scores = Scores(:,idx);
-
-PredictedLabel = zeros(size(label_T_str));
-for j=1:length(TreeClassLabels)
-    idx = cellfun(@(x) isequal(x,TreeClassLabels{j}),label_T_str);
-    PredictedLabel(idx) = j;
+if exist('Score_TreeEnsemble_Core_FFC','file')==3
+    
+    % Score the flattened trees
+    [~,idx] = ismember(TreeClassLabels,RandomForest.ClassNames');
+    [CutFeature,CutPoint,Children,ClassProbability,NumNodes] = Flatten_TreeEnsemble_FFC(RandomForest.Trees,idx);
+    Scores = Score_TreeEnsemble_Core_FFC(Test(:,1:end-2),CutFeature,CutPoint,Children,ClassProbability,NumNodes);
+    [~,PredictedLabel] = max(Scores,[],2);
+    
+else
+    
+    [label_T_str,Scores] = predict(RandomForest,Test(:,1:end-2));
+    
+    [~,idx] = ismember(TreeClassLabels,RandomForest.ClassNames');
+    Scores = Scores(:,idx);
+    
+    PredictedLabel = zeros(size(label_T_str));
+    for j=1:length(TreeClassLabels)
+        idx = cellfun(@(x) isequal(x,TreeClassLabels{j}),label_T_str);
+        PredictedLabel(idx) = j;
+    end
+    
 end
 
 [ConfusionMatrix,Pc] = ConfusionMatrix_FFC(Test(:,end-1),PredictedLabel,DataClassLabels,TreeClassLabels,Test_Weights);
\ No newline at end of file
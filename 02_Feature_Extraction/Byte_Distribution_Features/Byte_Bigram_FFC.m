@@ -1,4 +1,4 @@
-function freq = Byte_Bigram_FFC(fragment)
+function freq = Byte_Bigram_FFC(fragment,Bigrams)
 
 % This function calculates the distribution of the bigram byte frequencies. D
 %
@@ -18,14 +18,25 @@ function freq = Byte_Bigram_FFC(fragment)
 %
 % Inputs:
 %   fragment: row vector of byte values
+%   Bigrams (optional): Row vector of the bigrams (256*first byte+second byte) whose normalized
+%       frequencies are calculated (default: 0:65535)
 %
 % Outputs:
-%   freq: Row vector with length 65536 that contains the normalized bigrams
+%   freq: Row vector with length 65536 (or length(Bigrams)) that contains the normalized bigrams
 %
 % Revisions:
 % 2020-Oct-31   function was created
+% 2026-Oct-18   subset of bigrams (Bigrams) was added for pruned feature plans
 
 y = filter([1 256],1,fragment); 
 y = y(2:end);
-freq = histcounts(y,(0:2^16));
+if nargin<2
+    freq = histcounts(y,(0:2^16));
+else
+    % Only the requested bigrams are counted
+    idx = zeros(1,2^16);
+    idx(Bigrams+1) = 1:length(Bigrams);
+    b = idx(y+1);
+    freq = accumarray(b(b>0)',1,[length(Bigrams) 1])';
+end
 freq = freq/length(y)*2^16;
\ No newline at end of file
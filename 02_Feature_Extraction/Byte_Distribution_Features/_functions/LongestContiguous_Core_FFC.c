@@ -25,11 +25,18 @@
  *
  * Revisions:
  * 2023-Dec-25   The was written 
+ * 2026-Oct-18   variants with fixed-size buffers were added for the standard packet sizes
  */
 
 #include "mex.h"
 
-int LongestContiguous_Core_FFC(int *fragments,int length)
+#if defined(_MSC_VER)
+#define FORCE_INLINE static __forceinline
+#else
+#define FORCE_INLINE static inline __attribute__((always_inline))
+#endif
+
+FORCE_INLINE int LongestContiguous_Core(const int *fragments,int length)
 {
     int i, newval, L = 1;
     int Lmax = 1;
@@ -55,12 +62,48 @@ int LongestContiguous_Core_FFC(int *fragments,int length)
     return Lmax;
 }
 
+/* Variants for the standard packet sizes (fixed-size buffer and known trip count) */
+#define DEFINE_LONGESTCONTIGUOUS_FIXED(N) \
+int LongestContiguous_##N(const double *S) \
+{ \
+    int j, S_int[N]; \
+    for (j=0;j<N;j++) \
+        S_int[j] = (int) S[j]; \
+    return LongestContiguous_Core(S_int,N); \
+}
+
+DEFINE_LONGESTCONTIGUOUS_FIXED(512)
+DEFINE_LONGESTCONTIGUOUS_FIXED(1024)
+DEFINE_LONGESTCONTIGUOUS_FIXED(1500)
+DEFINE_LONGESTCONTIGUOUS_FIXED(4096)
+
+/* Generic variant for other lengths */
+int LongestContiguous_Core_FFC(const double *S,int n)
+{
+    int j, c, *S_int;
+
+    switch (n)
+    {
+        case 512:  return LongestContiguous_512(S);
+        case 1024: return LongestContiguous_1024(S);
+        case 1500: return LongestContiguous_1500(S);
+        case 4096: return LongestContiguous_4096(S);
+    }
+
+    S_int = (int*) malloc (n*sizeof(int));
+    for(j=0;j<n;j++)
+        S_int[j] = (int) S[j];
+    c = LongestContiguous_Core(S_int,n);
+    free(S_int);
+
+    return c;
+}
+
 void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
 {
     double *S,*c;
-    int *S_int,c_int;
+    int c_int;
     size_t dim1,dim2,n;
-    int j;
 
     /* Check for the proper number of arguments. */
     if (nrhs != 1)
@@ -82,21 +125,13 @@ void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
     /* Get pointers to the inputs. */
     S =  mxGetPr(prhs[0]);
 
-    /* Convert input to integer values */
-    S_int = (int*) malloc (dim1*dim2*sizeof(int));
-    for(j=0;j<n;j++)
-        S_int[j] = (int) S[j];
-
-    /* Call the C subroutine. */
-    c_int = LongestContiguous_Core_FFC(S_int,n);
+    /* Call the C subroutine (it converts input to integer values). */
+    c_int = LongestContiguous_Core_FFC(S,(int)n);
 
     /* Create a new array and set the output pointer to it. */
     plhs[0] = mxCreateDoubleMatrix(1, 1, mxREAL);
     c =  mxGetPr(plhs[0]);
     c[0] = (double) c_int; // Normalization
 
-    //free memory
-    free(S_int);
-
     return;
 }
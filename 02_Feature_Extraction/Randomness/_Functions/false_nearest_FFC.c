@@ -23,6 +23,7 @@
  * If not, see <http://www.gnu.org/licenses/>.
  *
  * Usage method: results = false_nearest_FFC(series,minemb,maxemb,rt);
+ *               [results,stats] = false_nearest_FFC(series,minemb,maxemb,rt); (instrumentation mode)
  *
  * Input:
  * series: A fragment of bytes
@@ -36,10 +37,24 @@
  *  2nd column: The fraction of false nearest neighbors
  *  3rd column: The average size of the neighborhood
  *  4th column: The square root of the average of the squared size of the neighborhood
+ * stats: A structure of counters of the work done, with fields of length maxemb-minemb+1 (one element for each dimension):
+ *  Epsilon: The last neighborhood size (in the scale of series)
+ *  EpsilonSteps: Number of neighborhood sizes tried (each one puts the points in boxes)
+ *  OccupiedBoxes: Number of non-empty boxes (for the last neighborhood size)
+ *  MaxBoxOccupancy: Number of points in the most occupied box (over all neighborhood sizes)
+ *  NeighborsScanned: Number of candidate neighbors visited in the boxes around the points
+ *  TheilerRejections: Number of candidates rejected by the Theiler window
+ *  NeighborsFound: Number of points whose nearest neighbor was found
+ *  FalseNeighbors: Number of false nearest neighbors (for which the distance ratio exceeds rt)
+ *
+ * Note: The counters are compiled only in the instrumentation mode:
+ *  mex -O -DKERNEL_STATS false_nearest_FFC.c
+ *  Otherwise, the kernel does no extra work and the second output is not available.
  *
  * Revisions:
  * 2005-Dec-16   The first version was written by Rainer Hegger.
  * 2020-Mar-17   The function was written in c-mex format. Moreover, single-variate inputs (one-dimensional fragments) are considered.
+ * 2026-Oct-18   instrumentation mode with counters of the work done was added
  */
 
 #include "mex.h"
@@ -62,6 +77,14 @@ long **box,*list;
 unsigned int *vcomp,*vemb;
 unsigned long toolarge;
 
+/* Counters of the instrumentation mode (the index of the current dimension is results_num) */
+#ifdef KERNEL_STATS
+#define STAT(statement) statement
+double *stat_eps,*stat_steps,*stat_boxes,*stat_maxocc,*stat_scanned,*stat_theiler,*stat_found,*stat_false;
+#else
+#define STAT(statement)
+#endif
+
 int variance(double *s,unsigned long l,double *av,double *var)
 {
     unsigned long i;
@@ -119,6 +142,24 @@ void mmb(unsigned int hdim,unsigned int hemb,double eps)
         list[i]=box[x][y];
         box[x][y]=i;
     }
+
+#ifdef KERNEL_STATS
+    {
+        long element,occupancy;
+        stat_steps[results_num]++;
+        stat_boxes[results_num]=0;
+        for (x=0;x<BOX;x++)
+            for (y=0;y<BOX;y++)
+                if (box[x][y] != -1) {
+                    occupancy=0;
+                    for (element=box[x][y];element != -1;element=list[element])
+                        occupancy++;
+                    stat_boxes[results_num]++;
+                    if (occupancy>stat_maxocc[results_num])
+                        stat_maxocc[results_num]=(double)occupancy;
+                }
+    }
+#endif
 }
 
 char find_nearest(long n,unsigned int dim,double eps)
@@ -140,6 +181,7 @@ char find_nearest(long n,unsigned int dim,double eps)
             element=box[x2][y1&ibox];
             while (element != -1)
             {
+                STAT(stat_scanned[results_num]++;)
                 if (labs(element-n) > theiler)
                 {
                     maxdx=fabs(series[0][n]-series[0][element]);
@@ -157,6 +199,7 @@ char find_nearest(long n,unsigned int dim,double eps)
                         mindx=maxdx;
                     }
                 }
+                STAT(else stat_theiler[results_num]++;)
                 element=list[element];
             }
         }
@@ -262,6 +305,9 @@ int false_nearest()
                 eps0=epsilon;
         }
 
+        STAT(stat_eps[results_num]=epsilon/sqrt(2.0)*inter;)
+        STAT(stat_found[results_num]=(double)donesofar;)
+        STAT(stat_false[results_num]=(double)toolarge;)
         if (donesofar == 0)
             return(3); // Not enough points found! Exit!
 
@@ -285,12 +331,19 @@ void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
     unsigned long dim1,dim2,i,j;
     double *out,*series_tmp;
     int retval;
+#ifdef KERNEL_STATS
+    mxArray *stats;
+#endif
 
     /* Check for the proper number of arguments. */
     if (nrhs != 4)
         mexErrMsgTxt("Four inputs are required.");
+    if (nlhs > 2)
+        mexErrMsgTxt("No more than two outputs are required!");
+#ifndef KERNEL_STATS
     if (nlhs > 1)
-        mexErrMsgTxt("No more than one output is required!");
+        mexErrMsgTxt("The second output is only available when the function is compiled with -DKERNEL_STATS.");
+#endif
 
     /* Initialization */
     theiler=0;
@@ -326,12 +379,35 @@ void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
     for(j=0;j<=(maxemb-minemb);j++)
         results[j] = (double*)malloc(sizeof(double)*4);
 
+#ifdef KERNEL_STATS
+    /* Counters are kept in the fields of the second output */
+    {
+        static const char *fields[] = {"Epsilon","EpsilonSteps","OccupiedBoxes","MaxBoxOccupancy",
+            "NeighborsScanned","TheilerRejections","NeighborsFound","FalseNeighbors"};
+        double **stat_ptr[] = {&stat_eps,&stat_steps,&stat_boxes,&stat_maxocc,&stat_scanned,&stat_theiler,&stat_found,&stat_false};
+        stats = mxCreateStructMatrix(1,1,8,fields);
+        for (j=0;j<8;j++)
+        {
+            mxArray *field = mxCreateDoubleMatrix(1,maxemb-minemb+1,mxREAL);
+            mxSetField(stats,0,fields[j],field);
+            *stat_ptr[j] = mxGetPr(field);
+        }
+    }
+#endif
+
     /* Call the C subroutine. */
     if (((int)length-(int)(maxemb+1)*(int)delay)<0)
         retval = 4; // Data length is too small. Exiting!
     else
         retval = false_nearest();
 
+#ifdef KERNEL_STATS
+    if (nlhs > 1)
+        plhs[1] = stats;
+    else
+        mxDestroyArray(stats);
+#endif
+
     /* Create a new array and set the output pointer to it. */
     plhs[0] = mxCreateDoubleMatrix(results_num, 4, mxREAL);
     out =  mxGetPr(plhs[0]);
@@ -18,12 +18,22 @@
  * If not, see <http://www.gnu.org/licenses/>.
  *
  * Usage method: c = kolmogorov_FFC(S);
+ *               [c,stats] = kolmogorov_FFC(S); (instrumentation mode)
  *
  * Input:
  * S: A fragment of bytes
  *
  * Outputs:
  * c: Normalized algorithmic complexity of S
+ * stats: A structure of counters of the work done with the following fields:
+ *  Comparisons: Number of symbol comparisons
+ *  Restarts: Number of times the search for the current component restarts from the next prefix position
+ *  Components: Number of components (the complexity before normalization)
+ *  MaxMatchLength: Length of the longest match of a component with the prefix
+ *
+ * Note: The counters are compiled only in the instrumentation mode:
+ *  mex -O -DKERNEL_STATS kolmogorov_FFC.c
+ *  Otherwise, the kernel does no extra work and the second output is not available.
  *
  * Revisions:
  * 2005-Feb-09   The first version was written by Stephen Faul.
@@ -31,11 +41,27 @@
  *               In order to normalize complexity, it is divided by fragment length.
  *               For file fragment classification, it seems to be a better
  *               normalization.
+ * 2026-Oct-18   variants with fixed-size buffers were added for the standard packet sizes
+ * 2026-Oct-18   instrumentation mode with counters of the work done was added
  */
 
 #include "mex.h"
 
-int ArCmp_FFC(int *S,size_t n)
+#if defined(_MSC_VER)
+#define FORCE_INLINE static __forceinline
+#else
+#define FORCE_INLINE static inline __attribute__((always_inline))
+#endif
+
+/* Counters of the instrumentation mode */
+#ifdef KERNEL_STATS
+#define STAT(statement) statement
+double stat_comparisons,stat_restarts,stat_maxmatch;
+#else
+#define STAT(statement)
+#endif
+
+FORCE_INLINE int ArCmp_Core(const int *S,size_t n)
 {
     int c;
     size_t l,i,k,kmax;
@@ -50,6 +76,7 @@ int ArCmp_FFC(int *S,size_t n)
     // Algorithm Loop
     while ((l+k)<=n)
     {
+        STAT(stat_comparisons++;)
         if (S[i+k-1]==S[l+k-1])
         {
             k = k+1;
@@ -65,6 +92,7 @@ int ArCmp_FFC(int *S,size_t n)
         {
             if (k>kmax)
                 kmax = k;
+            STAT(if (kmax>stat_maxmatch) stat_maxmatch = kmax;)
             i = i+1;
             if (i==l)
             {
@@ -82,6 +110,7 @@ int ArCmp_FFC(int *S,size_t n)
             }
             else
             {
+                STAT(stat_restarts++;)
                 k = 1;
                 continue;
             }
@@ -91,18 +120,60 @@ int ArCmp_FFC(int *S,size_t n)
     return c;
 }
 
+/* Variants for the standard packet sizes (fixed-size buffer and known length) */
+#define DEFINE_ARCMP_FIXED(N) \
+int ArCmp_##N(const double *S) \
+{ \
+    int j, S_int[N]; \
+    for (j=0;j<N;j++) \
+        S_int[j] = (int) S[j]; \
+    return ArCmp_Core(S_int,N); \
+}
+
+DEFINE_ARCMP_FIXED(512)
+DEFINE_ARCMP_FIXED(1024)
+DEFINE_ARCMP_FIXED(1500)
+DEFINE_ARCMP_FIXED(4096)
+
+/* Generic variant for other lengths */
+int ArCmp_FFC(const double *S,size_t n)
+{
+    int c;
+    size_t j;
+    int *S_int;
+
+    switch (n)
+    {
+        case 512:  return ArCmp_512(S);
+        case 1024: return ArCmp_1024(S);
+        case 1500: return ArCmp_1500(S);
+        case 4096: return ArCmp_4096(S);
+    }
+
+    S_int = (int*) malloc (n*sizeof(int));
+    for(j=0;j<n;j++)
+        S_int[j] = (int) S[j];
+    c = ArCmp_Core(S_int,n);
+    free(S_int);
+
+    return c;
+}
+
 void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
 {
     double *S,*c;
-    int *S_int,c_int;
+    int c_int;
     size_t dim1,dim2,n;
-    int j;
 
     /* Check for the proper number of arguments. */
     if (nrhs != 1)
         mexErrMsgTxt("One input is required.");
+    if (nlhs > 2)
+        mexErrMsgTxt("No more than two outputs are required!");
+#ifndef KERNEL_STATS
     if (nlhs > 1)
-        mexErrMsgTxt("No more than one output is required!");
+        mexErrMsgTxt("The second output is only available when the function is compiled with -DKERNEL_STATS.");
+#endif
 
     /* Check that first input is real*/
     if (!mxIsDouble(prhs[0]))
@@ -118,21 +189,26 @@ void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
     /* Get pointers to the inputs. */
     S =  mxGetPr(prhs[0]);
 
-    /* Convert input to integer values */
-    S_int = (int*) malloc (dim1*dim2*sizeof(int));
-    for(j=0;j<n;j++)
-        S_int[j] = (int) S[j];
-
-    /* Call the C subroutine. */
-    c_int = ArCmp_FFC(S_int,n);
+    /* Call the C subroutine (it converts input to integer values). */
+    STAT(stat_comparisons = stat_restarts = stat_maxmatch = 0;)
+    c_int = ArCmp_FFC(S,n);
 
     /* Create a new array and set the output pointer to it. */
     plhs[0] = mxCreateDoubleMatrix(1, 1, mxREAL);
     c =  mxGetPr(plhs[0]);
     c[0] = (double) c_int / (double) n; // Normalization
 
-    //free memory
-    free(S_int);
+#ifdef KERNEL_STATS
+    if (nlhs > 1)
+    {
+        static const char *fields[] = {"Comparisons","Restarts","Components","MaxMatchLength"};
+        plhs[1] = mxCreateStructMatrix(1,1,4,fields);
+        mxSetField(plhs[1],0,"Comparisons",mxCreateDoubleScalar(stat_comparisons));
+        mxSetField(plhs[1],0,"Restarts",mxCreateDoubleScalar(stat_restarts));
+        mxSetField(plhs[1],0,"Components",mxCreateDoubleScalar((double) c_int));
+        mxSetField(plhs[1],0,"MaxMatchLength",mxCreateDoubleScalar(stat_maxmatch));
+    }
+#endif
 
     return;
 }
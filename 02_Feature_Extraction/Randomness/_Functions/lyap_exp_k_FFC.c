@@ -18,6 +18,7 @@
  * If not, see <http://www.gnu.org/licenses/>.
  *
  * Usage method: results = lyap_exp_k_FFC(series,mindim,maxdim);
+ *               [results,stats] = lyap_exp_k_FFC(series,mindim,maxdim); (instrumentation mode)
  *
  * Input:
  * series: A fragment of bytes
@@ -26,10 +27,24 @@
  *
  * Outputs:
  * results: A vector with length maxdim-mindim+1 containing Lyapunov exponents
+ * stats: A structure of counters of the work done, with fields of length epscount (one element for each epsilon):
+ *  Epsilon: Neighborhood size (in the scale of series)
+ *  BoxedPoints: Number of points put in boxes
+ *  OccupiedBoxes: Number of non-empty boxes
+ *  MaxBoxOccupancy: Number of points in the most occupied box
+ *  NeighborsScanned: Number of candidate neighbors visited in the boxes around the reference points
+ *  WindowRejections: Number of candidates rejected by the temporal exclusion window
+ *  DistanceEvaluations: Number of coordinates of the candidates compared to epsilon
+ *  NeighborsFound: Number of neighbors found in mindim dimensions
+ *
+ * Note: The counters are compiled only in the instrumentation mode:
+ *  mex -O -DKERNEL_STATS lyap_exp_k_FFC.c
+ *  Otherwise, the kernel does no extra work and the second output is not available.
  *
  * Revisions:
  * 1999-Sep-03   The first version was written by Rainer Hegger.
  * 2020-Mar-28   The function was written in c-mex format.
+ * 2026-Oct-18   instrumentation mode with counters of the work done was added
  */
 
 #include "mex.h"
@@ -59,6 +74,15 @@ double *series,**lyap,*out;
 long box[BOX][BOX],*liste,**lfound,*found,**count;
 double max,min;
 
+/* Counters of the instrumentation mode (the index of the current epsilon is stat_eps) */
+#ifdef KERNEL_STATS
+#define STAT(statement) statement
+double *stat_boxed,*stat_boxes,*stat_maxocc,*stat_scanned,*stat_window,*stat_dist,*stat_found;
+unsigned int stat_eps;
+#else
+#define STAT(statement)
+#endif
+
 void iterate_points(long act)
 {
     double **lfactor;
@@ -146,16 +170,19 @@ void lfind_neighbors(long act,double eps)
             element=box[i2][j1&ibox];
             while (element != -1)
             {
+                STAT(stat_scanned[stat_eps]++;)
                 if ((element < (act-lwindow)) || (element > (act+lwindow)))
                 {
                     dx=series[act]-series[element];
                     dx*=dx;
+                    STAT(stat_dist[stat_eps]++;)
                     if (dx <= eps2) {
                         for (k=1;k<maxdim;k++)
                         {
                             k1=k*delay;
                             tmp = series[act+k1]-series[element+k1];
                             dx += tmp*tmp;
+                            STAT(stat_dist[stat_eps]++;)
                             if (dx <= eps2)
                             {
                                 k1=k-1;
@@ -167,10 +194,12 @@ void lfind_neighbors(long act,double eps)
                         }
                     }
                 }
+                STAT(else stat_window[stat_eps]++;)
                 element=liste[element];
             }
         }
     }
+    STAT(stat_found[stat_eps] += found[mindim-2];)
 }
 
 void put_in_boxes(double eps)
@@ -191,6 +220,23 @@ void put_in_boxes(double eps)
     liste[i]=box[j][k];
     box[j][k]=i;
   }
+
+#ifdef KERNEL_STATS
+  {
+    long element,occupancy;
+    stat_boxed[stat_eps]=(double)blength;
+    for (j=0;j<BOX;j++)
+      for (k=0;k<BOX;k++)
+        if (box[j][k] != -1) {
+          occupancy=0;
+          for (element=box[j][k];element != -1;element=liste[element])
+            occupancy++;
+          stat_boxes[stat_eps]++;
+          if (occupancy>stat_maxocc[stat_eps])
+            stat_maxocc[stat_eps]=(double)occupancy;
+        }
+  }
+#endif
 }
 
 int rescale_data(double *x,unsigned long l,double *min,double *interval)
@@ -263,6 +309,7 @@ int lyap_exp_k()
     for (l=0;l<epscount;l++)
     {
         epsilon=epsmin*pow(eps_fak,(double)l);
+        STAT(stat_eps=l;)
         for (i=0;i<maxdim-1;i++)
             for (j=0;j<=maxiter;j++)
             {
@@ -319,12 +366,19 @@ void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
     unsigned long dim1,dim2,i,j;
     double *series_tmp;
     int retval;
+#ifdef KERNEL_STATS
+    mxArray *stats;
+#endif
 
     /* Check for the proper number of arguments. */
     if (nrhs != 3)
         mexErrMsgTxt("Three inputs are required.");
+    if (nlhs > 2)
+        mexErrMsgTxt("No more than two outputs are required!");
+#ifndef KERNEL_STATS
     if (nlhs > 1)
-        mexErrMsgTxt("No more than one output is required!");
+        mexErrMsgTxt("The second output is only available when the function is compiled with -DKERNEL_STATS.");
+#endif
 
     /* Initialization */
     //debugfile = fopen("debugfile.dat","w");
@@ -370,9 +424,41 @@ void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
     for(j=0;j<(maxdim-mindim+1);j++)
         out[j] = -1;
 
+#ifdef KERNEL_STATS
+    /* Counters are kept in the fields of the second output (epscount is fixed above) */
+    {
+        static const char *fields[] = {"Epsilon","BoxedPoints","OccupiedBoxes","MaxBoxOccupancy",
+            "NeighborsScanned","WindowRejections","DistanceEvaluations","NeighborsFound"};
+        double **stat_ptr[] = {NULL,&stat_boxed,&stat_boxes,&stat_maxocc,&stat_scanned,&stat_window,&stat_dist,&stat_found};
+        stats = mxCreateStructMatrix(1,1,8,fields);
+        for (j=0;j<8;j++)
+        {
+            mxArray *field = mxCreateDoubleMatrix(1,epscount,mxREAL);
+            mxSetField(stats,0,fields[j],field);
+            if (stat_ptr[j])
+                *stat_ptr[j] = mxGetPr(field);
+        }
+    }
+#endif
+
     /* Call the C subroutine. */
     retval = lyap_exp_k();
 
+#ifdef KERNEL_STATS
+    /* Epsilon in the scale of series (epsmin and epsmax are rescaled in lyap_exp_k) */
+    if (retval==0)
+    {
+        double *eps_out = mxGetPr(mxGetField(stats,0,"Epsilon"));
+        double eps_fak = (epscount==1) ? 1.0 : pow(epsmax/epsmin,1.0/(double)(epscount-1));
+        for (j=0;j<epscount;j++)
+            eps_out[j] = epsmin*pow(eps_fak,(double)j)*max;
+    }
+    if (nlhs > 1)
+        plhs[1] = stats;
+    else
+        mxDestroyArray(stats);
+#endif
+
     /* Free Memory */
     //fclose(debugfile);
     free(series);
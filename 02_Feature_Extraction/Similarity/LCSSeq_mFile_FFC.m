@@ -1,4 +1,4 @@
-function L = LCSSeq_mFile_FFC(X,Y,m,n)
+function L = LCSSeq_mFile_FFC(X,Y,m,n,Band)
 
 % This function calculates the longest common subsequence (LCSSeq) between two
 % vectors using a dynamic programming approach.
@@ -22,18 +22,24 @@ function L = LCSSeq_mFile_FFC(X,Y,m,n)
 %   Y: The second vector
 %   m: The length of the first vector (optional)
 %   n: The length of the second vector (optional)
+%   Band: Band width of the approximate mode (optional); only the elements X(i) and Y(j) with |i-j|<=Band
+%       are matched (see LCSSeq_FFC). The default value is Inf (exact mode).
 %
 % Output:
 %   L: The length of the longest common subsequence between X and Y 
 %
 % Revisions:
 % 2020-Apr-26   function was created
+% 2026-Oct-18   approximate mode (banded dynamic programming) was added
 
 %% Initialization
-if nargin<3
+if nargin<3 || isempty(m)
     m = length(X);
     n = length(Y);
 end
+if nargin<5
+    Band = Inf;
+end
 
 Z = zeros(m+1,n+1);
 
@@ -43,7 +49,7 @@ for i=1:m+1
         if (i==1 || j==1)
             Z(i,j) = 0;
             
-        elseif (X(i-1)==Y(j-1))
+        elseif (X(i-1)==Y(j-1)) && abs(i-j)<=Band
             Z(i,j) = Z(i-1,j-1)+1;
             
         else
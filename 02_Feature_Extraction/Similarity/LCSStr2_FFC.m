@@ -1,4 +1,4 @@
-function L = LCSStr2_FFC(X,Y2)
+function L = LCSStr2_FFC(X,Y2,Band)
 
 % This function employs LCSStr_FFC in order to calculates the average of longest 
 % common substring (LCSStr) between a vector and a set of vectors.
@@ -20,29 +20,41 @@ function L = LCSStr2_FFC(X,Y2)
 % Inputs:
 %   X: The first vector
 %   Y: A cell array of vectors
+%   Band: Band width of the approximate mode of LCSStr_FFC (optional). The default value is Inf (exact mode).
+%       For each pair, the error of the normalized value is at most max(0,max(m,n)-Band-1-L)/min(m,n),
+%       where L is the approximate length, and m and n are the lengths of the vectors (see LCSStr_FFC).
 %
 % Output:
 %   L: The average length of the longest common substring between X and the elements of Y 
 %
 % Revisions:
 % 2020-Apr-28   function was created
+% 2026-Oct-18   approximate mode (banded dynamic programming) was added
+% 2026-Oct-18   LCSStr_mFile_FFC is used for the approximate mode if the C-MEX file does not support it
 
 %% Global Flag
 global C_MEX_64_Available
 
 %% Function Main Body
-if C_MEX_64_Available
+if nargin<3
+    Band = Inf;
+end
+if C_MEX_64_Available && (isinf(Band) || Banded_LCS_Available_FFC('LCSStr_FFC')) % Band needs a rebuilt C-MEX file
     N = length(Y2);
     L = 0;
     for j=1:N
-        L = L+LCSStr_FFC(X,Y2{j})/min(length(X),length(Y2{j}));
+        if isinf(Band)
+            L = L+LCSStr_FFC(X,Y2{j})/min(length(X),length(Y2{j}));
+        else
+            L = L+LCSStr_FFC(X,Y2{j},Band)/min(length(X),length(Y2{j}));
+        end
     end
     L = L/N;
 else
     N = length(Y2);
     L = 0;
     for j=1:N
-        L = L+LCSStr_mFile_FFC(X,Y2{j})/min(length(X),length(Y2{j}));
+        L = L+LCSStr_mFile_FFC(X,Y2{j},[],[],Band)/min(length(X),length(Y2{j}));
     end
     L = L/N;
 end
\ No newline at end of file
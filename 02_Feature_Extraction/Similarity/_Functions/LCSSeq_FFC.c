@@ -1,5 +1,15 @@
 /* This function calculates the longest common subsequence (LCSSeq) between two
- * vectors using a dynamic programming approach.
+ * vectors using a dynamic programming approach. For vectors of byte values, the
+ * bit-parallel form of the dynamic programming is used, in which one column of the
+ * dynamic programming table is kept as a bit vector and is updated by word operations.
+ * For the standard packet sizes (512, 1024, 1500 and 4096), specialized variants with
+ * fixed-size buffers and known word counts are selected at runtime; other lengths use
+ * the generic variant.
+ *
+ * In the approximate mode, only the elements X(i) and Y(j) with |i-j|<=Band can be matched
+ * (banded dynamic programming), and only the words of the bit vector that intersect the band
+ * are updated. For 4096-byte fragments and Band=128, about 5 of the 64 words are updated for
+ * each element of Y.
  *
  * Copyright (C) 2020 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
  *
@@ -16,25 +26,68 @@
  * If not, see <http://www.gnu.org/licenses/>.
  *
  * Usage method: L = LCSSeq_FFC(X,Y);
+ *               L = LCSSeq_FFC(X,Y,Band); (approximate mode)
+ *               [L,stats] = LCSSeq_FFC(X,Y); (instrumentation mode)
  *
  * Inputs:
  *  X: The first vector
  *  Y: The second vector
+ *  Band: Band width of the approximate mode (optional, non-negative integer). If Band is not
+ *      provided or Band is Inf, the exact LCSSeq is calculated.
  *
  * Output:
  *  L: The length of the longest common subsequence between X and Y
+ *      (in the approximate mode, the longest common subsequence whose matched elements satisfy |i-j|<=Band)
+ *  stats: A structure of counters of the work done with the following fields:
+ *      Cells: Number of cells of the dynamic programming table
+ *      WordOperations: Number of 64-bit word updates of the bit-parallel form (equal to Cells for the generic dynamic programming)
+ *      Method: 0 (generic dynamic programming), 1 (generic bit-parallel variant), 2 (bit-parallel variant of a standard packet size),
+ *          or 3 (banded bit-parallel variant of the approximate mode)
+ *
+ * Error bound of the approximate mode: Let L* be the exact LCSSeq, and m and n be the lengths of X and Y.
+ *  The matched elements X(i) and Y(j) of any common subsequence of length L* satisfy |i-j|<=max(m,n)-L*.
+ *  Therefore, the approximate mode never overestimates, and it is exact when L*>=max(m,n)-Band:
+ *      L <= L* <= max(L, max(m,n)-Band-1)
+ *  i.e. the error is zero for similar vectors, and the error of the normalized value L/min(m,n) is at most
+ *  max(0,max(m,n)-Band-1-L)/min(m,n). For dissimilar vectors, the bound is loose, and the actual effect on
+ *  classification can be measured by Validate_Approximate_LCS_FFC.
+ *
+ * Note: The counters are compiled only in the instrumentation mode:
+ *  mex -O -DKERNEL_STATS LCSSeq_FFC.c
+ *  Otherwise, the kernel does no extra work and the second output is not available.
  *
  * Revisions:
  * 2020-Apr-26   function was created
+ * 2026-Oct-18   bit-parallel variants specialized for the standard packet sizes were added
+ * 2026-Oct-18   instrumentation mode with counters of the work done was added
+ * 2026-Oct-18   approximate mode (banded dynamic programming) was added
  */
 
 #include "mex.h"
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#define FORCE_INLINE static __forceinline
+#else
+#define FORCE_INLINE static inline __attribute__((always_inline))
+#endif
 
+/* Global Variables */
 int *X;
 int *Y;
 int **Z;
 
-int LCSSeq(int m,int n)
+/* Counters of the instrumentation mode */
+#ifdef KERNEL_STATS
+#define STAT(statement) statement
+double stat_cells,stat_words,stat_method;
+#else
+#define STAT(statement)
+#endif
+
+/* Generic dynamic programming (for inputs which are not byte values). If band>=0, only the
+ * elements with |i-j|<=band are matched. */
+int LCSSeq(int m,int n,int band)
 {
     int i,j;
 
@@ -47,7 +100,7 @@ int LCSSeq(int m,int n)
 
             else
             {
-                if (X[i-1]==Y[j-1])
+                if (X[i-1]==Y[j-1] && (band<0 || (i-j<=band && j-i<=band)))
                     Z[i][j] = Z[i-1][j-1]+1;
 
                 else
@@ -64,17 +117,157 @@ int LCSSeq(int m,int n)
     return(Z[m][n]);
 
 }
+
+int popcount64(uint64_t x)
+{
+    x = x-((x>>1)&0x5555555555555555ULL);
+    x = (x&0x3333333333333333ULL)+((x>>2)&0x3333333333333333ULL);
+    x = (x+(x>>4))&0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x*0x0101010101010101ULL)>>56);
+}
+
+/* Bit-parallel LCS: bit i of V is zero iff the i-th column of the DP table increases at row i.
+ * PM[c*nw+w] is the match bit vector of byte value c; PM is all-zero on entry and is cleared
+ * before return. When nw is a compile-time constant, the word loops have known trip counts and
+ * are unrolled by the compiler.
+ * If band>=0, the match bits of rows outside [j-band,j+band] are masked for column j, and only
+ * the words that intersect this range are updated: the words below the range have no match bits
+ * (so they are unchanged and produce no carry), and the words above the range have not been
+ * updated yet (so they are all-one and absorb the carry). The exact variants pass band=-1, which
+ * is a compile-time constant after inlining. */
+FORCE_INLINE int LCSSeq_BitParallel(const int *Xb,int m,const int *Yb,int n,int nw,uint64_t *PM,uint64_t *V,int band)
+{
+    int i,j,w,L,lo,hi,wlo,whi;
+    uint64_t U,sum,t,carry,pmw,*pm;
+
+    for (i=0;i<m;i++)
+        PM[Xb[i]*nw+(i>>6)] |= 1ULL<<(i&63);
+    for (w=0;w<nw;w++)
+        V[w] = ~0ULL;
+    STAT(stat_cells = (band<0) ? (double)m*n : 0; stat_words = 0;)
+
+    lo = 0; hi = m-1;
+    wlo = 0; whi = nw-1;
+    for (j=0;j<n;j++)
+    {
+        if (band>=0)
+        {
+            lo = j-band; hi = j+band;
+            if (lo>m-1)
+                break;
+            lo = (lo<0) ? 0 : lo;
+            hi = (hi>m-1) ? m-1 : hi;
+            wlo = lo>>6; whi = hi>>6;
+            STAT(stat_cells += hi-lo+1;)
+        }
+        STAT(stat_words += whi-wlo+1;)
+
+        pm = PM+Yb[j]*nw;
+        carry = 0;
+        for (w=wlo;w<=whi;w++)
+        {
+            pmw = pm[w];
+            if (band>=0)
+            {
+                if (w==wlo)
+                    pmw &= ~0ULL<<(lo&63);
+                if (w==whi)
+                    pmw &= ~0ULL>>(63-(hi&63));
+            }
+            U = V[w]&pmw;
+            sum = V[w]+U;
+            t = sum+carry;
+            carry = (sum<U)|(t<sum);
+            V[w] = t|(V[w]&~pmw);
+        }
+    }
+
+    for (i=0;i<m;i++)
+        PM[Xb[i]*nw+(i>>6)] = 0;
+
+    /* The number of zero bits among the first m bits of V */
+    L = 0;
+    for (w=0;w<nw;w++)
+    {
+        if ((w+1)*64<=m)
+            L += 64-popcount64(V[w]);
+        else
+            L += (m-w*64)-popcount64(V[w]&((1ULL<<(m-w*64))-1));
+    }
+
+    return L;
+}
+
+/* Variants for the standard packet sizes (fixed-size buffers and word counts); the exact and
+ * the banded forms are inlined separately */
+#define DEFINE_LCSSEQ_FIXED(M) \
+int LCSSeq_##M(const int *Xb,const int *Yb,int n,int band) \
+{ \
+    static uint64_t PM[256*((M+63)/64)]; \
+    uint64_t V[(M+63)/64]; \
+    if (band<0) \
+        return LCSSeq_BitParallel(Xb,M,Yb,n,(M+63)/64,PM,V,-1); \
+    return LCSSeq_BitParallel(Xb,M,Yb,n,(M+63)/64,PM,V,band); \
+}
+
+DEFINE_LCSSEQ_FIXED(512)
+DEFINE_LCSSEQ_FIXED(1024)
+DEFINE_LCSSEQ_FIXED(1500)
+DEFINE_LCSSEQ_FIXED(4096)
+
+/* Generic variant for other lengths, and for the approximate mode (band>=0) */
+int LCSSeq_Generic(const int *Xb,int m,const int *Yb,int n,int band)
+{
+    int nw = (m+63)/64, L;
+    uint64_t *PM = (uint64_t*)calloc(256*nw,sizeof(uint64_t));
+    uint64_t *V = (uint64_t*)malloc(sizeof(uint64_t)*nw);
+
+    L = LCSSeq_BitParallel(Xb,m,Yb,n,nw,PM,V,band);
+
+    free(PM);
+    free(V);
+    return L;
+}
+
+/* Runtime dispatcher: the first vector is kept as the bit vector */
+int LCSSeq_Dispatch(const int *Xb,int m,const int *Yb,int n,int band)
+{
+    if (m==0 || n==0)
+        return 0;
+    STAT(stat_method = (band<0) ? 2 : 3;)
+    switch (m)
+    {
+        case 512:  return LCSSeq_512(Xb,Yb,n,band);
+        case 1024: return LCSSeq_1024(Xb,Yb,n,band);
+        case 1500: return LCSSeq_1500(Xb,Yb,n,band);
+        case 4096: return LCSSeq_4096(Xb,Yb,n,band);
+    }
+    switch (n) /* LCS and the band are symmetric */
+    {
+        case 512:  return LCSSeq_512(Yb,Xb,m,band);
+        case 1024: return LCSSeq_1024(Yb,Xb,m,band);
+        case 1500: return LCSSeq_1500(Yb,Xb,m,band);
+        case 4096: return LCSSeq_4096(Yb,Xb,m,band);
+    }
+    STAT(stat_method = (band<0) ? 1 : 3;)
+    return LCSSeq_Generic(Xb,m,Yb,n,band);
+}
+
 void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
 {
-    int m,n,dim1,dim2,j;
-    double *Xd,*Yd,*out;
+    int m,n,dim1,dim2,j,isbyte,band;
+    double *Xd,*Yd,*out,Bd;
     int L;
 
     /* Check for the proper number of arguments. */
-    if (nrhs != 2)
-        mexErrMsgTxt("Two inputs are required.");
+    if (nrhs != 2 && nrhs != 3)
+        mexErrMsgTxt("Two or three inputs are required.");
+    if (nlhs > 2)
+        mexErrMsgTxt("No more than two outputs are required!");
+#ifndef KERNEL_STATS
     if (nlhs > 1)
-        mexErrMsgTxt("No more than one output is required!");
+        mexErrMsgTxt("The second output is only available when the function is compiled with -DKERNEL_STATS.");
+#endif
 
     /* Get the length of the first input vector. */
     dim1 = mxGetM(prhs[0]);
@@ -90,37 +283,81 @@ void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
         mexErrMsgTxt("Second Input must be vector.\n");
     n = dim1*dim2;
 
+    /* Get the band width of the approximate mode (-1 for the exact mode). */
+    band = -1;
+    if (nrhs == 3)
+    {
+        if (mxGetNumberOfElements(prhs[2]) != 1)
+            mexErrMsgTxt("Band must be a scalar.\n");
+        Bd = mxGetScalar(prhs[2]);
+        if (!(Bd>=0))
+            mexErrMsgTxt("Band must be a non-negative integer or Inf.\n");
+        if (!mxIsInf(Bd) && Bd<(m>n ? m : n))
+        {
+            band = (int)Bd;
+            if (band!=Bd)
+                mexErrMsgTxt("Band must be a non-negative integer or Inf.\n");
+        }
+    }
+
     /* Get pointers to the inputs and prepare inputs. */
+    isbyte = 1;
     Xd = mxGetPr(prhs[0]);
     X = (int*)malloc(sizeof(int)*m);
     for(j=0;j<m;j++)
+    {
         X[j] = (int) Xd[j];
+        if (X[j]<0 || X[j]>255 || X[j]!=Xd[j])
+            isbyte = 0;
+    }
 
     Yd = mxGetPr(prhs[1]);
     Y = (int*)malloc(sizeof(int)*n);
     for(j=0;j<n;j++)
+    {
         Y[j] = (int) Yd[j];
-
-    /* Initialize Z */
-    Z = (int**)malloc(sizeof(int*)*(m+1));
-    for(j=0;j<=m;j++)
-        Z[j] = (int*)malloc(sizeof(int)*(n+1));
+        if (Y[j]<0 || Y[j]>255 || Y[j]!=Yd[j])
+            isbyte = 0;
+    }
 
     /* Call the C subroutine. */
-    L = LCSSeq(m,n);
+    STAT(stat_cells = stat_words = stat_method = 0;)
+    if (isbyte)
+        L = LCSSeq_Dispatch(X,m,Y,n,band);
+    else
+    {
+        Z = (int**)malloc(sizeof(int*)*(m+1));
+        for(j=0;j<=m;j++)
+            Z[j] = (int*)malloc(sizeof(int)*(n+1));
+
+        L = LCSSeq(m,n,band);
+        STAT(stat_cells = stat_words = (double)(m+1)*(n+1);)
+
+        for(j=0;j<=m;j++)
+            free(Z[j]);
+        free(Z);
+    }
 
     /* Create a new array and set the output pointer to it. */
     plhs[0] = mxCreateDoubleMatrix(1, 1, mxREAL);
     out =  mxGetPr(plhs[0]);
     out[0] = (double) L;
 
+#ifdef KERNEL_STATS
+    if (nlhs > 1)
+    {
+        static const char *fields[] = {"Cells","WordOperations","Method"};
+        plhs[1] = mxCreateStructMatrix(1,1,3,fields);
+        mxSetField(plhs[1],0,"Cells",mxCreateDoubleScalar(stat_cells));
+        mxSetField(plhs[1],0,"WordOperations",mxCreateDoubleScalar(stat_words));
+        mxSetField(plhs[1],0,"Method",mxCreateDoubleScalar(stat_method));
+    }
+#endif
+
     /* Free Memory */
     free(Y);
     free(X);
-    for(j=0;j<=m;j++)
-        free(Z[j]);
-    free(Z);
 
     return;
 
-}
\ No newline at end of file
+}
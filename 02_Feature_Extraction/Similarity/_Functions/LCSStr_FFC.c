@@ -1,6 +1,10 @@
 /* This function calculates the longest common substring (LCSStr) between two
  * vectors using a dynamic programming approach.
  *
+ * In the approximate mode, only the common substrings X(i:i+k) and Y(j:j+k) with |i-j|<=Band are
+ * considered (banded dynamic programming), so (2*Band+1) cells are calculated in each row instead
+ * of length(Y) cells. For 4096-byte fragments and Band=128, this is about 1/16 of the cells.
+ *
  * Copyright (C) 2020 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
  *
  * This file is a part of Fragments-Expert software, a software package for
@@ -16,65 +20,193 @@
  * If not, see <http://www.gnu.org/licenses/>.
  *
  * Usage method: L = LCSStr_FFC(X,Y);
+ *               L = LCSStr_FFC(X,Y,Band); (approximate mode)
+ *               [L,stats] = LCSStr_FFC(X,Y); (instrumentation mode)
  *
  * Inputs:
  *  X: The first vector
  *  Y: The second vector
+ *  Band: Band width of the approximate mode (optional, non-negative integer). If Band is not
+ *      provided or Band is Inf, the exact LCSStr is calculated.
  *
  * Output:
  *  L: The length of the longest common substring between X and Y
+ *      (in the approximate mode, the longest common substring whose positions in X and Y differ by at most Band)
+ *  stats: A structure of counters of the work done with the following fields:
+ *      Cells: Number of cells of the dynamic programming table
+ *      Matches: Number of cells with equal elements of X and Y (cells that extend a common substring)
+ *      Method: 1 (generic variant), 2 (variant of a standard packet size), or 3 (banded variant of the approximate mode)
+ *
+ * Error bound of the approximate mode: Let L* be the exact LCSStr, and m and n be the lengths of X and Y.
+ *  A common substring X(i:i+k) = Y(j:j+k) with |i-j|>Band is not longer than max(m,n)-Band-1.
+ *  Therefore, the approximate mode never overestimates, and
+ *      L <= L* <= max(L, max(m,n)-Band-1)
+ *  i.e. the error of the normalized value L/min(m,n) is at most max(0,max(m,n)-Band-1-L)/min(m,n).
+ *  The bound is loose for dissimilar vectors; the actual effect on classification can be measured
+ *  by Validate_Approximate_LCS_FFC.
+ *
+ * Note: The counters are compiled only in the instrumentation mode:
+ *  mex -O -DKERNEL_STATS LCSStr_FFC.c
+ *  Otherwise, the kernel does no extra work and the second output is not available.
  *
  * Revisions:
  * 2020-Apr-26   function was created
+ * 2026-Oct-18   only two rows of the dynamic programming table are kept, and variants with
+ *               fixed-size buffers are selected at runtime for the standard packet sizes
+ * 2026-Oct-18   instrumentation mode with counters of the work done was added
+ * 2026-Oct-18   approximate mode (banded dynamic programming) was added
  */
 
 #include "mex.h"
 
+#if defined(_MSC_VER)
+#define FORCE_INLINE static __forceinline
+#else
+#define FORCE_INLINE static inline __attribute__((always_inline))
+#endif
+
+/* Global Variables */
 int *X;
 int *Y;
-int **Z;
 
-int LCSStr(int m,int n)
+/* Counters of the instrumentation mode */
+#ifdef KERNEL_STATS
+#define STAT(statement) statement
+double stat_cells,stat_matches,stat_method;
+#else
+#define STAT(statement)
+#endif
+
+/* Dynamic programming with two rows of the table. The row length n is a compile-time
+ * constant in the specialized variants, so the inner loop has a known trip count and
+ * has no loop-carried dependency (it can be vectorized by the compiler). */
+FORCE_INLINE int LCSStr_TwoRows(const int *Xv,int m,const int *Yv,int n,int *prev,int *cur)
 {
-    int i,j,L;
+    int i,j,L,*tmp;
 
     L = 0;
+    for (j=0;j<=n;j++)
+        prev[j] = 0;
+    cur[0] = 0;
 
-    for (i=0;i<=m;i++)
+    for (i=1;i<=m;i++)
     {
-        for (j=0;j<=n;j++)
+        const int x = Xv[i-1];
+        for (j=1;j<=n;j++)
         {
-            if ((i==0)||(j==0))
-                Z[i][j] = 0;
-
-            else
-            {
-                if (X[i-1]==Y[j-1])
-                {
-                    Z[i][j]=1+Z[i-1][j-1];
-                    if (Z[i][j]>L)
-                        L = Z[i][j];
-                }
-                else
-                    Z[i][j] = 0;
-            }
+            cur[j] = (x==Yv[j-1]) ? prev[j-1]+1 : 0;
+            L = (cur[j]>L) ? cur[j] : L;
+            STAT(stat_matches += (x==Yv[j-1]);)
         }
+        tmp = prev; prev = cur; cur = tmp;
     }
+    STAT(stat_cells = (double)m*n;)
 
     return(L);
 
 }
+
+/* Variants for the standard packet sizes (fixed-size buffers) */
+#define DEFINE_LCSSTR_FIXED(N) \
+int LCSStr_##N(const int *Xv,int m,const int *Yv) \
+{ \
+    int prev[N+1],cur[N+1]; \
+    return LCSStr_TwoRows(Xv,m,Yv,N,prev,cur); \
+}
+
+DEFINE_LCSSTR_FIXED(512)
+DEFINE_LCSSTR_FIXED(1024)
+DEFINE_LCSSTR_FIXED(1500)
+DEFINE_LCSSTR_FIXED(4096)
+
+/* Generic variant for other lengths */
+int LCSStr(int m,int n)
+{
+    int L;
+    int *prev = (int*)malloc(sizeof(int)*(n+1));
+    int *cur = (int*)malloc(sizeof(int)*(n+1));
+
+    L = LCSStr_TwoRows(X,m,Y,n,prev,cur);
+
+    free(prev);
+    free(cur);
+    return(L);
+}
+
+/* Banded dynamic programming with two rows of the table: only the cells with |i-j|<=band are
+ * calculated. The cells of the previous row which are read for row i are [i-band-1,i+band-1],
+ * which are all inside the band of the previous row, so the rows are not cleared. */
+int LCSStr_Banded(int m,int n,int band)
+{
+    int i,j,L,jlo,jhi,*tmp;
+    int *prev = (int*)calloc(n+1,sizeof(int));
+    int *cur = (int*)calloc(n+1,sizeof(int));
+
+    L = 0;
+    for (i=1;i<=m && i-band<=n;i++)
+    {
+        const int x = X[i-1];
+        jlo = (i-band>1) ? i-band : 1;
+        jhi = (i+band<n) ? i+band : n;
+        for (j=jlo;j<=jhi;j++)
+        {
+            cur[j] = (x==Y[j-1]) ? prev[j-1]+1 : 0;
+            L = (cur[j]>L) ? cur[j] : L;
+            STAT(stat_matches += (x==Y[j-1]);)
+        }
+        STAT(stat_cells += jhi-jlo+1;)
+        tmp = prev; prev = cur; cur = tmp;
+    }
+
+    free(prev);
+    free(cur);
+    return(L);
+}
+
+/* Runtime dispatcher: the second vector is kept along the rows */
+int LCSStr_Dispatch(int m,int n,int band)
+{
+    if (m==0 || n==0)
+        return 0;
+    if (band>=0)
+    {
+        STAT(stat_method = 3;)
+        return LCSStr_Banded(m,n,band);
+    }
+    STAT(stat_method = 2;)
+    switch (n)
+    {
+        case 512:  return LCSStr_512(X,m,Y);
+        case 1024: return LCSStr_1024(X,m,Y);
+        case 1500: return LCSStr_1500(X,m,Y);
+        case 4096: return LCSStr_4096(X,m,Y);
+    }
+    switch (m) /* LCS is symmetric */
+    {
+        case 512:  return LCSStr_512(Y,n,X);
+        case 1024: return LCSStr_1024(Y,n,X);
+        case 1500: return LCSStr_1500(Y,n,X);
+        case 4096: return LCSStr_4096(Y,n,X);
+    }
+    STAT(stat_method = 1;)
+    return LCSStr(m,n);
+}
+
 void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
 {
-    int m,n,dim1,dim2,j;
-    double *Xd,*Yd,*out;
+    int m,n,dim1,dim2,j,band;
+    double *Xd,*Yd,*out,Bd;
     int L;
 
     /* Check for the proper number of arguments. */
-    if (nrhs != 2)
-        mexErrMsgTxt("Two inputs are required.");
+    if (nrhs != 2 && nrhs != 3)
+        mexErrMsgTxt("Two or three inputs are required.");
+    if (nlhs > 2)
+        mexErrMsgTxt("No more than two outputs are required!");
+#ifndef KERNEL_STATS
     if (nlhs > 1)
-        mexErrMsgTxt("No more than one output is required!");
+        mexErrMsgTxt("The second output is only available when the function is compiled with -DKERNEL_STATS.");
+#endif
 
     /* Get the length of the first input vector. */
     dim1 = mxGetM(prhs[0]);
@@ -90,6 +222,23 @@ void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
         mexErrMsgTxt("Second Input must be vector.\n");
     n = dim1*dim2;
 
+    /* Get the band width of the approximate mode (-1 for the exact mode). */
+    band = -1;
+    if (nrhs == 3)
+    {
+        if (mxGetNumberOfElements(prhs[2]) != 1)
+            mexErrMsgTxt("Band must be a scalar.\n");
+        Bd = mxGetScalar(prhs[2]);
+        if (!(Bd>=0))
+            mexErrMsgTxt("Band must be a non-negative integer or Inf.\n");
+        if (!mxIsInf(Bd) && Bd<(m>n ? m : n))
+        {
+            band = (int)Bd;
+            if (band!=Bd)
+                mexErrMsgTxt("Band must be a non-negative integer or Inf.\n");
+        }
+    }
+
     /* Get pointers to the inputs and prepare inputs. */
     Xd = mxGetPr(prhs[0]);
     X = (int*)malloc(sizeof(int)*m);
@@ -101,26 +250,30 @@ void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
     for(j=0;j<n;j++)
         Y[j] = (int) Yd[j];
 
-    /* Initialize Z */
-    Z = (int**)malloc(sizeof(int*)*(m+1));
-    for(j=0;j<=m;j++)
-        Z[j] = (int*)malloc(sizeof(int)*(n+1));
-
     /* Call the C subroutine. */
-    L = LCSStr(m,n);
+    STAT(stat_cells = stat_matches = stat_method = 0;)
+    L = LCSStr_Dispatch(m,n,band);
 
     /* Create a new array and set the output pointer to it. */
     plhs[0] = mxCreateDoubleMatrix(1, 1, mxREAL);
     out =  mxGetPr(plhs[0]);
     out[0] = (double) L;
 
+#ifdef KERNEL_STATS
+    if (nlhs > 1)
+    {
+        static const char *fields[] = {"Cells","Matches","Method"};
+        plhs[1] = mxCreateStructMatrix(1,1,3,fields);
+        mxSetField(plhs[1],0,"Cells",mxCreateDoubleScalar(stat_cells));
+        mxSetField(plhs[1],0,"Matches",mxCreateDoubleScalar(stat_matches));
+        mxSetField(plhs[1],0,"Method",mxCreateDoubleScalar(stat_method));
+    }
+#endif
+
     /* Free Memory */
     free(Y);
     free(X);
-    for(j=0;j<=m;j++)
-        free(Z[j]);
-    free(Z);
 
     return;
 
-}
\ No newline at end of file
+}
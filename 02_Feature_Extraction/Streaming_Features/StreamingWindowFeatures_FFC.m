@@ -0,0 +1,63 @@
+function [Features,Offsets,state] = StreamingWindowFeatures_FFC(bytes,state)
+
+% This function computes byte-distribution features over a sliding window of a continuous
+% byte stream. The stream is given chunk by chunk. For each chunk, one row of features is
+% produced for each position of the window (moved by stride bytes) which is completed by
+% this chunk. The features are updated incrementally: the bytes which leave the window are
+% evicted and the bytes which enter it are added (see StreamingWindowFeatures_Core_FFC).
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   bytes: Vector of byte values (the next chunk of the stream)
+%   state: The state of the streaming feature extractor (see StreamingWindowFeatures_Init_FFC)
+%
+% Outputs:
+%   Features: Rx525 matrix of features, where R is the number of windows completed by this chunk.
+%       The columns are BFD (256 values), SdFreq, ModesFreq, CorNextFreq, ChiSq (the same as BFD_FFC),
+%       Entropy, d_Entropy (the same as Entropy_FFC), BinaryRatio (the same as BinaryRatio_FFC),
+%       RoC (257 values, the same as RoC_FFC), LongestContiguous, ArithmeticMean, STD, Skewness and
+%       Kurtosis. The labels are available in state.FeatureLabels.
+%   Offsets: Rx1 vector that contains the position of the first byte of each window in the stream
+%   state: The updated state
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Append the chunk to the remaining bytes
+bytes = double(bytes(:)');
+if state.Skip>0 % The bytes between non-overlapping windows (stride>windowSize) are skipped
+    skip = min(state.Skip,length(bytes));
+    bytes = bytes(skip+1:end);
+    state.Skip = state.Skip-skip;
+end
+buffer = [state.Buffer bytes];
+
+%% Features of the completed windows
+F = StreamingWindowFeatures_Core_FFC(buffer,state.WindowSize,state.Stride);
+R = size(F,1);
+
+ChiSq = chi2cdf(F(:,260),255,'upper');
+dE = state.HNu-F(:,261);
+MeanRoC = mean(F(:,263:518),2);
+Features = [F(:,1:259) ChiSq F(:,261) dE F(:,262:518) MeanRoC F(:,519:523)];
+
+Offsets = state.Position+(0:R-1)'*state.Stride;
+
+%% Keep the bytes which are needed for the next windows
+consumed = min(R*state.Stride,length(buffer));
+state.Buffer = buffer(consumed+1:end);
+state.Skip = R*state.Stride-consumed;
+state.Position = state.Position+R*state.Stride;
@@ -0,0 +1,65 @@
+function [Features,Offsets,FeatureLabels] = StreamingWindowFeatures_File_FFC(filename,windowSize,stride,ChunkSize)
+
+% This function computes byte-distribution features over a sliding window of a file, 
+% which is read chunk by chunk as a byte stream. It can be used as a stand-in for a
+% live byte source (e.g. network traffic) when testing StreamingWindowFeatures_FFC.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   filename: The name of the file
+%   windowSize: The length of the sliding window in bytes (>=4)
+%   stride: The number of bytes by which the window is moved at each step (>=1)
+%   ChunkSize (optional): The number of bytes which are read at each step (default: 1048576)
+%
+% Outputs:
+%   Features: Matrix of features with one row for each position of the window (see StreamingWindowFeatures_FFC)
+%   Offsets: The position of the first byte of each window in the file
+%   FeatureLabels: Labels of the features
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+if nargin<4
+    ChunkSize = 1048576;
+end
+
+state = StreamingWindowFeatures_Init_FFC(windowSize,stride);
+FeatureLabels = state.FeatureLabels;
+
+fileID = fopen(filename,'r');
+if fileID<0
+    error('File %s cannot be opened.',filename);
+end
+
+%% Read the file chunk by chunk
+Features = cell(0,1);
+Offsets = cell(0,1);
+while true
+    bytes = fread(fileID,ChunkSize,'uint8=>double')';
+    if isempty(bytes)
+        break;
+    end
+    [Features{end+1,1},Offsets{end+1,1},state] = StreamingWindowFeatures_FFC(bytes,state); %#ok<AGROW>
+end
+fclose(fileID);
+
+Features = cell2mat(Features);
+Offsets = cell2mat(Offsets);
+if isempty(Features)
+    Features = zeros(0,length(FeatureLabels));
+    Offsets = zeros(0,1);
+end
@@ -0,0 +1,69 @@
+function state = StreamingWindowFeatures_Init_FFC(windowSize,stride)
+
+% This function creates the state of a streaming feature extractor which computes 
+% byte-distribution features over a sliding window of a continuous byte stream.
+% The state is passed to StreamingWindowFeatures_FFC together with each new chunk of the stream.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   windowSize: The length of the sliding window in bytes (>=4)
+%   stride: The number of bytes by which the window is moved at each step (>=1)
+%
+% Outputs:
+%   state: A structure with the following fields
+%       WindowSize: The length of the sliding window
+%       Stride: The number of bytes by which the window is moved at each step
+%       Buffer: The bytes of the stream which are still needed for the next windows
+%       Position: The position of the first byte of the next window in the stream (starting from 1)
+%       Skip: The number of the next bytes of the stream which are not included in any window
+%       HNu: n-truncated entropy of uniform distribution for the window size (see Entropy_FFC)
+%       FeatureLabels: Labels of the features
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Check Inputs
+[Err,ErrMsg] = Check_Variable_Value_FFC(windowSize,'Window size','type','scalar','class','real','class','integer','min',4);
+if Err
+    error(ErrMsg);
+end
+[Err,ErrMsg] = Check_Variable_Value_FFC(stride,'Stride','type','scalar','class','real','class','integer','min',1);
+if Err
+    error(ErrMsg);
+end
+
+%% State
+state.WindowSize = windowSize;
+state.Stride = stride;
+state.Buffer = zeros(1,0);
+state.Position = 1;
+state.Skip = 0;
+
+c = windowSize/256;
+j = (1:171);
+state.HNu = log2(c)+log2(256)-exp(-c)*sum(c.^(j-1)./factorial(j-1).*log2(j));
+
+%% Feature Labels
+FeatureLabels = cell(1,525);
+for i=0:255
+    FeatureLabels{i+1} = sprintf('BFD_%d',i);
+end
+FeatureLabels(257:263) = {'SdFreq','ModesFreq','CorNextFreq','ChiSq','Entropy','d_Entropy','BinaryRatio'};
+for i=0:255
+    FeatureLabels{264+i} = sprintf('RoC_%d',i);
+end
+FeatureLabels(520:525) = {'MeanRoC','LongestContiguous','ArithmeticMean','STD','Skewness','Kurtosis'};
+state.FeatureLabels = FeatureLabels;
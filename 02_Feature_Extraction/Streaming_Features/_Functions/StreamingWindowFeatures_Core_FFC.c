@@ -0,0 +1,344 @@
+/* This c-mex function computes byte-distribution features over a sliding window of a byte stream.
+ * The window is moved by "stride" bytes at each step and one row of features is produced for each
+ * position of the window. Only the first window is computed from scratch. For the next windows, the
+ * sufficient statistics of all features are updated by evicting the bytes which leave the window and
+ * adding the bytes which enter it, so that the cost of each row is O(stride) and not O(windowSize).
+ * The central moments are computed from the byte counts (256 terms), so that they do not suffer from
+ * the cancellation of the sums of powers.
+ *
+ * Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+ *
+ * This file is a part of Fragments-Expert software, a software package for
+ * feature extraction from file fragments and classification among various file formats.
+ *
+ * Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Usage method: F = StreamingWindowFeatures_Core_FFC(buffer,windowSize,stride);
+ *
+ * Inputs:
+ *  buffer: Row vector of byte values (length n)
+ *  windowSize: The length of the sliding window (>=4)
+ *  stride: The number of bytes by which the window is moved at each step (>=1)
+ *
+ * Output:
+ *  F: Rx(NUM_FEATURES) matrix, where R = floor((n-windowSize)/stride)+1. Row r contains the features of
+ *      buffer((r-1)*stride+1:(r-1)*stride+windowSize), in the following order:
+ *      1-256: BFD, i.e. byte frequencies multiplied by 256 (the same as BFD_FFC)
+ *      257: SdFreq, standard deviation of the byte frequencies
+ *      258: ModesFreq, the sum of the four highest byte frequencies
+ *      259: CorNextFreq, correlation of the frequencies of byte values m and m+1
+ *      260: ChiSq statistic for the test of uniform distribution (the p-value is computed by the caller)
+ *      261: Entropy
+ *      262: Binary Ratio (the same as BinaryRatio_FFC)
+ *      263-518: Normalized Rate of Change (the same as the first 256 outputs of RoC_FFC)
+ *      519: The size of the longest contiguous streak of repeating bytes
+ *      520-523: Mean, standard deviation, skewness and kurtosis (unbiased estimations)
+ *
+ * Revisions:
+ * 2026-Oct-18   function was created
+ * 2026-Oct-18   central moments are computed from the byte counts (instead of the sums of powers)
+ */
+
+#include "mex.h"
+#include <math.h>
+#include <string.h>
+
+#define NUM_FEATURES 523
+
+/* Global Variables */
+int W;                      /* window size */
+int *cnt;                   /* byte counts */
+int *order,*pos;            /* byte values sorted by count (descending) and their positions */
+int *first,*last;           /* first and last position of the byte values with a given count */
+int *roc;                   /* histogram of absolute differences of consecutive bytes */
+int *runs,rhead,rtail;      /* queue of the lengths of the runs of repeating bytes */
+int *runcnt,runmax;         /* histogram of the lengths of the runs and the maximum length */
+double *clog2c;             /* c*log2(c) for c=0,...,W */
+long long sumsq,sumnext;    /* sum of cnt^2, and sum of cnt(m)*cnt(m+1) */
+long long ones;             /* number of one bits */
+long long S1,S2;            /* sum and sum of squares of (byte-128) */
+double sumclog;             /* sum of cnt*log2(cnt) */
+int popcnt[256];
+
+/* Add byte value b to the counters */
+void count_inc(int b)
+{
+    int c = cnt[b], i = pos[b], j = first[c], t = order[j];
+
+    order[i] = t; pos[t] = i;
+    order[j] = b; pos[b] = j;
+    if (j+1<=last[c])
+        first[c] = j+1;
+    if (j>0 && cnt[order[j-1]]==c+1)
+        last[c+1] = j;
+    else
+    {
+        first[c+1] = j;
+        last[c+1] = j;
+    }
+
+    sumsq += 2*c+1;
+    sumnext += (b>0 ? cnt[b-1] : 0)+(b<255 ? cnt[b+1] : 0);
+    sumclog += clog2c[c+1]-clog2c[c];
+    cnt[b] = c+1;
+}
+
+/* Remove byte value b from the counters */
+void count_dec(int b)
+{
+    int c = cnt[b], i = pos[b], j = last[c], t = order[j];
+
+    order[i] = t; pos[t] = i;
+    order[j] = b; pos[b] = j;
+    if (j-1>=first[c])
+        last[c] = j-1;
+    if (j<255 && cnt[order[j+1]]==c-1)
+        first[c-1] = j;
+    else
+    {
+        first[c-1] = j;
+        last[c-1] = j;
+    }
+
+    sumsq -= 2*c-1;
+    sumnext -= (b>0 ? cnt[b-1] : 0)+(b<255 ? cnt[b+1] : 0);
+    sumclog += clog2c[c-1]-clog2c[c];
+    cnt[b] = c-1;
+}
+
+/* Add a byte to the end of the window (prev is the previous byte, or -1) */
+void add_byte(int b,int prev)
+{
+    long long v = b-128;
+
+    count_inc(b);
+    ones += popcnt[b];
+    S1 += v; S2 += v*v;
+
+    if (prev>=0)
+        roc[b>prev ? b-prev : prev-b]++;
+
+    if (rtail>=rhead && prev==b)
+    {
+        runcnt[runs[rtail]]--;
+        runs[rtail]++;
+    }
+    else
+        runs[++rtail] = 1;
+    runcnt[runs[rtail]]++;
+    if (runs[rtail]>runmax)
+        runmax = runs[rtail];
+}
+
+/* Remove a byte from the beginning of the window (next is the byte after it) */
+void remove_byte(int b,int next)
+{
+    long long v = b-128;
+
+    count_dec(b);
+    ones -= popcnt[b];
+    S1 -= v; S2 -= v*v;
+
+    roc[b>next ? b-next : next-b]--;
+
+    runcnt[runs[rhead]]--;
+    runs[rhead]--;
+    if (runs[rhead]>0)
+        runcnt[runs[rhead]]++;
+    else
+        rhead++;
+    while (runmax>0 && runcnt[runmax]==0)
+        runmax--;
+}
+
+/* Reset the counters to an empty window */
+void reset_window(void)
+{
+    int i;
+
+    for (i=0;i<256;i++)
+    {
+        cnt[i] = 0;
+        roc[i] = 0;
+        order[i] = i;
+        pos[i] = i;
+    }
+    first[0] = 0;
+    last[0] = 255;
+    memset(runcnt,0,(W+2)*sizeof(int));
+    sumsq = 0; sumnext = 0; sumclog = 0; ones = 0;
+    S1 = 0; S2 = 0;
+    rhead = 0; rtail = -1; runmax = 0;
+}
+
+/* Write the features of the current window to row r of F (column-major, R rows) */
+void write_features(double *F,int R,int r)
+{
+    int i;
+    double n = (double) W, scale = 256.0/W, mu, m2, m3, m4, d, d2, sd, var, num, den;
+
+    /* BFD */
+    for (i=0;i<256;i++)
+        F[r+(size_t)i*R] = scale*cnt[i];
+
+    /* SdFreq: the mean of frequencies is always one */
+    var = (scale*scale*(double)sumsq-256.0)/255.0;
+    F[r+(size_t)256*R] = sqrt(var>0 ? var : 0);
+
+    /* ModesFreq */
+    F[r+(size_t)257*R] = scale*(cnt[order[0]]+cnt[order[1]]+cnt[order[2]]+cnt[order[3]]);
+
+    /* CorNextFreq */
+    num = scale*scale*(double)sumnext-(256.0-scale*cnt[255])-(256.0-scale*cnt[0])+255.0;
+    den = scale*scale*(double)sumsq-256.0;
+    F[r+(size_t)258*R] = (256*sumsq!=(long long)W*W) ? num/den : 1.0; /* NaN is replaced by one in Autocorrelation_FFC */
+
+    /* ChiSq statistic */
+    F[r+(size_t)259*R] = scale*(double)sumsq-n;
+
+    /* Entropy */
+    F[r+(size_t)260*R] = log2(n)-sumclog/n;
+
+    /* Binary Ratio */
+    F[r+(size_t)261*R] = (8.0*n-(double)ones+1.0)/((double)ones+1.0);
+
+    /* Rate of Change */
+    F[r+(size_t)262*R] = roc[0]/(n-1)*256.0;
+    for (i=1;i<256;i++)
+        F[r+(size_t)(262+i)*R] = roc[i]/(n-1)*(256.0*128.0)/(256-i);
+
+    /* Longest contiguous streak */
+    F[r+(size_t)518*R] = (double) runmax;
+
+    /* Moments (central moments from the byte counts) */
+    mu = (double)S1/n;
+    m2 = 0; m3 = 0; m4 = 0;
+    for (i=0;i<256;i++)
+    {
+        if (cnt[i]==0)
+            continue;
+        d = i-128-mu;
+        d2 = d*d;
+        m2 += cnt[i]*d2;
+        m3 += cnt[i]*d2*d;
+        m4 += cnt[i]*d2*d2;
+    }
+    m2 /= n; m3 /= n; m4 /= n;
+    sd = sqrt(m2>0 ? m2*n/(n-1) : 0);
+    F[r+(size_t)519*R] = mu+128.0;
+    F[r+(size_t)520*R] = sd;
+    if (S2*W==S1*S1) /* zero variance */
+    {
+        F[r+(size_t)521*R] = 0;
+        F[r+(size_t)522*R] = 0;
+    }
+    else
+    {
+        F[r+(size_t)521*R] = m3/pow(m2,1.5)*sqrt(n*(n-1))/(n-2);
+        F[r+(size_t)522*R] = 3+(n-1)/((n-2)*(n-3))*((n+1)*m4/(m2*m2)-3*(n-1));
+    }
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
+{
+    double *S,*F;
+    int *B;
+    size_t n,k;
+    int stride,R,r,i,s,c;
+
+    /* Check for the proper number of arguments. */
+    if (nrhs != 3)
+        mexErrMsgTxt("Three inputs are required.");
+    if (nlhs > 1)
+        mexErrMsgTxt("No more than one output is required!");
+
+    /* Check inputs */
+    if (!mxIsDouble(prhs[0]) || mxIsComplex(prhs[0]))
+        mexErrMsgTxt("buffer must be real.\n");
+    if (mxGetM(prhs[0])>1 && mxGetN(prhs[0])>1)
+        mexErrMsgTxt("buffer must be vector.\n");
+    n = mxGetNumberOfElements(prhs[0]);
+    W = (int) mxGetScalar(prhs[1]);
+    stride = (int) mxGetScalar(prhs[2]);
+    if (W<4)
+        mexErrMsgTxt("windowSize must be at least 4.\n");
+    if (stride<1)
+        mexErrMsgTxt("stride must be at least 1.\n");
+
+    /* Number of windows */
+    R = (n>=(size_t)W) ? (int)((n-W)/stride)+1 : 0;
+    plhs[0] = mxCreateDoubleMatrix(R, NUM_FEATURES, mxREAL);
+    if (R==0)
+        return;
+    F = mxGetPr(plhs[0]);
+
+    /* Convert input to integer values */
+    S = mxGetPr(prhs[0]);
+    B = (int*) malloc(n*sizeof(int));
+    for (k=0;k<n;k++)
+    {
+        B[k] = (int) S[k];
+        if (B[k]<0 || B[k]>255)
+        {
+            free(B);
+            mexErrMsgTxt("buffer must contain byte values.\n");
+        }
+    }
+
+    /* Allocate memory */
+    cnt = (int*) malloc(256*sizeof(int));
+    order = (int*) malloc(256*sizeof(int));
+    pos = (int*) malloc(256*sizeof(int));
+    first = (int*) calloc(W+2,sizeof(int));
+    last = (int*) calloc(W+2,sizeof(int));
+    roc = (int*) malloc(256*sizeof(int));
+    runs = (int*) malloc(n*sizeof(int));
+    runcnt = (int*) malloc((W+2)*sizeof(int));
+    clog2c = (double*) malloc((W+1)*sizeof(double));
+
+    /* Initialization */
+    for (i=0;i<256;i++)
+        popcnt[i] = (i&1)+((i>>1)&1)+((i>>2)&1)+((i>>3)&1)+((i>>4)&1)+((i>>5)&1)+((i>>6)&1)+((i>>7)&1);
+    clog2c[0] = 0;
+    for (c=1;c<=W;c++)
+        clog2c[c] = c*log2((double)c);
+    reset_window();
+
+    /* First window */
+    for (i=0;i<W;i++)
+        add_byte(B[i],i>0 ? B[i-1] : -1);
+    write_features(F,R,0);
+
+    /* Next windows */
+    for (r=1;r<R;r++)
+    {
+        s = (r-1)*stride; /* start of the previous window */
+        if (stride<W)
+            for (i=0;i<stride;i++)
+            {
+                remove_byte(B[s+i],B[s+i+1]);
+                add_byte(B[s+W+i],B[s+W+i-1]);
+            }
+        else /* windows do not overlap */
+        {
+            reset_window();
+            s += stride;
+            for (i=0;i<W;i++)
+                add_byte(B[s+i],i>0 ? B[s+i-1] : -1);
+        }
+        write_features(F,R,r);
+    }
+
+    /* Free memory */
+    free(B); free(cnt); free(order); free(pos); free(first); free(last);
+    free(roc); free(runs); free(runcnt); free(clog2c);
+
+    return;
+}
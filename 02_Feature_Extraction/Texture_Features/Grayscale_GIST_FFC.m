@@ -1,4 +1,4 @@
-function F = Grayscale_GIST_FFC(fragment,rowsize,orientPerScale,numBlks)
+function F = Grayscale_GIST_FFC(fragment,rowsize,orientPerScale,numBlks,Filters)
 
 % This function computes the gist features for the equaivalent gray scale image 
 % corresponding to a fragment. The function works based on the method proposed in [1] 
@@ -26,18 +26,24 @@ function F = Grayscale_GIST_FFC(fragment,rowsize,orientPerScale,numBlks)
 %   rowsize: The number of elements when converting fragments into image
 %   orientPerScale: Number of orientations at each scale (a vector of integers)
 %   numBlks: Number of non-overlapping windows in each dimension
+%   Filters (optional): Indices of the Gabor filters (orientations and scales, in the order of the 
+%       filter bank) whose features are calculated (default: 1:sum(orientPerScale)).
 %
 % Outputs:
-%   F: vector of Gist features with length sum(orientPerScale)*numBlks^2;
+%   F: vector of Gist features with length length(Filters)*numBlks^2;
 %
 % Revisions:
 % 2020-Mar-29   function was created
+% 2026-Oct-18   subset of Gabor filters (Filters) was added for pruned feature plans
 
 %% Initialization
 imageSize = [256 256];
 boundaryExtension = 32;
 fc_prefilt = 4;
 img = vec2mat(fragment,rowsize);
+if nargin<5
+    Filters = 1:sum(orientPerScale);
+end
 
 %% Persistent Variables: Create Gabor Filters
 persistent G orientationsPerScale numberBlocks
@@ -59,7 +65,7 @@ img = 255*img/max(img(:));
 output = prefilt(img, fc_prefilt);
 
 %% Get GIST
-F = gistGabor(output,numberBlocks,G,boundaryExtension)';
+F = gistGabor(output,numberBlocks,G,boundaryExtension,Filters)';
 F(isnan(F)) = -1;
 
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -97,18 +103,20 @@ output = output./(.2+localstd);
 % Crop output to have same size than the input
 output = output(w+1:sn-w, w+1:sm-w);
 
-function g = gistGabor(img,numberBlocks,G,boundaryExtension)
+function g = gistGabor(img,numberBlocks,G,boundaryExtension,Filters)
 % 
 % Input:
 %   img: input image
 %   numberBlocks: number of windows (w*w)
 %   G: precomputed transfer functions
+%   Filters: indices of the applied transfer functions
 %
 % Output:
 %   g: are the global features = [Nfeatures 1], 
 %                    Nfeatures = numberBlocks*Nfilters
 
-[ny,nx,Nfilters] = size(G);
+[ny,nx,~] = size(G);
+Nfilters = length(Filters);
 W = numberBlocks*numberBlocks;
 g = zeros([W*Nfilters 1]);
 
@@ -117,7 +125,7 @@ img = padarray(img, [boundaryExtension boundaryExtension], 'symmetric');
 
 img = single(fft2(img)); 
 k=0;
-for n = 1:Nfilters
+for n = Filters
     ig = abs(ifft2(img.*G(:,:,n))); 
     ig = ig(boundaryExtension+1:ny-boundaryExtension, boundaryExtension+1:nx-boundaryExtension, :);
     
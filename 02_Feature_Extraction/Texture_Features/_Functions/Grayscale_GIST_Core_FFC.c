@@ -0,0 +1,1035 @@
+/* This c-mex function computes the gist features for the equivalent gray scale images corresponding to
+ * a batch of fragments. The function works based on the method proposed in [1] and the codes available at
+ * https://people.csail.mit.edu/torralba/code/spatialenvelope. It is the native counterpart of
+ * Grayscale_GIST_FFC.m: The prefilter and the Gabor filter bank are kept in frequency domain for each
+ * (image size, orientPerScale, numBlks) configuration and are reused across calls. All fragments of a
+ * batch are passed through the same 2-D FFT plans using single-precision arithmetic, and if OpenMP is
+ * available, the fragments are processed on multiple threads.
+ *
+ *   [1] Aude Oliva and Antonio Torralba, "Modeling the shape of the scene: a holistic representation of the
+ *   spatial envelope", International Journal of Computer Vision, Vol. 42(3): 145-175, 2001.
+ *
+ * Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+ *
+ * This file is a part of Fragments-Expert software, a software package for
+ * feature extraction from file fragments and classification among various file formats.
+ *
+ * Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Usage method: Features = Grayscale_GIST_Core_FFC(fragments,rowsize,orientPerScale,numBlks,LowRes,Filters);
+ *
+ * Inputs:
+ *  fragments: Cell array with length M consisting of row vectors of byte values
+ *  rowsize: The number of elements when converting fragments into image (<=256)
+ *  orientPerScale: Number of orientations at each scale (a vector of integers)
+ *  numBlks: Number of non-overlapping windows in each dimension
+ *  LowRes: (Optional, default 0) If nonzero, fragment images whose smaller dimension is at most 16 (or 32)
+ *      pixels are processed at 64x64 (or 128x128) instead of being upscaled to 256x256. The prefilter and
+ *      the Gabor filter bank are scaled so that they pass the same spatial frequencies (in cycles per image).
+ *      Since the upscaled images carry no information above the original resolution, the features are
+ *      close to those of the standard mode, but they are not identical.
+ *  Filters: (Optional, default 1:sum(orientPerScale)) Indices of the Gabor filters (orientations and scales, in the
+ *      order of the filter bank) whose features are calculated. The other filters are not applied.
+ *
+ * Output:
+ *  Features: Mx(length(Filters)*numBlks^2) matrix of Gist features. NaN values are replaced by -1.
+ *
+ * Compilation (OpenMP is optional):
+ *  mex -O COMPFLAGS="$COMPFLAGS /openmp" Grayscale_GIST_Core_FFC.c              (Windows, MSVC)
+ *  mex -O CFLAGS="$CFLAGS -fopenmp" LDFLAGS="$LDFLAGS -fopenmp" Grayscale_GIST_Core_FFC.c  (GCC)
+ *
+ * Revisions:
+ * 2026-Oct-18   function was created
+ * 2026-Oct-18   subset of Gabor filters (Filters) was added for pruned feature plans
+ */
+
+#include "mex.h"
+#include <math.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define PI_D 3.14159265358979323846
+#define MAX_FACTORS 32
+#define MAX_PLANS 8
+#define MAX_SCALES 32
+#define PREFILT_W 5
+#define PREFILT_FC 4.0
+#define VLEN 8 /* Number of transforms that are computed together (SIMD lanes) */
+
+/* ------------------------------------------------------------------------------------------------ */
+/* ---------------------------- Mixed-Radix Single-Precision Batched FFT -------------------------- */
+/* ------------------------------------------------------------------------------------------------ */
+
+/* VLEN transforms of length n are computed together. The data are kept in split real/imaginary
+ * arrays, where element k of lane v is stored at k*VLEN+v. So, every butterfly is a loop over the
+ * lanes that the compiler turns into SIMD instructions. The transform is the self-sorting
+ * (Stockham) form of the decimation-in-frequency FFT. */
+typedef struct {
+    int n;
+    int nstages;
+    int radix[MAX_FACTORS];
+    float *twr[MAX_FACTORS];    /* twiddles of each stage: w^(r*j), r=1...p-1, j=0...m-1 */
+    float *twi[MAX_FACTORS];
+    float *rootr[MAX_FACTORS];  /* p-th roots of unity for generic radices */
+    float *rooti[MAX_FACTORS];
+} fft_plan;
+
+void fft_plan_free(fft_plan *plan)
+{
+    int st;
+
+    for (st=0;st<MAX_FACTORS;st++)
+    {
+        if (plan->twr[st]) free(plan->twr[st]);
+        if (plan->twi[st]) free(plan->twi[st]);
+        if (plan->rootr[st]) free(plan->rootr[st]);
+        if (plan->rooti[st]) free(plan->rooti[st]);
+        plan->twr[st] = plan->twi[st] = plan->rootr[st] = plan->rooti[st] = NULL;
+    }
+}
+
+int fft_plan_init(fft_plan *plan,int n,int inverse)
+{
+    int p,r,j,m,n0,st,nn;
+    double sgn = inverse ? 1.0 : -1.0;
+
+    memset(plan,0,sizeof(fft_plan));
+    plan->n = n;
+
+    /* Factor out powers of 4, powers of 2, and then any remaining primes */
+    nn = n;
+    p = 4;
+    while (nn>1)
+    {
+        while (nn % p)
+        {
+            p = (p==4) ? 2 : ((p==2) ? 3 : p+2);
+            if (p*p>nn)
+                p = nn;
+        }
+        if (plan->nstages==MAX_FACTORS)
+            return(1);
+        plan->radix[plan->nstages++] = p;
+        nn /= p;
+    }
+
+    n0 = n;
+    for (st=0;st<plan->nstages;st++)
+    {
+        p = plan->radix[st];
+        m = n0/p;
+        plan->twr[st] = (float*)malloc(sizeof(float)*(p-1)*m+1);
+        plan->twi[st] = (float*)malloc(sizeof(float)*(p-1)*m+1);
+        plan->rootr[st] = (float*)malloc(sizeof(float)*p);
+        plan->rooti[st] = (float*)malloc(sizeof(float)*p);
+        if (!plan->twr[st] || !plan->twi[st] || !plan->rootr[st] || !plan->rooti[st])
+        {
+            fft_plan_free(plan);
+            return(1);
+        }
+        for (r=1;r<p;r++)
+            for (j=0;j<m;j++)
+            {
+                plan->twr[st][(r-1)*m+j] = (float)cos(sgn*2.0*PI_D*r*j/n0);
+                plan->twi[st][(r-1)*m+j] = (float)sin(sgn*2.0*PI_D*r*j/n0);
+            }
+        for (r=0;r<p;r++)
+        {
+            plan->rootr[st][r] = (float)cos(sgn*2.0*PI_D*r/p);
+            plan->rooti[st][r] = (float)sin(sgn*2.0*PI_D*r/p);
+        }
+        n0 = m;
+    }
+    return(0);
+}
+
+/* One radix-p stage: x -> y, with current length n0 = p*m and stride s */
+void fft_stage(const fft_plan *plan,int st,int m,int s,const float *xr,const float *xi,float *yr,float *yi)
+{
+    const int p = plan->radix[st];
+    const float *twr = plan->twr[st];
+    const float *twi = plan->twi[st];
+    const float *rr = plan->rootr[st];
+    const float *ri = plan->rooti[st];
+    const float rsign = ri[p>2 ? 1 : 0] < 0 ? -1.0f : 1.0f; /* -1 for forward transforms */
+    int j,q,v,r,t;
+    float ar[VLEN],ai[VLEN];
+    float wr,wi,w1r,w1i,w2r,w2i,w3r,w3i,w4r,w4i;
+
+    for (j=0;j<m;j++)
+    {
+        for (q=0;q<s;q++)
+        {
+            const float *x0r = xr+(size_t)(q+s*j)*VLEN;
+            const float *x0i = xi+(size_t)(q+s*j)*VLEN;
+            const size_t in_step = (size_t)s*m*VLEN;
+            float *y0r = yr+(size_t)(q+s*p*j)*VLEN;
+            float *y0i = yi+(size_t)(q+s*p*j)*VLEN;
+            const size_t out_step = (size_t)s*VLEN;
+
+            switch (p) {
+
+                case 2:
+                    wr = twr[j]; wi = twi[j];
+#pragma omp simd
+                    for (v=0;v<VLEN;v++)
+                    {
+                        const float hr = x0r[v]-x0r[in_step+v];
+                        const float hi = x0i[v]-x0i[in_step+v];
+                        y0r[v] = x0r[v]+x0r[in_step+v];
+                        y0i[v] = x0i[v]+x0i[in_step+v];
+                        y0r[out_step+v] = hr*wr-hi*wi;
+                        y0i[out_step+v] = hr*wi+hi*wr;
+                    }
+                    break;
+
+                case 4:
+                    w1r = twr[j]; w1i = twi[j];
+                    w2r = twr[m+j]; w2i = twi[m+j];
+                    w3r = twr[2*m+j]; w3i = twi[2*m+j];
+#pragma omp simd
+                    for (v=0;v<VLEN;v++)
+                    {
+                        const float ar = x0r[v]+x0r[2*in_step+v];
+                        const float ai = x0i[v]+x0i[2*in_step+v];
+                        const float br = x0r[v]-x0r[2*in_step+v];
+                        const float bi = x0i[v]-x0i[2*in_step+v];
+                        const float cr = x0r[in_step+v]+x0r[3*in_step+v];
+                        const float ci = x0i[in_step+v]+x0i[3*in_step+v];
+                        /* (x1-x3) multiplied by -i (forward) or +i (inverse) */
+                        const float dr = -rsign*(x0i[in_step+v]-x0i[3*in_step+v]);
+                        const float di = rsign*(x0r[in_step+v]-x0r[3*in_step+v]);
+                        const float e1r = br+dr, e1i = bi+di;
+                        const float e2r = ar-cr, e2i = ai-ci;
+                        const float e3r = br-dr, e3i = bi-di;
+                        y0r[v] = ar+cr;
+                        y0i[v] = ai+ci;
+                        y0r[out_step+v] = e1r*w1r-e1i*w1i;
+                        y0i[out_step+v] = e1r*w1i+e1i*w1r;
+                        y0r[2*out_step+v] = e2r*w2r-e2i*w2i;
+                        y0i[2*out_step+v] = e2r*w2i+e2i*w2r;
+                        y0r[3*out_step+v] = e3r*w3r-e3i*w3i;
+                        y0i[3*out_step+v] = e3r*w3i+e3i*w3r;
+                    }
+                    break;
+
+                case 5:
+                    w1r = twr[j]; w1i = twi[j];
+                    w2r = twr[m+j]; w2i = twi[m+j];
+                    w3r = twr[2*m+j]; w3i = twi[2*m+j];
+                    w4r = twr[3*m+j]; w4i = twi[3*m+j];
+#pragma omp simd
+                    for (v=0;v<VLEN;v++)
+                    {
+                        const float s7r = x0r[in_step+v]+x0r[4*in_step+v], s7i = x0i[in_step+v]+x0i[4*in_step+v];
+                        const float s10r = x0r[in_step+v]-x0r[4*in_step+v], s10i = x0i[in_step+v]-x0i[4*in_step+v];
+                        const float s8r = x0r[2*in_step+v]+x0r[3*in_step+v], s8i = x0i[2*in_step+v]+x0i[3*in_step+v];
+                        const float s9r = x0r[2*in_step+v]-x0r[3*in_step+v], s9i = x0i[2*in_step+v]-x0i[3*in_step+v];
+                        const float s5r = x0r[v]+s7r*rr[1]+s8r*rr[2], s5i = x0i[v]+s7i*rr[1]+s8i*rr[2];
+                        const float s6r = s10i*ri[1]+s9i*ri[2], s6i = -s10r*ri[1]-s9r*ri[2];
+                        const float s11r = x0r[v]+s7r*rr[2]+s8r*rr[1], s11i = x0i[v]+s7i*rr[2]+s8i*rr[1];
+                        const float s12r = -s10i*ri[2]+s9i*ri[1], s12i = s10r*ri[2]-s9r*ri[1];
+                        const float e1r = s5r-s6r, e1i = s5i-s6i;
+                        const float e2r = s11r+s12r, e2i = s11i+s12i;
+                        const float e3r = s11r-s12r, e3i = s11i-s12i;
+                        const float e4r = s5r+s6r, e4i = s5i+s6i;
+                        y0r[v] = x0r[v]+s7r+s8r;
+                        y0i[v] = x0i[v]+s7i+s8i;
+                        y0r[out_step+v] = e1r*w1r-e1i*w1i;
+                        y0i[out_step+v] = e1r*w1i+e1i*w1r;
+                        y0r[2*out_step+v] = e2r*w2r-e2i*w2i;
+                        y0i[2*out_step+v] = e2r*w2i+e2i*w2r;
+                        y0r[3*out_step+v] = e3r*w3r-e3i*w3i;
+                        y0i[3*out_step+v] = e3r*w3i+e3i*w3r;
+                        y0r[4*out_step+v] = e4r*w4r-e4i*w4i;
+                        y0i[4*out_step+v] = e4r*w4i+e4i*w4r;
+                    }
+                    break;
+
+                default:
+                    for (r=0;r<p;r++)
+                    {
+#pragma omp simd
+                        for (v=0;v<VLEN;v++)
+                        {
+                            ar[v] = x0r[v];
+                            ai[v] = x0i[v];
+                        }
+                        for (t=1;t<p;t++)
+                        {
+                            wr = rr[(t*r)%p]; wi = ri[(t*r)%p];
+#pragma omp simd
+                            for (v=0;v<VLEN;v++)
+                            {
+                                ar[v] += x0r[t*in_step+v]*wr-x0i[t*in_step+v]*wi;
+                                ai[v] += x0r[t*in_step+v]*wi+x0i[t*in_step+v]*wr;
+                            }
+                        }
+                        if (r==0)
+                        {
+                            wr = 1.0f; wi = 0.0f;
+                        }
+                        else
+                        {
+                            wr = twr[(r-1)*m+j]; wi = twi[(r-1)*m+j];
+                        }
+#pragma omp simd
+                        for (v=0;v<VLEN;v++)
+                        {
+                            y0r[r*out_step+v] = ar[v]*wr-ai[v]*wi;
+                            y0i[r*out_step+v] = ar[v]*wi+ai[v]*wr;
+                        }
+                    }
+                    break;
+            }
+        }
+    }
+}
+
+/* Unnormalized transforms of VLEN sequences stored in (xr,xi); (yr,yi) is a work buffer of the same size */
+void fft_exec(const fft_plan *plan,float *xr,float *xi,float *yr,float *yi)
+{
+    int st,s,n0,m;
+    float *ar = xr, *ai = xi, *br = yr, *bi = yi, *tmp;
+
+    s = 1;
+    n0 = plan->n;
+    for (st=0;st<plan->nstages;st++)
+    {
+        m = n0/plan->radix[st];
+        fft_stage(plan,st,m,s,ar,ai,br,bi);
+        tmp = ar; ar = br; br = tmp;
+        tmp = ai; ai = bi; bi = tmp;
+        s *= plan->radix[st];
+        n0 = m;
+    }
+    if (ar!=xr)
+    {
+        memcpy(xr,ar,sizeof(float)*plan->n*VLEN);
+        memcpy(xi,ai,sizeof(float)*plan->n*VLEN);
+    }
+}
+
+/* ------------------------------------------------------------------------------------------------ */
+/* ------------------------------------------ 2-D Transforms -------------------------------------- */
+/* ------------------------------------------------------------------------------------------------ */
+
+/* Work buffers for VLEN transforms of length n */
+typedef struct {
+    float *xr,*xi,*yr,*yi;
+} fft_buf;
+
+/* Real-to-complex forward 2-D FFT of the n x n row-major image x. The output (Hr,Hi) is the n x (n/2+1)
+ * half spectrum (row-major), i.e., columns 0...n/2 of fft2(x). Two real rows are packed into each
+ * complex transform. */
+void rfft2_half(const fft_plan *fwd,const float *x,float *Hr,float *Hi,fft_buf *B)
+{
+    const int n = fwd->n;
+    const int nh = n/2+1;
+    int r0,r,c,cc,v,nv;
+    float zr,zi,wr,wi;
+
+    /* Row transforms: lane v holds rows r0+2v (real part) and r0+2v+1 (imaginary part) */
+    for (r0=0;r0<n;r0+=2*VLEN)
+    {
+        for (c=0;c<n;c++)
+            for (v=0;v<VLEN;v++)
+            {
+                r = r0+2*v;
+                B->xr[c*VLEN+v] = (r<n) ? x[r*n+c] : 0.0f;
+                B->xi[c*VLEN+v] = (r+1<n) ? x[(r+1)*n+c] : 0.0f;
+            }
+        fft_exec(fwd,B->xr,B->xi,B->yr,B->yi);
+        for (v=0;v<VLEN;v++)
+        {
+            r = r0+2*v;
+            if (r>=n)
+                break;
+            for (c=0;c<nh;c++)
+            {
+                cc = (n-c)%n;
+                zr = B->xr[c*VLEN+v]; zi = B->xi[c*VLEN+v];
+                wr = B->xr[cc*VLEN+v]; wi = B->xi[cc*VLEN+v];
+                Hr[r*nh+c] = 0.5f*(zr+wr);
+                Hi[r*nh+c] = 0.5f*(zi-wi);
+                if (r+1<n)
+                {
+                    Hr[(r+1)*nh+c] = 0.5f*(zi+wi);
+                    Hi[(r+1)*nh+c] = -0.5f*(zr-wr);
+                }
+            }
+        }
+    }
+
+    /* Column transforms */
+    for (c=0;c<nh;c+=VLEN)
+    {
+        nv = (nh-c<VLEN) ? nh-c : VLEN;
+        for (r=0;r<n;r++)
+            for (v=0;v<VLEN;v++)
+            {
+                B->xr[r*VLEN+v] = (v<nv) ? Hr[r*nh+c+v] : 0.0f;
+                B->xi[r*VLEN+v] = (v<nv) ? Hi[r*nh+c+v] : 0.0f;
+            }
+        fft_exec(fwd,B->xr,B->xi,B->yr,B->yi);
+        for (r=0;r<n;r++)
+            for (v=0;v<nv;v++)
+            {
+                Hr[r*nh+c+v] = B->xr[r*VLEN+v];
+                Hi[r*nh+c+v] = B->xi[r*VLEN+v];
+            }
+    }
+}
+
+/* Expands the n x (n/2+1) half spectrum of a real image to the full n x n spectrum */
+void expand_half(int n,const float *Hr,const float *Hi,float *Xr,float *Xi)
+{
+    const int nh = n/2+1;
+    int r,c;
+
+    for (r=0;r<n;r++)
+    {
+        for (c=0;c<nh;c++)
+        {
+            Xr[r*n+c] = Hr[r*nh+c];
+            Xi[r*n+c] = Hi[r*nh+c];
+        }
+        for (c=nh;c<n;c++)
+        {
+            Xr[r*n+c] = Hr[((n-r)%n)*nh+(n-c)];
+            Xi[r*n+c] = -Hi[((n-r)%n)*nh+(n-c)];
+        }
+    }
+}
+
+/* Complex-to-real inverse 2-D FFT of the half spectrum (Hr,Hi), which is destroyed on return.
+ * The output y is the n x n real image real(ifft2(X)) including the 1/n^2 normalization. */
+void irfft2_half(const fft_plan *inv,float *Hr,float *Hi,float *y,fft_buf *B)
+{
+    const int n = inv->n;
+    const int nh = n/2+1;
+    const float scale = 1.0f/((float)n*(float)n);
+    int r0,r,c,v,nv,ca;
+    float ar,ai,br,bi,cs;
+
+    /* Column transforms */
+    for (c=0;c<nh;c+=VLEN)
+    {
+        nv = (nh-c<VLEN) ? nh-c : VLEN;
+        for (r=0;r<n;r++)
+            for (v=0;v<VLEN;v++)
+            {
+                B->xr[r*VLEN+v] = (v<nv) ? Hr[r*nh+c+v] : 0.0f;
+                B->xi[r*VLEN+v] = (v<nv) ? Hi[r*nh+c+v] : 0.0f;
+            }
+        fft_exec(inv,B->xr,B->xi,B->yr,B->yi);
+        for (r=0;r<n;r++)
+            for (v=0;v<nv;v++)
+            {
+                Hr[r*nh+c+v] = B->xr[r*VLEN+v];
+                Hi[r*nh+c+v] = B->xi[r*VLEN+v];
+            }
+    }
+
+    /* Row transforms: The rows are Hermitian, so rows r0+2v and r0+2v+1 share the transform of lane v */
+    for (r0=0;r0<n;r0+=2*VLEN)
+    {
+        for (v=0;v<VLEN;v++)
+        {
+            r = r0+2*v;
+            for (c=0;c<n;c++)
+            {
+                ca = (c<nh) ? c : n-c;
+                cs = (c<nh) ? 1.0f : -1.0f;
+                ar = (r<n) ? Hr[r*nh+ca] : 0.0f;
+                ai = (r<n) ? cs*Hi[r*nh+ca] : 0.0f;
+                br = (r+1<n) ? Hr[(r+1)*nh+ca] : 0.0f;
+                bi = (r+1<n) ? cs*Hi[(r+1)*nh+ca] : 0.0f;
+                B->xr[c*VLEN+v] = ar-bi;
+                B->xi[c*VLEN+v] = ai+br;
+            }
+        }
+        fft_exec(inv,B->xr,B->xi,B->yr,B->yi);
+        for (v=0;v<VLEN;v++)
+        {
+            r = r0+2*v;
+            for (c=0;c<n;c++)
+            {
+                if (r<n)
+                    y[r*n+c] = B->xr[c*VLEN+v]*scale;
+                if (r+1<n)
+                    y[(r+1)*n+c] = B->xi[c*VLEN+v]*scale;
+            }
+        }
+    }
+}
+
+/* ------------------------------------------------------------------------------------------------ */
+/* ------------------------------------- Filter Bank Plans ---------------------------------------- */
+/* ------------------------------------------------------------------------------------------------ */
+
+typedef struct {
+    int S;                  /* image size after resize and crop */
+    int be;                 /* boundary extension for Gabor filtering */
+    int n1;                 /* prefilter transform size */
+    int n2;                 /* Gabor transform size */
+    int numBlks;
+    int Nscales;
+    int orient[MAX_SCALES];
+    int Nfilters;
+    fft_plan fwd1,inv1,fwd2,inv2;
+    float *gf;              /* n1 x (n1/2+1) prefilter transfer function */
+    float *G;               /* Nfilters x n2 x n2 Gabor transfer functions */
+    int *edges;             /* numBlks+1 block edges */
+} gist_plan;
+
+gist_plan *plans[MAX_PLANS];
+int num_plans = 0;
+
+void gist_plan_free(gist_plan *P)
+{
+    fft_plan_free(&P->fwd1);
+    fft_plan_free(&P->inv1);
+    fft_plan_free(&P->fwd2);
+    fft_plan_free(&P->inv2);
+    if (P->gf) free(P->gf);
+    if (P->G) free(P->G);
+    if (P->edges) free(P->edges);
+    free(P);
+}
+
+void free_all_plans(void)
+{
+    int j;
+    for (j=0;j<num_plans;j++)
+        gist_plan_free(plans[j]);
+    num_plans = 0;
+}
+
+/* Signed frequency of index k after fftshift of -n/2:n/2-1 */
+double shifted_freq(int k,int n)
+{
+    return (k < n/2) ? (double)k : (double)(k-n);
+}
+
+gist_plan *gist_plan_create(int S,int numBlks,const int *orient,int Nscales)
+{
+    gist_plan *P;
+    int i,j,l,r,c,n,nh;
+    double s1,fx,fy,fr,t,tr,fscale,g;
+    double param[4];
+
+    P = (gist_plan*)calloc(1,sizeof(gist_plan));
+    if (P==NULL)
+        return(NULL);
+
+    P->S = S;
+    P->be = 32*S/256;
+    P->n1 = S+2*PREFILT_W;
+    P->n1 += P->n1 % 2;
+    P->n2 = S+2*P->be;
+    P->numBlks = numBlks;
+    P->Nscales = Nscales;
+    P->Nfilters = 0;
+    for (i=0;i<Nscales;i++)
+    {
+        P->orient[i] = orient[i];
+        P->Nfilters += orient[i];
+    }
+
+    if (fft_plan_init(&P->fwd1,P->n1,0) || fft_plan_init(&P->inv1,P->n1,1) ||
+            fft_plan_init(&P->fwd2,P->n2,0) || fft_plan_init(&P->inv2,P->n2,1))
+    {
+        gist_plan_free(P);
+        return(NULL);
+    }
+
+    /* Prefilter: gf = fftshift(exp(-(fx.^2+fy.^2)/(s1^2))) */
+    n = P->n1;
+    nh = n/2+1;
+    s1 = PREFILT_FC/sqrt(log(2.0));
+    P->gf = (float*)malloc(sizeof(float)*n*nh);
+    for (r=0;r<n;r++)
+    {
+        fy = shifted_freq(r,n);
+        for (c=0;c<nh;c++)
+        {
+            fx = shifted_freq(c,n);
+            P->gf[r*nh+c] = (float)exp(-(fx*fx+fy*fy)/(s1*s1));
+        }
+    }
+
+    /* Gabor filters: createGabor(orientPerScale,[n2 n2]). For reduced image sizes, the normalized
+     * frequency is scaled so that each filter keeps its center frequency in cycles per image. */
+    n = P->n2;
+    fscale = (double)S/256.0;
+    P->G = (float*)malloc(sizeof(float)*(size_t)P->Nfilters*n*n);
+    if (P->gf==NULL || P->G==NULL)
+    {
+        gist_plan_free(P);
+        return(NULL);
+    }
+    l = 0;
+    for (i=0;i<Nscales;i++)
+    {
+        for (j=0;j<orient[i];j++)
+        {
+            param[0] = 0.35;
+            param[1] = 0.3/pow(1.85,(double)i);
+            param[2] = 16.0*orient[i]*orient[i]/(32.0*32.0);
+            param[3] = PI_D/orient[i]*j;
+            for (r=0;r<n;r++)
+            {
+                fy = shifted_freq(r,n);
+                for (c=0;c<n;c++)
+                {
+                    fx = shifted_freq(c,n);
+                    fr = sqrt(fx*fx+fy*fy);
+                    t = atan2(fy,fx);
+                    tr = t+param[3];
+                    tr = tr+2*PI_D*(tr<-PI_D)-2*PI_D*(tr>PI_D);
+                    g = exp(-10.0*param[0]*pow(fr/n*fscale/param[1]-1.0,2.0)-2.0*param[2]*PI_D*tr*tr);
+                    P->G[((size_t)l*n+r)*n+c] = (g<1e-20) ? 0.0f : (float)g; /* avoid denormal arithmetic */
+                }
+            }
+            l++;
+        }
+    }
+
+    /* Block edges: fix(linspace(0,S,numBlks+1)) */
+    P->edges = (int*)malloc(sizeof(int)*(numBlks+1));
+    for (i=0;i<=numBlks;i++)
+        P->edges[i] = (int)(((long)i*S)/numBlks);
+
+    return(P);
+}
+
+gist_plan *get_plan(int S,int numBlks,const int *orient,int Nscales)
+{
+    int j,i,same;
+    gist_plan *P;
+
+    for (j=0;j<num_plans;j++)
+    {
+        P = plans[j];
+        if (P->S!=S || P->numBlks!=numBlks || P->Nscales!=Nscales)
+            continue;
+        same = 1;
+        for (i=0;i<Nscales;i++)
+            if (P->orient[i]!=orient[i])
+                same = 0;
+        if (same)
+            return(P);
+    }
+
+    if (num_plans==MAX_PLANS)
+        free_all_plans();
+
+    P = gist_plan_create(S,numBlks,orient,Nscales);
+    if (P!=NULL)
+        plans[num_plans++] = P;
+    return(P);
+}
+
+/* ------------------------------------------------------------------------------------------------ */
+/* --------------------------------------- GIST of One Image -------------------------------------- */
+/* ------------------------------------------------------------------------------------------------ */
+
+typedef struct {
+    float *img;         /* S x S */
+    float *pad1;        /* n1 x n1 */
+    float *low;         /* n1 x n1 */
+    float *pad2;        /* n2 x n2 */
+    float *Hr,*Hi;      /* n x (n/2+1), n = max(n1,n2) */
+    float *Xr,*Xi;      /* n2 x n2 */
+    float *Tr,*Ti;      /* S x n2 */
+    fft_buf B;          /* VLEN x max(n1,n2) */
+    double *blk;        /* VLEN x numBlks */
+} gist_work;
+
+int gist_work_alloc(gist_work *W,int S,int n1,int n2,int numBlks)
+{
+    const int n = (n1>n2) ? n1 : n2;
+    const size_t nb = sizeof(float)*n*VLEN;
+
+    W->img = (float*)malloc(sizeof(float)*S*S);
+    W->pad1 = (float*)malloc(sizeof(float)*n1*n1);
+    W->low = (float*)malloc(sizeof(float)*n1*n1);
+    W->pad2 = (float*)malloc(sizeof(float)*n2*n2);
+    W->Hr = (float*)malloc(sizeof(float)*n*(n/2+1));
+    W->Hi = (float*)malloc(sizeof(float)*n*(n/2+1));
+    W->Xr = (float*)malloc(sizeof(float)*n2*n2);
+    W->Xi = (float*)malloc(sizeof(float)*n2*n2);
+    W->Tr = (float*)malloc(sizeof(float)*S*n2);
+    W->Ti = (float*)malloc(sizeof(float)*S*n2);
+    W->B.xr = (float*)malloc(nb);
+    W->B.xi = (float*)malloc(nb);
+    W->B.yr = (float*)malloc(nb);
+    W->B.yi = (float*)malloc(nb);
+    W->blk = (double*)malloc(sizeof(double)*VLEN*numBlks);
+
+    return (!W->img || !W->pad1 || !W->low || !W->pad2 || !W->Hr || !W->Hi || !W->Xr || !W->Xi ||
+            !W->Tr || !W->Ti || !W->B.xr || !W->B.xi || !W->B.yr || !W->B.yi || !W->blk);
+}
+
+void gist_work_free(gist_work *W)
+{
+    free(W->img);
+    free(W->pad1);
+    free(W->low);
+    free(W->pad2);
+    free(W->Hr);
+    free(W->Hi);
+    free(W->Xr);
+    free(W->Xi);
+    free(W->Tr);
+    free(W->Ti);
+    free(W->B.xr);
+    free(W->B.xi);
+    free(W->B.yr);
+    free(W->B.yi);
+    free(W->blk);
+}
+
+/* Index of padarray(...,'symmetric') */
+int sym_index(int k,int L)
+{
+    while (k<0 || k>=L)
+    {
+        if (k<0)
+            k = -k-1;
+        if (k>=L)
+            k = 2*L-k-1;
+    }
+    return(k);
+}
+
+/* Bilinear resampling weights of imresize for an upscaling factor of out/in (1-based MATLAB convention) */
+void resize_coord(int x,int in,int out,int *i0,int *i1,float *w1)
+{
+    double scale = (double)out/(double)in;
+    double u = (x+1)/scale + 0.5*(1.0-1.0/scale);
+    double fl = floor(u);
+
+    *w1 = (float)(u-fl);
+    *i0 = sym_index((int)fl-1,in);
+    *i1 = sym_index((int)fl,in);
+}
+
+/* img = vec2mat(fragment,rowsize), resized and cropped as in imresizecrop, and scaled to [0 255].
+ * Returns zero if the image is constant (the features are NaN in this case). */
+int make_image(const double *frag,int L,int rowsize,int S,float *img)
+{
+    int rows = (L+rowsize-1)/rowsize;
+    int cols = rowsize;
+    double scaling = (S/(double)rows > S/(double)cols) ? S/(double)rows : S/(double)cols;
+    int nr = (int)floor(rows*scaling+0.5);
+    int nc = (int)floor(cols*scaling+0.5);
+    int sr = (nr-S)/2;
+    int sc = (nc-S)/2;
+    int x,y,r0,r1,c0,c1,k;
+    float wr,wc,v00,v01,v10,v11,mn,mx;
+
+    for (y=0;y<S;y++)
+    {
+        resize_coord(sr+y,rows,nr,&r0,&r1,&wr);
+        for (x=0;x<S;x++)
+        {
+            resize_coord(sc+x,cols,nc,&c0,&c1,&wc);
+            k = r0*cols+c0; v00 = (k<L) ? (float)frag[k] : 0.0f;
+            k = r0*cols+c1; v01 = (k<L) ? (float)frag[k] : 0.0f;
+            k = r1*cols+c0; v10 = (k<L) ? (float)frag[k] : 0.0f;
+            k = r1*cols+c1; v11 = (k<L) ? (float)frag[k] : 0.0f;
+            img[y*S+x] = (1.0f-wr)*((1.0f-wc)*v00+wc*v01) + wr*((1.0f-wc)*v10+wc*v11);
+        }
+    }
+
+    mn = img[0];
+    for (k=1;k<S*S;k++)
+        if (img[k]<mn)
+            mn = img[k];
+    mx = 0.0f;
+    for (k=0;k<S*S;k++)
+    {
+        img[k] -= mn;
+        if (img[k]>mx)
+            mx = img[k];
+    }
+    if (mx==0.0f)
+        return(0);
+    for (k=0;k<S*S;k++)
+        img[k] = 255.0f*img[k]/mx;
+    return(1);
+}
+
+void gist_image(const gist_plan *P,gist_work *W,const double *frag,int L,int rowsize,const int *filt,int nfilt,
+    double *F,size_t Fstride)
+{
+    const int S = P->S;
+    const int n1 = P->n1, nh1 = n1/2+1;
+    const int n2 = P->n2;
+    const int be = P->be;
+    const int N = P->numBlks;
+    const int W2 = N*N;
+    const float scale2 = 1.0f/((float)n2*(float)n2);
+    fft_buf *B = &W->B;
+    int r,c,k,v,nv,r0,xx,yy,f,q;
+    const float *g;
+    float re,im;
+    double cnt;
+
+    if (L<=0 || !make_image(frag,L,rowsize,S,W->img))
+    {
+        for (k=0;k<nfilt*W2;k++)
+            F[k*Fstride] = -1;
+        return;
+    }
+
+    /* Prefiltering: local contrast scaling */
+    for (r=0;r<n1;r++)
+        for (c=0;c<n1;c++)
+            W->pad1[r*n1+c] = logf(W->img[sym_index(r-PREFILT_W,S)*S+sym_index(c-PREFILT_W,S)]+1.0f);
+
+    rfft2_half(&P->fwd1,W->pad1,W->Hr,W->Hi,B);
+#pragma omp simd
+    for (k=0;k<n1*nh1;k++)
+    {
+        W->Hr[k] *= P->gf[k];
+        W->Hi[k] *= P->gf[k];
+    }
+    irfft2_half(&P->inv1,W->Hr,W->Hi,W->low,B);
+#pragma omp simd
+    for (k=0;k<n1*n1;k++)
+    {
+        W->pad1[k] -= W->low[k];
+        W->low[k] = W->pad1[k]*W->pad1[k];
+    }
+
+    rfft2_half(&P->fwd1,W->low,W->Hr,W->Hi,B);
+#pragma omp simd
+    for (k=0;k<n1*nh1;k++)
+    {
+        W->Hr[k] *= P->gf[k];
+        W->Hi[k] *= P->gf[k];
+    }
+    irfft2_half(&P->inv1,W->Hr,W->Hi,W->low,B);
+    for (k=0;k<n1*n1;k++)
+        W->pad1[k] /= 0.2f+sqrtf(fabsf(W->low[k]));
+
+    /* Crop the prefiltered image and pad it for Gabor filtering */
+    for (r=0;r<n2;r++)
+        for (c=0;c<n2;c++)
+            W->pad2[r*n2+c] = W->pad1[(sym_index(r-be,S)+PREFILT_W)*n1+sym_index(c-be,S)+PREFILT_W];
+
+    rfft2_half(&P->fwd2,W->pad2,W->Hr,W->Hi,B);
+    expand_half(n2,W->Hr,W->Hi,W->Xr,W->Xi);
+
+    /* Filter bank (only the requested filters; f is the output position of the filter) */
+    for (f=0;f<nfilt;f++)
+    {
+        q = filt[f];
+        g = P->G+(size_t)q*n2*n2;
+
+        /* Multiply by the transfer function and inverse transform the columns. Only the rows inside
+         * the crop are kept. */
+        for (c=0;c<n2;c+=VLEN)
+        {
+            nv = (n2-c<VLEN) ? n2-c : VLEN;
+            for (r=0;r<n2;r++)
+            {
+                k = r*n2+c;
+                for (v=0;v<VLEN;v++)
+                {
+                    B->xr[r*VLEN+v] = (v<nv) ? W->Xr[k+v]*g[k+v] : 0.0f;
+                    B->xi[r*VLEN+v] = (v<nv) ? W->Xi[k+v]*g[k+v] : 0.0f;
+                }
+            }
+            fft_exec(&P->inv2,B->xr,B->xi,B->yr,B->yi);
+            for (r=0;r<S;r++)
+                for (v=0;v<nv;v++)
+                {
+                    W->Tr[r*n2+c+v] = B->xr[(r+be)*VLEN+v];
+                    W->Ti[r*n2+c+v] = B->xi[(r+be)*VLEN+v];
+                }
+        }
+
+        /* Inverse transform the rows, VLEN rows at a time, and average |.| over the blocks */
+        for (k=0;k<W2;k++)
+            F[(f*W2+k)*Fstride] = 0.0;
+        for (r0=0;r0<S;r0+=VLEN)
+        {
+            nv = (S-r0<VLEN) ? S-r0 : VLEN;
+            for (c=0;c<n2;c++)
+                for (v=0;v<VLEN;v++)
+                {
+                    B->xr[c*VLEN+v] = (v<nv) ? W->Tr[(r0+v)*n2+c] : 0.0f;
+                    B->xi[c*VLEN+v] = (v<nv) ? W->Ti[(r0+v)*n2+c] : 0.0f;
+                }
+            fft_exec(&P->inv2,B->xr,B->xi,B->yr,B->yi);
+            for (k=0;k<VLEN*N;k++)
+                W->blk[k] = 0.0;
+            xx = 0;
+            for (c=0;c<S;c++)
+            {
+                while (c>=P->edges[xx+1])
+                    xx++;
+                for (v=0;v<nv;v++)
+                {
+                    re = B->xr[(c+be)*VLEN+v];
+                    im = B->xi[(c+be)*VLEN+v];
+                    W->blk[v*N+xx] += sqrtf(re*re+im*im)*scale2;
+                }
+            }
+            for (v=0;v<nv;v++)
+            {
+                yy = 0;
+                while (r0+v>=P->edges[yy+1])
+                    yy++;
+                for (xx=0;xx<N;xx++)
+                    F[(f*W2+yy+xx*N)*Fstride] += W->blk[v*N+xx];
+            }
+        }
+
+        /* downN: average over non-overlapping blocks (rows of the image are the first index) */
+        for (xx=0;xx<N;xx++)
+            for (yy=0;yy<N;yy++)
+            {
+                cnt = (double)(P->edges[yy+1]-P->edges[yy])*(double)(P->edges[xx+1]-P->edges[xx]);
+                F[(f*W2+yy+xx*N)*Fstride] = (cnt>0) ? F[(f*W2+yy+xx*N)*Fstride]/cnt : -1;
+            }
+    }
+}
+
+/* Image size used for a fragment image */
+int image_size(int L,int rowsize,int LowRes)
+{
+    int rows = (L+rowsize-1)/rowsize;
+    int m = (rows<rowsize) ? rows : rowsize;
+
+    /* Reduced sizes still keep an upscaling factor of at least 4 */
+    if (LowRes && 4*m<=64)
+        return(64);
+    if (LowRes && 4*m<=128)
+        return(128);
+    return(256);
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
+{
+    const mxArray *cell;
+    double *orient_d,*filt_d,*out;
+    int orient[MAX_SCALES];
+    int *filt;
+    int rowsize,numBlks,Nscales,Nfilters,nfilt,LowRes,nfeat,S,j,g,err;
+    int sizes[3] = {64,128,256};
+    size_t M;
+    gist_plan *P;
+
+    /* Check for the proper number of arguments. */
+    if (nrhs < 4 || nrhs > 6)
+        mexErrMsgTxt("Four to six inputs are required.");
+    if (nlhs > 1)
+        mexErrMsgTxt("No more than one output is required!");
+    if (!mxIsCell(prhs[0]))
+        mexErrMsgTxt("First input must be a cell array of fragments.\n");
+
+    /* Read inputs */
+    cell = prhs[0];
+    M = mxGetNumberOfElements(cell);
+    rowsize = (int) mxGetScalar(prhs[1]);
+    Nscales = (int) mxGetNumberOfElements(prhs[2]);
+    numBlks = (int) mxGetScalar(prhs[3]);
+    LowRes = (nrhs>=5) ? (mxGetScalar(prhs[4])!=0) : 0;
+    if (rowsize<1 || rowsize>256)
+        mexErrMsgTxt("Image row size must be between 1 and 256.\n");
+    if (numBlks<1 || numBlks>64)
+        mexErrMsgTxt("Wrong number of non-overlapping windows!\n");
+    if (Nscales<1 || Nscales>MAX_SCALES || !mxIsDouble(prhs[2]))
+        mexErrMsgTxt("Wrong number of orientations at each scale!\n");
+    orient_d = mxGetPr(prhs[2]);
+    Nfilters = 0;
+    for (j=0;j<Nscales;j++)
+    {
+        orient[j] = (int) orient_d[j];
+        if (orient[j]<1)
+            mexErrMsgTxt("Wrong number of orientations at each scale!\n");
+        Nfilters += orient[j];
+    }
+    for (j=0;j<(int)M;j++)
+        if (mxGetCell(cell,j)==NULL || !mxIsDouble(mxGetCell(cell,j)))
+            mexErrMsgTxt("Fragments must be real vectors.\n");
+    if (nrhs==6 && !mxIsDouble(prhs[5]))
+        mexErrMsgTxt("Indices of Gabor filters must be double values.\n");
+    nfilt = (nrhs==6) ? (int) mxGetNumberOfElements(prhs[5]) : Nfilters;
+    filt = (int*)mxMalloc(sizeof(int)*(nfilt>0 ? nfilt : 1));
+    filt_d = (nrhs==6) ? mxGetPr(prhs[5]) : NULL;
+    for (j=0;j<nfilt;j++)
+    {
+        filt[j] = (filt_d!=NULL) ? (int) filt_d[j]-1 : j;
+        if (filt[j]<0 || filt[j]>=Nfilters)
+            mexErrMsgTxt("Wrong index of Gabor filter!\n");
+    }
+    nfeat = nfilt*numBlks*numBlks;
+
+    /* Prepare Output */
+    plhs[0] = mxCreateDoubleMatrix(M,nfeat,mxREAL);
+    out = mxGetPr(plhs[0]);
+    mexAtExit(free_all_plans);
+
+    /* Process the fragments group by group, where all fragments of a group share the same plan */
+    for (g=0;g<3;g++)
+    {
+        S = sizes[g];
+        P = NULL;
+        for (j=0;j<(int)M;j++)
+            if (image_size((int)mxGetNumberOfElements(mxGetCell(cell,j)),rowsize,LowRes)==S)
+            {
+                P = get_plan(S,numBlks,orient,Nscales);
+                break;
+            }
+        if (P==NULL && j<(int)M)
+            mexErrMsgTxt("Not enough memory for GIST filter bank.\n");
+        if (P==NULL)
+            continue;
+
+        err = 0;
+#pragma omp parallel reduction(|:err)
+        {
+            gist_work W;
+            int jj,L,failed;
+            const mxArray *frg;
+
+            failed = gist_work_alloc(&W,P->S,P->n1,P->n2,P->numBlks);
+            err |= failed;
+#pragma omp for schedule(dynamic,4)
+            for (jj=0;jj<(int)M;jj++)
+            {
+                frg = mxGetCell(cell,jj);
+                L = (int)mxGetNumberOfElements(frg);
+                if (failed || image_size(L,rowsize,LowRes)!=P->S)
+                    continue;
+                gist_image(P,&W,mxGetPr(frg),L,rowsize,filt,nfilt,out+jj,M);
+            }
+            gist_work_free(&W);
+        }
+        if (err)
+            mexErrMsgTxt("Not enough memory for GIST computation.\n");
+    }
+
+    /* F(isnan(F)) = -1 */
+    for (j=0;j<(int)(M*nfeat);j++)
+        if (out[j]!=out[j])
+            out[j] = -1;
+    mxFree(filt);
+
+    return;
+}
@@ -1,4 +1,4 @@
-function freqs = Byte_Bigram_Parallel_FFC(fragments)
+function freqs = Byte_Bigram_Parallel_FFC(fragments,Bigrams)
 
 % This function calculates the distribution of the bigram byte frequencies. D
 %
@@ -18,22 +18,42 @@ function freqs = Byte_Bigram_Parallel_FFC(fragments)
 %
 % Inputs:
 %   fragments: Cell array with length M consisting of row vectors of byte values
+%   Bigrams (optional): Row vector of the bigrams (256*first byte+second byte) whose normalized
+%       frequencies are calculated (default: 0:65535)
 %
 % Outputs:
-%   freq: Matrix with row size 65536 that contains the normalized bigrams
+%   freq: Matrix with row size 65536 (or length(Bigrams)) that contains the normalized bigrams
 %
 % Revisions:
 % 2023-Dec-24   function was created
+% 2026-Oct-18   subset of bigrams (Bigrams) was added for pruned feature plans
 
 
 M = length(fragments);
-freqs = zeros(M,2^16);
+if nargin<2
+    freqs = zeros(M,2^16);
+    parfor j=1:M
+        
+        y = filter([1 256],1,fragments{j});
+        y = y(2:end);
+        freq = histcounts(y,(0:2^16));
+        freq = freq/length(y)*2^16;
+        freqs(j,:) = freq;
+        
+    end
+    return;
+end
+
+% Only the requested bigrams are counted
+K = length(Bigrams);
+idx = zeros(1,2^16);
+idx(Bigrams+1) = 1:K;
+freqs = zeros(M,K);
 parfor j=1:M
     
     y = filter([1 256],1,fragments{j});
-    y = y(2:end);
-    freq = histcounts(y,(0:2^16));
-    freq = freq/length(y)*2^16;
-    freqs(j,:) = freq;
+    b = idx(y(2:end)+1);
+    freq = accumarray(b(b>0)',1,[K 1])';
+    freqs(j,:) = freq/length(b)*2^16;
     
 end
\ No newline at end of file
@@ -41,8 +41,16 @@ function Features = false_nearest_caller_Parallel_FFC(fragments,minemb,maxemb,rt
 %           3rd column: The average size of the neighborhood
 %           4th column: The square root of the average of the squared size of the neighborhood
 %
+%   Note: The features are calculated by FeaturePool_Core_FFC (if the MEX file is available).
+%
 % Revisions:
 % 2023-Dec-24   function was created
+% 2026-Oct-18   native worker pool (FeaturePool_Core_FFC) is used if it is available
+
+if exist('FeaturePool_Core_FFC','file')==3
+    Features = FeaturePool_Core_FFC('FalseNearest',fragments,minemb,maxemb,rt);
+    return;
+end
 
 M = length(fragments);
 Features = zeros(M,(maxemb-minemb+1)*3);
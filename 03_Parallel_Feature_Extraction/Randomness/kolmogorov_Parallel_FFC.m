@@ -25,8 +25,16 @@ function F = kolmogorov_Parallel_FFC(fragments)
 % Outputs:
 %   Outputs: Mx1 vector
 %
+%   Note: The features are calculated by FeaturePool_Core_FFC (if the MEX file is available).
+%
 % Revisions:
 % 2023-Dec-24   function was created
+% 2026-Oct-18   native worker pool (FeaturePool_Core_FFC) is used if it is available
+
+if exist('FeaturePool_Core_FFC','file')==3
+    F = FeaturePool_Core_FFC('Kolmogorov',fragments);
+    return;
+end
 
 M = length(fragments);
 F = zeros(M,1);
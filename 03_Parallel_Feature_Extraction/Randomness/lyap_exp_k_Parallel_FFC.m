@@ -26,8 +26,16 @@ function F = lyap_exp_k_Parallel_FFC(fragments,mindim,maxdim)
 % Outputs:
 %   Outputs: Mx(maxdim-mindim+1) matrix that each row is a vector with length maxdim-mindim+1 containing Lyapunov exponents
 %
+%   Note: The features are calculated by FeaturePool_Core_FFC (if the MEX file is available).
+%
 % Revisions:
 % 2023-Dec-24   function was created
+% 2026-Oct-18   native worker pool (FeaturePool_Core_FFC) is used if it is available
+
+if exist('FeaturePool_Core_FFC','file')==3
+    F = sort(FeaturePool_Core_FFC('Lyapunov',fragments,mindim,maxdim),2,'descend');
+    return;
+end
 
 M = length(fragments);
 F = zeros(M,maxdim-mindim+1);
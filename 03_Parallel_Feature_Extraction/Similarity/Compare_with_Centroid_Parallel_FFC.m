@@ -35,15 +35,7 @@ function output = Compare_with_Centroid_Parallel_FFC(fragments,centroid_mu,centr
 %
 % Revisions:
 % 2023-Dec-24   function was created
+% 2026-Oct-18   batched implementation (Compare_with_Centroids_Parallel_FFC) is used
 
-%% Calculate BFD
-BFD = ByteHistogram_Parallel_FFC(fragments)*256;
-
-%% Cosine Similarity
-CosineSimilarity = (BFD*centroid_mu')./(sqrt(sum(BFD.^2,2))*sqrt(sum(centroid_mu.^2)));
-
-%% Mahalanobis Distance
-MahalanobisDistance = sqrt(sum((BFD-repmat(centroid_mu,length(fragments),1)).^2./(0.01+repmat(centroid_sigma.^2,length(fragments),1)),2)); % Smoothing factor 0.01
-
-%% Output
-output = [CosineSimilarity MahalanobisDistance];
\ No newline at end of file
+%% Function Main Body
+output = Compare_with_Centroids_Parallel_FFC(fragments,centroid_mu,centroid_sigma);
\ No newline at end of file
@@ -0,0 +1,79 @@
+function output = Compare_with_Centroids_Parallel_FFC(fragments,centroids_mu,centroids_sigma)
+
+% This function calculates Mahalanobis distance and cosine similarity
+% between a list of fragments of byte values and a set of centroid models.
+% The byte histograms of all fragments are built once and are scored against
+% all centroid models at the same time using matrix products.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Inputs:
+%   fragments: Cell array with length M consisting of row vectors of byte values
+%   centroids_mu: Kx256 matrix of centroid model means (one row for each centroid model)
+%   centroids_sigma: Kx256 matrix of centroid model standard deviations
+%
+% Output:
+%   output: Mx(2K) matrix. Columns 2k-1 and 2k correspond to the k-th centroid model and include
+%       CosineSimilarity: The value of cosine similarity [1].
+%       MahalanobisDistance: Mahalanobis distance [2].
+%
+%   Refs:
+%       [1] I. Ahmed, K.-s. Lhee, H. Shin, and M. Hong, "On improving the accuracy and performance of content-based file type identification,"
+%           in Information Security and Privacy, 2009, pp. 44-59.
+%       [2] W.-J. Li, K. Wang, S. J. Stolfo, and B. Herzog, "Fileprints: Identifying file types by n-gram analysis,"
+%           in 6th Annu. IEEE SMC Information Assurance Workshop, 2005, pp. 64-71.
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+BlockSize = 4096; % Number of fragments which are scored in each block
+M = length(fragments);
+K = size(centroids_mu,1);
+
+%% Centroid-Dependent Terms
+W = 1./(0.01+centroids_sigma.^2); % Smoothing factor 0.01
+MUW = centroids_mu.*W;
+MUWMU = sum(centroids_mu.*MUW,2)';
+MUnorm = sqrt(sum(centroids_mu.^2,2))';
+
+%% Score Fragments Block by Block
+CosineSimilarity = zeros(M,K);
+MahalanobisDistance = zeros(M,K);
+for i0=1:BlockSize:M
+
+    i1 = min(i0+BlockSize-1,M);
+    m = i1-i0+1;
+
+    % Byte histograms of the block (multiplied by 256, as in BFD_FFC)
+    lens = cellfun(@length,fragments(i0:i1));
+    bytes = double([fragments{i0:i1}]);
+    rows = repelem((1:m)',lens(:));
+    BFD = accumarray([rows bytes(:)+1],1,[m 256]);
+    BFD = 256*BFD./lens(:);
+
+    % Cosine Similarity
+    CosineSimilarity(i0:i1,:) = (BFD*centroids_mu')./(sqrt(sum(BFD.^2,2))*MUnorm);
+
+    % Mahalanobis Distance: sum((x-mu).^2.*w) = x.^2*w'-2*x*(mu.*w)'+mu.^2*w'
+    D2 = (BFD.^2)*W'-2*BFD*MUW'+MUWMU;
+    MahalanobisDistance(i0:i1,:) = sqrt(max(D2,0));
+
+end
+
+%% Output
+output = zeros(M,2*K);
+output(:,1:2:end) = CosineSimilarity;
+output(:,2:2:end) = MahalanobisDistance;
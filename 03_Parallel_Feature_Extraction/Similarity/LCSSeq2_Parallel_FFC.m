@@ -1,4 +1,4 @@
-function L = LCSSeq2_Parallel_FFC(X,Y)
+function L = LCSSeq2_Parallel_FFC(X,Y,Band)
 
 % This function employs LCSSeq_FFC in order to calculates the average of longest
 % common subsequence (LCSSeq) between each element of sample vectors and a set of Representators.
@@ -20,20 +20,47 @@ function L = LCSSeq2_Parallel_FFC(X,Y)
 % Inputs:
 %   X: Cell array of vectors with length M
 %   Y: Cell array of vectors with length N (Representators)
+%   Band: Band width of the approximate mode of LCSSeq_FFC (optional). The default value is Inf (exact mode).
 %
 % Output:
 %   L: The average lengths of the longest common subsequence between each X and all elements of Y
 %
+%   Note: The features are calculated by FeaturePool_Core_FFC (if the MEX file is available).
+%
 % Revisions:
 % 2023-Dec-24   function was created
+% 2026-Oct-18   approximate mode (banded dynamic programming) was added
+% 2026-Oct-18   native worker pool (FeaturePool_Core_FFC) is used if it is available
+% 2026-Oct-18   LCSSeq_mFile_FFC is used for the approximate mode if the C-MEX file does not support it
+
+if nargin<3
+    Band = Inf;
+end
+if exist('FeaturePool_Core_FFC','file')==3
+    L = FeaturePool_Core_FFC('LCSSeq',X,Y,Band);
+    return;
+end
+
+% The C-MEX file supports Band only if it is rebuilt from the current source
+Banded = ~isinf(Band) && Banded_LCS_Available_FFC('LCSSeq_FFC');
 
 M = length(X);
 N = length(Y);
 L = zeros(M,N);
 for j=1:N
     Rep = Y{j};
-    parfor i=1:M
-        L(i,j) = LCSSeq_FFC(X{i},Rep)/min(length(X{i}),length(Rep));
+    if isinf(Band)
+        parfor i=1:M
+            L(i,j) = LCSSeq_FFC(X{i},Rep)/min(length(X{i}),length(Rep));
+        end
+    elseif Banded
+        parfor i=1:M
+            L(i,j) = LCSSeq_FFC(X{i},Rep,Band)/min(length(X{i}),length(Rep));
+        end
+    else
+        parfor i=1:M
+            L(i,j) = LCSSeq_mFile_FFC(X{i},Rep,[],[],Band)/min(length(X{i}),length(Rep));
+        end
     end
 end
 L = mean(L,2);
\ No newline at end of file
@@ -1,4 +1,4 @@
-function Features = Grayscale_GIST_Parallel_FFC(fragments,rowsize,orientPerScale,numBlks)
+function Features = Grayscale_GIST_Parallel_FFC(fragments,rowsize,orientPerScale,numBlks,LowRes,Filters)
 
 % This function computes the gist features for the equaivalent gray scale image 
 % corresponding to each fragment. The function works based on the method proposed in [1] 
@@ -26,12 +26,33 @@ function Features = Grayscale_GIST_Parallel_FFC(fragments,rowsize,orientPerScale
 %   rowsize: The number of elements when converting fragments into image
 %   orientPerScale: Number of orientations at each scale (a vector of integers)
 %   numBlks: Number of non-overlapping windows in each dimension
+%   LowRes (optional): If true, small fragment images are not upscaled to 256x256 and 
+%       an equivalent lower-resolution filter bank is used instead (default: false).
+%       This option is only used when Grayscale_GIST_Core_FFC is available.
+%   Filters (optional): Indices of the Gabor filters (orientations and scales, in the order of the 
+%       filter bank) whose features are calculated (default: 1:sum(orientPerScale)).
 %
 % Outputs:
-%   Features: Matrix of Gist features with row length of sum(orientPerScale)*numBlks^2;
+%   Features: Matrix of Gist features with row length of length(Filters)*numBlks^2;
 %
 % Revisions:
 % 2023-Dec-24   function was created
+% 2026-Oct-18   native batched implementation (Grayscale_GIST_Core_FFC) is used when C-MEX functions are available
+% 2026-Oct-18   subset of Gabor filters (Filters) was added for pruned feature plans
+% 2026-Oct-18   native implementation is used if its MEX file is available (instead of C_MEX_64_Available)
+
+if nargin<5
+    LowRes = false;
+end
+if nargin<6
+    Filters = 1:sum(orientPerScale);
+end
+
+if exist('Grayscale_GIST_Core_FFC','file')==3
+    fragments = cellfun(@double,fragments,'UniformOutput',false);
+    Features = Grayscale_GIST_Core_FFC(fragments,rowsize,orientPerScale,numBlks,double(LowRes),double(Filters));
+    return;
+end
 
 %% Initialization
 imageSize = [256 256];
@@ -48,7 +69,7 @@ if ~(isequal(orientPerScale,orientationsPerScale) && isequal(numBlks,numberBlock
 end
 
 M = length(fragments);
-Features = zeros(M,sum(orientPerScale)*numBlks^2);
+Features = zeros(M,length(Filters)*numBlks^2);
 parfor j=1:M
     
     fragment = fragments{j};
@@ -65,7 +86,7 @@ parfor j=1:M
     output = prefilt(img, fc_prefilt);
     
     %% Get GIST
-    F = gistGabor(output,numberBlocks,G,boundaryExtension)';
+    F = gistGabor(output,numberBlocks,G,boundaryExtension,Filters)';
     F(isnan(F)) = -1;
     
     Features(j,:) = F;
@@ -107,18 +128,20 @@ output = output./(.2+localstd);
 % Crop output to have same size than the input
 output = output(w+1:sn-w, w+1:sm-w);
 
-function g = gistGabor(img,numberBlocks,G,boundaryExtension)
+function g = gistGabor(img,numberBlocks,G,boundaryExtension,Filters)
 % 
 % Input:
 %   img: input image
 %   numberBlocks: number of windows (w*w)
 %   G: precomputed transfer functions
+%   Filters: indices of the applied transfer functions
 %
 % Output:
 %   g: are the global features = [Nfeatures 1], 
 %                    Nfeatures = numberBlocks*Nfilters
 
-[ny,nx,Nfilters] = size(G);
+[ny,nx,~] = size(G);
+Nfilters = length(Filters);
 W = numberBlocks*numberBlocks;
 g = zeros([W*Nfilters 1]);
 
@@ -127,7 +150,7 @@ img = padarray(img, [boundaryExtension boundaryExtension], 'symmetric');
 
 img = single(fft2(img)); 
 k=0;
-for n = 1:Nfilters
+for n = Filters
     ig = abs(ifft2(img.*G(:,:,n))); 
     ig = ig(boundaryExtension+1:ny-boundaryExtension, boundaryExtension+1:nx-boundaryExtension, :);
     
@@ -0,0 +1,1497 @@
+/* This c-mex function is a persistent pool of native worker threads for the feature extraction of batches of
+ * fragments. It replaces the parfor loops of the following parallel feature extraction functions (each pool
+ * kernel is a thread-safe version of the C-MEX kernel with the same results):
+ *   'LCSSeq': LCSSeq2_Parallel_FFC (LCSSeq_FFC)
+ *   'LCSStr': LCSStr2_Parallel_FFC (LCSStr_FFC)
+ *   'Kolmogorov': kolmogorov_Parallel_FFC (kolmogorov_FFC)
+ *   'FalseNearest': false_nearest_caller_Parallel_FFC (false_nearest_FFC)
+ *   'Lyapunov': lyap_exp_k_Parallel_FFC (lyap_exp_k_FFC)
+ *
+ * The threads of the pool are the OpenMP threads, which stay alive between the calls of the function (for the
+ * MATLAB session, or until the function is cleared), so a batch pays neither the startup of parfor nor the
+ * broadcast of the fragments to the workers. In the affinity modes, each thread is pinned to a CPU (compact:
+ * the CPUs of a NUMA node are filled first; scatter: the threads are spread over the NUMA nodes), and the batch
+ * is partitioned between the NUMA nodes in proportion to their threads. The partition of a node is copied by the
+ * threads of that node, so that its memory pages are placed on the node (first-touch), and it is processed by
+ * them; a thread takes the fragments of the other partitions only when its own partition is done. Without
+ * affinity, the batch is a single partition. A batch can be loaded once and used by all kernels. The workspaces
+ * of the kernels (bit vectors and rows of the LCS tables, representatives, and boxes and lists of the false
+ * nearest neighbors and the Lyapunov exponents) are allocated by each thread and are kept for the next batches.
+ *
+ * The memory traffic between NUMA nodes is counted in bytes of fragments:
+ *   Load: Copies from the MATLAB arrays (fragments and representatives) to the pool. The MATLAB arrays are
+ *       assumed to be on the node of the calling thread.
+ *   Kernel: Reads of the fragments of the partitions by the kernels. A read is remote if the thread runs on a
+ *       node other than the node of the thread that copied the fragment.
+ *
+ * Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+ *
+ * This file is a part of Fragments-Expert software, a software package for
+ * feature extraction from file fragments and classification among various file formats.
+ *
+ * Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Usage method:
+ *  FeaturePool_Core_FFC('init',NumThreads,Affinity);
+ *  FeaturePool_Core_FFC('load',Fragments);
+ *  L = FeaturePool_Core_FFC('LCSSeq',Fragments,Reps,Band);
+ *  L = FeaturePool_Core_FFC('LCSStr',Fragments,Reps,Band);
+ *  F = FeaturePool_Core_FFC('Kolmogorov',Fragments);
+ *  F = FeaturePool_Core_FFC('FalseNearest',Fragments,minemb,maxemb,rt);
+ *  F = FeaturePool_Core_FFC('Lyapunov',Fragments,mindim,maxdim);
+ *  FeaturePool_Core_FFC('unload');
+ *  Info = FeaturePool_Core_FFC('info');
+ *  FeaturePool_Core_FFC('clear');
+ *
+ * Inputs:
+ *  NumThreads: Number of threads (default: 0, one thread for each CPU of the process)
+ *  Affinity: 0 (none), 1 (compact), or 2 (scatter) (default: 0)
+ *  Fragments: Cell array with length M consisting of vectors of byte values
+ *  Reps: Cell array with length N consisting of vectors of byte values (Representators)
+ *  Band: Band width of the approximate mode of the LCS kernels (default: Inf, exact mode)
+ *  minemb, maxemb, rt: Parameters of false_nearest_FFC
+ *  mindim, maxdim: Parameters of lyap_exp_k_FFC
+ *
+ * Outputs:
+ *  L: Mx1 vector of the average of LCS_FFC(Fragments{i},Reps{j})/min(length(Fragments{i}),length(Reps{j})) over j
+ *  F: Mx1 vector of the outputs of kolmogorov_FFC,
+ *     Mx(3*(maxemb-minemb+1)) matrix of the outputs of false_nearest_FFC (in the form of false_nearest_caller_Parallel_FFC),
+ *     or Mx(maxdim-mindim+1) matrix of the outputs of lyap_exp_k_FFC (not sorted)
+ *  Info: A structure with the following fields
+ *      NumThreads: Number of threads
+ *      Affinity: 'none', 'compact', or 'scatter'
+ *      NumNodes: Number of NUMA nodes of the CPUs of the process
+ *      CPU: 1xNumThreads vector of the CPUs of threads (-1 for the threads which are not pinned)
+ *      Node: 1xNumThreads vector of the NUMA nodes of threads (the last observed node of the threads which are not pinned)
+ *      Partitions: Number of partitions of batches
+ *      Fragments, Bytes: Number of fragments and bytes of the loaded batch (0 if no batch is loaded)
+ *      WorkspaceBytes: Memory of the workspaces of the threads
+ *      Calls: Number of kernel calls
+ *      LoadBytes, LoadRemoteBytes: Bytes copied to the pool, and those copied to other NUMA nodes
+ *      KernelBytes, KernelRemoteBytes: Bytes read by kernels, and those read from other NUMA nodes
+ *
+ * Note: If the fragments of a kernel call are not the loaded batch (the same MATLAB arrays), they are copied to
+ *  the pool for that call. 'unload' must be called before the arrays of the loaded batch are changed or cleared.
+ *  If the pool is not initialized, it is initialized with the default values.
+ *  With affinity, the threads are pinned only inside the parallel regions of 'load' and kernel calls; each
+ *  thread restores its previous affinity at the end of the region, so the OpenMP workers which are reused by
+ *  other MEX files and MATLAB are never left pinned.
+ *
+ * Compilation (OpenMP is needed for more than one thread):
+ *  mex -O COMPFLAGS="$COMPFLAGS /openmp" FeaturePool_Core_FFC.c              (Windows, MSVC)
+ *  mex -O CFLAGS="$CFLAGS -fopenmp" LDFLAGS="$LDFLAGS -fopenmp" FeaturePool_Core_FFC.c  (GCC)
+ *
+ * Revisions:
+ * 2026-Oct-18   function was created
+ * 2026-Oct-18   all pinned threads (not only the calling thread) restore their affinity at the end of a region
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "mex.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#include <dirent.h>
+#endif
+
+#if defined(_MSC_VER)
+#define FORCE_INLINE static __forceinline
+#else
+#define FORCE_INLINE static inline __attribute__((always_inline))
+#endif
+
+#define MAX_CPUS 1024
+#define FNN_BOX 1024
+#define LYAP_BOX 128
+#define LYAP_MAXITER 10
+#define LYAP_EPSCOUNT 5
+
+/* ---------------------------------------------- Platform ---------------------------------------------- */
+
+#if defined(_WIN32)
+typedef DWORD_PTR cpumask_t;
+#elif defined(__linux__)
+typedef cpu_set_t cpumask_t;
+#else
+typedef int cpumask_t;
+#endif
+
+/* CPUs on which the process can run */
+static int sys_cpus(int *cpus,int max)
+{
+    int n = 0, c;
+#if defined(_WIN32)
+    DWORD_PTR pmask,smask;
+    if (GetProcessAffinityMask(GetCurrentProcess(),&pmask,&smask))
+        for (c=0;c<(int)(8*sizeof(DWORD_PTR)) && n<max;c++)
+            if (pmask & ((DWORD_PTR)1<<c))
+                cpus[n++] = c;
+#elif defined(__linux__)
+    cpu_set_t set;
+    if (sched_getaffinity(0,sizeof(set),&set)==0)
+        for (c=0;c<CPU_SETSIZE && n<max;c++)
+            if (CPU_ISSET(c,&set))
+                cpus[n++] = c;
+#endif
+    if (n==0)
+        cpus[n++] = 0;
+    return n;
+}
+
+/* NUMA node of a CPU (0 if it is not known) */
+static int sys_node(int cpu)
+{
+    int node = 0;
+#if defined(_WIN32)
+    UCHAR h;
+    if (cpu<256 && GetNumaProcessorNode((UCHAR)cpu,&h) && h!=0xFF)
+        node = h;
+#elif defined(__linux__)
+    char path[64];
+    DIR *dir;
+    struct dirent *e;
+    sprintf(path,"/sys/devices/system/cpu/cpu%d",cpu);
+    if ((dir = opendir(path))!=NULL)
+    {
+        while ((e = readdir(dir))!=NULL)
+            if (strncmp(e->d_name,"node",4)==0 && e->d_name[4]>='0' && e->d_name[4]<='9')
+            {
+                node = atoi(e->d_name+4);
+                break;
+            }
+        closedir(dir);
+    }
+#endif
+    return node;
+}
+
+/* CPU of the calling thread (-1 if it is not known) */
+static int sys_current_cpu(void)
+{
+#if defined(_WIN32)
+    return (int) GetCurrentProcessorNumber();
+#elif defined(__linux__)
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+/* Pin the calling thread to a CPU; the previous affinity is kept in old */
+static int sys_pin(int cpu,cpumask_t *old)
+{
+#if defined(_WIN32)
+    *old = SetThreadAffinityMask(GetCurrentThread(),(DWORD_PTR)1<<cpu);
+    return *old!=0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    if (sched_getaffinity(0,sizeof(cpu_set_t),old)!=0)
+        return 0;
+    CPU_ZERO(&set);
+    CPU_SET(cpu,&set);
+    return sched_setaffinity(0,sizeof(cpu_set_t),&set)==0;
+#else
+    (void) cpu; (void) old;
+    return 0;
+#endif
+}
+
+static void sys_unpin(const cpumask_t *old)
+{
+#if defined(_WIN32)
+    SetThreadAffinityMask(GetCurrentThread(),*old);
+#elif defined(__linux__)
+    sched_setaffinity(0,sizeof(cpu_set_t),old);
+#else
+    (void) old;
+#endif
+}
+
+/* ------------------------------------------------ Pool ------------------------------------------------ */
+
+typedef struct
+{
+    int cpu;                /* CPU of the thread (-1 if the thread is not pinned) */
+    int node;               /* NUMA node of the thread */
+    int group;              /* Partition of the batch that is served by the thread */
+    int rank;               /* Index of the thread among the threads of its partition */
+    int err;                /* Out of memory in the current call */
+    double bytes,remote;    /* Bytes of the current call (all, and from other nodes) */
+
+    /* Workspaces of the kernels (allocated by the thread, so that they are placed on its node) */
+    unsigned char *reps; size_t reps_cap;   /* Representatives */
+    uint64_t *pm; size_t pm_cap;            /* LCSSeq: match bit vectors (all-zero between calls) */
+    uint64_t *v; size_t v_cap;              /* LCSSeq: column of the table */
+    int *rows; size_t rows_cap;             /* LCSStr: two rows of the table */
+    double *series; size_t series_cap;      /* Rescaled fragment */
+    int *list; size_t list_cap;             /* Linked lists of the points of boxes */
+    int *cell; size_t cell_cap;             /* FalseNearest: box of each point */
+    char *nearest; size_t nearest_cap;      /* FalseNearest: points whose nearest neighbor is found */
+    int *fbox;                              /* FalseNearest: FNN_BOXxFNN_BOX boxes (all -1 between calls) */
+    int *lbox;                              /* Lyapunov: LYAP_BOXxLYAP_BOX boxes */
+    int *lfound; size_t lfound_cap;         /* Lyapunov: neighbors of each dimension */
+    long *lcounts; size_t lcounts_cap;      /* Lyapunov: found, count, and lcount */
+    double *lsums; size_t lsums_cap;        /* Lyapunov: lyap, lfactor, and dx */
+} pool_thread;
+
+int Initialized = 0;
+int NumThreads, Affinity, NumGroups, NumNodes;
+pool_thread *Threads;
+int *GroupSize;                 /* Number of threads of each partition */
+int MaxCPU;
+int *CPUNode;                   /* NUMA node of CPUs 0~MaxCPU */
+
+/* Batch of fragments */
+int NumFrag, Resident;
+const double **Source;          /* Data of the MATLAB arrays of fragments */
+size_t *Len;                    /* Lengths of fragments */
+unsigned char **Frag;           /* Fragments in the partitions */
+int *Home;                      /* NUMA node of the thread which copied each fragment */
+int *First;                     /* Fragments First[g]~First[g+1]-1 are in partition g */
+int *Next;                      /* Next fragment of each partition in a kernel call */
+unsigned char **PartBuf;        /* Memory of partitions */
+size_t *PartCap;
+size_t FragCap;
+
+/* Counters of the memory traffic */
+double Calls, LoadBytes, LoadRemote, KernelBytes, KernelRemote;
+
+/* Parameters of the current kernel call */
+int NumReps;
+const double **RepSrc;          /* Data of the MATLAB arrays of representatives */
+size_t *RepLen, *RepOff, RepBytes;
+double Band;
+unsigned int Minemb, Maxemb, Mindim, Maxdim;
+double Rt;
+
+static const char *AffinityNames[] = {"none","compact","scatter"};
+
+static void free_thread(pool_thread *t)
+{
+    free(t->reps); free(t->pm); free(t->v); free(t->rows); free(t->series); free(t->list); free(t->cell);
+    free(t->nearest); free(t->fbox); free(t->lbox); free(t->lfound); free(t->lcounts); free(t->lsums);
+}
+
+void free_state(void)
+{
+    int i;
+    if (Threads)
+        for (i=0;i<NumThreads;i++)
+            free_thread(&Threads[i]);
+    if (PartBuf)
+        for (i=0;i<NumGroups;i++)
+            free(PartBuf[i]);
+    free(Threads); free(GroupSize); free(CPUNode); free(Source); free(Len); free(Frag); free(Home);
+    free(First); free(Next); free(PartBuf); free(PartCap); free(RepSrc); free(RepLen); free(RepOff);
+    Threads = NULL; GroupSize = NULL; CPUNode = NULL; Source = NULL; Len = NULL; Frag = NULL; Home = NULL;
+    First = NULL; Next = NULL; PartBuf = NULL; PartCap = NULL; RepSrc = NULL; RepLen = NULL; RepOff = NULL;
+    NumFrag = 0; FragCap = 0; Resident = 0;
+    Initialized = 0;
+}
+
+/* Make sure that a workspace has at least n bytes (the contents are not kept) */
+static int reserve(void **p,size_t *cap,size_t n,int zero)
+{
+    if (n<=*cap && *p)
+        return 1;
+    free(*p);
+    *p = zero ? calloc(n,1) : malloc(n);
+    *cap = *p ? n : 0;
+    return *p!=NULL;
+}
+#define RESERVE(t,name,n) reserve((void**)&(t)->name,&(t)->name##_cap,(n),0)
+
+static int thread_id(void)
+{
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+static int team_size(void)
+{
+#ifdef _OPENMP
+    return omp_get_num_threads();
+#else
+    return 1;
+#endif
+}
+
+static int current_node(pool_thread *t)
+{
+    int cpu = sys_current_cpu();
+    if (cpu>=0 && cpu<=MaxCPU)
+        t->node = CPUNode[cpu];
+    return t->node;
+}
+
+/* Pin the calling thread at the start of a parallel region; every pinned thread restores its own previous
+   affinity at the end, so no OpenMP worker stays pinned between calls or after 'init'/'clear' */
+static void enter_region(pool_thread *t,cpumask_t *old,int *pinned)
+{
+    *pinned = 0;
+    if (t->cpu>=0)
+        *pinned = sys_pin(t->cpu,old);
+    t->err = 0;
+    t->bytes = t->remote = 0;
+}
+
+static void leave_region(const cpumask_t *old,int pinned)
+{
+    if (pinned)
+        sys_unpin(old);
+}
+
+static void init_pool(int nthreads,int affinity)
+{
+    int cpus[MAX_CPUS], order[MAX_CPUS], nodes[MAX_CPUS], ncpu, nnodes, i, j, k, r;
+
+    free_state();
+    ncpu = sys_cpus(cpus,MAX_CPUS);
+#ifdef _OPENMP
+    NumThreads = (nthreads>0) ? nthreads : ncpu;
+#else
+    NumThreads = 1;
+#endif
+    Affinity = affinity;
+
+    /* NUMA nodes of CPUs */
+    MaxCPU = cpus[ncpu-1];
+    for (i=0;i<ncpu;i++)
+        MaxCPU = (cpus[i]>MaxCPU) ? cpus[i] : MaxCPU;
+    CPUNode = (int*) calloc(MaxCPU+1,sizeof(int));
+    Threads = (pool_thread*) calloc(NumThreads,sizeof(pool_thread));
+    GroupSize = (int*) calloc(NumThreads,sizeof(int));
+    if (!CPUNode || !Threads || !GroupSize)
+    {
+        free_state();
+        mexErrMsgTxt("Out of memory.\n");
+    }
+    for (i=0;i<=MaxCPU;i++)
+        CPUNode[i] = sys_node(i);
+    nnodes = 0;
+    for (i=0;i<ncpu;i++)
+    {
+        for (j=0;j<nnodes && nodes[j]!=CPUNode[cpus[i]];j++);
+        if (j==nnodes)
+            nodes[nnodes++] = CPUNode[cpus[i]];
+    }
+    NumNodes = nnodes;
+
+    /* Order of CPUs: compact (the CPUs of each node together) or scatter (one CPU of each node in turn) */
+    k = 0;
+    if (Affinity==1)
+    {
+        for (j=0;j<nnodes;j++)
+            for (i=0;i<ncpu;i++)
+                if (CPUNode[cpus[i]]==nodes[j])
+                    order[k++] = cpus[i];
+    }
+    else if (Affinity==2)
+    {
+        for (r=0;k<ncpu;r++)
+            for (j=0;j<nnodes;j++)
+            {
+                int c = 0;
+                for (i=0;i<ncpu;i++)
+                    if (CPUNode[cpus[i]]==nodes[j] && c++==r)
+                    {
+                        order[k++] = cpus[i];
+                        break;
+                    }
+            }
+    }
+
+    /* CPUs and partitions of threads (one partition for each NUMA node in the affinity modes) */
+    NumGroups = 1;
+    for (i=0;i<NumThreads;i++)
+    {
+        pool_thread *t = &Threads[i];
+        if (Affinity>0)
+        {
+            t->cpu = order[i%ncpu];
+            t->node = CPUNode[t->cpu];
+            for (j=0;nodes[j]!=t->node;j++);
+            t->group = j;
+            NumGroups = (j+1>NumGroups) ? j+1 : NumGroups;
+        }
+        else
+        {
+            t->cpu = -1;
+            t->node = nodes[0];
+            t->group = 0;
+        }
+        t->rank = GroupSize[t->group]++;
+    }
+
+    First = (int*) calloc(NumGroups+1,sizeof(int));
+    Next = (int*) calloc(NumGroups,sizeof(int));
+    PartBuf = (unsigned char**) calloc(NumGroups,sizeof(unsigned char*));
+    PartCap = (size_t*) calloc(NumGroups,sizeof(size_t));
+    if (!First || !Next || !PartBuf || !PartCap)
+    {
+        free_state();
+        mexErrMsgTxt("Out of memory.\n");
+    }
+    Calls = LoadBytes = LoadRemote = KernelBytes = KernelRemote = 0;
+    Initialized = 1;
+}
+
+/* ------------------------------------------------ Batch ----------------------------------------------- */
+
+/* Copy the fragments of partition g that are assigned to the thread with the given rank (by bytes) */
+static int copy_part(int g,int rank,int node,double *remote_node_bytes,int src_node)
+{
+    int i, bad = 0;
+    size_t j, off = 0, total = 0, lo, hi;
+
+    for (i=First[g];i<First[g+1];i++)
+        total += Len[i];
+    lo = total*rank/GroupSize[g];
+    hi = total*(rank+1)/GroupSize[g];
+    for (i=First[g];i<First[g+1];i++)
+    {
+        if (off>=lo && off<hi) /* Fragments are assigned by their first byte */
+        {
+            const double *s = Source[i];
+            unsigned char *d = Frag[i];
+            for (j=0;j<Len[i];j++)
+            {
+                if (s[j]>=0 && s[j]<=255)
+                {
+                    d[j] = (unsigned char) s[j];
+                    bad |= (d[j]!=s[j]);
+                }
+                else
+                    bad = 1;
+            }
+            Home[i] = node;
+            if (node!=src_node)
+                *remote_node_bytes += Len[i];
+        }
+        off += Len[i];
+    }
+    return bad;
+}
+
+/* Copy a cell array of fragments to the partitions */
+static void load_batch(const mxArray *C)
+{
+    int n, i, g, bad = 0, src_node;
+    size_t total = 0, cum, *need;
+    double remote = 0;
+    pool_thread master;
+
+    if (!mxIsCell(C))
+        mexErrMsgTxt("Fragments must be a cell array.\n");
+    n = (int) mxGetNumberOfElements(C);
+    Resident = 0;
+    NumFrag = 0;
+    if ((size_t)n>FragCap || !Source)
+    {
+        free(Source); free(Len); free(Frag); free(Home);
+        Source = (const double**) malloc((n+1)*sizeof(double*));
+        Len = (size_t*) malloc((n+1)*sizeof(size_t));
+        Frag = (unsigned char**) malloc((n+1)*sizeof(unsigned char*));
+        Home = (int*) malloc((n+1)*sizeof(int));
+        FragCap = n;
+        if (!Source || !Len || !Frag || !Home)
+        {
+            free_state();
+            mexErrMsgTxt("Out of memory.\n");
+        }
+    }
+    for (i=0;i<n;i++)
+    {
+        const mxArray *a = mxGetCell(C,i);
+        if (!a || !mxIsDouble(a) || mxIsComplex(a) || (mxGetM(a)>1 && mxGetN(a)>1))
+            mexErrMsgTxt("Fragments must be real vectors of type double.\n");
+        Source[i] = mxGetPr(a);
+        Len[i] = mxGetNumberOfElements(a);
+        total += Len[i];
+    }
+
+    /* Partitions in proportion to their threads */
+    need = (size_t*) calloc(NumGroups,sizeof(size_t));
+    if (!need)
+        mexErrMsgTxt("Out of memory.\n");
+    g = 0;
+    cum = 0;
+    First[0] = 0;
+    for (i=0;i<n;i++)
+    {
+        size_t threads = 0;
+        int h;
+        while (g<NumGroups-1)
+        {
+            threads = 0;
+            for (h=0;h<=g;h++)
+                threads += GroupSize[h];
+            if ((double)cum<(double)total*threads/NumThreads)
+                break;
+            First[++g] = i;
+        }
+        need[g] += Len[i];
+        cum += Len[i];
+    }
+    while (g<NumGroups-1)
+        First[++g] = n;
+    First[NumGroups] = n;
+
+    /* Memory of partitions (the pages of new memory are placed by the threads which copy the fragments) */
+    for (g=0;g<NumGroups;g++)
+    {
+        size_t off = 0;
+        if (!reserve((void**)&PartBuf[g],&PartCap[g],need[g]+1,0))
+        {
+            free(need);
+            mexErrMsgTxt("Out of memory.\n");
+        }
+        for (i=First[g];i<First[g+1];i++)
+        {
+            Frag[i] = PartBuf[g]+off;
+            off += Len[i];
+        }
+    }
+    free(need);
+
+    master.node = 0;
+    src_node = current_node(&master);
+
+    /* Each thread copies a part of its partition (first-touch) */
+    #pragma omp parallel num_threads(NumThreads) reduction(|:bad) reduction(+:remote)
+    {
+        int id = thread_id(), nt = team_size(), slot, pinned, node;
+        cpumask_t old;
+        pool_thread *t = &Threads[id];
+
+        enter_region(t,&old,&pinned);
+        node = current_node(t);
+        for (slot=id;slot<NumThreads;slot+=nt) /* Slots of the threads which are not in the team */
+            bad |= copy_part(Threads[slot].group,Threads[slot].rank,node,&remote,src_node);
+        leave_region(&old,pinned);
+    }
+    if (bad)
+        mexErrMsgTxt("Fragments must be vectors of byte values.\n");
+
+    NumFrag = n;
+    LoadBytes += (double) total;
+    LoadRemote += remote;
+}
+
+/* Use the loaded batch if it is the same as the cell array of fragments; otherwise, copy the fragments */
+static void prepare_batch(const mxArray *C)
+{
+    int i, n;
+    if (!mxIsCell(C))
+        mexErrMsgTxt("Fragments must be a cell array.\n");
+    n = (int) mxGetNumberOfElements(C);
+    if (Resident && n==NumFrag)
+    {
+        for (i=0;i<n;i++)
+        {
+            const mxArray *a = mxGetCell(C,i);
+            if (!a || !mxIsDouble(a) || mxGetPr(a)!=Source[i] || mxGetNumberOfElements(a)!=Len[i])
+                break;
+        }
+        if (i==n)
+            return;
+    }
+    load_batch(C);
+}
+
+/* Representatives (they are copied by each thread to its workspace) */
+static void prepare_reps(const mxArray *C)
+{
+    int j;
+    size_t k;
+    if (!mxIsCell(C))
+        mexErrMsgTxt("Representatives must be a cell array.\n");
+    NumReps = (int) mxGetNumberOfElements(C);
+    free(RepSrc); free(RepLen); free(RepOff);
+    RepSrc = (const double**) malloc((NumReps+1)*sizeof(double*));
+    RepLen = (size_t*) malloc((NumReps+1)*sizeof(size_t));
+    RepOff = (size_t*) malloc((NumReps+1)*sizeof(size_t));
+    if (!RepSrc || !RepLen || !RepOff)
+        mexErrMsgTxt("Out of memory.\n");
+    RepBytes = 0;
+    for (j=0;j<NumReps;j++)
+    {
+        const mxArray *a = mxGetCell(C,j);
+        const double *s;
+        if (!a || !mxIsDouble(a) || mxIsComplex(a) || (mxGetM(a)>1 && mxGetN(a)>1))
+            mexErrMsgTxt("Representatives must be real vectors of type double.\n");
+        s = RepSrc[j] = mxGetPr(a);
+        RepLen[j] = mxGetNumberOfElements(a);
+        RepOff[j] = RepBytes;
+        RepBytes += RepLen[j];
+        for (k=0;k<RepLen[j];k++)
+            if (!(s[k]>=0 && s[k]<=255 && s[k]==floor(s[k])))
+                mexErrMsgTxt("Representatives must be vectors of byte values.\n");
+    }
+}
+
+static int copy_reps(pool_thread *t)
+{
+    int j;
+    size_t k;
+    if (!RESERVE(t,reps,RepBytes+1))
+        return 1;
+    for (j=0;j<NumReps;j++)
+        for (k=0;k<RepLen[j];k++)
+            t->reps[RepOff[j]+k] = (unsigned char) RepSrc[j][k];
+    return 0;
+}
+
+/* ----------------------------------------------- Kernels ---------------------------------------------- */
+
+/* Kernel for fragment x of length n; the outputs of the fragment are out[0], out[ld], out[2*ld], ... */
+typedef int (*pool_kernel)(pool_thread *t,const unsigned char *x,size_t n,double *out,size_t ld);
+
+static int popcount64(uint64_t x)
+{
+    x = x-((x>>1)&0x5555555555555555ULL);
+    x = (x&0x3333333333333333ULL)+((x>>2)&0x3333333333333333ULL);
+    x = (x+(x>>4))&0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x*0x0101010101010101ULL)>>56);
+}
+
+/* Bit-parallel LCSSeq of LCSSeq_FFC; PM is the workspace of the thread (all-zero on entry and on return) */
+FORCE_INLINE int LCSSeq_BitParallel(const unsigned char *Xb,int m,const unsigned char *Yb,int n,int nw,uint64_t *PM,uint64_t *V,int band)
+{
+    int i,j,w,L,lo,hi,wlo,whi;
+    uint64_t U,sum,t,carry,pmw,*pm;
+
+    for (i=0;i<m;i++)
+        PM[Xb[i]*nw+(i>>6)] |= 1ULL<<(i&63);
+    for (w=0;w<nw;w++)
+        V[w] = ~0ULL;
+
+    lo = 0; hi = m-1;
+    wlo = 0; whi = nw-1;
+    for (j=0;j<n;j++)
+    {
+        if (band>=0)
+        {
+            lo = j-band; hi = j+band;
+            if (lo>m-1)
+                break;
+            lo = (lo<0) ? 0 : lo;
+            hi = (hi>m-1) ? m-1 : hi;
+            wlo = lo>>6; whi = hi>>6;
+        }
+
+        pm = PM+Yb[j]*nw;
+        carry = 0;
+        for (w=wlo;w<=whi;w++)
+        {
+            pmw = pm[w];
+            if (band>=0)
+            {
+                if (w==wlo)
+                    pmw &= ~0ULL<<(lo&63);
+                if (w==whi)
+                    pmw &= ~0ULL>>(63-(hi&63));
+            }
+            U = V[w]&pmw;
+            sum = V[w]+U;
+            t = sum+carry;
+            carry = (sum<U)|(t<sum);
+            V[w] = t|(V[w]&~pmw);
+        }
+    }
+
+    for (i=0;i<m;i++)
+        PM[Xb[i]*nw+(i>>6)] = 0;
+
+    L = 0;
+    for (w=0;w<nw;w++)
+    {
+        if ((w+1)*64<=m)
+            L += 64-popcount64(V[w]);
+        else
+            L += (m-w*64)-popcount64(V[w]&((1ULL<<(m-w*64))-1));
+    }
+
+    return L;
+}
+
+#define DEFINE_LCSSEQ_FIXED(M) \
+static int LCSSeq_##M(const unsigned char *Xb,const unsigned char *Yb,int n,uint64_t *PM,int band) \
+{ \
+    uint64_t V[(M+63)/64]; \
+    if (band<0) \
+        return LCSSeq_BitParallel(Xb,M,Yb,n,(M+63)/64,PM,V,-1); \
+    return LCSSeq_BitParallel(Xb,M,Yb,n,(M+63)/64,PM,V,band); \
+}
+
+DEFINE_LCSSEQ_FIXED(512)
+DEFINE_LCSSEQ_FIXED(1024)
+DEFINE_LCSSEQ_FIXED(1500)
+DEFINE_LCSSEQ_FIXED(4096)
+
+/* The dispatch of LCSSeq_FFC, with the workspaces of the thread */
+static int LCSSeq_Pool(pool_thread *t,const unsigned char *Xb,int m,const unsigned char *Yb,int n,int band)
+{
+    int nw = (m>n ? m : n)/64+1;
+    if (m==0 || n==0)
+        return 0;
+    if (!reserve((void**)&t->pm,&t->pm_cap,256*nw*sizeof(uint64_t),1) || !RESERVE(t,v,nw*sizeof(uint64_t)))
+        return -1;
+    switch (m)
+    {
+        case 512:  return LCSSeq_512(Xb,Yb,n,t->pm,band);
+        case 1024: return LCSSeq_1024(Xb,Yb,n,t->pm,band);
+        case 1500: return LCSSeq_1500(Xb,Yb,n,t->pm,band);
+        case 4096: return LCSSeq_4096(Xb,Yb,n,t->pm,band);
+    }
+    switch (n)
+    {
+        case 512:  return LCSSeq_512(Yb,Xb,m,t->pm,band);
+        case 1024: return LCSSeq_1024(Yb,Xb,m,t->pm,band);
+        case 1500: return LCSSeq_1500(Yb,Xb,m,t->pm,band);
+        case 4096: return LCSSeq_4096(Yb,Xb,m,t->pm,band);
+    }
+    return LCSSeq_BitParallel(Xb,m,Yb,n,(m+63)/64,t->pm,t->v,band);
+}
+
+/* LCSStr of LCSStr_FFC (two rows of the table; only the cells with |i-j|<=band if band>=0) */
+static int LCSStr_Pool(pool_thread *t,const unsigned char *Xv,int m,const unsigned char *Yv,int n,int band)
+{
+    int i,j,L,jlo,jhi,*prev,*cur,*tmp;
+
+    if (m==0 || n==0)
+        return 0;
+    if (!RESERVE(t,rows,2*(n+1)*sizeof(int)))
+        return -1;
+    prev = t->rows;
+    cur = t->rows+n+1;
+    for (j=0;j<=n;j++)
+        prev[j] = cur[j] = 0;
+
+    L = 0;
+    for (i=1;i<=m && (band<0 || i-band<=n);i++)
+    {
+        const int x = Xv[i-1];
+        jlo = (band>=0 && i-band>1) ? i-band : 1;
+        jhi = (band>=0 && i+band<n) ? i+band : n;
+        for (j=jlo;j<=jhi;j++)
+        {
+            cur[j] = (x==Yv[j-1]) ? prev[j-1]+1 : 0;
+            L = (cur[j]>L) ? cur[j] : L;
+        }
+        tmp = prev; prev = cur; cur = tmp;
+    }
+
+    return L;
+}
+
+/* Band of a pair of vectors (-1 for the exact mode) */
+static int pair_band(size_t m,size_t n)
+{
+    if (mxIsInf(Band) || Band>=(double)(m>n ? m : n))
+        return -1;
+    return (int) Band;
+}
+
+static int kernel_lcs(pool_thread *t,const unsigned char *x,size_t m,double *out,size_t ld,int seq)
+{
+    int j, L;
+    double sum = 0;
+    (void) ld;
+    for (j=0;j<NumReps;j++)
+    {
+        size_t n = RepLen[j];
+        const unsigned char *y = t->reps+RepOff[j];
+        if (seq)
+            L = LCSSeq_Pool(t,x,(int)m,y,(int)n,pair_band(m,n));
+        else
+            L = LCSStr_Pool(t,x,(int)m,y,(int)n,pair_band(m,n));
+        if (L<0)
+            return 1;
+        sum += (double)L/(double)(m<n ? m : n);
+    }
+    out[0] = sum/NumReps;
+    return 0;
+}
+
+static int kernel_lcsseq(pool_thread *t,const unsigned char *x,size_t m,double *out,size_t ld)
+{
+    return kernel_lcs(t,x,m,out,ld,1);
+}
+
+static int kernel_lcsstr(pool_thread *t,const unsigned char *x,size_t m,double *out,size_t ld)
+{
+    return kernel_lcs(t,x,m,out,ld,0);
+}
+
+/* Complexity of kolmogorov_FFC */
+static int kernel_kolmogorov(pool_thread *t,const unsigned char *S,size_t n,double *out,size_t ld)
+{
+    int c;
+    size_t l,i,k,kmax;
+    (void) t; (void) ld;
+
+    c = 1;
+    l = 1;
+    i = 0;
+    k = 1;
+    kmax = 1;
+    while ((l+k)<=n)
+    {
+        if (S[i+k-1]==S[l+k-1])
+        {
+            k = k+1;
+            if ((l+k)<n)
+                continue;
+            c = c+1;
+            break;
+        }
+        if (k>kmax)
+            kmax = k;
+        i = i+1;
+        if (i==l)
+        {
+            c = c+1;
+            l = l+kmax;
+            if (l>=n)
+                break;
+            i = 0;
+            kmax = 1;
+        }
+        k = 1;
+    }
+
+    out[0] = (double) c/(double) n;
+    return 0;
+}
+
+/* Rescale to [0,1] (1 if the range of data is zero) */
+static int rescale_series(double *x,size_t l,double *min,double *interval)
+{
+    size_t i;
+
+    *min = *interval = x[0];
+    for (i=1;i<l;i++)
+    {
+        if (x[i] < *min) *min = x[i];
+        if (x[i] > *interval) *interval = x[i];
+    }
+    *interval -= *min;
+    if (*interval == 0.0)
+        return 1;
+    for (i=0;i<l;i++)
+        x[i] = (x[i]- *min)/ *interval;
+    return 0;
+}
+
+static int copy_series(pool_thread *t,const unsigned char *x,size_t n)
+{
+    size_t i;
+    if (!RESERVE(t,series,(n+1)*sizeof(double)))
+        return 1;
+    for (i=0;i<n;i++)
+        t->series[i] = (double) x[i];
+    return 0;
+}
+
+/* False nearest neighbors of false_nearest_FFC (theiler=0, delay=1, comp=1). The boxes are kept all -1
+ * between calls, and only the boxes of the points are cleared. */
+typedef struct
+{
+    const double *s;
+    size_t length;
+    double varianz,aveps,vareps;
+    unsigned long toolarge;
+    int *box,*list,*cell;
+    size_t boxed;
+} fnn_state;
+
+static void fnn_clear(fnn_state *f)
+{
+    size_t i;
+    for (i=0;i<f->boxed;i++)
+        f->box[f->cell[i]] = -1;
+    f->boxed = 0;
+}
+
+static void fnn_mmb(fnn_state *f,unsigned int hemb,double eps)
+{
+    size_t i;
+    long x,y;
+    const long ibox = FNN_BOX-1;
+
+    fnn_clear(f);
+    for (i=0;i<f->length-(Maxemb+1);i++)
+    {
+        x = (long)(f->s[i]/eps)&ibox;
+        y = (long)(f->s[i+hemb]/eps)&ibox;
+        f->cell[i] = (int)(x*FNN_BOX+y);
+        f->list[i] = f->box[f->cell[i]];
+        f->box[f->cell[i]] = (int) i;
+    }
+    f->boxed = f->length-(Maxemb+1);
+}
+
+static char fnn_find_nearest(fnn_state *f,long n,unsigned int dim,double eps)
+{
+    long x,y,x1,x2,y1,i,element,which = -1;
+    const long ibox = FNN_BOX-1;
+    const double *s = f->s;
+    double dx,maxdx,mindx = 1.1,factor;
+
+    x = (long)(s[n]/eps)&ibox;
+    y = (long)(s[n+dim]/eps)&ibox;
+    for (x1=x-1;x1<=x+1;x1++)
+    {
+        x2 = x1&ibox;
+        for (y1=y-1;y1<=y+1;y1++)
+        {
+            element = f->box[x2*FNN_BOX+(y1&ibox)];
+            while (element != -1)
+            {
+                if (element != n)
+                {
+                    maxdx = fabs(s[n]-s[element]);
+                    for (i=1;i<=(long)dim;i++)
+                    {
+                        dx = fabs(s[n+i]-s[element+i]);
+                        if (dx > maxdx)
+                            maxdx = dx;
+                    }
+                    if ((maxdx < mindx) && (maxdx > 0.0))
+                    {
+                        which = element;
+                        mindx = maxdx;
+                    }
+                }
+                element = f->list[element];
+            }
+        }
+    }
+
+    if ((which != -1) && (mindx <= eps) && (mindx <= f->varianz/Rt))
+    {
+        f->aveps += mindx;
+        f->vareps += mindx*mindx;
+        factor = fabs(s[n+dim+1]-s[which+dim+1])/mindx;
+        if (factor > Rt)
+            f->toolarge++;
+        return 1;
+    }
+    return 0;
+}
+
+static int kernel_false_nearest(pool_thread *t,const unsigned char *x,size_t n,double *out,size_t ld)
+{
+    fnn_state f;
+    double min,inter,av,var,h,epsilon,eps0 = 1.0e-5;
+    unsigned int emb,dim,D = Maxemb-Minemb+1,r;
+    unsigned long donesofar;
+    size_t i;
+    char alldone;
+
+    for (i=0;i<3*D;i++)
+        out[i*ld] = -1;
+    if ((long)n-(long)(Maxemb+1)<0) /* Data length is too small */
+        return 0;
+    if (copy_series(t,x,n))
+        return 1;
+    if (rescale_series(t->series,n,&min,&inter)) /* Data range is zero */
+        return 0;
+
+    /* Variance of the rescaled data */
+    av = var = 0.0;
+    for (i=0;i<n;i++)
+    {
+        h = t->series[i];
+        av += h;
+        var += h*h;
+    }
+    av /= (double)n;
+    var = sqrt(fabs(var/(double)n-av*av));
+    if (var == 0.0)
+        return 0;
+
+    if (!RESERVE(t,list,n*sizeof(int)+1) || !RESERVE(t,cell,n*sizeof(int)+1) || !RESERVE(t,nearest,n+1))
+        return 1;
+    if (!t->fbox)
+    {
+        t->fbox = (int*) malloc((size_t)FNN_BOX*FNN_BOX*sizeof(int));
+        if (!t->fbox)
+            return 1;
+        for (i=0;i<(size_t)FNN_BOX*FNN_BOX;i++)
+            t->fbox[i] = -1;
+    }
+    f.s = t->series;
+    f.length = n;
+    f.varianz = var;
+    f.box = t->fbox;
+    f.list = t->list;
+    f.cell = t->cell;
+    f.boxed = 0;
+
+    for (emb=Minemb,r=0;emb<=Maxemb;emb++,r++)
+    {
+        dim = emb-1;
+        epsilon = eps0;
+        f.toolarge = 0;
+        f.aveps = f.vareps = 0.0;
+        alldone = 0;
+        donesofar = 0;
+        memset(t->nearest,0,n);
+
+        while (!alldone && (epsilon < 2.0*var/Rt))
+        {
+            alldone = 1;
+            fnn_mmb(&f,dim,epsilon);
+            for (i=0;i<n-Maxemb;i++)
+                if (!t->nearest[i])
+                {
+                    t->nearest[i] = fnn_find_nearest(&f,(long)i,dim,epsilon);
+                    alldone &= t->nearest[i];
+                    donesofar += (unsigned long)t->nearest[i];
+                }
+            epsilon *= sqrt(2.0);
+            if (!donesofar)
+                eps0 = epsilon;
+        }
+        if (donesofar == 0) /* Not enough points found */
+            break;
+
+        f.aveps *= (1.0/(double)donesofar);
+        f.vareps *= (1.0/(double)donesofar);
+        out[(3*r)*ld] = (double)f.toolarge/(double)donesofar;
+        out[(3*r+1)*ld] = f.aveps*inter;
+        out[(3*r+2)*ld] = sqrt(f.vareps)*inter;
+    }
+    fnn_clear(&f);
+
+    return 0;
+}
+
+/* Lyapunov exponents of lyap_exp_k_FFC (delay=1, window=0, epscount=5, maxiter=10, epsmin=1e-3,
+ * epsmax=1e-2, and all points as references) */
+static int kernel_lyapunov(pool_thread *t,const unsigned char *x,size_t length,double *out,size_t ld)
+{
+    const unsigned int maxiter = LYAP_MAXITER, D = Maxdim-1, W = LYAP_MAXITER+1;
+    const long ibox = LYAP_BOX-1;
+    double min,max,eps_fak,epsilon,eps2,dx,tmp,xs[3],ys[3],xmean,ymean,slope;
+    double *s,*lyap,*lfactor,*dxi;
+    long *found,*count,*lcount;
+    int *lfound,*box,*liste;
+    unsigned long reference = length, blength, act;
+    unsigned int i,j,k,l,cnt;
+    long e,i1,i2,j1,element,bi,bj;
+
+    for (i=0;i<Maxdim-Mindim+1;i++)
+        out[i*ld] = -1;
+    if (copy_series(t,x,length))
+        return 1;
+    s = t->series;
+    if (rescale_series(s,length,&min,&max)) /* Data range is zero */
+        return 0;
+    if (reference > (length-maxiter-(Maxdim-1)))
+        reference = length-maxiter-(Maxdim-1);
+    if ((maxiter+(Maxdim-1)) >= length) /* Too few points */
+        return 0;
+
+    if (!RESERVE(t,list,length*sizeof(int)) || !RESERVE(t,lfound,(size_t)D*length*sizeof(int)) ||
+        !RESERVE(t,lcounts,(D+2*(size_t)D*W)*sizeof(long)) || !RESERVE(t,lsums,(2*(size_t)D*W+W)*sizeof(double)))
+        return 1;
+    if (!t->lbox && !(t->lbox = (int*) malloc(LYAP_BOX*LYAP_BOX*sizeof(int))))
+        return 1;
+    box = t->lbox;
+    liste = t->list;
+    lfound = t->lfound;
+    found = t->lcounts;
+    count = found+D;
+    lcount = count+D*W;
+    lyap = t->lsums;
+    lfactor = lyap+D*W;
+    dxi = lfactor+D*W;
+
+    eps_fak = pow(1.e-2/1.e-3,1.0/(double)(LYAP_EPSCOUNT-1));
+    for (l=0;l<LYAP_EPSCOUNT;l++)
+    {
+        epsilon = 1.e-3*pow(eps_fak,(double)l);
+        eps2 = epsilon*epsilon;
+        for (i=0;i<D*W;i++)
+        {
+            count[i] = 0;
+            lyap[i] = 0.0;
+        }
+
+        /* Put the points in boxes */
+        blength = length-(Maxdim-1)-maxiter;
+        for (i=0;i<LYAP_BOX*LYAP_BOX;i++)
+            box[i] = -1;
+        for (act=0;act<blength;act++)
+        {
+            bj = (long)(s[act]/epsilon)&ibox;
+            bi = (long)(s[act+1]/epsilon)&ibox;
+            liste[act] = box[bj*LYAP_BOX+bi];
+            box[bj*LYAP_BOX+bi] = (int) act;
+        }
+
+        for (act=0;act<reference;act++)
+        {
+            /* Neighbors of the reference point */
+            for (i=0;i<D;i++)
+                found[i] = 0;
+            bi = (long)(s[act]/epsilon)&ibox;
+            bj = (long)(s[act+1]/epsilon)&ibox;
+            for (i1=bi-1;i1<=bi+1;i1++)
+            {
+                i2 = i1&ibox;
+                for (j1=bj-1;j1<=bj+1;j1++)
+                {
+                    element = box[i2*LYAP_BOX+(j1&ibox)];
+                    while (element != -1)
+                    {
+                        if (element != (long)act)
+                        {
+                            dx = s[act]-s[element];
+                            dx *= dx;
+                            if (dx <= eps2)
+                            {
+                                for (k=1;k<Maxdim;k++)
+                                {
+                                    tmp = s[act+k]-s[element+k];
+                                    dx += tmp*tmp;
+                                    if (dx <= eps2)
+                                    {
+                                        lfound[(k-1)*length+found[k-1]] = (int) element;
+                                        found[k-1]++;
+                                    }
+                                    else
+                                        break;
+                                }
+                            }
+                        }
+                        element = liste[element];
+                    }
+                }
+            }
+
+            /* Iterate the neighbors */
+            for (i=0;i<D*W;i++)
+            {
+                lfactor[i] = 0.0;
+                lcount[i] = 0;
+            }
+            for (j=Mindim-2;j<D;j++)
+            {
+                for (e=0;e<found[j];e++)
+                {
+                    element = lfound[j*length+e];
+                    for (i=0;i<=maxiter;i++)
+                    {
+                        tmp = s[act+i]-s[element+i];
+                        dxi[i] = tmp*tmp;
+                    }
+                    for (k=1;k<j+2;k++)
+                        for (i=0;i<=maxiter;i++)
+                        {
+                            tmp = s[act+i+k]-s[element+k+i];
+                            dxi[i] += tmp*tmp;
+                        }
+                    for (i=0;i<=maxiter;i++)
+                        if (dxi[i] > 0.0)
+                        {
+                            lcount[j*W+i]++;
+                            lfactor[j*W+i] += dxi[i];
+                        }
+                }
+            }
+            for (i=Mindim-2;i<D;i++)
+                for (j=0;j<=maxiter;j++)
+                    if (lcount[i*W+j])
+                    {
+                        count[i*W+j]++;
+                        lyap[i*W+j] += log(lfactor[i*W+j]/lcount[i*W+j])/2.0;
+                    }
+        }
+
+        /* Slope of the first three points of each dimension */
+        for (i=Mindim-2;i<D;i++)
+        {
+            cnt = 0;
+            for (j=0;j<=maxiter;j++)
+                if (count[i*W+j])
+                {
+                    xs[cnt] = (double)j;
+                    ys[cnt] = lyap[i*W+j]/count[i*W+j];
+                    cnt++;
+                    if (cnt==3)
+                        break;
+                }
+            if (cnt==3)
+            {
+                xmean = (xs[0]+xs[1]+xs[2])/3.0;
+                ymean = (ys[0]+ys[1]+ys[2])/3.0;
+                xs[0] -= xmean; xs[1] -= xmean; xs[2] -= xmean;
+                ys[0] -= ymean; ys[1] -= ymean; ys[2] -= ymean;
+                slope = ((xs[0]*ys[0])+(xs[1]*ys[1])+(xs[2]*ys[2]))/(xs[0]*xs[0]+xs[1]*xs[1]+xs[2]*xs[2]);
+                if (slope>out[(i+2-Mindim)*ld])
+                    out[(i+2-Mindim)*ld] = slope;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* ------------------------------------------------ Calls ----------------------------------------------- */
+
+/* Run a kernel for all fragments of the batch. Each thread takes chunks of fragments of its own partition,
+ * and then of the other partitions. */
+static void run_kernel(pool_kernel kernel,double *out,int reps)
+{
+    int g, err = 0, src_node;
+    double bytes = 0, remote = 0, reps_remote = 0;
+    pool_thread master;
+
+    master.node = 0;
+    src_node = current_node(&master);
+    for (g=0;g<NumGroups;g++)
+        Next[g] = First[g];
+
+    #pragma omp parallel num_threads(NumThreads) reduction(|:err) reduction(+:bytes,remote,reps_remote)
+    {
+        int id = thread_id(), pinned, k, g1, first, last, chunk, i, node;
+        cpumask_t old;
+        pool_thread *t = &Threads[id];
+
+        enter_region(t,&old,&pinned);
+        node = current_node(t);
+        if (reps)
+        {
+            t->err |= copy_reps(t);
+            if (node!=src_node)
+                reps_remote += (double) RepBytes;
+        }
+        for (k=0;k<NumGroups && !t->err;k++)
+        {
+            g1 = (t->group+k)%NumGroups;
+            chunk = (First[g1+1]-First[g1])/(8*GroupSize[g1])+1;
+            chunk = (chunk>64) ? 64 : chunk;
+            while (!t->err)
+            {
+                #pragma omp critical (pool_queue)
+                {
+                    first = Next[g1];
+                    last = (first+chunk<First[g1+1]) ? first+chunk : First[g1+1];
+                    Next[g1] = last;
+                }
+                if (first>=last)
+                    break;
+                node = current_node(t);
+                for (i=first;i<last && !t->err;i++)
+                {
+                    t->err |= kernel(t,Frag[i],Len[i],out+i,(size_t)NumFrag);
+                    t->bytes += (double) Len[i];
+                    if (Home[i]!=node)
+                        t->remote += (double) Len[i];
+                }
+            }
+        }
+        err |= t->err;
+        bytes += t->bytes;
+        remote += t->remote;
+        leave_region(&old,pinned);
+    }
+    if (err)
+        mexErrMsgTxt("Out of memory.\n");
+
+    Calls++;
+    KernelBytes += bytes;
+    KernelRemote += remote;
+    if (reps)
+    {
+        LoadBytes += (double) RepBytes*NumThreads;
+        LoadRemote += reps_remote;
+    }
+}
+
+static double scalar_input(const mxArray *a,const char *msg)
+{
+    if (!mxIsDouble(a) || mxIsComplex(a) || mxGetNumberOfElements(a)!=1)
+        mexErrMsgTxt(msg);
+    return mxGetScalar(a);
+}
+
+static mxArray *pool_info(void)
+{
+    static const char *fields[] = {"NumThreads","Affinity","NumNodes","CPU","Node","Partitions","Fragments","Bytes",
+        "WorkspaceBytes","Calls","LoadBytes","LoadRemoteBytes","KernelBytes","KernelRemoteBytes"};
+    mxArray *Info = mxCreateStructMatrix(1,1,14,fields), *cpu, *node;
+    double resident = 0, ws = 0;
+    int i;
+
+    cpu = mxCreateDoubleMatrix(1,NumThreads,mxREAL);
+    node = mxCreateDoubleMatrix(1,NumThreads,mxREAL);
+    for (i=0;i<NumThreads;i++)
+    {
+        pool_thread *t = &Threads[i];
+        mxGetPr(cpu)[i] = t->cpu;
+        mxGetPr(node)[i] = t->node;
+        ws += (double) (t->reps_cap+t->pm_cap+t->v_cap+t->rows_cap+t->series_cap+t->list_cap+t->cell_cap+
+            t->nearest_cap+t->lfound_cap+t->lcounts_cap+t->lsums_cap);
+        ws += (t->fbox ? (double)FNN_BOX*FNN_BOX*sizeof(int) : 0)+(t->lbox ? (double)LYAP_BOX*LYAP_BOX*sizeof(int) : 0);
+    }
+    if (Resident)
+        for (i=0;i<NumFrag;i++)
+            resident += (double) Len[i];
+
+    mxSetField(Info,0,"NumThreads",mxCreateDoubleScalar(NumThreads));
+    mxSetField(Info,0,"Affinity",mxCreateString(AffinityNames[Affinity]));
+    mxSetField(Info,0,"NumNodes",mxCreateDoubleScalar(NumNodes));
+    mxSetField(Info,0,"CPU",cpu);
+    mxSetField(Info,0,"Node",node);
+    mxSetField(Info,0,"Partitions",mxCreateDoubleScalar(NumGroups));
+    mxSetField(Info,0,"Fragments",mxCreateDoubleScalar(Resident ? NumFrag : 0));
+    mxSetField(Info,0,"Bytes",mxCreateDoubleScalar(resident));
+    mxSetField(Info,0,"WorkspaceBytes",mxCreateDoubleScalar(ws));
+    mxSetField(Info,0,"Calls",mxCreateDoubleScalar(Calls));
+    mxSetField(Info,0,"LoadBytes",mxCreateDoubleScalar(LoadBytes));
+    mxSetField(Info,0,"LoadRemoteBytes",mxCreateDoubleScalar(LoadRemote));
+    mxSetField(Info,0,"KernelBytes",mxCreateDoubleScalar(KernelBytes));
+    mxSetField(Info,0,"KernelRemoteBytes",mxCreateDoubleScalar(KernelRemote));
+    return Info;
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],int nrhs, const mxArray *prhs[])
+{
+    char mode[16];
+    int M;
+
+    /* Check for the proper number of arguments. */
+    if (nrhs<1 || !mxIsChar(prhs[0]) || mxGetString(prhs[0],mode,sizeof(mode)))
+        mexErrMsgTxt("The first input must be a command of the pool (see FeaturePool_Core_FFC.c).");
+    if (nlhs > 1)
+        mexErrMsgTxt("No more than one output is required!");
+    mexAtExit(free_state);
+
+    if (strcmp(mode,"clear")==0)
+    {
+        free_state();
+        return;
+    }
+
+    if (strcmp(mode,"init")==0)
+    {
+        double nt = 0, aff = 0;
+        if (nrhs>3)
+            mexErrMsgTxt("At most three inputs are required for 'init'.");
+        if (nrhs>1)
+            nt = scalar_input(prhs[1],"Number of threads must be a scalar.\n");
+        if (nrhs>2)
+            aff = scalar_input(prhs[2],"Affinity must be a scalar.\n");
+        if (!(nt>=0 && nt<=MAX_CPUS && nt==floor(nt)))
+            mexErrMsgTxt("Number of threads must be an integer in {0,1,...,1024}.\n");
+        if (!(aff==0 || aff==1 || aff==2))
+            mexErrMsgTxt("Affinity must be 0 (none), 1 (compact), or 2 (scatter).\n");
+        init_pool((int)nt,(int)aff);
+        return;
+    }
+
+    if (!Initialized)
+        init_pool(0,0);
+
+    if (strcmp(mode,"info")==0)
+    {
+        plhs[0] = pool_info();
+        return;
+    }
+
+    if (strcmp(mode,"unload")==0)
+    {
+        Resident = 0;
+        return;
+    }
+
+    if (strcmp(mode,"load")==0)
+    {
+        if (nrhs!=2)
+            mexErrMsgTxt("Two inputs are required for 'load'.");
+        load_batch(prhs[1]);
+        Resident = 1;
+        return;
+    }
+
+    if (strcmp(mode,"LCSSeq")==0 || strcmp(mode,"LCSStr")==0)
+    {
+        if (nrhs!=3 && nrhs!=4)
+            mexErrMsgTxt("Three or four inputs are required for LCS kernels.");
+        Band = mxGetInf();
+        if (nrhs==4)
+        {
+            Band = scalar_input(prhs[3],"Band must be a scalar.\n");
+            if (!(Band>=0) || (!mxIsInf(Band) && Band!=floor(Band)))
+                mexErrMsgTxt("Band must be a non-negative integer or Inf.\n");
+        }
+        prepare_reps(prhs[2]);
+        prepare_batch(prhs[1]);
+        plhs[0] = mxCreateDoubleMatrix(NumFrag,1,mxREAL);
+        run_kernel(strcmp(mode,"LCSSeq")==0 ? kernel_lcsseq : kernel_lcsstr,mxGetPr(plhs[0]),1);
+    }
+    else if (strcmp(mode,"Kolmogorov")==0)
+    {
+        if (nrhs!=2)
+            mexErrMsgTxt("Two inputs are required for 'Kolmogorov'.");
+        prepare_batch(prhs[1]);
+        plhs[0] = mxCreateDoubleMatrix(NumFrag,1,mxREAL);
+        run_kernel(kernel_kolmogorov,mxGetPr(plhs[0]),0);
+    }
+    else if (strcmp(mode,"FalseNearest")==0)
+    {
+        if (nrhs!=5)
+            mexErrMsgTxt("Five inputs are required for 'FalseNearest'.");
+        Minemb = (unsigned int) scalar_input(prhs[2],"Minimum embedding dimension must be a scalar.\n");
+        Maxemb = (unsigned int) scalar_input(prhs[3],"Maximum embedding dimension must be a scalar.\n");
+        Rt = scalar_input(prhs[4],"Ratio factor must be a scalar.\n");
+        if ((Rt<=0) || Minemb==0 || Maxemb==0 || Maxemb<Minemb || Maxemb>50 || Minemb>50)
+            mexErrMsgTxt("Wrong input parameters!\n");
+        prepare_batch(prhs[1]);
+        M = NumFrag;
+        plhs[0] = mxCreateDoubleMatrix(M,3*(Maxemb-Minemb+1),mxREAL);
+        run_kernel(kernel_false_nearest,mxGetPr(plhs[0]),0);
+    }
+    else if (strcmp(mode,"Lyapunov")==0)
+    {
+        if (nrhs!=4)
+            mexErrMsgTxt("Four inputs are required for 'Lyapunov'.");
+        Mindim = (unsigned int) scalar_input(prhs[2],"Minimum embedding dimension must be a scalar.\n");
+        Maxdim = (unsigned int) scalar_input(prhs[3],"Maximum embedding dimension must be a scalar.\n");
+        if (Maxdim < 2 || Maxdim > 50 || Mindim < 2 || Mindim > 50 || Mindim > Maxdim)
+            mexErrMsgTxt("Wrong input parameters!\n");
+        prepare_batch(prhs[1]);
+        M = NumFrag;
+        plhs[0] = mxCreateDoubleMatrix(M,Maxdim-Mindim+1,mxREAL);
+        run_kernel(kernel_lyapunov,mxGetPr(plhs[0]),0);
+    }
+    else
+        mexErrMsgTxt("The first input must be a command of the pool (see FeaturePool_Core_FFC.c).");
+}
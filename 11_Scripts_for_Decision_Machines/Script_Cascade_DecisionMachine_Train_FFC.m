@@ -0,0 +1,418 @@
+function ErrorMsg = Script_Cascade_DecisionMachine_Train_FFC
+
+% This function takes Dataset_FFC with its feature extraction functions and trains a cascade of decision machines.
+% Each stage of cascade adds a group of feature extraction functions to the features of the previous stages and
+% has its own decision machine. At classification time, a fragment goes to the next stage only if the maximum score
+% of the current stage is less than the threshold of stage (see Classify_Fragments_Cascade_FFC). The validation part
+% of dataset is split into a tuning part and a held-out part. The thresholds are determined on the tuning part, and
+% the accuracy versus mean cost of cascade is reported on the held-out part only.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Output:
+%   ErrorMsg: Possible error message. If there is no error, this output is
+%   empty.
+%
+%   Note: The cascade is saved in a *.mat file (see Load_Cascade_FFC), and the decision machine of stage s is
+%   exported into the bundle file [name '_Stage' s '.dmb'] in the same folder (see Export_DecisionMachine_FFC).
+%
+% Revisions:
+% 2026-Oct-18   function was created
+% 2026-Oct-18   thresholds are tuned on a tuning part of validation data, and accuracy and mean cost are reported
+%               on a separate held-out part (TV has three elements)
+% 2026-Oct-18   the training samples are limited as in the baseline scaling (TrainIndex of Scale_Features_FFC)
+
+%% Initialization
+global ClassLabels_FFC FeatureLabels_FFC Dataset_FFC
+global Function_Handles_FFC Function_Labels_FFC Function_Select_FFC
+global Dataset_FFC_Name_TextBox
+global Feature_Transfrom_FFC
+
+%% Check that Dataset is generated/loaded
+if isempty(Dataset_FFC)
+    ErrorMsg = 'No dataset is loaded. Please generate or load a dataset.';
+    return;
+end
+
+%% Check that Dataset has at least two classes
+if length(ClassLabels_FFC)<2
+    ErrorMsg = 'At least two classes should be presented.';
+    return;
+end
+
+%% Check that the features of Dataset are grouped by feature extraction functions
+if isempty(Function_Handles_FFC)
+    ErrorMsg = 'The dataset does not include any feature extraction function.';
+    return;
+end
+if ~isempty(Feature_Transfrom_FFC)
+    ErrorMsg = 'A cascade cannot be trained on transformed features. Please load a dataset without feature transform.';
+    return;
+end
+
+NumHandles = length(Function_Handles_FFC);
+NumSelected = cellfun(@(x) sum(logical(x)),Function_Select_FFC); % Number of features of each function handle in Dataset
+Cols = cell(1,NumHandles); % Columns of features of each function handle in Dataset
+cnt = 0;
+for i=1:NumHandles
+    Cols{i} = cnt+(1:NumSelected(i));
+    cnt = cnt+NumSelected(i);
+end
+
+%% Determine Decision Machine Type
+% Only the decision machines whose scores are class probabilities are supported
+DecisionModels = {'Decision Tree','Random Forest','Naive Bayes','Linear Discriminant Analysis (LDA)'};
+[Selection,ok] = listdlg('Name','Decision Machines','PromptString','Select Decision Model of Stages',...
+    'SelectionMode','single','ListSize',[200 300],'ListString',DecisionModels);
+if ~ok
+    ErrorMsg = 'Process is aborted. No decision model is selected.';
+    return;
+end
+DecisionModel = DecisionModels{Selection};
+
+%% Costs of Feature Extraction Functions
+% The costs are the wall-clock times per fragment in the profile of generating Dataset (if any), where
+% the feature extraction functions appear in the order of Function_Handles_FFC
+Costs = ones(1,NumHandles);
+button = questdlg('Do you want to take the costs of feature extraction functions from a profile of dataset generation (*.json)?',...
+    'Costs of Feature Extraction Functions','Yes','No','No');
+if isequal(button,'Yes')
+    [FileName,PathName] = uigetfile('*.json','Select Profile of Dataset Generation','MultiSelect','off');
+    if isequal(FileName,0)
+        ErrorMsg = 'Process is aborted. No profile was selected.';
+        return;
+    end
+    try
+        Totals = jsondecode(fileread([PathName FileName]));
+        Totals = Totals.Totals;
+        if ~iscell(Totals)
+            Totals = num2cell(Totals);
+        end
+        Totals = Totals(cellfun(@(x) isfield(x,'Function'),Totals));
+        if length(Totals)~=NumHandles
+            error('The profile and the dataset have different feature extraction functions.');
+        end
+        for i=1:NumHandles
+            Costs(i) = Totals{i}.WallTime/max(Totals{i}.NumFragments,1);
+        end
+    catch
+        ErrorMsg = 'Process is aborted. The selected file is not a proper profile of dataset generation.';
+        return;
+    end
+end
+Order = find(NumSelected>0); % Default stages: one function per stage in ascending order of cost
+[~,idx] = sort(Costs(Order));
+Order = Order(idx);
+
+%% Parameters
+Param_Names = {'Weighting_Method','TVIndex','TV','Stages','Cost_Values','Target_Accuracy'};
+Param_Description = {'Weighting Method (balanced or uniform)',...
+    'Start and End of the Train/Validation in Dataset (1x2 vector with elements 0~1)',...
+    'Train, Tuning, and Held-out Validation Percentages Taken from Dataset (1x3 vector with sum ==100, Train>=60, Tuning>=10, Held-out>=10)',...
+    sprintf('Stages of cascade (cell array; each element is the indices of the feature extraction functions 1~%d which are added in a stage)',NumHandles),...
+    sprintf('Costs of feature extraction functions 1~%d per fragment (1x%d vector with elements >=0)',NumHandles,NumHandles),...
+    'Target accuracy (percent) of the fragments which are classified in each stage before the last stage (0~100)'};
+Default_Value = {'balanced','[0 1]','[70 15 15]',['{' strjoin(arrayfun(@num2str,Order,'UniformOutput',false),',') '}'],...
+    ['[' num2str(Costs,'%g ') ']'],'99'};
+
+switch DecisionModel
+    case 'Decision Tree'
+        Param_Names = [Param_Names 'MinLeafSize'];
+        Param_Description = [Param_Description 'Minimum relative number of leaf node observations to total samples (1e-5~0.1)'];
+        Default_Value = [Default_Value '0.001'];
+
+    case 'Random Forest'
+        Param_Names = [Param_Names 'NumTrees'];
+        Param_Description = [Param_Description 'Value for number of trees in random forest (2~1e4)'];
+        Default_Value = [Default_Value '100'];
+
+        Param_Names = [Param_Names 'MinLeafSize'];
+        Param_Description = [Param_Description 'Value for minimum relative number of leaf node observations to total samples (1e-5~0.1)'];
+        Default_Value = [Default_Value '0.0001'];
+
+    case {'Naive Bayes','Linear Discriminant Analysis (LDA)'}
+        Param_Names = [Param_Names 'feature_scaling_method'];
+        Param_Description = [Param_Description 'The method of feature scaling: z-score, min-max, or no scaling'];
+        Default_Value = [Default_Value 'z-score'];
+
+end
+dlg_title = sprintf('Parameters for Training Cascade of %s',DecisionModel);
+str_cmd = PromptforParameters_text_for_eval_FFC(Param_Names,Param_Description,Default_Value,dlg_title);
+eval(str_cmd);
+
+if ~success
+    ErrorMsg = 'Process is aborted. Parameters are not specified for training cascade.';
+    return;
+end
+
+%% Check Parameters
+[Err,ErrMsg] = Check_Variable_Value_FFC(Weighting_Method,'Weighting Method','possiblevalues',{'balanced','uniform'});
+if Err
+    ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+    return;
+end
+
+[Err,ErrMsg] = Check_Variable_Value_FFC(TVIndex,'Start and End of the Train/Validation in Dataset','type','vector','class','real','size',[1 2],'min',0,'max',1,'issorted','ascend');
+if Err
+    ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+    return;
+end
+
+[Err,ErrMsg] = Check_Variable_Value_FFC(TV,'Train, Tuning, and Held-out Validation Percentages','type','vector','class','real','size',[1 3],'sum',100,'min',0);
+if Err
+    ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+    return;
+end
+
+[Err,ErrMsg] = Check_Variable_Value_FFC(TV(1),'Train Percentage','type','scalar','class','real','min',60);
+if Err
+    ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+    return;
+end
+
+[Err,ErrMsg] = Check_Variable_Value_FFC(TV(2),'Tuning Validation Percentage for cascade','type','scalar','class','real','min',10);
+if Err
+    ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+    return;
+end
+
+[Err,ErrMsg] = Check_Variable_Value_FFC(TV(3),'Held-out Validation Percentage for cascade','type','scalar','class','real','min',10);
+if Err
+    ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+    return;
+end
+
+if ~iscell(Stages) || isempty(Stages) || ~all(cellfun(@(x) isnumeric(x) && ~isempty(x),Stages))
+    ErrorMsg = 'Process is aborted. Stages of cascade should be a cell array of non-empty vectors.';
+    return;
+end
+AllStages = [Stages{:}];
+[Err,ErrMsg] = Check_Variable_Value_FFC(AllStages,'Indices of feature extraction functions in stages','type','vector','class','real','class','integer','min',1,'max',NumHandles);
+if Err
+    ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+    return;
+end
+if length(unique(AllStages))~=length(AllStages)
+    ErrorMsg = 'Process is aborted. Each feature extraction function should appear in at most one stage.';
+    return;
+end
+if any(cellfun(@(x) sum(NumSelected(x)),Stages)==0)
+    ErrorMsg = 'Process is aborted. Each stage should add at least one feature.';
+    return;
+end
+
+[Err,ErrMsg] = Check_Variable_Value_FFC(Cost_Values,'Costs of feature extraction functions','type','vector','class','real','size',[1 NumHandles],'min',0);
+if Err
+    ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+    return;
+end
+
+[Err,ErrMsg] = Check_Variable_Value_FFC(Target_Accuracy,'Target accuracy','type','scalar','class','real','min',0,'max',100);
+if Err
+    ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+    return;
+end
+
+if isequal(exist('MinLeafSize','var'),1)
+    [Err,ErrMsg] = Check_Variable_Value_FFC(MinLeafSize,'Minimum relative number of leaf node observations to total samples','type','scalar','class','real','min',1e-5,'max',0.1);
+    if Err
+        ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+        return;
+    end
+end
+
+if isequal(exist('NumTrees','var'),1)
+    [Err,ErrMsg] = Check_Variable_Value_FFC(NumTrees,'Number of trees in random forest','type','scalar','class','real','class','integer','min',2,'max',1e4);
+    if Err
+        ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+        return;
+    end
+end
+
+if isequal(exist('feature_scaling_method','var'),1)
+    [Err,ErrMsg] = Check_Variable_Value_FFC(feature_scaling_method,'The method of feature scaling','possiblevalues',{'z-score','min-max','no scaling'});
+    if Err
+        ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+        return;
+    end
+end
+
+%% Get filename for saving the cascade
+FullFileName = ['Cascade_' matlab.lang.makeValidName(DecisionModel) '.mat'];
+[Filename,path] = uiputfile('*.mat','Save Cascade of Decision Machines As',FullFileName);
+if isequal(Filename,0)
+    ErrorMsg = 'Process is aborted. No file was selected by user for saving the cascade.';
+    return;
+end
+[~,name] = fileparts(Filename);
+
+%% ###################################################################################################
+%% --------------------------------------------------------------------------------------------------#
+%% -------------------------------------- Function Main Body ----------------------------------------#
+%% --------------------------------------------------------------------------------------------------#
+%% ###################################################################################################
+
+%% Select training, tuning, and held-out validation samples
+% VIndex is used for training the stages and determining the thresholds, and HIndex is used only for reporting
+Bounds = TVIndex(1)+(TVIndex(2)-TVIndex(1))*cumsum([0 TV/sum(TV)]);
+[ErrorMsg,TIndex,VIndex,HIndex] = Partition_Dataset_FFC(Dataset_FFC(:,end-1:end),ClassLabels_FFC,...
+    {[Bounds(1) Bounds(2)],[Bounds(2) Bounds(3)],[Bounds(3) Bounds(4)]},[true true true]);
+if ~isempty(ErrorMsg)
+    return;
+end
+
+%% Assign Weights to Samples
+Weights = Assign_Weights_FFC(Dataset_FFC(:,end-1),ClassLabels_FFC,Weighting_Method);
+
+%% Train Stages
+S = length(Stages);
+StageCosts = cellfun(@(x) sum(Cost_Values(x)),Stages);
+StageScores = cell(1,S); % Scores of tuning samples for stages
+HeldOutScores = cell(1,S); % Scores of held-out samples for stages
+StagePc = zeros(1,S); % Held-out accuracy of stages
+StageFiles = cell(1,S);
+progressbar_FFC('Training Stages of Cascade');
+for s=1:S
+
+    % View of the features of stages 1,...,s (the samples are not copied)
+    Handles = [Stages{1:s}];
+    FeatureIndex = [Cols{Handles}];
+    FeatureLabels = FeatureLabels_FFC(FeatureIndex);
+    Dataset = Subset_DatasetView_FFC(Dataset_FFC,':',FeatureIndex);
+
+    % Scaling Features
+    TrainingParameters = struct;
+    switch DecisionModel
+        case {'Naive Bayes','Linear Discriminant Analysis (LDA)'}
+            [Dataset,Scaling_Parameters] = Scale_Features_FFC(Dataset,feature_scaling_method,[],[TIndex ; VIndex]);
+            TrainingParameters.Scaling_Parameters = Scaling_Parameters;
+            TrainingParameters.feature_scaling_method = feature_scaling_method;
+
+        case {'Decision Tree','Random Forest'}
+
+    end
+
+    % Build and validate decision machine of stage
+    switch DecisionModel
+        case 'Decision Tree'
+            [DM,DM_CL] = Build_DecisionTree_FFC(Dataset,ClassLabels_FFC,FeatureLabels,Weights,TIndex,VIndex,MinLeafSize,0);
+            [~,~,~,~,StageScores{s}] = Test_DecisionTree_FFC(DM,Dataset,VIndex,ClassLabels_FFC,ClassLabels_FFC,FeatureLabels,FeatureLabels,Weights);
+            [~,StagePc(s),~,~,HeldOutScores{s}] = Test_DecisionTree_FFC(DM,Dataset,HIndex,ClassLabels_FFC,ClassLabels_FFC,FeatureLabels,FeatureLabels,Weights);
+
+        case 'Random Forest'
+            DM = [];
+            DM_CL = Build_RandomForest_FFC([],Dataset,ClassLabels_FFC,FeatureLabels,Weights,TIndex,VIndex,NumTrees,MinLeafSize);
+            [~,~,~,~,StageScores{s}] = Test_RandomForest_FFC(DM_CL,Dataset,VIndex,ClassLabels_FFC,ClassLabels_FFC,FeatureLabels,FeatureLabels,Weights);
+            [~,StagePc(s),~,~,HeldOutScores{s}] = Test_RandomForest_FFC(DM_CL,Dataset,HIndex,ClassLabels_FFC,ClassLabels_FFC,FeatureLabels,FeatureLabels,Weights);
+
+        case 'Naive Bayes'
+            [DM,DM_CL] = Build_NaiveBayes_FFC(Dataset,ClassLabels_FFC,FeatureLabels,Weights,TIndex,VIndex);
+            [~,~,~,~,StageScores{s}] = Test_NaiveBayes_FFC(DM,Dataset,VIndex,ClassLabels_FFC,ClassLabels_FFC,FeatureLabels,FeatureLabels,Weights);
+            [~,StagePc(s),~,~,HeldOutScores{s}] = Test_NaiveBayes_FFC(DM,Dataset,HIndex,ClassLabels_FFC,ClassLabels_FFC,FeatureLabels,FeatureLabels,Weights);
+
+        case 'Linear Discriminant Analysis (LDA)'
+            DM = [];
+            DM_CL = Build_LDA_FFC(Dataset,ClassLabels_FFC,FeatureLabels,Weights,TIndex,VIndex);
+            [~,~,~,~,StageScores{s}] = Test_LDA_FFC(DM_CL,Dataset,VIndex,ClassLabels_FFC,ClassLabels_FFC,FeatureLabels,FeatureLabels,Weights);
+            [~,StagePc(s),~,~,HeldOutScores{s}] = Test_LDA_FFC(DM_CL,Dataset,HIndex,ClassLabels_FFC,ClassLabels_FFC,FeatureLabels,FeatureLabels,Weights);
+    end
+
+    % Export decision machine of stage
+    TrainingParameters.Type = DecisionModel;
+    StageFiles{s} = sprintf('%s_Stage%d.dmb',name,s);
+    ErrorMsg = Export_DecisionMachine_FFC([path StageFiles{s}],TrainingParameters,DM,DM_CL,ClassLabels_FFC,FeatureLabels,...
+        Function_Handles_FFC(Handles),Function_Labels_FFC(Handles),Function_Select_FFC(Handles),[]);
+    if ~isempty(ErrorMsg)
+        progressbar_FFC(1,1);
+        ErrorMsg = sprintf('Process is aborted. Stage %d cannot be exported. %s',s,ErrorMsg);
+        return;
+    end
+
+    % progress indication
+    stopbar = progressbar_FFC(1,s/S);
+    if stopbar
+        ErrorMsg = 'Process is aborted by user.';
+        return;
+    end
+
+end
+
+%% Determine Thresholds
+% The threshold of each stage is the smallest threshold for which the accuracy of the tuning samples
+% that leave the cascade at that stage is not less than Target_Accuracy.
+TrueLabels = Dataset_FFC(VIndex,end-1);
+W = Weights(VIndex);
+Thresholds = zeros(1,S);
+Remain = true(length(VIndex),1);
+for s=1:S-1
+    [Confidence,Label] = max(StageScores{s},[],2);
+    Correct = Label==TrueLabels;
+    Candidates = unique(Confidence(Remain));
+    Thresholds(s) = inf;
+    for t=Candidates'
+        Leave = Remain & Confidence>=t;
+        if 100*sum(W(Leave & Correct))/sum(W(Leave))>=Target_Accuracy
+            Thresholds(s) = t;
+            break;
+        end
+    end
+    Remain = Remain & Confidence<Thresholds(s);
+end
+
+%% Accuracy versus Mean Cost
+% Cascades with the determined thresholds, with common thresholds for all stages, and the single stages
+% (on the held-out samples, which are not used for determining the thresholds)
+TrueLabels = Dataset_FFC(HIndex,end-1);
+W = Weights(HIndex);
+Common_Thresholds = [0.5:0.05:0.95 0.99 1];
+TradeOff.Thresholds = [Thresholds ; repmat(Common_Thresholds',1,S)];
+NumCases = size(TradeOff.Thresholds,1);
+TradeOff.Pc = zeros(NumCases,1);
+TradeOff.MeanCost = zeros(NumCases,1);
+TradeOff.StageFraction = zeros(NumCases,S);
+for k=1:NumCases
+    [TradeOff.Pc(k),TradeOff.MeanCost(k),TradeOff.StageFraction(k,:)] = Evaluate_Cascade_FFC(HeldOutScores,TrueLabels,W,TradeOff.Thresholds(k,:),StageCosts);
+end
+TradeOff.StagePc = StagePc;
+TradeOff.StageCumulativeCosts = cumsum(StageCosts);
+
+%% Save Cascade
+Cascade.ClassLabels = ClassLabels_FFC;
+Cascade.StageFiles = StageFiles;
+Cascade.Stages = Stages;
+Cascade.StageCosts = StageCosts;
+Cascade.Thresholds = Thresholds;
+Cascade.TradeOff = TradeOff;
+Cascade.DM_Type = DecisionModel;
+Cascade.DatasetName = get(Dataset_FFC_Name_TextBox,'String'); % The name of the employed Dataset
+save([path Filename],'Cascade','-v7.3');
+
+%% Show Accuracy versus Mean Cost
+GUI_MainEditBox_Update_FFC(false,sprintf('Cascade of %d stages (%s) is saved in %s.',S,DecisionModel,Filename));
+GUI_MainEditBox_Update_FFC(false,'Held-out validation accuracy and cumulative cost of single stages:');
+for s=1:S
+    GUI_MainEditBox_Update_FFC(false,sprintf('    Stage %d (functions %s): Pc = %.2f%%, Cost = %.4g',s,mat2str(Stages{s}),StagePc(s),TradeOff.StageCumulativeCosts(s)));
+end
+GUI_MainEditBox_Update_FFC(false,'Held-out validation accuracy versus mean cost of cascade:');
+for k=1:NumCases
+    if k==1
+        str = 'Determined thresholds';
+    else
+        str = sprintf('Common threshold %.2f',Common_Thresholds(k-1));
+    end
+    GUI_MainEditBox_Update_FFC(false,sprintf('    %-24s Pc = %.2f%%, Mean Cost = %.4g (%.1f%% of last stage), Classified at Stages = %s',...
+        str,TradeOff.Pc(k),TradeOff.MeanCost(k),100*TradeOff.MeanCost(k)/TradeOff.StageCumulativeCosts(S),mat2str(round(1000*TradeOff.StageFraction(k,:))/1000)));
+end
+GUI_MainEditBox_Update_FFC(false,'The process is completed successfully.');
@@ -28,6 +28,11 @@ function ErrorMsg = Script_DecisionMachine_CrossValidation_FFC
 % 2020-Oct-19   filename for saving the results is prompted before the process begins  
 % 2021-Jan-15   The Nodes output in decision tree was removed for 
 %               compatibility with other MATLAB releases.
+% 2026-Oct-18   the nearest neighbor indices of ensemble kNNs are reused along the number of learners
+%               (DM_Index is kept by CrossValidation_Job_FFC)
+% 2026-Oct-18   (fold, tuning parameters) jobs are run on the parallel pool (if any) with a shared copy of dataset,
+%               and ensemble kNNs are grown along the number of learners (see CrossValidation_Job_FFC)
+% 2026-Oct-18   without an open parallel pool, the jobs are run in the client (no pool is started)
 
 %% Initialization
 global Dataset_FFC
@@ -123,6 +128,10 @@ switch DecisionModel
         Param_Names = [Param_Names 'NumNeighbors_Values'];
         Param_Description = [Param_Description 'Different values for number of nearest neighbors for classifying each point (1~50)'];
         Default_Value = [Default_Value '(1:2:7)'];
+
+        Param_Names = [Param_Names 'SearchEpsilon'];
+        Param_Description = [Param_Description 'Relative error bound of the nearest neighbor search (>=0, 0 for exact search)'];
+        Default_Value = [Default_Value '0'];
         
     case {'Naive Bayes','Linear Discriminant Analysis (LDA)'}
         Param_Names = [Param_Names 'feature_scaling_method'];
@@ -272,6 +281,14 @@ if isequal(exist('NumNeighbors_Values','var'),1)
     end
 end
 
+if isequal(exist('SearchEpsilon','var'),1)
+    [Err,ErrMsg] = Check_Variable_Value_FFC(SearchEpsilon,'Relative error bound of the nearest neighbor search','type','scalar','class','real','min',0);
+    if Err
+        ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+        return;
+    end
+end
+
 if isequal(exist('hiddenSize_Values','var'),1)
     [Err,ErrMsg] = Check_Variable_Value_FFC(hiddenSize_Values,'Dimension of hidden layer','type','vector','class','real','class','integer','min',1,'max',length(FeatureLabels_FFC));
     if Err
@@ -311,61 +328,127 @@ TV = cumsum([0 TV]);
 %% Assign Weights
 Weights = Assign_Weights_FFC(Dataset_FFC(:,end-1),ClassLabels_FFC,Weighting_Method);
 
-%% Initialize Progressbar
-switch DecisionModel
-    case 'Decision Tree'
-        progressbar_FFC('Loop over Tuning Parameter','Loop over K Folds','Training Decision Tree');
-        
-    case 'SVM'
-        progressbar_FFC('Loop over Tuning Parameters','Loop over K Folds','Training Multi-Class SVM Model');
-        
-    case {'Random Forest','Ensemble kNN','Neural Network'}
-        progressbar_FFC('Loop over Tuning Parameters','Loop over K Folds');
-        
-    case {'Naive Bayes','Linear Discriminant Analysis (LDA)'}
-        progressbar_FFC('Loop over K Folds');
-        
-end
-
 %% Prepare Tuning Parameter
+% Tune(i) is the i-th tuning parameter. Each element of Chains is a chain of tuning parameters that are trained 
+% in one job for each fold. For random forests and ensemble kNNs, each row of the grid is a chain (ascending number of
+% trees or learners), so that the model of each tuning parameter is grown from the model of the previous one.
 switch DecisionModel
     case 'Decision Tree'
         L_Tune = length(MinLeafSize_Values);
+        Tune = struct('MinLeafSize',num2cell(MinLeafSize_Values(:)'));
+        Chains = num2cell(1:L_Tune);
         
     case 'SVM'
         [S_values,C_values] = meshgrid(KernelScale_values,BoxConstraint_values);
         L_Tune = numel(S_values);
+        Tune = struct('KernelScale',num2cell(S_values(:)'),'BoxConstraint',num2cell(C_values(:)'));
+        Chains = num2cell(1:L_Tune);
         
     case 'Random Forest'
         [NT_values,MLS_values] = meshgrid(sort(NumTrees_Values),MinLeafSize_Values);
         L_Tune = numel(NT_values);
-        
-        DM = cell(size(NT_values,1),size(NT_values,2),K); % Initial Random Forests
-        Trees_Total = sum(sum(diff([zeros(size(NT_values,1),1) NT_values],1,2))); % Total Number of Trees for each fold
-        Trees_Cnt = 0;
+        Tune = struct('NumTrees',num2cell(NT_values(:)'),'MinLeafSize',num2cell(MLS_values(:)'));
+        Chains = num2cell(reshape(1:L_Tune,size(NT_values)),2)';
         
     case 'Ensemble kNN'
         [NL_values,NN_values] = meshgrid(sort(NumLearners_Values),NumNeighbors_Values);
         L_Tune = numel(NL_values);
-        
-        DM = cell(size(NL_values,1),size(NL_values,2),K); % Initial kNNs
-        kNNs_Total = sum(sum(diff([zeros(size(NL_values,1),1) NL_values],1,2))); % Total Number of Trees for each fold
-        kNNs_Cnt = 0;
+        Tune = struct('NumLearners',num2cell(NL_values(:)'),'NumNeighbors',num2cell(NN_values(:)'));
+        Chains = num2cell(reshape(1:L_Tune,size(NL_values)),2)';
         
     case {'Naive Bayes','Linear Discriminant Analysis (LDA)'}
         L_Tune = 1;
+        Tune = struct();
+        Chains = {1};
         
     case 'Neural Network'
-        L_Tune = length(hiddenSize_Values);        
+        L_Tune = length(hiddenSize_Values);
+        Tune = struct('hiddenSize',num2cell(hiddenSize_Values(:)'));
+        Chains = num2cell(1:L_Tune);
         
 end
 
-%% K-Fold Cross-Validation
+% Parameters which are not tuned
+Prms = struct('Weighting_Method',Weighting_Method,'feature_scaling_method','no scaling',...
+    'KernelFunction','','PolynomialOrder',[],'NumFeatures',[],'SearchEpsilon',0);
+if isequal(exist('feature_scaling_method','var'),1)
+    Prms.feature_scaling_method = feature_scaling_method;
+end
+if isequal(exist('KernelFunction','var'),1)
+    Prms.KernelFunction = KernelFunction;
+    Prms.PolynomialOrder = PolynomialOrder;
+end
+if isequal(exist('NumFeatures','var'),1)
+    Prms.NumFeatures = NumFeatures;
+    Prms.SearchEpsilon = SearchEpsilon;
+end
+
+%% K-Fold Partitioning into Train, Validation and Test
+% The partitions of each fold are determined once and shared by all tuning parameters
 AllIndex = [];
 for j=1:K
     AllIndex = union(AllIndex,KFoldsIdx{j});
 end
 
+Folds = struct('TestIndex',cell(1,K),'TrainValidationIndex',[],'TIndex',[],'VIndex',[]);
+for j=1:K
+    TestIndex = KFoldsIdx{j};
+    TrainValidationIndex = setdiff(AllIndex,TestIndex);
+    [ErrorMsg,TIndex,VIndex] = Partition_Dataset_FFC(Dataset_FFC(TrainValidationIndex,end-1:end),ClassLabels_FFC,{[TV(1) TV(2)],[TV(2) TV(3)]},PartitionGenerateError);
+    if ~isempty(ErrorMsg)
+        return;
+    end
+    Folds(j).TestIndex = TestIndex;
+    Folds(j).TrainValidationIndex = TrainValidationIndex;
+    Folds(j).TIndex = TrainValidationIndex(TIndex);
+    Folds(j).VIndex = TrainValidationIndex(VIndex);
+end
+
+%% K-Fold Cross-Validation Jobs
+% Each job trains and tests a chain of tuning parameters on a fold. The jobs are run on the parallel pool 
+% (if any) in waves, and the progressbar is updated between the waves. Without an open pool, NumWorkers
+% is zero and the parfor loops are run in the client (a pool is not started automatically).
+[JobFold,JobChain] = ndgrid(1:K,1:length(Chains));
+NumJobs = numel(JobFold);
+
+% Read-only copy of dataset shared by the jobs of each worker
+ClassLabels = ClassLabels_FFC;
+FeatureLabels = FeatureLabels_FFC;
+SharedDataset = Dataset_FFC;
+NumWorkers = 0;
+try
+    Pool = gcp('nocreate');
+    if ~isempty(Pool)
+        NumWorkers = Pool.NumWorkers;
+        SharedDataset = parallel.pool.Constant(Dataset_FFC);
+    end
+catch
+    % Parallel Computing Toolbox is not available. The jobs are run one by one.
+end
+WaveSize = max(1,2*NumWorkers);
+
+progressbar_FFC(sprintf('Cross-Validation Jobs (%d Folds x %d Chains of Tuning Parameters)',K,length(Chains)));
+JobResults = cell(1,NumJobs);
+for w=1:WaveSize:NumJobs
+    Wave = w:min(w+WaveSize-1,NumJobs);
+    WaveResults = cell(1,length(Wave));
+    parfor (n=1:length(Wave),NumWorkers)
+        q = Wave(n);
+        WaveResults{n} = CrossValidation_Job_FFC(SharedDataset,ClassLabels,FeatureLabels,Weights,...
+            Folds(JobFold(q)),DecisionModel,Prms,Tune(Chains{JobChain(q)}));
+    end
+    JobResults(Wave) = WaveResults;
+    
+    % progress indication
+    stopbar = progressbar_FFC(1,Wave(end)/NumJobs);
+    if stopbar
+        ErrorMsg = 'Process is aborted by user.';
+        return;
+    end
+end
+clear SharedDataset
+
+%% Collect Results of Jobs
 M = length(ClassLabels_FFC);
 
 % Predicted Labels and Scores for all data over various tuning parameters
@@ -384,223 +467,38 @@ Pc_Validation_Tune = repmat({0},1,L_Tune);
 ConfusionMatrix_Tune = repmat({zeros(M,M)},1,L_Tune);
 Pc_Tune = repmat({0},1,L_Tune);
 
-for i=1:L_Tune % Loop over Tuning Parameter
-    
-    % progress indication
-    switch DecisionModel
-        case {'Decision Tree','SVM','Random Forest','Ensemble kNN','Neural Network'}
-            stopbar = progressbar_FFC(2,eps);
-            if stopbar
-                ErrorMsg = 'Process is aborted by user.';
-                return;
-            end
-            
-        case {'Naive Bayes','Linear Discriminant Analysis (LDA)'}
-            
-    end
-    
-    for j=1:K % Loop over K Folds
-        
-        % Train and Test Index
-        TestIndex = KFoldsIdx{j};
-        TrainValidationIndex = setdiff(AllIndex,TestIndex);
-        [ErrorMsg,TIndex,VIndex] = Partition_Dataset_FFC(Dataset_FFC(TrainValidationIndex,end-1:end),ClassLabels_FFC,{[TV(1) TV(2)],[TV(2) TV(3)]},PartitionGenerateError);
-        if ~isempty(ErrorMsg)
-            progressbar_FFC(1,1);
-            return;
-        end
-        
-        % Scaling Features
-        Dataset = Dataset_FFC;
-        switch DecisionModel
-            case {'SVM','Ensemble kNN','Naive Bayes','Linear Discriminant Analysis (LDA)','Neural Network'}
-                Dataset = zeros(size(Dataset_FFC));
-                [Dataset(TrainValidationIndex,:),Scaling_Parameters] = Scale_Features_FFC(Dataset_FFC(TrainValidationIndex,:),feature_scaling_method);
-                Dataset(TestIndex,:) = Scale_Features_FFC(Dataset_FFC(TestIndex,:),Scaling_Parameters);
-                
-            case {'Decision Tree','Random Forest'}                
-                
-        end
-        
-        % Train Decision Model
-        switch DecisionModel
-            case 'Decision Tree'
-                
-                % Build Decision Trees
-                [DM,~,Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp,stopbar] = ...
-                    Build_DecisionTree_FFC(Dataset,ClassLabels_FFC,FeatureLabels_FFC,Weights,TrainValidationIndex(TIndex),TrainValidationIndex(VIndex),MinLeafSize_Values(i),3);
-                if stopbar
-                    ErrorMsg = 'Process is aborted by user.';
-                    return;
-                end
-                
-            case 'SVM'
-                
-                % Build SVM Model
-                [DM,~,Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp,~,~,~,~,stopbar] = ...
-                    Build_MultiClassSVM_FFC(Dataset,ClassLabels_FFC,FeatureLabels_FFC,...
-                    Weights,Weighting_Method,TrainValidationIndex(TIndex),TrainValidationIndex(VIndex),...
-                    KernelFunction,PolynomialOrder,S_values(i),C_values(i),3);
-                if stopbar
-                    ErrorMsg = 'Process is aborted by user.';
-                    return;
-                end
-                
-            case 'Random Forest'
-                
-                % Build Random Forest
-                [I_idx,J_idx] = ind2sub(size(NT_values),i);
-                
-                if J_idx==1 % Train Initial Random Forest
-                    [DM{I_idx,J_idx,j},Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp] = ...
-                        Build_RandomForest_FFC([],Dataset,ClassLabels_FFC,FeatureLabels_FFC,Weights,TrainValidationIndex(TIndex),TrainValidationIndex(VIndex),...
-                        NT_values(i),MLS_values(i));
-                    
-                    Trees_Cnt = Trees_Cnt+(j==1)*NT_values(i);
-                    
-                else % Train Additional Trees
-                    [DM{I_idx,J_idx,j},Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp] = Build_RandomForest_FFC(DM{I_idx,J_idx-1,j},Dataset,ClassLabels_FFC,FeatureLabels_FFC,Weights,TrainValidationIndex(TIndex),TrainValidationIndex(VIndex),...
-                        NT_values(I_idx,J_idx)-NT_values(I_idx,J_idx-1),MLS_values(i));
-                    
-                    Trees_Cnt = Trees_Cnt+(j==1)*(NT_values(I_idx,J_idx)-NT_values(I_idx,J_idx-1));
-                end
-                
-            case 'Ensemble kNN'
-                
-                [I_idx,J_idx] = ind2sub(size(NL_values),i);
-                
-                % Build kNN Model
-                if J_idx==1 % Train Initial ensemble kNN
-                    [DM{I_idx,J_idx,j},Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp] = Build_EnsemblekNN_FFC([],Dataset,ClassLabels_FFC,FeatureLabels_FFC,Weights,TrainValidationIndex(TIndex),TrainValidationIndex(VIndex),...
-                        NL_values(i),NumFeatures,NN_values(i));
-                    
-                    kNNs_Cnt = kNNs_Cnt+(j==1)*NL_values(i);
-                    
-                else % Train Additional kNNs
-                    [DM{I_idx,J_idx,j},Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp] = Build_EnsemblekNN_FFC(DM{I_idx,J_idx,j},Dataset,ClassLabels_FFC,FeatureLabels_FFC,Weights,TrainValidationIndex(TIndex),TrainValidationIndex(VIndex),...
-                        NL_values(I_idx,J_idx)-NL_values(I_idx,J_idx-1),NumFeatures,NN_values(i));
-                    
-                    kNNs_Cnt = kNNs_Cnt+(j==1)*(NL_values(I_idx,J_idx)-NL_values(I_idx,J_idx-1));
-                end
-                
-            case 'Naive Bayes'
-                [DM,~,Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp] = Build_NaiveBayes_FFC(Dataset,ClassLabels_FFC,FeatureLabels_FFC,Weights,TrainValidationIndex(TIndex),TrainValidationIndex(VIndex));
-                
-            case 'Linear Discriminant Analysis (LDA)'
-                [DM,Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp] = Build_LDA_FFC(Dataset,ClassLabels_FFC,FeatureLabels_FFC,Weights,TrainValidationIndex(TIndex),TrainValidationIndex(VIndex));
-                
-            case 'Neural Network'
-                [DM,Pc_tmp,ConfusionMatrix_tmp,Pc_Train_tmp,ConfusionMatrix_Train_tmp] = Build_PatternRecognitionNeuralNetwork_FFC(Dataset,ClassLabels_FFC,FeatureLabels_FFC,Weights,TrainValidationIndex(TIndex)',TrainValidationIndex(VIndex)',hiddenSize_Values(i));
-        end
+for q=1:NumJobs
+    j = JobFold(q);
+    Chain = Chains{JobChain(q)};
+    for n=1:length(Chain)
+        i = Chain(n);
+        R = JobResults{q}(n);
         
         % Update Training Results
-        ConfusionMatrix_Train_Tune{i} = ConfusionMatrix_Train_Tune{i}+Scale_ConfusionMatrix_FFC(ConfusionMatrix_Train_tmp);
-        Pc_Train_Tune{i} = Pc_Train_Tune{i}+Pc_Train_tmp;
+        ConfusionMatrix_Train_Tune{i} = ConfusionMatrix_Train_Tune{i}+Scale_ConfusionMatrix_FFC(R.ConfusionMatrix_Train);
+        Pc_Train_Tune{i} = Pc_Train_Tune{i}+R.Pc_Train;
         
         % Update Validation Results
-        ConfusionMatrix_Validation_Tune{i} = ConfusionMatrix_Validation_Tune{i}+Scale_ConfusionMatrix_FFC(ConfusionMatrix_tmp);
-        Pc_Validation_Tune{i} = Pc_Validation_Tune{i}+Pc_tmp;
-        
-        % Evaluate the performance of the final decision machine on the test set
-        switch DecisionModel
-            case 'Decision Tree'
-                
-                % Test Decision Tree
-                [~,Pc_tmp,ConfusionMatrix_tmp,PLabel_tmp,Sc_tmp] = Test_DecisionTree_FFC(DM,Dataset,TestIndex,ClassLabels_FFC,ClassLabels_FFC,FeatureLabels_FFC,FeatureLabels_FFC,Weights);
-                
-            case 'SVM'
-                
-                % Test SVM Model
-                [~,Pc_tmp,ConfusionMatrix_tmp,Sc_tmp,PLabel_tmp] = ...
-                    Test_MultiClassSVM_FFC(DM,Dataset,TestIndex,ClassLabels_FFC,ClassLabels_FFC,FeatureLabels_FFC,FeatureLabels_FFC,Weights);
-                
-            case 'Random Forest'
-                
-                % Test Random Forest
-                [~,Pc_tmp,ConfusionMatrix_tmp,PLabel_tmp,Sc_tmp] = Test_RandomForest_FFC(DM{I_idx,J_idx,j},Dataset,TestIndex,...
-                    ClassLabels_FFC,ClassLabels_FFC,FeatureLabels_FFC,FeatureLabels_FFC,Weights);
-                
-            case 'Ensemble kNN'
-                
-                % Test Ensemble SVM
-                [~,Pc_tmp,ConfusionMatrix_tmp,PLabel_tmp,Sc_tmp] = Test_EnsemblekNN_FFC(DM{I_idx,J_idx,j},Dataset,TestIndex,...
-                    ClassLabels_FFC,ClassLabels_FFC,FeatureLabels_FFC,FeatureLabels_FFC,Weights);
-                
-            case 'Naive Bayes'
-                [~,Pc_tmp,ConfusionMatrix_tmp,PLabel_tmp,Sc_tmp] = Test_NaiveBayes_FFC(DM,Dataset,TestIndex,...
-                    ClassLabels_FFC,ClassLabels_FFC,FeatureLabels_FFC,FeatureLabels_FFC,Weights);
-                
-            case 'Linear Discriminant Analysis (LDA)'
-                [~,Pc_tmp,ConfusionMatrix_tmp,PLabel_tmp,Sc_tmp] = Test_LDA_FFC(DM,Dataset,TestIndex,...
-                    ClassLabels_FFC,ClassLabels_FFC,FeatureLabels_FFC,FeatureLabels_FFC,Weights);                
-                
-            case 'Neural Network'
-                [~,Pc_tmp,ConfusionMatrix_tmp,PLabel_tmp,Sc_tmp] = Test_PatternRecognitionNeuralNetwork_FFC(DM,Dataset,TestIndex,...
-                    ClassLabels_FFC,ClassLabels_FFC,FeatureLabels_FFC,FeatureLabels_FFC,Weights);                
-        end
-        
+        ConfusionMatrix_Validation_Tune{i} = ConfusionMatrix_Validation_Tune{i}+Scale_ConfusionMatrix_FFC(R.ConfusionMatrix_Validation);
+        Pc_Validation_Tune{i} = Pc_Validation_Tune{i}+R.Pc_Validation;
         
         % Update Test Results
-        ConfusionMatrix_Tune{i} = ConfusionMatrix_Tune{i}+Scale_ConfusionMatrix_FFC(ConfusionMatrix_tmp);
-        Pc_Tune{i} = Pc_Tune{i}+Pc_tmp;
-        PredictedLabels_Tune{i}(TestIndex) = PLabel_tmp;
-        Scores_Tune{i}(TestIndex,:) = Sc_tmp;
-        
-        % progress indication
-        switch DecisionModel
-            case {'Decision Tree','SVM','Random Forest','Ensemble kNN','Neural Network'}
-                stopbar = progressbar_FFC(2,j/K);
-                if stopbar
-                    ErrorMsg = 'Process is aborted by user.';
-                    return;
-                end
-                
-            case {'Naive Bayes','Linear Discriminant Analysis (LDA)'}
-                stopbar = progressbar_FFC(1,j/K);
-                if stopbar
-                    ErrorMsg = 'Process is aborted by user.';
-                    return;
-                end
-        end
-        
+        ConfusionMatrix_Tune{i} = ConfusionMatrix_Tune{i}+Scale_ConfusionMatrix_FFC(R.ConfusionMatrix);
+        Pc_Tune{i} = Pc_Tune{i}+R.Pc;
+        PredictedLabels_Tune{i}(Folds(j).TestIndex) = R.PredictedLabels;
+        Scores_Tune{i}(Folds(j).TestIndex,:) = R.Scores;
     end
-    
-    % Update Training, Validtion and Test Results
+end
+clear JobResults
+
+% Average of Training, Validtion and Test Results over K Folds
+for i=1:L_Tune
     ConfusionMatrix_Train_Tune{i} = ConfusionMatrix_Train_Tune{i}/K;
     Pc_Train_Tune{i} = Pc_Train_Tune{i}/K;
     ConfusionMatrix_Validation_Tune{i} = ConfusionMatrix_Validation_Tune{i}/K;
     Pc_Validation_Tune{i} = Pc_Validation_Tune{i}/K;
     ConfusionMatrix_Tune{i} = ConfusionMatrix_Tune{i}/K;
     Pc_Tune{i} = Pc_Tune{i}/K;
-    
-    % progress indication
-    switch DecisionModel
-        
-        case 'Random Forest'
-            stopbar = progressbar_FFC(1,Trees_Cnt/Trees_Total);
-            if stopbar
-                ErrorMsg = 'Process is aborted by user.';
-                return;
-            end
-            
-        case 'Ensemble kNN'
-            stopbar = progressbar_FFC(1,kNNs_Cnt/kNNs_Total);
-            if stopbar
-                ErrorMsg = 'Process is aborted by user.';
-                return;
-            end
-            
-        case {'Decision Tree','SVM','Neural Network'}
-            stopbar = progressbar_FFC(1,i/L_Tune);
-            if stopbar
-                ErrorMsg = 'Process is aborted by user.';
-                return;
-            end
-            
-        case {'Naive Bayes','Linear Discriminant Analysis (LDA)'}
-            
-    end
-    
 end
 
 %% Find the best tuning parameter and set corresponding cross-validation result
@@ -674,6 +572,7 @@ switch DecisionModel
         CV_Parameters.NumFeatures = NumFeatures;
         CV_Parameters.NumLearners_MeshGrid = NL_values;
         CV_Parameters.NumNeighbors_MeshGrid = NN_values;
+        CV_Parameters.SearchEpsilon = SearchEpsilon;
         CV_Results.BestNumLearners = NL_values(idx);
         CV_Results.BestNumNeighbors = NN_values(idx);
         
@@ -25,12 +25,14 @@ function ErrorMsg = Script_DecisionMachine_Train_FFC
 % 2020-Mar-03   function was created
 % 2020-Oct-19   filename for saving the results is prompted before the process begins  
 % 2021-Jan-03   DM_Feature_Transfrom_FFC was included
+% 2026-Oct-18   the nearest neighbor index of ensemble kNN is saved as DecisionMachine
+% 2026-Oct-18   scaling parameters are determined from the statistics of features if all samples are used
 
 %% Initialization
 global ClassLabels_FFC FeatureLabels_FFC Dataset_FFC
 global Function_Handles_FFC Function_Labels_FFC Function_Select_FFC
 global Dataset_FFC_Name_TextBox
-global Feature_Transfrom_FFC
+global Feature_Transfrom_FFC FeatureStats_FFC
 
 %% Check that Dataset is generated/loaded
 if isempty(Dataset_FFC)
@@ -113,6 +115,10 @@ switch DecisionModel
         Param_Names = [Param_Names 'NumNeighbors'];
         Param_Description = [Param_Description 'Number of nearest neighbors for classifying each point (1~50)'];
         Default_Value = [Default_Value '5'];
+
+        Param_Names = [Param_Names 'SearchEpsilon'];
+        Param_Description = [Param_Description 'Relative error bound of the nearest neighbor search (>=0, 0 for exact search)'];
+        Default_Value = [Default_Value '0'];
         
     case {'Naive Bayes','Linear Discriminant Analysis (LDA)'}
         Param_Names = [Param_Names 'feature_scaling_method'];
@@ -254,6 +260,14 @@ if isequal(exist('NumNeighbors','var'),1)
     end
 end
 
+if isequal(exist('SearchEpsilon','var'),1)
+    [Err,ErrMsg] = Check_Variable_Value_FFC(SearchEpsilon,'Relative error bound of the nearest neighbor search','type','scalar','class','real','min',0);
+    if Err
+        ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+        return;
+    end
+end
+
 if isequal(exist('hiddenSize','var'),1)
     [Err,ErrMsg] = Check_Variable_Value_FFC(hiddenSize,'Dimension of hidden layer','type','scalar','class','real','class','integer','min',1,'max',length(FeatureLabels_FFC));
     if Err
@@ -294,7 +308,13 @@ end
 Dataset = Dataset_FFC;
 switch DecisionModel
     case {'SVM','Ensemble kNN','Naive Bayes','Linear Discriminant Analysis (LDA)','Neural Network'}
-        [Dataset([TIndex ; VIndex],:),Scaling_Parameters] = Scale_Features_FFC(Dataset_FFC([TIndex ; VIndex],:),feature_scaling_method);
+        % The statistics of features describe all samples of dataset
+        if length(TIndex)+length(VIndex)==size(Dataset_FFC,1)
+            FeatureStats = FeatureStats_FFC;
+        else
+            FeatureStats = [];
+        end
+        [Dataset([TIndex ; VIndex],:),Scaling_Parameters] = Scale_Features_FFC(Dataset_FFC([TIndex ; VIndex],:),feature_scaling_method,FeatureStats);
         
     case {'Decision Tree','Random Forest'}
         
@@ -356,8 +376,8 @@ switch DecisionModel
         for i=1:ceil(NumLearners/MinPrg)
             
             NumLearners_i = min(MinPrg,NumLearners-CntPrg);
-            [DM_CL,Pc,ConfusionMatrix,Pc_Train,ConfusionMatrix_Train] = Build_EnsemblekNN_FFC(DM_CL,Dataset,ClassLabels_FFC,FeatureLabels_FFC,Weights,TIndex,VIndex,...
-                NumLearners_i,NumFeatures,NumNeighbors);            
+            [DM_CL,Pc,ConfusionMatrix,Pc_Train,ConfusionMatrix_Train,DM] = Build_EnsemblekNN_FFC(DM_CL,Dataset,ClassLabels_FFC,FeatureLabels_FFC,Weights,TIndex,VIndex,...
+                NumLearners_i,NumFeatures,NumNeighbors,DM,SearchEpsilon);            
             
             % progress indication
             CntPrg = CntPrg+MinPrg;
@@ -428,6 +448,7 @@ switch DecisionModel
         TrainingParameters.NumFeatures = NumFeatures;
         TrainingParameters.NumLearners = NumLearners;
         TrainingParameters.NumNeighbors = NumNeighbors;
+        TrainingParameters.SearchEpsilon = SearchEpsilon;
         
     case {'Naive Bayes','Linear Discriminant Analysis (LDA)'}
         TrainingParameters.feature_scaling_method = feature_scaling_method;
@@ -26,6 +26,7 @@ function ErrorMsg = Script_DecisionMacine_Test_FFC
 % 2020-Oct-19   filename for saving the results is prompted before the process begins  
 % 2021-Jan-15   The Nodes output in decision tree was removed for 
 %               compatibility with other MATLAB releases.
+% 2026-Oct-18   the nearest neighbor index of ensemble kNN (DecisionMachine_FFC) is used
 
 %% Initialization 
 global Dataset_FFC DecisionMachine_FFC DecisionMachine_CL_FFC
@@ -129,8 +130,12 @@ switch DM_TrainingParameters_FFC.Type
         
     case 'Ensemble kNN'
         
+        SearchEpsilon = 0;
+        if isfield(DM_TrainingParameters_FFC,'SearchEpsilon')
+            SearchEpsilon = DM_TrainingParameters_FFC.SearchEpsilon;
+        end
         [ErrorMsg,Pc,ConfusionMatrix,PredictedLabel,Scores] = Test_EnsemblekNN_FFC(DecisionMachine_CL_FFC,Dataset,TestIndex,...
-            ClassLabels_FFC,DM_ClassLabels_FFC,FeatureLabels_FFC,DM_FeatureLabels_FFC,Weights);
+            ClassLabels_FFC,DM_ClassLabels_FFC,FeatureLabels_FFC,DM_FeatureLabels_FFC,Weights,DecisionMachine_FFC,SearchEpsilon);
         
     case 'Naive Bayes'
         
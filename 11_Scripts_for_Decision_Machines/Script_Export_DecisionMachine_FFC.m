@@ -0,0 +1,61 @@
+function ErrorMsg = Script_Export_DecisionMachine_FFC
+
+% This function exports DecisionMachine_FFC together with its feature plan, feature transform,
+% and scaling parameters into a decision machine bundle (see Export_DecisionMachine_FFC).
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Output:
+%   ErrorMsg: Possible error message. If there is no error, this output is
+%   empty.
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+global DecisionMachine_FFC DecisionMachine_CL_FFC DM_TrainingParameters_FFC
+global DM_ClassLabels_FFC DM_FeatureLabels_FFC
+global DM_Function_Handles_FFC DM_Function_Labels_FFC DM_Function_Select_FFC DM_Feature_Transfrom_FFC
+
+%% Check that Decision Machine is trained/loaded
+if isempty(DecisionMachine_FFC) && isempty(DecisionMachine_CL_FFC)
+    ErrorMsg = 'No decision machine is loaded. Please train or load a decision machine.';
+    return;
+end
+
+%% Get filename for saving the bundle
+FullFileName = [matlab.lang.makeValidName(DM_TrainingParameters_FFC.Type) '.dmb'];
+[Filename,path] = uiputfile('*.dmb','Export Decision Machine As',FullFileName);
+if isequal(Filename,0)
+    ErrorMsg = 'Process is aborted. No file was selected by user for exporting the decision machine.';
+    return;
+end
+
+%% ###################################################################################################
+%% --------------------------------------------------------------------------------------------------#
+%% -------------------------------------- Function Main Body ----------------------------------------#
+%% --------------------------------------------------------------------------------------------------#
+%% ###################################################################################################
+
+%% Export Decision Machine
+ErrorMsg = Export_DecisionMachine_FFC([path Filename],DM_TrainingParameters_FFC,DecisionMachine_FFC,DecisionMachine_CL_FFC,...
+    DM_ClassLabels_FFC,DM_FeatureLabels_FFC,DM_Function_Handles_FFC,DM_Function_Labels_FFC,DM_Function_Select_FFC,DM_Feature_Transfrom_FFC);
+if ~isempty(ErrorMsg)
+    ErrorMsg = sprintf('Process is aborted. %s',ErrorMsg);
+    return;
+end
+
+%% Update GUI
+GUI_MainEditBox_Update_FFC(false,'The process is completed successfully.');
@@ -23,6 +23,8 @@ function ErrorMsg = Script_ConvertCSVtoDATFragmentDataset_FFC
 %
 % Revisions:
 % 2023-Dec-25   function was created
+% 2026-Oct-18   files are converted by ConvertFragmentDataset_Core_FFC (C-MEX) if it is available
+% 2026-Oct-18   line-by-line conversion is done by ConvertCSVtoDAT_mFile_FFC
 
 %% Default Output
 ErrorMsg = '';
@@ -69,62 +71,22 @@ for j=1:NumFiles
     NewFileName{j}(end-2:end) = 'dat';
 end
 
+NativeConverter = exist('ConvertFragmentDataset_Core_FFC','file')==3;
+
 progressbar_FFC('Converting files ....','Progress for the current file');
 for j=1:NumFiles
     
-    % Open dat file for reading
-    fileID_Read = fopen([PathName FileName{j}],'r');
-    
-    % Length of file
-    FileLength = GetFileSize_FFC(fileID_Read);
-
-    % Open dat file for writing
+    % Convert the whole file by the C-MEX converter (or line by line)
     DAT_File = [NewPathName '\' NewFileName{j}];
-    fileID_Write = fopen(DAT_File,'w');
-        
-    % Read file fragments
-    curr_file_id = -1;
-    file_id = 0;
-    frg_id = 0;
-    while ~feof(fileID_Read)
-        
-        line = fgets(fileID_Read);        
-        
-        stopbar = progressbar_FFC(2,ftell(fileID_Read)/FileLength);
-        if stopbar
-            ErrorMsg = sprintf('Process is aborted by user.');
+    if NativeConverter
+        ConvertFragmentDataset_Core_FFC('csv2dat',[PathName FileName{j}],DAT_File,IncludedFileIdentifier);
+    else
+        [~,ErrorMsg] = ConvertCSVtoDAT_mFile_FFC([PathName FileName{j}],DAT_File,IncludedFileIdentifier,true);
+        if ~isempty(ErrorMsg)
             return;
         end
-    
-        if isequal(line,-1)
-            break; % Exit the loop at the end of the file
-        end
-        Fragment = str2num(line);
-        
-        if IncludedFileIdentifier
-            file_id = Fragment(1);
-            if curr_file_id~=file_id
-                curr_file_id = file_id;
-                frg_id = 0;
-            end
-            frg_id = frg_id+1;
-            Fragment(1) = [];
-        else
-            file_id = file_id+1;
-            frg_id = 1;
-        end
-        
-        fwrite(fileID_Write,file_id,'uint64',0,'b');
-        fwrite(fileID_Write,frg_id,'uint64',0,'b');
-        fwrite(fileID_Write,length(Fragment),'uint64',0,'b');
-        fwrite(fileID_Write,Fragment,'uint8',0,'b');
-
     end
     
-    % Close files
-    fclose(fileID_Write);
-    fclose(fileID_Read);
-    
     stopbar = progressbar_FFC(1,j/NumFiles);
     if stopbar
         ErrorMsg = sprintf('Process is aborted by user.');
@@ -26,6 +26,7 @@ function ErrorMsg = Script_ConvertDATtoCSVFragmentDataset_FFC
 %
 % Revisions:
 % 2023-Dec-25   function was created
+% 2026-Oct-18   files are converted by ConvertFragmentDataset_Core_FFC (C-MEX) if it is available
 
 %% Default Output
 ErrorMsg = '';
@@ -71,9 +72,24 @@ for j=1:NumFiles
     NewFileName{j}(end-2:end) = 'csv';
 end
 
+NativeConverter = exist('ConvertFragmentDataset_Core_FFC','file')==3;
+
 progressbar_FFC('Converting files ....','Progress for the current file');
 for j=1:NumFiles
     
+    % Convert the whole file by the C-MEX converter
+    if NativeConverter
+        CSV_File = [NewPathName '\' NewFileName{j}];
+        ConvertFragmentDataset_Core_FFC('dat2csv',[PathName FileName{j}],CSV_File,IncludeFileIdentifier);
+        
+        stopbar = progressbar_FFC(1,j/NumFiles);
+        if stopbar
+            ErrorMsg = sprintf('Process is aborted by user.');
+            return;
+        end
+        continue;
+    end
+    
     % Open dat file for reading
     fileID_Read = fopen([PathName FileName{j}],'r');
     
@@ -50,6 +50,7 @@ function ErrorMsg = Script_GenerateDataset_for_DecisionMachine_FFC
 % 2020-May-20   function was created
 % 2020-Oct-18   filename for saving the dataset is prompted before the process of feature extraction begins  
 % 2021-Jan-03   DM_Feature_Transfrom_FFC was included
+% 2026-Oct-18   only the selected features are calculated (see Compile_FeaturePlan_FFC)
 
 %% Global Variables
 global DecisionMachine_FFC DecisionMachine_CL_FFC DM_FeatureLabels_FFC
@@ -182,9 +183,8 @@ ClassLabels = SetVariableNames_FFC(ClassLabels);
 % The last-1 and the last columns are class label and FileID, respectively
 NumberofFeatures = sum(cell2mat(DM_Function_Select_FFC));
 FeatureLabels = DM_FeatureLabels_FFC;
-Function_Handles = DM_Function_Handles_FFC;
-Function_Labels = DM_Function_Labels_FFC;
-Function_Select = DM_Function_Select_FFC;
+[Function_Handles,Function_Labels,Function_Select] = ...
+    Compile_FeaturePlan_FFC(DM_Function_Handles_FFC,DM_Function_Labels_FFC,DM_Function_Select_FFC);
 Feature_Transfrom = DM_Feature_Transfrom_FFC;
 
 Dataset = zeros(TotalFragments,NumberofFeatures+2);
@@ -51,6 +51,10 @@ function ErrorMsg = Script_GenerateDataset_from_FragmentDataset_FFC
 % 2020-Oct-18   - filename for saving the dataset is prompted before the process of feature extraction begins  
 %               - function handles for Longest Common Subsequence and Longest Common Substring are modified
 %                   for preventing large file size of the saved dataset 
+% 2026-Oct-18   profile of read, compute (per function), and write phases of classes is saved and summarized
+% 2026-Oct-18   approximate mode (band width) was added for LCS features
+% 2026-Oct-18   statistics of features are accumulated for each class and saved with the dataset
+% 2026-Oct-18   all centroid models are scored in one call (Compare_with_Centroids_FFC)
 
 %% Initialization
 global C_MEX_64_Available
@@ -154,6 +158,13 @@ if any(strcmp(FeatureTypes,'GIST Features'))
     Default_Value = [Default_Value '[32 4 4 4 4 4]'];
 end
 
+% Define default parameter for Longest Common Subsequence and Longest Common Substring
+if any(strcmp(FeatureTypes,'Longest Common Subsequence')) || any(strcmp(FeatureTypes,'Longest Common Substring'))
+    Param_Names = [Param_Names 'LCS_Band'];
+    Param_Description = [Param_Description 'Band width for approximate LCS features (Inf for exact LCS; e.g. 128 for more than 10 times faster LCS features on 4096-byte fragments)'];
+    Default_Value = [Default_Value 'Inf'];
+end
+
 % Write specific command using PromptforParameters_FFC to get parameters
 if ~isempty(Param_Names)
     dlg_title = 'Parameters for feature extraction functions';
@@ -288,6 +299,18 @@ if any(strcmp(FeatureTypes,'GIST Features'))
     end
 end
 
+% Check parameter for Longest Common Subsequence and Longest Common Substring
+if any(strcmp(FeatureTypes,'Longest Common Subsequence')) || any(strcmp(FeatureTypes,'Longest Common Substring'))
+    [Err,ErrMsg] = Check_Variable_Value_FFC(LCS_Band,'Band width for approximate LCS features','type','scalar','class','real','min',0);
+    if ~Err && ~isinf(LCS_Band)
+        [Err,ErrMsg] = Check_Variable_Value_FFC(LCS_Band,'Band width for approximate LCS features','class','integer');
+    end
+    if Err
+        ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+        return;
+    end
+end
+
 %% Define Features Extraction Functions
 NumFeatExtFunc = 0; % Number of features extraction functions
 
@@ -570,10 +593,16 @@ FrgDataset = cell(2,N);
 TotalFragments = 0;
 FileEmpty = false(1,N);
 ClassMembersNumber = zeros(1,N);
+
+% Profile of dataset generation: each binary file (class) of fragments is a batch
+Profile = Init_GenerationProfile_FFC(f_handles);
+
 progressbar_FFC('Step 1: Read fragments from binary files, please wait ...');
 for j=1:N
     
     % Open file
+    ReadStart = tic;
+    ReadCPUStart = cputime;
     fileID = fopen([PathName FileName{j}],'r');
     str = FileName{j};
     str(strfind(lower(str), '.dat'):end) = [];
@@ -617,6 +646,7 @@ for j=1:N
     
     % Close file
     fclose(fileID);
+    Profile = Add_GenerationProfile_FFC(Profile,j,0,L,cnt,toc(ReadStart),cputime-ReadCPUStart);
     
     stopbar = progressbar_FFC(1,j/N);
     if stopbar
@@ -749,7 +779,7 @@ for i=1:length(ClassofReps)
             for j=1:length(ClassLabelsSelect{i})
                 cnt = cnt+1;
                 RepsFrgs = Representatives_Fragments{i}{j};
-                f_handles{cnt} = @(x) LCSSeq2_FFC(x,RepsFrgs); % Function of feature extraction
+                f_handles{cnt} = @(x) LCSSeq2_FFC(x,RepsFrgs,LCS_Band); % Function of feature extraction
                 f_OutputLabels{cnt} = {sprintf('LCS_Seq_%s',ClassLabels{ClassLabelsSelect{i}(j)})}; % Lables for Features
             end
             
@@ -759,26 +789,31 @@ for i=1:length(ClassofReps)
                 cnt = cnt+1;
                 RepsFrgs = Representatives_Fragments{i}{j};
                 f_OutputLabels{cnt} = {sprintf('LCS_Str_%s',ClassLabels{ClassLabelsSelect{i}(j)})}; % Lables for Features                
-                f_handles{cnt} = @(x) LCSStr2_FFC(x,RepsFrgs); % Function of feature extraction
+                f_handles{cnt} = @(x) LCSStr2_FFC(x,RepsFrgs,LCS_Band); % Function of feature extraction
             end            
             
         case 'Centroid Models'
             
-            for j=1:length(ClassLabelsSelect{i})                
-                
-                % Build Centroid Model
+            % Build Centroid Models
+            centroids_mu = zeros(length(ClassLabelsSelect{i}),256);
+            centroids_sigma = zeros(length(ClassLabelsSelect{i}),256);
+            for j=1:length(ClassLabelsSelect{i})
                 Centroid = zeros(length(Representatives_Fragments{i}{j}),256);
                 for k=1:length(Representatives_Fragments{i}{j})
                     output = BFD_FFC(Representatives_Fragments{i}{j}{k},num2cell(0:255));
                     Centroid(k,:) = output(1:256);
                 end
-                centroid_mu = mean(Centroid,1);
-                centroid_sigma = std(Centroid,0,1);
-                
-                cnt = cnt+1;
-                f_handles{cnt} = @(x) Compare_with_Centroid_FFC(x,centroid_mu,centroid_sigma); % Function of feature extraction
-                f_OutputLabels{cnt} = {sprintf('CosineSimilarity_%s',ClassLabels{ClassLabelsSelect{i}(j)}) ...
-                    sprintf('MahalanobisDistance_%s',ClassLabels{ClassLabelsSelect{i}(j)})}; % Lables for Features
+                centroids_mu(j,:) = mean(Centroid,1);
+                centroids_sigma(j,:) = std(Centroid,0,1);
+            end
+            
+            % All centroid models are scored in one call
+            cnt = cnt+1;
+            f_handles{cnt} = @(x) Compare_with_Centroids_FFC(x,centroids_mu,centroids_sigma); % Function of feature extraction
+            f_OutputLabels{cnt} = cell(1,2*length(ClassLabelsSelect{i})); % Lables for Features
+            for j=1:length(ClassLabelsSelect{i})
+                f_OutputLabels{cnt}{2*j-1} = sprintf('CosineSimilarity_%s',ClassLabels{ClassLabelsSelect{i}(j)});
+                f_OutputLabels{cnt}{2*j} = sprintf('MahalanobisDistance_%s',ClassLabels{ClassLabelsSelect{i}(j)});
             end
             
     end
@@ -809,11 +844,24 @@ end
 TotalFragments = TotalFragments-TotalReps;
 Dataset = zeros(TotalFragments,NumberofFeatures+2);
 
+% Names of representatives-related feature extraction functions
+ProfileNames = Init_GenerationProfile_FFC(f_handles);
+Profile.FunctionNames = ProfileNames.FunctionNames;
+FragmentBytes = 0;
+
+% Statistics of features are accumulated for each class (batch) while the dataset is generated
+FeatureStats = Init_FeatureStats_FFC(NumberofFeatures,length(ClassLabels));
+
 count = 0;
 counter = 0;
 progressbar_FFC('Step 2: Calculating features, please wait ...');
 for j=1:length(ClassLabels) % Loop over different labels
     
+    ClassStart = count;
+    FuncWallTime = zeros(1,NumFeatExtFunc);
+    FuncCPUTime = zeros(1,NumFeatExtFunc);
+    ClassFragments = 0;
+    ClassBytes = 0;
     for i=1:length(FrgDataset{2,j}) % Loop over different file identifiers
         for k=1:length(FrgDataset{2,j}(i).Fragments) % Loop over different fragments of a single file
             
@@ -825,10 +873,16 @@ for j=1:length(ClassLabels) % Loop over different labels
             
             count = count+1;
             x = FrgDataset{2,j}(i).Fragments{k};            
+            ClassFragments = ClassFragments+1;
+            ClassBytes = ClassBytes+length(x);
 
             % Calculate feature
             for cnt=1:NumFeatExtFunc
+                FuncStart = tic;
+                FuncCPUStart = cputime;
                 Dataset(count,F_idx(cnt)+1:F_idx(cnt+1)) = f_handles{cnt}(x);
+                FuncWallTime(cnt) = FuncWallTime(cnt)+toc(FuncStart);
+                FuncCPUTime(cnt) = FuncCPUTime(cnt)+cputime-FuncCPUStart;
             end
             Dataset(count,end-1) = j;
             Dataset(count,end) = i;
@@ -848,6 +902,12 @@ for j=1:length(ClassLabels) % Loop over different labels
         end
         
     end
+    
+    for cnt=1:NumFeatExtFunc
+        Profile = Add_GenerationProfile_FFC(Profile,j,cnt,ClassFragments,ClassBytes,FuncWallTime(cnt),FuncCPUTime(cnt));
+    end
+    FragmentBytes = FragmentBytes+ClassBytes;
+    FeatureStats = Add_FeatureStats_FFC(FeatureStats,Dataset(ClassStart+1:count,:));
 end
 progressbar_FFC(1,1);
 
@@ -858,8 +918,29 @@ Function_Select = cell(1,length(Function_Labels));
 for j=1:length(Function_Labels)
     Function_Select{j} = true(1,length(Function_Labels{j}));
 end
-save([path filename],'Dataset','FeatureLabels','ClassLabels','Function_Handles','Function_Labels','Function_Select','-v7.3');
+WriteStart = tic;
+WriteCPUStart = cputime;
+save([path filename],'Dataset','FeatureLabels','ClassLabels','Function_Handles','Function_Labels','Function_Select','FeatureStats','-v7.3');
+Profile = Add_GenerationProfile_FFC(Profile,length(ClassLabels),-1,count,FragmentBytes,toc(WriteStart),cputime-WriteCPUStart,...
+    8*FragmentBytes+8*numel(Dataset)); % Fragments and features are of type double
+
+%% Save and Display Profile of Dataset Generation
+[~,profile_name] = fileparts(filename);
+[Summary,ErrMsg] = Save_GenerationProfile_FFC(Profile,fullfile(path,[profile_name '_profile']));
+if isempty(ErrMsg)
+    for i=1:length(Summary)
+        GUI_MainEditBox_Update_FFC(false,Summary{i});
+    end
+else
+    GUI_MainEditBox_Update_FFC(false,ErrMsg);
+end
+
+%% Display Statistics of Features
+Summary = Summarize_FeatureStats_FFC(FeatureStats,ClassLabels,FeatureLabels);
+for i=1:length(Summary)
+    GUI_MainEditBox_Update_FFC(false,Summary{i});
+end
 
 %% Update GUI
-GUI_Dataset_Update_FFC(filename,Dataset,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select);
+GUI_Dataset_Update_FFC(filename,Dataset,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select,[],FeatureStats);
 GUI_MainEditBox_Update_FFC(false,'The process is completed successfully.');
\ No newline at end of file
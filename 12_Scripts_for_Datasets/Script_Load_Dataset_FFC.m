@@ -23,6 +23,7 @@ function ErrorMsg = Script_Load_Dataset_FFC
 % Revisions:
 % 2020-Mar-05   function was created
 % 2021-Jan-03   Feature_Transfrom_FFC was added
+% 2026-Oct-18   the statistics of features are loaded with dataset
 
 %% ###################################################################################################
 %% --------------------------------------------------------------------------------------------------#
@@ -31,11 +32,11 @@ function ErrorMsg = Script_Load_Dataset_FFC
 %% ###################################################################################################
 
 %% Load Dataset
-[Filename,Dataset,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select,Feature_Transfrom,ErrorMsg] = Load_Dataset_FFC;
+[Filename,Dataset,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select,Feature_Transfrom,ErrorMsg,FeatureStats] = Load_Dataset_FFC;
 if ~isempty(ErrorMsg)
     return;
 end
 
 %% Update GUI
-GUI_Dataset_Update_FFC(Filename,Dataset,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select,Feature_Transfrom);
+GUI_Dataset_Update_FFC(Filename,Dataset,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select,Feature_Transfrom,FeatureStats);
 GUI_MainEditBox_Update_FFC(false,'Dataset is loaded successfully.');
@@ -40,6 +40,12 @@ function ErrorMsg = Script_Parallel_GenerateDataset_from_FragmentDataset_FFC
 %
 % Revisions:
 % 2023-Dec-23   function was created
+% 2026-Oct-18   low-resolution mode was added for GIST features
+% 2026-Oct-18   all centroid models are scored in one call (Compare_with_Centroids_Parallel_FFC)
+% 2026-Oct-18   profile of read, compute (per function), and write phases of batches is saved and summarized
+% 2026-Oct-18   approximate mode (band width) was added for LCS features
+% 2026-Oct-18   statistics of features are accumulated for each batch and saved next to the dataset
+% 2026-Oct-18   batches are processed by the native worker pool (FeaturePool_Core_FFC) if it is available
 
 %% Initialization
 global C_MEX_64_Available
@@ -158,8 +164,18 @@ if ~ReadyFunctions
         Param_Names = [Param_Names 'GIST_Prms'];
         Param_Description = [Param_Description 'GIST Parameters: Image row size (>=16 and <=256), non-overlapping windows in each dimension(>=2 and <=32), and Number of orientations at each scale (a vector of integers with >=2 and <=8 values)'];
         Default_Value = [Default_Value '[32 4 4 4 4 4]'];
+        Param_Names = [Param_Names 'GIST_LowRes'];
+        Param_Description = [Param_Description 'GIST Low-Resolution Mode: Use a lower-resolution filter bank instead of upscaling small fragment images to 256x256 (0 or 1)'];
+        Default_Value = [Default_Value '0'];
     end
     
+    % Define default parameter for Longest Common Subsequence and Longest Common Substring
+    if any(strcmp(FeatureTypes,'Longest Common Subsequence')) || any(strcmp(FeatureTypes,'Longest Common Substring'))
+        Param_Names = [Param_Names 'LCS_Band'];
+        Param_Description = [Param_Description 'Band width for approximate LCS features (Inf for exact LCS; e.g. 128 for more than 10 times faster LCS features on 4096-byte fragments)'];
+        Default_Value = [Default_Value 'Inf'];
+    end
+
     % Write specific command using PromptforParameters_FFC to get parameters
     if ~isempty(Param_Names)
         dlg_title = 'Parameters for feature extraction functions';
@@ -292,6 +308,24 @@ if ~ReadyFunctions
             ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
             return;
         end
+        
+        [Err,ErrMsg] = Check_Variable_Value_FFC(GIST_LowRes,'Low-resolution mode for GIST Features','type','scalar','class','real','class','integer','min',0,'max',1);
+        if Err
+            ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+            return;
+        end
+    end
+
+    % Check parameter for Longest Common Subsequence and Longest Common Substring
+    if any(strcmp(FeatureTypes,'Longest Common Subsequence')) || any(strcmp(FeatureTypes,'Longest Common Substring'))
+        [Err,ErrMsg] = Check_Variable_Value_FFC(LCS_Band,'Band width for approximate LCS features','type','scalar','class','real','min',0);
+        if ~Err && ~isinf(LCS_Band)
+            [Err,ErrMsg] = Check_Variable_Value_FFC(LCS_Band,'Band width for approximate LCS features','class','integer');
+        end
+        if Err
+            ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+            return;
+        end
     end
     
     %% Define Features Extraction Functions
@@ -507,7 +541,7 @@ if ~ReadyFunctions
     
     if any(strcmp(FeatureTypes,'GIST Features'))
         pointer = pointer+1;
-        f_handles{pointer} = @(x) Grayscale_GIST_Parallel_FFC(x,rowsize,orientPerScale,numBlks); % Function of feature extraction
+        f_handles{pointer} = @(x) Grayscale_GIST_Parallel_FFC(x,rowsize,orientPerScale,numBlks,GIST_LowRes); % Function of feature extraction
         f_OutputLabels{pointer} = cell(1,sum(orientPerScale)*numBlks^2); % Lables for Features
         GIST_str = num2str(orientPerScale);
         GIST_str(GIST_str==' ') = '_';
@@ -675,7 +709,7 @@ if ~ReadyFunctions
                 for j=1:length(ClassLabelsSelect{i})
                     pointer = pointer+1;
                     RepsFrgs = Fragments{j}(1:NumReps{i});
-                    f_handles{pointer} = @(x) LCSSeq2_Parallel_FFC(x,RepsFrgs); % Function of feature extraction
+                    f_handles{pointer} = @(x) LCSSeq2_Parallel_FFC(x,RepsFrgs,LCS_Band); % Function of feature extraction
                     f_OutputLabels{pointer} = {sprintf('LCS_Seq_%s',ClassLabels{ClassLabelsSelect{i}(j)})}; % Lables for Features
                 end
                 
@@ -685,27 +719,32 @@ if ~ReadyFunctions
                     pointer = pointer+1;
                     RepsFrgs = Fragments{j}(1:NumReps{i});
                     f_OutputLabels{pointer} = {sprintf('LCS_Str_%s',ClassLabels{ClassLabelsSelect{i}(j)})}; % Lables for Features
-                    f_handles{pointer} = @(x) LCSStr2_Parallel_FFC(x,RepsFrgs); % Function of feature extraction
+                    f_handles{pointer} = @(x) LCSStr2_Parallel_FFC(x,RepsFrgs,LCS_Band); % Function of feature extraction
                 end
                 
             case 'Centroid Models'
                 
+                % Build Centroid Models
+                centroids_mu = zeros(length(ClassLabelsSelect{i}),256);
+                centroids_sigma = zeros(length(ClassLabelsSelect{i}),256);
                 for j=1:length(ClassLabelsSelect{i})
-                    
-                    % Build Centroid Model
                     RepsFrgs = Fragments{j}(1:NumReps{i});
                     Centroid = zeros(length(RepsFrgs),256);
                     for k=1:length(RepsFrgs) % Usually, it does not need parallelization
                         output = BFD_FFC(RepsFrgs{k},num2cell(0:255));
                         Centroid(k,:) = output(1:256);
                     end
-                    centroid_mu = mean(Centroid,1);
-                    centroid_sigma = std(Centroid,0,1);
-                    
-                    pointer = pointer+1;
-                    f_handles{pointer} = @(x) Compare_with_Centroid_Parallel_FFC(x,centroid_mu,centroid_sigma); % Function of feature extraction
-                    f_OutputLabels{pointer} = {sprintf('CosineSimilarity_%s',ClassLabels{ClassLabelsSelect{i}(j)}) ...
-                        sprintf('MahalanobisDistance_%s',ClassLabels{ClassLabelsSelect{i}(j)})}; % Lables for Features
+                    centroids_mu(j,:) = mean(Centroid,1);
+                    centroids_sigma(j,:) = std(Centroid,0,1);
+                end
+                
+                % All centroid models are scored in one call
+                pointer = pointer+1;
+                f_handles{pointer} = @(x) Compare_with_Centroids_Parallel_FFC(x,centroids_mu,centroids_sigma); % Function of feature extraction
+                f_OutputLabels{pointer} = cell(1,2*length(ClassLabelsSelect{i})); % Lables for Features
+                for j=1:length(ClassLabelsSelect{i})
+                    f_OutputLabels{pointer}{2*j-1} = sprintf('CosineSimilarity_%s',ClassLabels{ClassLabelsSelect{i}(j)});
+                    f_OutputLabels{pointer}{2*j} = sprintf('MahalanobisDistance_%s',ClassLabels{ClassLabelsSelect{i}(j)});
                 end
                 
         end
@@ -748,6 +787,38 @@ if NumFeatExtFunc==0
     return;
 end
 
+%% Native Worker Pool
+% The batches are loaded in FeaturePool_Core_FFC (if the MEX file is available), and its kernels replace the
+% parfor loops of the parallel feature extraction functions.
+NativePool = exist('FeaturePool_Core_FFC','file')==3;
+if NativePool
+    NumThreads = 0; % Number of threads (0: one thread for each CPU)
+    Affinity = 1; % Affinity of threads (0: none, 1: compact, 2: scatter)
+    [success,NumThreads,Affinity] = PromptforParameters_FFC(...
+        {'Number of threads of the native worker pool (0 for one thread for each CPU)',...
+        'Affinity of threads to CPUs (0: none, 1: compact, 2: scatter over NUMA nodes)'},...
+        {num2str(NumThreads),num2str(Affinity)},'Parameters of the native worker pool');
+    
+    if ~success
+        ErrorMsg = 'Process is aborted. Parameters of the native worker pool are not specified.';
+        return;
+    end
+    
+    [Err,ErrMsg] = Check_Variable_Value_FFC(NumThreads,'Number of threads','type','scalar','class','real','class','integer','min',0,'max',1024);
+    if Err
+        ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+        return;
+    end
+    
+    [Err,ErrMsg] = Check_Variable_Value_FFC(Affinity,'Affinity of threads','type','scalar','class','real','class','integer','min',0,'max',2);
+    if Err
+        ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+        return;
+    end
+    
+    FeaturePool_Core_FFC('init',NumThreads,Affinity);
+end
+
 %% Generate Dataset
 
 fid = fopen(dataset_filename,'w');
@@ -775,11 +846,21 @@ Dataset = zeros(N,sum(cellfun(@length,f_OutputLabels))+2);
 ParforFileIdentifier = zeros(N,1);
 counter = 0;
 
+% Profile of dataset generation
+Profile = Init_GenerationProfile_FFC(f_handles(1:NumFeatExtFunc));
+Batch = 0;
+BatchBytes = 0;
+
+% Statistics of features are accumulated for each batch while the dataset is written
+FeatureStats = Init_FeatureStats_FFC(length(FeatureLabels),length(ClassLabels));
+
 progressbar_FFC('Calculating features, this might take a while ...');
 NumFiles = length(FileName);
 for j=1:NumFiles
     
     % Open file
+    ReadStart = tic;
+    ReadCPUStart = cputime;
     fileID = fopen([PathName FileName{j}],'r');
     
     % Length of file
@@ -804,6 +885,7 @@ for j=1:NumFiles
             parfor_buffer_counter = parfor_buffer_counter+1;
             Fragments{parfor_buffer_counter} = fread(fileID,L0,'uint8=>double',0,'b')';
             ParforFileIdentifier(parfor_buffer_counter) = Curr_File;
+            BatchBytes = BatchBytes+L0;
         else
             fseek(fileID,L0,'cof');
         end
@@ -813,21 +895,48 @@ for j=1:NumFiles
             continue;
         end
         
+        Batch = Batch+1;
+        Batch_Fragments = Fragments(1:parfor_buffer_counter);
+        if NativePool
+            % The batch is copied once to the partitions of the pool and is used by all kernels
+            FeaturePool_Core_FFC('load',Batch_Fragments);
+        end
+        Profile = Add_GenerationProfile_FFC(Profile,Batch,0,parfor_buffer_counter,BatchBytes,toc(ReadStart),cputime-ReadCPUStart);
+        
         % Calculate feature
         F1 = 0;
-        for cnt=1:NumFeatExtFunc
-            F2 = F1+length(f_OutputLabels{cnt});
-            Dataset_Partition = f_handles{cnt}(Fragments(1:parfor_buffer_counter));
-            Dataset(1:parfor_buffer_counter,F1+1:F2) = Dataset_Partition(1:parfor_buffer_counter,:);
-            F1 = F2;
+        try
+            for cnt=1:NumFeatExtFunc
+                FuncStart = tic;
+                FuncCPUStart = cputime;
+                F2 = F1+length(f_OutputLabels{cnt});
+                Dataset_Partition = f_handles{cnt}(Batch_Fragments);
+                Dataset(1:parfor_buffer_counter,F1+1:F2) = Dataset_Partition(1:parfor_buffer_counter,:);
+                F1 = F2;
+                Profile = Add_GenerationProfile_FFC(Profile,Batch,cnt,parfor_buffer_counter,BatchBytes,toc(FuncStart),cputime-FuncCPUStart);
+            end
+        catch ME
+            if NativePool
+                FeaturePool_Core_FFC('unload');
+            end
+            rethrow(ME);
+        end
+        if NativePool
+            FeaturePool_Core_FFC('unload');
         end
         Dataset(1:parfor_buffer_counter,end-1) = j;
         Dataset(1:parfor_buffer_counter,end) = ParforFileIdentifier(1:parfor_buffer_counter);
+        FeatureStats = Add_FeatureStats_FFC(FeatureStats,Dataset(1:parfor_buffer_counter,:));
         
         % Update Dataset
+        WriteStart = tic;
+        WriteCPUStart = cputime;
         dlmwrite(dataset_filename,Dataset(1:parfor_buffer_counter,:),'-append');
+        Profile = Add_GenerationProfile_FFC(Profile,Batch,-1,parfor_buffer_counter,BatchBytes,toc(WriteStart),cputime-WriteCPUStart,...
+            8*BatchBytes+8*numel(Dataset)); % Buffers of fragments and features are of type double
         counter = counter+parfor_buffer_counter;
         parfor_buffer_counter = 0;
+        BatchBytes = 0;
         
         stopbar = progressbar_FFC(1,counter/TotalFragments);
         if stopbar
@@ -839,6 +948,9 @@ for j=1:NumFiles
         if pointer>=FileLength
             break;
         end
+        
+        ReadStart = tic;
+        ReadCPUStart = cputime;
     end
     
     % Close file
@@ -855,6 +967,33 @@ if ~ReadyFunctions
     
 end
 
+%% Save and Display Statistics of Features
+[profile_path,profile_name] = fileparts(dataset_filename);
+save(fullfile(profile_path,[profile_name '_stats.mat']),'FeatureStats','FeatureLabels','ClassLabels','-v7.3');
+Summary = Summarize_FeatureStats_FFC(FeatureStats,ClassLabels,FeatureLabels);
+for i=1:length(Summary)
+    GUI_MainEditBox_Update_FFC(false,Summary{i});
+end
+
+%% Save and Display Profile of Dataset Generation
+[Summary,ErrMsg] = Save_GenerationProfile_FFC(Profile,fullfile(profile_path,[profile_name '_profile']));
+if isempty(ErrMsg)
+    for i=1:length(Summary)
+        GUI_MainEditBox_Update_FFC(false,Summary{i});
+    end
+else
+    GUI_MainEditBox_Update_FFC(false,ErrMsg);
+end
+
+%% Display Report of Native Worker Pool
+if NativePool
+    Info = FeaturePool_Core_FFC('info');
+    GUI_MainEditBox_Update_FFC(false,sprintf('Native worker pool: %d threads (affinity: %s) on %d NUMA nodes, %d partitions of batches',...
+        Info.NumThreads,Info.Affinity,Info.NumNodes,Info.Partitions));
+    GUI_MainEditBox_Update_FFC(false,sprintf('  Loaded: %.1f MB (%.1f%% to other NUMA nodes), read by kernels: %.1f MB (%.1f%% from other NUMA nodes)',...
+        Info.LoadBytes/2^20,100*Info.LoadRemoteBytes/max(Info.LoadBytes,1),Info.KernelBytes/2^20,100*Info.KernelRemoteBytes/max(Info.KernelBytes,1)));
+end
+
 %% Update GUI
 GUI_MainEditBox_Update_FFC(false,'The process is completed successfully.');
 
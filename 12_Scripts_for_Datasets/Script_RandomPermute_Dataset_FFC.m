@@ -24,11 +24,12 @@ function ErrorMsg = Script_RandomPermute_Dataset_FFC
 % Revisions:
 % 2020-Mar-05   function was created
 % 2021-Jan-03   Feature_Transfrom_FFC was included
+% 2026-Oct-18   the statistics of features are kept (they do not depend on the order of samples)
 
 %% Initialization
 global ClassLabels_FFC FeatureLabels_FFC Dataset_FFC
 global Function_Handles_FFC Function_Labels_FFC Function_Select_FFC
-global Feature_Transfrom_FFC
+global Feature_Transfrom_FFC FeatureStats_FFC
 ErrorMsg = '';
 
 %% Check that Dataset is generated/loaded
@@ -64,8 +65,9 @@ Function_Handles = Function_Handles_FFC;
 Function_Labels = Function_Labels_FFC;
 Function_Select = Function_Select_FFC;
 Feature_Transfrom = Feature_Transfrom_FFC;
-save([path Filename],'Dataset','FeatureLabels','ClassLabels','Function_Handles','Function_Labels','Function_Select','Feature_Transfrom','-v7.3');
+FeatureStats = FeatureStats_FFC;
+save([path Filename],'Dataset','FeatureLabels','ClassLabels','Function_Handles','Function_Labels','Function_Select','Feature_Transfrom','FeatureStats','-v7.3');
 
 %% Update GUI
-GUI_Dataset_Update_FFC(Filename,Dataset,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select,Feature_Transfrom);
+GUI_Dataset_Update_FFC(Filename,Dataset,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select,Feature_Transfrom,FeatureStats);
 GUI_MainEditBox_Update_FFC(false,'The process is completed successfully.');
@@ -33,6 +33,7 @@ function ErrorMsg = Script_RawData_to_Fragments_FFC
 %
 % Revisions:
 % 2020-Mar-01   function was created
+% 2026-Oct-18   fragments are taken and written by RawData_to_Fragments_Core_FFC (C-MEX) when it is available
 
 %% Initialization
 ErrorMsg = '';
@@ -114,6 +115,9 @@ end
 %% --------------------------------------------------------------------------------------------------#
 %% ###################################################################################################
 
+%% Check that the C-MEX fragmenter is available
+NativeFragmenter = exist('RawData_to_Fragments_Core_FFC','file')==3;
+
 %% Get the fragments in each folder
 GUI_MainEditBox_Update_FFC(false,sprintf('File fragments generation is started ...'));
 progressbar_FFC('Taking fragments, please wait ...');
@@ -141,6 +145,23 @@ for j=1:length(Foldernames)
         end
     end
     
+    % Take fragments of all files in parallel and write them into the binary file
+    if NativeFragmenter
+        NumFragments = RawData_to_Fragments_Core_FFC(Filenames(1:N),[outputfoldername '\' str '.dat'],...
+            PossiblePacketSizes,DisregardBOF,DisregardEOF,MaxFragment,randi([0 2^31-1]));
+        L = sum(max(NumFragments,0));
+        
+        % Progress bar
+        stopbar = progressbar_FFC(1,j/length(Foldernames));
+        if stopbar
+            ErrorMsg = 'Process is aborted by user.';
+            return;
+        end
+        
+        GUI_MainEditBox_Update_FFC(false,sprintf('Total number of fragments in %s: %d',str,L));
+        continue;
+    end
+    
     fileID = fopen([outputfoldername '\' str '.dat'],'w');
     
     % For all files take fragments
@@ -3,6 +3,9 @@ function ErrorMsg = Script_2D_Histogram_FFC
 % This function takes Dataset_FFC with L rows (L samples) and C columns (C-2 features) and does the following process:
 %   - The samples of two or more different sets of classes are plotted in 2-D histogram space. 
 %
+%   Note: If no dataset is loaded, a dataset file can be selected. The dataset is streamed in blocks,
+%   and only the compact summaries of the features are plotted (see Aggregate_Dataset_FFC).
+%
 % Copyright (C) 2023 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
 % 
 % This file is a part of Fragments-Expert software, a software package for
@@ -23,13 +26,25 @@ function ErrorMsg = Script_2D_Histogram_FFC
 %
 % Revisions:
 % 2023-Oct-29   function was created
+% 2026-Oct-18   2-D histograms are aggregated by streaming the dataset (or a dataset file) in blocks
 
 %% Initialization
 global ClassLabels_FFC FeatureLabels_FFC Dataset_FFC
+global FeatureStats_FFC
 
+%% Check that Dataset is generated/loaded (or select a dataset file)
 if isempty(Dataset_FFC)
-    ErrorMsg = 'No dataset is loaded. Please generate or load a dataset.';
-    return;
+    [Source,FeatureLabels,ClassLabels,~,~,~,~,ErrorMsg] = ...
+        Open_Dataset_File_FFC('No dataset is loaded. Select a dataset file for visualization');
+    if ~isempty(ErrorMsg)
+        return;
+    end
+    FeatureStats = [];
+else
+    Source = Dataset_FFC;
+    FeatureLabels = FeatureLabels_FFC;
+    ClassLabels = ClassLabels_FFC;
+    FeatureStats = FeatureStats_FFC;
 end
 
 
@@ -39,11 +54,6 @@ end
 %% --------------------------------------------------------------------------------------------------#
 %% ###################################################################################################
 
-%% Initial Assignment
-FeatureLabels = FeatureLabels_FFC;
-ClassLabels = ClassLabels_FFC;
-Dataset = Dataset_FFC;
-
 %% Select Features
 [ErrorMsg,FeatureIdx,~] = Select_from_List_FFC(FeatureLabels,1,'Select two feature to be included');
 if ~isempty(ErrorMsg)
@@ -67,25 +77,40 @@ end
 
 CategoriesLabels = SetVariableNames_FFC(Select_CellContents_FFC(ClassLabels,ClassIdx),false);
 
-%% Collect Feature Values
-F = cell(1,length(ClassIdx));
-for j=1:length(ClassIdx)
-    
-    % Find rows for class j
-    fun = @(x) ismember(x,ClassIdx{j});
-    idx = arrayfun(fun,Dataset(:,end-1));
-    
-    % The value of the features for class j
-    F{j} = Dataset(idx,FeatureSel);
+%% Get Parameters
+B = 50; % Number of bins of each axis
+[success,B] = PromptforParameters_FFC({'Number of bins of each axis (>=2)'},{num2str(B)},'Parameters for displaying 2-D histogram');
+if ~success
+    ErrorMsg = 'Process is aborted. Parameters for displaying 2-D histogram are not specified.';
+    return;
+end
 
+[Err,ErrMsg] = Check_Variable_Value_FFC(B,'Number of bins','type','scalar','class','real','class','integer','min',2);
+if Err
+    ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+    return;
+end
+
+%% Aggregate 2-D Histograms of Features for Classes
+Options.FeatureStats = FeatureStats;
+Options.Classes = unique([ClassIdx{:}]);
+Options.Pairs = [1 2];
+Options.NumBins2 = B;
+[Summary,ErrorMsg] = Aggregate_Dataset_FFC(Source,length(ClassLabels),FeatureSel,Options);
+if ~isempty(ErrorMsg)
+    return;
 end
+XEdges = Summary.Lo(1)+(Summary.Hi(1)-Summary.Lo(1))*(0:B)/B;
+YEdges = Summary.Lo(2)+(Summary.Hi(2)-Summary.Lo(2))*(0:B)/B;
     
 %% Plot Samples in Feature Space
 figure('Name','Samples in FeatureSpace','NumberTitle','off');
 for j=1:length(ClassIdx)
     
-    % Create Density-Based Grid
-    histogram2(F{j}(:,1),F{j}(:,2),'Normalization','pdf');
+    % Create Density-Based Grid (normalized as probability density function)
+    count = sum(Summary.Hist2{1}(:,:,ClassIdx{j}),3);
+    count = count/(sum(count(:))*(XEdges(2)-XEdges(1))*(YEdges(2)-YEdges(1)));
+    histogram2('XBinEdges',XEdges,'YBinEdges',YEdges,'BinCounts',count);
     hold on
 end
 xlabel(XYZ_Labels{1},'FontSize',12,'FontWeight','normal','FontName','Times')
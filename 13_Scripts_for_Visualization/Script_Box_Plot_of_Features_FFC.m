@@ -3,6 +3,9 @@ function ErrorMsg = Script_Box_Plot_of_Features_FFC
 % This function takes Dataset_FFC with L rows (L samples) and C columns (C-2 features) and does the following process:
 %   - produces box plots for one or more fetures
 %
+%   Note: If no dataset is loaded, a dataset file can be selected. The dataset is streamed in blocks,
+%   and only the compact summaries of the features are plotted (see Aggregate_Dataset_FFC).
+%
 % Copyright (C) 2020 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
 % 
 % This file is a part of Fragments-Expert software, a software package for
@@ -23,13 +26,26 @@ function ErrorMsg = Script_Box_Plot_of_Features_FFC
 %
 % Revisions:
 % 2020-Oct-29   function was created
+% 2026-Oct-18   box plots are drawn from quantile sketches (fine histograms) which are aggregated by
+%               streaming the dataset (or a dataset file) in blocks
 
 %% Initialization
 global ClassLabels_FFC FeatureLabels_FFC Dataset_FFC
+global FeatureStats_FFC
 
+%% Check that Dataset is generated/loaded (or select a dataset file)
 if isempty(Dataset_FFC)
-    ErrorMsg = 'No dataset is loaded. Please generate or load a dataset.';
-    return;
+    [Source,FeatureLabels,ClassLabels,~,~,~,~,ErrorMsg] = ...
+        Open_Dataset_File_FFC('No dataset is loaded. Select a dataset file for visualization');
+    if ~isempty(ErrorMsg)
+        return;
+    end
+    FeatureStats = [];
+else
+    Source = Dataset_FFC;
+    FeatureLabels = FeatureLabels_FFC;
+    ClassLabels = ClassLabels_FFC;
+    FeatureStats = FeatureStats_FFC;
 end
 
 
@@ -39,11 +55,6 @@ end
 %% --------------------------------------------------------------------------------------------------#
 %% ###################################################################################################
 
-%% Initial Assignment
-FeatureLabels = FeatureLabels_FFC;
-ClassLabels = ClassLabels_FFC;
-Dataset = Dataset_FFC;
-
 %% Select Features
 [ErrorMsg,FeatureIdx,~] = Select_from_List_FFC(FeatureLabels,1,'Select feature labels');
 if ~isempty(ErrorMsg)
@@ -81,30 +92,78 @@ else
     spl = [1 1];
 end
 
+%% Aggregate Quantile Sketches of Features for Classes
+% The quantiles are interpolated in the bins of fine histograms (the error is less than one bin width)
+Options.FeatureStats = FeatureStats;
+Options.Classes = unique([ClassIdx{:}]);
+Options.NumBins = 4096;
+[Summary,ErrorMsg] = Aggregate_Dataset_FFC(Source,length(ClassLabels),FeatureSel,Options);
+if ~isempty(ErrorMsg)
+    return;
+end
+
 %% Plot Box Plot for Each Feature
 figure('Name','Box Plot of Features','NumberTitle','off');
-fun = cell(1,length(ClassIdx));
-Dataset(:,end) = 0;
-for j=1:length(ClassIdx)
-    
-    % Find rows for class j
-    fun{j} = @(x) ismember(x,ClassIdx{j});
-    idx = arrayfun(fun{j},Dataset(:,end-1));
-    Dataset(idx,end) = j;
-    
-end
-    
-for f = FeatureSel
-    
-    % Counter 
-    cnt = find(FeatureSel==f);
+for cnt=1:length(FeatureSel)
     
     % Box Plot
     subplot(spl(1),spl(2),cnt);
-    boxplot(Dataset(Dataset(:,end)~=0,f),CategoriesLabels(Dataset(Dataset(:,end)~=0,end))','notch','on');
+    box_plot(Summary,cnt,ClassIdx,CategoriesLabels);
     ylabel(Y_Labels{cnt},'FontSize',12,'FontWeight','normal','FontName','Times')
     set(gca,'FontSize',12,'FontWeight','normal','FontName','Times')    
 end
 
 %% Update GUI
 GUI_MainEditBox_Update_FFC(false,'Visualization is completed.');
+
+%% Box plot of feature i (as boxplot with 'notch','on') from its histograms
+function box_plot(Summary,i,ClassIdx,CategoriesLabels)
+
+nb = size(Summary.Hist{i},1);
+Edges = Summary.Lo(i)+(Summary.Hi(i)-Summary.Lo(i))*(0:nb)/nb;
+Lower = Edges(1:end-1)';
+Upper = Edges(2:end)';
+w = 0.25; % Half width of boxes
+hold on
+for j=1:length(ClassIdx)
+    
+    h = sum(Summary.Hist{i}(:,ClassIdx{j}),2);
+    n = sum(h);
+    if n==0
+        continue;
+    end
+    Min = min(Summary.Min(ClassIdx{j},i));
+    Max = max(Summary.Max(ClassIdx{j},i));
+    
+    % Quartiles
+    c = cumsum(h)/n;
+    Q = zeros(1,3);
+    p = [0.25 0.5 0.75];
+    for k=1:3
+        b = find(c>=p(k),1,'first');
+        c0 = 0;
+        if b>1
+            c0 = c(b-1);
+        end
+        Q(k) = Lower(b)+(Upper(b)-Lower(b))*(p(k)-c0)/(c(b)-c0);
+    end
+    Q = min(max(Q,Min),Max);
+    IQR = Q(3)-Q(1);
+    
+    % Whiskers (the most extreme values within 1.5 IQR of the box) and outliers
+    Fence = [Q(1)-1.5*IQR Q(3)+1.5*IQR];
+    In = find(h>0 & Upper>=Fence(1) & Lower<=Fence(2));
+    Whisker = [max([Lower(In(1)) Fence(1) Min]) min([Upper(In(end)) Fence(2) Max])];
+    Whisker = [min(Whisker(1),Q(1)) max(Whisker(2),Q(3))];
+    Outliers = (Lower(h>0 & (Upper<Fence(1) | Lower>Fence(2)))+Upper(h>0 & (Upper<Fence(1) | Lower>Fence(2))))/2;
+    Outliers = min(max(Outliers,Min),Max);
+    
+    % Notched box, median, whiskers, and outliers
+    Notch = Q(2)+[-1 1]*1.57*IQR/sqrt(n);
+    plot(j+w*[-1 1 1 0.5 1 1 -1 -1 -0.5 -1 -1],[Q(1) Q(1) Notch(1) Q(2) Notch(2) Q(3) Q(3) Notch(2) Q(2) Notch(1) Q(1)],'b-');
+    plot(j+w*[-0.5 0.5],[Q(2) Q(2)],'r-');
+    plot([j j],[Q(3) Whisker(2)],'k--',[j j],[Whisker(1) Q(1)],'k--');
+    plot(j+w*[-0.5 0.5],[Whisker(2) Whisker(2)],'k-',j+w*[-0.5 0.5],[Whisker(1) Whisker(1)],'k-');
+    plot(repmat(j,size(Outliers)),Outliers,'r+');
+end
+set(gca,'XTick',1:length(ClassIdx),'XTickLabel',CategoriesLabels,'XLim',[0.5 length(ClassIdx)+0.5]);
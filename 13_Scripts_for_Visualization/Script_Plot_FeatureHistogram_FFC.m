@@ -3,6 +3,9 @@ function ErrorMsg = Script_Plot_FeatureHistogram_FFC
 % This function takes Dataset_FFC with L rows (L samples) and C columns (C-2 features) and does the following process:
 %   - Plots histogram of a feature for two or more different sets of classes. 
 %
+%   Note: If no dataset is loaded, a dataset file can be selected. The dataset is streamed in blocks,
+%   and only the compact summaries of the features are plotted (see Aggregate_Dataset_FFC).
+%
 % Copyright (C) 2020 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
 % 
 % This file is a part of Fragments-Expert software, a software package for
@@ -23,13 +26,25 @@ function ErrorMsg = Script_Plot_FeatureHistogram_FFC
 %
 % Revisions:
 % 2020-Jun-01   function was created
+% 2026-Oct-18   histograms are aggregated by streaming the dataset (or a dataset file) in blocks
 
 %% Initialization
 global ClassLabels_FFC FeatureLabels_FFC Dataset_FFC
+global FeatureStats_FFC
 
+%% Check that Dataset is generated/loaded (or select a dataset file)
 if isempty(Dataset_FFC)
-    ErrorMsg = 'No dataset is loaded. Please generate or load a dataset.';
-    return;
+    [Source,FeatureLabels,ClassLabels,~,~,~,~,ErrorMsg] = ...
+        Open_Dataset_File_FFC('No dataset is loaded. Select a dataset file for visualization');
+    if ~isempty(ErrorMsg)
+        return;
+    end
+    FeatureStats = [];
+else
+    Source = Dataset_FFC;
+    FeatureLabels = FeatureLabels_FFC;
+    ClassLabels = ClassLabels_FFC;
+    FeatureStats = FeatureStats_FFC;
 end
 
 
@@ -39,11 +54,6 @@ end
 %% --------------------------------------------------------------------------------------------------#
 %% ###################################################################################################
 
-%% Initial Assignment
-FeatureLabels = FeatureLabels_FFC;
-ClassLabels = ClassLabels_FFC;
-Dataset = Dataset_FFC;
-
 %% Select Features
 [ErrorMsg,FeatureIdx,~] = Select_from_List_FFC(FeatureLabels,1,'Select feature labels');
 if ~isempty(ErrorMsg)
@@ -86,44 +96,30 @@ if Err
 end
 
 
+%% Aggregate Histograms of Features for Classes
+Options.FeatureStats = FeatureStats;
+Options.Classes = unique([ClassIdx{:}]);
+Options.NumBins = B;
+[Summary,ErrorMsg] = Aggregate_Dataset_FFC(Source,length(ClassLabels),FeatureSel,Options);
+if ~isempty(ErrorMsg)
+    return;
+end
+
 %% Plot Histogram for Each Feature
 figure('Name','Features Histogram','NumberTitle','off');
-fun = cell(1,length(ClassIdx));
-for f = FeatureSel
+for cnt=1:length(FeatureSel)
     
-    % Initialization
-    F = cell(1,length(FeatureSel));
-
-    % Counter 
-    cnt = find(FeatureSel==f);
-    
-    % Determine Bins
-    Min = inf;
-    Max = -inf;
-    for j=1:length(ClassIdx)
-        
-        % Find rows for class j
-        if cnt==1
-            fun{j} = @(x) ismember(x,ClassIdx{j});
-        end
-        idx = arrayfun(fun{j},Dataset(:,end-1));
-        
-        % The value of the feature for class j
-        F{j} = Dataset(idx,f);
-        
-        % Minimum and Maximum Range
-        Min = min(min(F{j}),Min);
-        Max = max(max(F{j}),Max);
-    end
-    bins_center = (0:1/B(cnt):1)*(Max-Min)+Min;
+    % Determine Bins (the range of the selected classes)
+    Min = Summary.Lo(cnt);
+    Max = Summary.Hi(cnt);
     bins = (1/(2*B(cnt)):1/B(cnt):1)*(Max-Min)+Min;
     
     % Histogram Calculation
-    count = [];
+    count = zeros(length(ClassIdx),B(cnt));
     for j=1:length(ClassIdx)
         
-        countj = histcounts(F{j},bins_center,'Normalization','probability');
-        count = [count ; countj];
+        countj = sum(Summary.Hist{cnt}(:,ClassIdx{j}),2)';
+        count(j,:) = countj/sum(countj);
     end
     
     % Plot Histogrm
@@ -3,6 +3,9 @@ function ErrorMsg = Script_Plot_Samples_in_FeatureSpace_FFC
 % This function takes Dataset_FFC with L rows (L samples) and C columns (C-2 features) and does the following process:
 %   - The samples of two or more different sets of classes are plotted in 2-D or 3-D feature space. 
 %
+%   Note: If no dataset is loaded, a dataset file can be selected. The dataset is streamed in blocks,
+%   and only the compact summaries of the features are plotted (see Aggregate_Dataset_FFC).
+%
 % Copyright (C) 2020 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
 % 
 % This file is a part of Fragments-Expert software, a software package for
@@ -23,13 +26,26 @@ function ErrorMsg = Script_Plot_Samples_in_FeatureSpace_FFC
 %
 % Revisions:
 % 2020-Jun-01   function was created
+% 2026-Oct-18   a stratified random sample of classes is plotted, which is taken by streaming the dataset
+%               (or a dataset file) in blocks
 
 %% Initialization
 global ClassLabels_FFC FeatureLabels_FFC Dataset_FFC
+global FeatureStats_FFC
 
+%% Check that Dataset is generated/loaded (or select a dataset file)
 if isempty(Dataset_FFC)
-    ErrorMsg = 'No dataset is loaded. Please generate or load a dataset.';
-    return;
+    [Source,FeatureLabels,ClassLabels,~,~,~,~,ErrorMsg] = ...
+        Open_Dataset_File_FFC('No dataset is loaded. Select a dataset file for visualization');
+    if ~isempty(ErrorMsg)
+        return;
+    end
+    FeatureStats = [];
+else
+    Source = Dataset_FFC;
+    FeatureLabels = FeatureLabels_FFC;
+    ClassLabels = ClassLabels_FFC;
+    FeatureStats = FeatureStats_FFC;
 end
 
 
@@ -39,11 +55,6 @@ end
 %% --------------------------------------------------------------------------------------------------#
 %% ###################################################################################################
 
-%% Initial Assignment
-FeatureLabels = FeatureLabels_FFC;
-ClassLabels = ClassLabels_FFC;
-Dataset = Dataset_FFC;
-
 %% Select Features
 [ErrorMsg,FeatureIdx,~] = Select_from_List_FFC(FeatureLabels,1,'Select up two or three feature to be included');
 if ~isempty(ErrorMsg)
@@ -67,16 +78,42 @@ end
 
 CategoriesLabels = SetVariableNames_FFC(Select_CellContents_FFC(ClassLabels,ClassIdx),false);
 
+%% Get Parameters
+K = 5000; % Maximum number of displayed samples of each set of classes
+[success,K] = PromptforParameters_FFC({'Maximum number of displayed samples of each set of classes'},{num2str(K)},'Parameters for displaying samples');
+if ~success
+    ErrorMsg = 'Process is aborted. Parameters for displaying samples are not specified.';
+    return;
+end
+
+[Err,ErrMsg] = Check_Variable_Value_FFC(K,'Maximum number of displayed samples','type','scalar','class','real','class','integer','min',1);
+if Err
+    ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+    return;
+end
+
+%% Take a Stratified Random Sample of Classes
+Options.FeatureStats = FeatureStats;
+Options.SampleSize = K;
+[Summary,ErrorMsg] = Aggregate_Dataset_FFC(Source,length(ClassLabels),FeatureSel,Options);
+if ~isempty(ErrorMsg)
+    return;
+end
+
 %% Collect Feature Values
+% The classes of a set are sampled in proportion to their number of samples
 F = cell(1,length(ClassIdx));
 for j=1:length(ClassIdx)
     
-    % Find rows for class j
-    fun = @(x) ismember(x,ClassIdx{j});
-    idx = arrayfun(fun,Dataset(:,end-1));
-    
-    % The value of the features for class j
-    F{j} = Dataset(idx,FeatureSel);
+    Count = Summary.Count(ClassIdx{j});
+    F{j} = zeros(0,length(FeatureSel));
+    for i=1:length(ClassIdx{j})
+        
+        % The value of the features for the sampled rows of class i
+        Fi = Summary.Sample(Summary.SampleLabels==ClassIdx{j}(i),:);
+        k = min(size(Fi,1),round(K*Count(i)/max(sum(Count),1)));
+        F{j} = [F{j} ; Fi(randperm(size(Fi,1),k),:)];
+    end
     
 end
     
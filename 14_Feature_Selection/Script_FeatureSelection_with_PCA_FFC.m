@@ -3,6 +3,9 @@ function ErrorMsg = Script_FeatureSelection_with_PCA_FFC
 % This function takes Dataset_FFC with L rows (L samples) and C columns (C-2 features) and does the following process:
 %   - Use feature transformation method of principal component analysis (PCA) to obtain the new set of features.
 %
+%   Note: The principal components are calculated by RandomizedPCA_FFC, which reads the dataset in blocks of rows.
+%   If no dataset is loaded, a dataset file can be selected, which is not loaded in memory as a whole.
+%
 % Copyright (C) 2020 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
 % 
 % This file is a part of Fragments-Expert software, a software package for
@@ -24,15 +27,57 @@ function ErrorMsg = Script_FeatureSelection_with_PCA_FFC
 % Revisions:
 % 2020-Oct-29   function was created
 % 2021-Jan-03   Feature_Transfrom_FFC was defined and included
+% 2026-Oct-18   Randomized block-streaming PCA (RandomizedPCA_FFC) and out-of-core datasets were included
 
 %% Initialization
 global ClassLabels_FFC FeatureLabels_FFC Dataset_FFC
 global Function_Handles_FFC Function_Labels_FFC Function_Select_FFC
 global Feature_Transfrom_FFC
 
-%% Check that Dataset is generated/loaded
+%% Check that Dataset is generated/loaded (or select a dataset file for out-of-core PCA)
+matObj = [];
 if isempty(Dataset_FFC)
-    ErrorMsg = 'No dataset is loaded. Please generate or load a dataset.';
+    [matObj,~,ClassLabels,Function_Handles,Function_Labels,Function_Select,Feature_Transfrom,ErrorMsg] = ...
+        Open_Dataset_File_FFC('No dataset is loaded. Select a dataset file for PCA');
+    if ~isempty(ErrorMsg)
+        return;
+    end
+    [L,C] = size(matObj,'Dataset');
+else
+    ClassLabels = ClassLabels_FFC;
+    Function_Handles = Function_Handles_FFC;
+    Function_Labels = Function_Labels_FFC;
+    Function_Select = Function_Select_FFC;
+    Feature_Transfrom = Feature_Transfrom_FFC;
+    [L,C] = size(Dataset_FFC);
+end
+F = C-2;
+
+%% Parameters
+Param_Names = {'NumComponents','NumIterations'};
+Param_Description = {sprintf('Number of principal components (1~%d)',F),...
+    'Number of power iterations (0~10, more iterations give more accurate components)'};
+Default_Value = {num2str(min(F,100)),'2'};
+
+dlg_title = 'Parameters for PCA';
+str_cmd = PromptforParameters_text_for_eval_FFC(Param_Names,Param_Description,Default_Value,dlg_title);
+eval(str_cmd);
+
+if ~success
+    ErrorMsg = sprintf('Process is aborted. Parameters for PCA are not specified');
+    return;
+end
+
+%% Check Parameters
+[Err,ErrMsg] = Check_Variable_Value_FFC(NumComponents,'Number of principal components','type','scalar','class','real','class','integer','min',1,'max',F);
+if Err
+    ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
+    return;
+end
+
+[Err,ErrMsg] = Check_Variable_Value_FFC(NumIterations,'Number of power iterations','type','scalar','class','real','class','integer','min',0,'max',10);
+if Err
+    ErrorMsg = sprintf('Process is aborted. %s',ErrMsg);
     return;
 end
 
@@ -43,21 +88,24 @@ end
 %% ###################################################################################################
 
 %% Assignments
-ClassLabels = ClassLabels_FFC;
-FeatureLabels = cell(1,length(FeatureLabels_FFC));
-for j=1:length(FeatureLabels_FFC)
+FeatureLabels = cell(1,NumComponents);
+for j=1:NumComponents
     FeatureLabels{j} = sprintf('PCA_%d',j);
 end
 
 %% Applying PCA
-Dataset = zeros(size(Dataset_FFC));
-[Coef,~,feat_eigs] = pca(Dataset_FFC(:,1:end-2));
-Dataset(:,1:end-2) = Dataset_FFC(:,1:end-2)*Coef;
-Dataset(:,end-1:end) = Dataset_FFC(:,end-1:end);
+if isempty(matObj)
+    [Coef,feat_eigs,ErrorMsg] = RandomizedPCA_FFC(Dataset_FFC,NumComponents,NumIterations);
+else
+    [Coef,feat_eigs,ErrorMsg] = RandomizedPCA_FFC(matObj,NumComponents,NumIterations);
+end
+if ~isempty(ErrorMsg)
+    return;
+end
 
 %% Prompt User for Selecting Features
-UsedFeatures_Str = cell(1,length(FeatureLabels_FFC));
-for j=1:length(FeatureLabels_FFC)
+UsedFeatures_Str = cell(1,NumComponents);
+for j=1:NumComponents
     UsedFeatures_Str{j} = sprintf('Feature #%d: %s (Eigen-Value  %g)',j,FeatureLabels{j},feat_eigs(j));
 end
 
@@ -73,11 +121,27 @@ UsedFeatures = FeatureLabels(FeatureSel);
 FeatSel = sort(FeatSel,'ascend');
 FeatSel = FeatSel(:)';
 
-Dataset = Dataset(:,[FeatSel end-1:end]);
+if isempty(matObj)
+    Dataset = [Dataset_FFC(:,1:end-2)*Coef(:,FeatSel) Dataset_FFC(:,end-1:end)];
+else
+    % Transform the dataset file in blocks of rows
+    Dataset = zeros(L,length(FeatSel)+2);
+    BlockSize = max(1,floor(2^27/(8*C)));
+    progressbar_FFC('Transforming dataset ...');
+    for r1=1:BlockSize:L
+        r2 = min(r1+BlockSize-1,L);
+        Xb = matObj.Dataset(r1:r2,:);
+        Dataset(r1:r2,:) = [Xb(:,1:end-2)*Coef(:,FeatSel) Xb(:,end-1:end)];
+        stopbar = progressbar_FFC(1,r2/L);
+        if stopbar
+            ErrorMsg = 'Process is aborted by user.';
+            return;
+        end
+    end
+end
 FeatureLabels = FeatureLabels(FeatSel);
 
 %% Modify Feature_Transfrom
-Feature_Transfrom = Feature_Transfrom_FFC;
 if isempty(Feature_Transfrom)
     Feature_Transfrom.Coef = Coef(:,FeatSel);
 else
@@ -85,10 +149,6 @@ else
 end
 
 %% Save Dataset
-Function_Handles = Function_Handles_FFC;
-Function_Labels = Function_Labels_FFC;
-Function_Select = Function_Select_FFC;
-
 [Filename,path] = uiputfile('feature_selected_dataset.mat','Save Feature-Selected Dataset');
 if isequal(Filename,0)
     ErrorMsg = 'Process is aborted. No file was selected by user for saving dataset.';
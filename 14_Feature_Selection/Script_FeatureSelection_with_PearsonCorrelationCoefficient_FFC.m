@@ -1,7 +1,10 @@
 function ErrorMsg = Script_FeatureSelection_with_PearsonCorrelationCoefficient_FFC
 
 % This function takes Dataset_FFC with L rows (L samples) and C columns (C-2 features) and does the following process:
-%   - Use Pearson correlation coefficient to sort and select the features.
+%   - Use Pearson correlation coefficient (or mutual information) to sort and select the features.
+%
+%   Note: If no dataset is loaded, a dataset file can be selected. Then, the features of the dataset file
+%   are ranked without loading the whole dataset in memory.
 %
 % Copyright (C) 2021 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
 %
@@ -24,20 +27,37 @@ function ErrorMsg = Script_FeatureSelection_with_PearsonCorrelationCoefficient_F
 % Revisions:
 % 2020-Oct-29   function was created
 % 2021-Jan-03   Feature_Transfrom_FFC was included
+% 2026-Oct-18   Ranking by Rank_Features_FFC (blocked, out-of-core), and mutual information criterion were added
 
 %% Initialization
 global ClassLabels_FFC FeatureLabels_FFC Dataset_FFC
 global Function_Handles_FFC Function_Labels_FFC Function_Select_FFC
 global Feature_Transfrom_FFC
 
-%% Check that Dataset is generated/loaded
+%% Check that Dataset is generated/loaded (or select a dataset file for out-of-core ranking)
+matObj = [];
 if isempty(Dataset_FFC)
-    ErrorMsg = 'No dataset is loaded. Please generate or load a dataset.';
-    return;
+    if exist('FeatureRanking_Core_FFC','file')~=3
+        ErrorMsg = 'No dataset is loaded. Please generate or load a dataset.';
+        return;
+    end
+    [matObj,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select,Feature_Transfrom,ErrorMsg] = ...
+        Open_Dataset_File_FFC('No dataset is loaded. Select a dataset file for ranking its features');
+    if ~isempty(ErrorMsg)
+        return;
+    end
+    [~,C] = size(matObj,'Dataset');
+else
+    FeatureLabels = FeatureLabels_FFC;
+    ClassLabels = ClassLabels_FFC;
+    Function_Handles = Function_Handles_FFC;
+    Function_Labels = Function_Labels_FFC;
+    Function_Select = Function_Select_FFC;
+    Feature_Transfrom = Feature_Transfrom_FFC;
 end
 
 %% Check that Dataset has at least two classes
-if length(ClassLabels_FFC)<2
+if length(ClassLabels)<2
     ErrorMsg = 'At least two classes should be presented.';
     return;
 end
@@ -48,34 +68,33 @@ end
 %% --------------------------------------------------------------------------------------------------#
 %% ###################################################################################################
 
-%% Assignments
-Dataset = Dataset_FFC;
-FeatureLabels = FeatureLabels_FFC;
-ClassLabels = ClassLabels_FFC;
-
-%% Calculating Pearson Correlation Coefficients
-progressbar_FFC('Calculating Pearson Correlation Coefficients ...');
-RHO = zeros(1,size(Dataset,2)-2);
-for j=1:size(Dataset,2)-2
-    
-    RHO(j) = corr(Dataset(:,j),Dataset(:,end-1));
-    
-    stopbar = progressbar_FFC(1,j/(size(Dataset,2)-2));
-    if stopbar
-        ErrorMsg = 'Process is aborted by user.';
-        return;
-    end
-    
+%% Calculating Pearson Correlation Coefficients and Mutual Information
+if isempty(matObj)
+    [RHO,MI,ErrorMsg] = Rank_Features_FFC(Dataset_FFC,length(ClassLabels));
+else
+    [RHO,MI,ErrorMsg] = Rank_Features_FFC(matObj,length(ClassLabels));
+end
+if ~isempty(ErrorMsg)
+    return;
 end
 
-RHO = abs(RHO);
-RHO(isnan(RHO)) = 0;
+%% Select Ranking Criterion
+button = questdlg('Select the criterion for sorting the features','Ranking Criterion',...
+    'Pearson Correlation','Mutual Information','Pearson Correlation');
+if isempty(button)
+    ErrorMsg = 'Process is aborted. No ranking criterion was selected by user.';
+    return;
+end
 
 %% Prompt User for Selecting Features
-[RHO,idx] = sort(RHO,'descend');
+if isequal(button,'Mutual Information')
+    [~,idx] = sort(MI,'descend');
+else
+    [~,idx] = sort(RHO,'descend');
+end
 UsedFeatures_Str = cell(1,length(idx));
 for j=1:length(idx)
-    UsedFeatures_Str{j} = sprintf('Feature #%d: %s (Correlation %0.2f)',j,FeatureLabels{idx(j)},RHO(j));
+    UsedFeatures_Str{j} = sprintf('Feature #%d: %s (Correlation %0.2f, MI %0.3f bits)',j,FeatureLabels{idx(j)},RHO(idx(j)),MI(idx(j)));
 end
 
 [ErrorMsg,FeatureSel,~] = Select_from_List_FFC(UsedFeatures_Str,1,'Select features to be included');
@@ -90,13 +109,22 @@ UsedFeatures = FeatureLabels(idx(FeatureSel));
 FeatSel = sort(FeatSel,'ascend');
 FeatSel = FeatSel(:)';
 
-Dataset = Dataset(:,[FeatSel end-1:end]);
+if isempty(matObj)
+    Dataset = Dataset_FFC(:,[FeatSel end-1:end]);
+else
+    % Read the selected columns one by one from the dataset file
+    L = size(matObj,'Dataset',1);
+    Dataset = zeros(L,length(FeatSel)+2);
+    Cols = [FeatSel C-1 C];
+    for j=1:length(Cols)
+        Dataset(:,j) = matObj.Dataset(:,Cols(j));
+    end
+end
 FeatureLabels = FeatureLabels(FeatSel);
 
-if isempty(Feature_Transfrom_FFC)
+if isempty(Feature_Transfrom)
     
     cnt = 0;
-    Function_Select = Function_Select_FFC;
     if ~isempty(Function_Select)
         for i=1:length(Function_Select)
             for j=1:length(Function_Select{i})
@@ -113,14 +141,10 @@ if isempty(Feature_Transfrom_FFC)
     
 else
     
-    Function_Select = Function_Select_FFC;
-    Feature_Transfrom.Coef = Feature_Transfrom_FFC.Coef(:,FeatSel);    
+    Feature_Transfrom.Coef = Feature_Transfrom.Coef(:,FeatSel);    
 end
 
 %% Save Dataset
-Function_Handles = Function_Handles_FFC;
-Function_Labels = Function_Labels_FFC;
-
 [Filename,path] = uiputfile('feature_selected_dataset.mat','Save Feature-Selected Dataset');
 if isequal(Filename,0)
     ErrorMsg = 'Process is aborted. No file was selected by user for saving dataset.';
@@ -0,0 +1,145 @@
+function ErrorMsg = Script_Remove_ConstantFeatures_FFC
+
+% This function takes Dataset_FFC with L rows (L samples) and C columns (C-2 features) and does the following process:
+%   - Remove the constant features (the features whose values are equal for all samples).
+%
+%   Note: The constant features are found from the statistics of features which are saved with the dataset
+%   (see Init_FeatureStats_FFC). If the dataset is saved without them, they are calculated by a single pass
+%   over the dataset. If no dataset is loaded, a dataset file can be selected. Then, only the remaining
+%   features of the dataset file are loaded in memory.
+%
+% Copyright (C) 2026 Mehdi Teimouri <mehditeimouri [at] ut.ac.ir>
+%
+% This file is a part of Fragments-Expert software, a software package for
+% feature extraction from file fragments and classification among various file formats.
+%
+% Fragments-Expert software is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License
+% as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+%
+% Fragments-Expert software is distributed in the hope that it will be useful,but WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along with this program.
+% If not, see <http://www.gnu.org/licenses/>.
+%
+% Output:
+%   ErrorMsg: Possible error message. If there is no error, this output is
+%   empty.
+%
+% Revisions:
+% 2026-Oct-18   function was created
+
+%% Initialization
+global ClassLabels_FFC FeatureLabels_FFC Dataset_FFC
+global Function_Handles_FFC Function_Labels_FFC Function_Select_FFC
+global Feature_Transfrom_FFC FeatureStats_FFC
+
+%% Check that Dataset is generated/loaded (or select a dataset file)
+matObj = [];
+if isempty(Dataset_FFC)
+    [matObj,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select,Feature_Transfrom,ErrorMsg] = ...
+        Open_Dataset_File_FFC('No dataset is loaded. Select a dataset file for removing its constant features');
+    if ~isempty(ErrorMsg)
+        return;
+    end
+    [~,C] = size(matObj,'Dataset');
+    try
+        FeatureStats = matObj.FeatureStats;
+    catch
+        FeatureStats = [];
+    end
+else
+    FeatureLabels = FeatureLabels_FFC;
+    ClassLabels = ClassLabels_FFC;
+    Function_Handles = Function_Handles_FFC;
+    Function_Labels = Function_Labels_FFC;
+    Function_Select = Function_Select_FFC;
+    Feature_Transfrom = Feature_Transfrom_FFC;
+    FeatureStats = FeatureStats_FFC;
+end
+
+%% ###################################################################################################
+%% --------------------------------------------------------------------------------------------------#
+%% -------------------------------------- Function Main Body ----------------------------------------#
+%% --------------------------------------------------------------------------------------------------#
+%% ###################################################################################################
+
+%% Statistics of Features
+if isempty(FeatureStats)
+    GUI_MainEditBox_Update_FFC(false,'The dataset is saved without the statistics of features. They are calculated ...');
+    if isempty(matObj)
+        [FeatureStats,ErrorMsg] = Collect_FeatureStats_FFC(Dataset_FFC,length(ClassLabels));
+    else
+        [FeatureStats,ErrorMsg] = Collect_FeatureStats_FFC(matObj,length(ClassLabels));
+    end
+    if ~isempty(ErrorMsg)
+        return;
+    end
+end
+
+Summary = Summarize_FeatureStats_FFC(FeatureStats,ClassLabels,FeatureLabels);
+for i=1:length(Summary)
+    GUI_MainEditBox_Update_FFC(false,Summary{i});
+end
+
+%% Find constant features
+Constant = Find_ConstantFeatures_FFC(FeatureStats);
+if ~any(Constant)
+    ErrorMsg = 'Process is aborted. The dataset has no constant feature.';
+    return;
+end
+if all(Constant)
+    ErrorMsg = 'Process is aborted. All features of the dataset are constant.';
+    return;
+end
+FeatSel = find(~Constant);
+
+%% Remove constant features from dataset
+if isempty(matObj)
+    Dataset = Dataset_FFC(:,[FeatSel end-1:end]);
+else
+    % Read the remaining columns one by one from the dataset file
+    L = size(matObj,'Dataset',1);
+    Dataset = zeros(L,length(FeatSel)+2);
+    Cols = [FeatSel C-1 C];
+    for j=1:length(Cols)
+        Dataset(:,j) = matObj.Dataset(:,Cols(j));
+    end
+end
+FeatureLabels = FeatureLabels(FeatSel);
+FeatureStats = Subset_FeatureStats_FFC(FeatureStats,FeatSel);
+
+if isempty(Feature_Transfrom)
+
+    cnt = 0;
+    if ~isempty(Function_Select)
+        for i=1:length(Function_Select)
+            for j=1:length(Function_Select{i})
+                if Function_Select{i}(j)
+                    cnt = cnt+1;
+                    if all(FeatSel~=cnt)
+                        Function_Select{i}(j) = false;
+                    end
+                end
+            end
+        end
+    end
+    Feature_Transfrom = [];
+
+else
+
+    Feature_Transfrom.Coef = Feature_Transfrom.Coef(:,FeatSel);
+end
+
+%% Save Dataset
+[Filename,path] = uiputfile('feature_selected_dataset.mat','Save Feature-Selected Dataset');
+if isequal(Filename,0)
+    ErrorMsg = 'Process is aborted. No file was selected by user for saving dataset.';
+    return;
+end
+save([path Filename],'Dataset','FeatureLabels','ClassLabels','Function_Handles','Function_Labels','Function_Select','Feature_Transfrom','FeatureStats','-v7.3');
+
+%% Update GUI
+GUI_Dataset_Update_FFC(Filename,Dataset,FeatureLabels,ClassLabels,Function_Handles,Function_Labels,Function_Select,Feature_Transfrom,FeatureStats);
+GUI_MainEditBox_Update_FFC(false,sprintf('%d constant features are removed.',sum(Constant)));
+GUI_MainEditBox_Update_FFC(false,'The process is completed successfully.');
@@ -26,6 +26,7 @@ function ErrorMsg = Script_SequentialForward_FeatureSelection_FFC
 % 2020-Jun-10   function was created
 % 2020-Oct-29   filename for saving the dataset is prompted before the process of feature selectiion begins
 % 2021-Jan-03   Feature_Transfrom_FFC was included
+% 2026-Oct-18   candidate features are evaluated by SequentialForward_LDA_Core_FFC (C-MEX) if it is available
 
 %% Initialization
 global ClassLabels_FFC FeatureLabels_FFC Dataset_FFC
@@ -119,6 +120,28 @@ end
 %% Assign Weights
 Weights = Assign_Weights_FFC(Dataset_FFC(:,end-1),ClassLabels_FFC,Weighting_Method);
 
+%% Native Selection Engine
+% The engine keeps the LDA classifiers of folds and evaluates each candidate feature by an incremental update.
+% It is not used if the dataset contains NaN, as the samples with NaN features are ignored by LDA.
+NativeEngine = exist('SequentialForward_LDA_Core_FFC','file')==3 && ~any(isnan(Dataset_FFC(:)));
+if NativeEngine
+    Fold = zeros(size(Dataset_FFC,1),1);
+    for j=1:K
+        
+        % The training samples of each fold are the samples of other folds (Train/Validation Percentages are [100 0])
+        TestIndex = KFoldsIdx{j};
+        TrainValidationIndex = setdiff(AllIndex,TestIndex);
+        [ErrorMsg,~,~] = Partition_Dataset_FFC(Dataset_FFC(TrainValidationIndex,end-1:end),ClassLabels_FFC,{[TV(1) TV(2)],[TV(2) TV(3)]},PartitionGenerateError);
+        if ~isempty(ErrorMsg)
+            return;
+        end
+        Fold(TestIndex) = j;
+        
+    end
+    SequentialForward_LDA_Core_FFC('init',Dataset_FFC,Weights,Fold,length(ClassLabels_FFC),...
+        find(strcmp(feature_scaling_method,{'z-score','min-max','no scaling'})));
+end
+
 %% Greedy Search Loop
 AllFeatures = (1:size(Dataset_FFC,2)-2);
 SelectedFeatures = [];
@@ -130,54 +153,77 @@ while(~isempty(AllFeatures))
     progressbar_FFC(sprintf('Selecting feature #%d',length(SelectedFeatures)+1),'Loop over K Folds');
     
     Pc = zeros(1,size(Dataset_FFC,2)-2);
-    for i=1:length(AllFeatures) % Loop over features
+    if NativeEngine
         
-        % Feature Vector
-        Features = [SelectedFeatures AllFeatures(i)];
-        
-        for j=1:K % Loop over K Folds
+        % Candidates are evaluated in chunks for progress indication
+        Chunk = ceil(length(AllFeatures)/20);
+        for i=1:Chunk:length(AllFeatures)
+            
+            idx = i:min(i+Chunk-1,length(AllFeatures));
+            Pc(idx) = SequentialForward_LDA_Core_FFC('evaluate',Dataset_FFC,AllFeatures(idx));
             
-            % Train and Test Index
-            TestIndex = KFoldsIdx{j};
-            TrainValidationIndex = setdiff(AllIndex,TestIndex);
-            [ErrorMsg,TIndex,VIndex] = Partition_Dataset_FFC(Dataset_FFC(TrainValidationIndex,end-1:end),ClassLabels_FFC,{[TV(1) TV(2)],[TV(2) TV(3)]},PartitionGenerateError);
-            if ~isempty(ErrorMsg)
-                progressbar_FFC(1,1);
+            % progress indication
+            stopbar = progressbar_FFC(1,idx(end)/length(AllFeatures));
+            if stopbar
+                SequentialForward_LDA_Core_FFC('clear');
+                ErrorMsg = 'Process is aborted by user.';
                 return;
             end
             
-            % Scaling Features
-            Dataset = zeros(size(Dataset_FFC,1),length(Features)+2);
-            [Dataset(TrainValidationIndex,:),Scaling_Parameters] = Scale_Features_FFC(Dataset_FFC(TrainValidationIndex,[Features end-1:end]),feature_scaling_method);
-            Dataset(TestIndex,:) = Scale_Features_FFC(Dataset_FFC(TestIndex,[Features end-1:end]),Scaling_Parameters);
+        end
+        
+    else
+        
+        for i=1:length(AllFeatures) % Loop over features
+        
+            % Feature Vector
+            Features = [SelectedFeatures AllFeatures(i)];
+        
+            for j=1:K % Loop over K Folds
             
-            % Train Decision Model
-            [DM,~,~,~,~] = Build_LDA_FFC(Dataset,ClassLabels_FFC,FeatureLabels_FFC(Features),Weights,TrainValidationIndex(TIndex),TrainValidationIndex(VIndex));
+                % Train and Test Index
+                TestIndex = KFoldsIdx{j};
+                TrainValidationIndex = setdiff(AllIndex,TestIndex);
+                [ErrorMsg,TIndex,VIndex] = Partition_Dataset_FFC(Dataset_FFC(TrainValidationIndex,end-1:end),ClassLabels_FFC,{[TV(1) TV(2)],[TV(2) TV(3)]},PartitionGenerateError);
+                if ~isempty(ErrorMsg)
+                    progressbar_FFC(1,1);
+                    return;
+                end
             
-            % Evaluate the performance of the final decision machine on the test set
-            [~,Pc_tmp,~,~,~] = Test_LDA_FFC(DM,Dataset,TestIndex,...
-                ClassLabels_FFC,ClassLabels_FFC,FeatureLabels_FFC(Features),FeatureLabels_FFC(Features),Weights);
+                % Scaling Features
+                Dataset = zeros(size(Dataset_FFC,1),length(Features)+2);
+                [Dataset(TrainValidationIndex,:),Scaling_Parameters] = Scale_Features_FFC(Dataset_FFC(TrainValidationIndex,[Features end-1:end]),feature_scaling_method);
+                Dataset(TestIndex,:) = Scale_Features_FFC(Dataset_FFC(TestIndex,[Features end-1:end]),Scaling_Parameters);
             
-            % Update Test Results
-            Pc(i)= Pc(i)+Pc_tmp;
+                % Train Decision Model
+                [DM,~,~,~,~] = Build_LDA_FFC(Dataset,ClassLabels_FFC,FeatureLabels_FFC(Features),Weights,TrainValidationIndex(TIndex),TrainValidationIndex(VIndex));
+            
+                % Evaluate the performance of the final decision machine on the test set
+                [~,Pc_tmp,~,~,~] = Test_LDA_FFC(DM,Dataset,TestIndex,...
+                    ClassLabels_FFC,ClassLabels_FFC,FeatureLabels_FFC(Features),FeatureLabels_FFC(Features),Weights);
+            
+                % Update Test Results
+                Pc(i)= Pc(i)+Pc_tmp;
             
+                % progress indication
+                stopbar = progressbar_FFC(2,j/K);
+                if stopbar
+                    ErrorMsg = 'Process is aborted by user.';
+                    return;
+                end
+            
+            end
+        
+            % Update Test Results
+            Pc(i) = Pc(i)/K;
+        
             % progress indication
-            stopbar = progressbar_FFC(2,j/K);
+            stopbar = progressbar_FFC(1,i/length(AllFeatures));
             if stopbar
                 ErrorMsg = 'Process is aborted by user.';
                 return;
             end
-            
-        end
         
-        % Update Test Results
-        Pc(i) = Pc(i)/K;
-        
-        % progress indication
-        stopbar = progressbar_FFC(1,i/length(AllFeatures));
-        if stopbar
-            ErrorMsg = 'Process is aborted by user.';
-            return;
         end
         
     end
@@ -196,9 +242,15 @@ while(~isempty(AllFeatures))
     GUI_MainEditBox_Update_FFC(false,sprintf('Selected feature #%d is %s. Average accuracy is %0.2f%%.',...
         cnt-1,FeatureLabels_FFC{AllFeatures(maxidx)},Pc_Selected(cnt)));
     SelectedFeatures = [SelectedFeatures AllFeatures(maxidx)];
+    if NativeEngine
+        SequentialForward_LDA_Core_FFC('add',Dataset_FFC,AllFeatures(maxidx));
+    end
     AllFeatures = setdiff(AllFeatures,AllFeatures(maxidx));
     
 end
+if NativeEngine
+    SequentialForward_LDA_Core_FFC('clear');
+end
 
 if isempty(AllFeatures)
     GUI_MainEditBox_Update_FFC(false,'All Features are needed. There is no need for saving the results.');
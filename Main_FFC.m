@@ -24,6 +24,9 @@ function Main_FFC
 %   2023-Oct-29   "Plot Feature 2D-Histogram" was defined and included
 %   2023-Dec-23   "Generate CSV Dataset from Generic Binary Files of Fragments Using Parallel Processing" was defined and included
 %   2023-Dec-25   Converting between *.dat and *.csv fragments dataset was defined
+%   2026-Oct-18   "Export Decision Machine" was defined and included
+%   2026-Oct-18   "Train Cascade of Decision Machines" was defined and included
+%   2026-Oct-18   "Filter: Remove Constant Features" and FeatureStats_FFC were defined and included
 
 %% Initialization
 global Main_FFC_fig
@@ -172,6 +175,7 @@ uimenu(Dataset_Menu,'Label','Convert Raw Multimedia to Fragments Dataset','Callb
 FeatureSelection_Menu = uimenu('Label','Feature Selection');
 uimenu(FeatureSelection_Menu,'Label','Embedded: Decision Tree','Callback',@RunMethodsforMenus_FFC);
 uimenu(FeatureSelection_Menu,'Label','Filter: Pearson Correlation Coefficient','Callback',@RunMethodsforMenus_FFC);
+uimenu(FeatureSelection_Menu,'Label','Filter: Remove Constant Features','Callback',@RunMethodsforMenus_FFC);
 uimenu(FeatureSelection_Menu,'Label','Wrapper: Sequential Forward Selection with LDA','Callback',@RunMethodsforMenus_FFC);
 uimenu(FeatureSelection_Menu,'Label','Feature Transformation: Principal Component Analysis (PCA)','Callback',@RunMethodsforMenus_FFC);
 
@@ -180,6 +184,8 @@ Learning_Menu = uimenu('Label','Learning');
 uimenu(Learning_Menu,'Label','Train Decision Machine','Callback',@RunMethodsforMenus_FFC);
 uimenu(Learning_Menu,'Label','Test Decision Machine','Callback',@RunMethodsforMenus_FFC);
 uimenu(Learning_Menu,'Label','Cross-Validation of Decision Machine','Callback',@RunMethodsforMenus_FFC);
+uimenu(Learning_Menu,'Label','Export Decision Machine','Callback',@RunMethodsforMenus_FFC,'Separator','on');
+uimenu(Learning_Menu,'Label','Train Cascade of Decision Machines','Callback',@RunMethodsforMenus_FFC);
 
 %% Define Visualization Menu and Submenus
 Visualization_Menu = uimenu('Label','Visualization');
@@ -254,6 +260,12 @@ switch get(source,'Label')
     case 'Cross-Validation of Decision Machine'
         ErrorMsg = Script_DecisionMachine_CrossValidation_FFC;
         
+    case 'Export Decision Machine'
+        ErrorMsg = Script_Export_DecisionMachine_FFC;
+        
+    case 'Train Cascade of Decision Machines'
+        ErrorMsg = Script_Cascade_DecisionMachine_Train_FFC;
+        
     case 'Generate Dataset (for Decision Machine) from Generic Binary Files of Fragments'
         ErrorMsg = Script_GenerateDataset_for_DecisionMachine_FFC;
         
@@ -284,6 +296,9 @@ switch get(source,'Label')
     case 'Filter: Pearson Correlation Coefficient'
         ErrorMsg = Script_FeatureSelection_with_PearsonCorrelationCoefficient_FFC;
         
+    case 'Filter: Remove Constant Features'
+        ErrorMsg = Script_Remove_ConstantFeatures_FFC;
+        
     case 'Feature Transformation: Principal Component Analysis (PCA)'
         ErrorMsg = Script_FeatureSelection_with_PCA_FFC;
 
@@ -353,6 +368,7 @@ function Close_Main_FFC(~,~)
 global AllPaths_FFC Main_FFC_fig Dataset_FFC Function_Handles_FFC
 global DecisionMachine_FFC DecisionMachine_CL_FFC
 global Feature_Transfrom_FFC DM_Feature_Transfrom_FFC
+global FeatureStats_FFC
 
 rmpath(AllPaths_FFC);
 Main_FFC_fig = [];
@@ -362,3 +378,4 @@ DecisionMachine_FFC = [];
 DecisionMachine_CL_FFC = [];
 Feature_Transfrom_FFC = [];
 DM_Feature_Transfrom_FFC = [];
+FeatureStats_FFC = [];